@@ -0,0 +1,112 @@
+/****************************************************************************
+ **
+ ** Copyright (C) 2011-2017 Philippe Steinmann.
+ **
+ ** This file is part of multiDiagTools library.
+ **
+ ** multiDiagTools is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Lesser General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** multiDiagTools is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public License
+ ** along with multiDiagTools.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+#include "CollatorSortKeyCache.h"
+#include <QModelIndex>
+#include <QAbstractItemModel>
+#include <QVariant>
+#include <QString>
+
+// #include <QDebug>
+
+namespace Mdt{ namespace ItemModel{
+
+const QCollatorSortKey *CollatorSortKeyCache::sortKey(const QModelIndex & index, int role, const QCollator & collator)
+{
+  Q_ASSERT(index.isValid());
+
+  if(index.parent().isValid()){
+    return nullptr;
+  }
+  auto & columnKeys = mColumnSortKeys[index.column()];
+  if( (columnKeys.role != role) || (columnKeys.caseSensitivity != collator.caseSensitivity()) || (columnKeys.numericMode != collator.numericMode()) ){
+    columnKeys = ColumnSortKeys();
+    columnKeys.caseSensitivity = collator.caseSensitivity();
+    columnKeys.numericMode = collator.numericMode();
+    columnKeys.role = role;
+  }
+  const int row = index.row();
+  const int rowCount = index.model()->rowCount();
+  if(columnKeys.keyStateByRow.size() != rowCount){
+    /*
+     * Allocate keys for all rows once. Rows are filled with a placeholder,
+     * so computing a key later is a assignment that never reallocates the storage.
+     */
+    columnKeys.keyStateByRow.fill(NotCached, rowCount);
+    columnKeys.keyByRow.clear();
+    columnKeys.keyByRow.resize( static_cast<size_t>(rowCount), collator.sortKey(QString()) );
+  }
+  Q_ASSERT(row < columnKeys.keyStateByRow.size());
+  Q_ASSERT(static_cast<size_t>(row) < columnKeys.keyByRow.size());
+  auto & state = columnKeys.keyStateByRow[row];
+  if(state == NotCached){
+    const auto data = index.data(role);
+    if(data.type() == QVariant::String){
+      columnKeys.keyByRow[row] = collator.sortKey(data.toString());
+      state = Cached;
+    }else{
+      state = NotString;
+    }
+  }
+  if(state == NotString){
+    return nullptr;
+  }
+  Q_ASSERT(state == Cached);
+
+  return &columnKeys.keyByRow[row];
+}
+
+void CollatorSortKeyCache::invalidate(const QModelIndex & topLeft, const QModelIndex & bottomRight)
+{
+  if( (!topLeft.isValid()) || (!bottomRight.isValid()) || topLeft.parent().isValid() ){
+    return;
+  }
+  for(int column = topLeft.column(); column <= bottomRight.column(); ++column){
+    const auto it = mColumnSortKeys.find(column);
+    if(it == mColumnSortKeys.end()){
+      continue;
+    }
+    auto & columnKeys = *it;
+    const int lastRow = qMin(bottomRight.row(), columnKeys.keyStateByRow.size() - 1);
+    for(int row = topLeft.row(); row <= lastRow; ++row){
+      columnKeys.keyStateByRow[row] = NotCached;
+    }
+  }
+}
+
+void CollatorSortKeyCache::clear()
+{
+  mColumnSortKeys.clear();
+}
+
+int CollatorSortKeyCache::count() const
+{
+  int n = 0;
+  for(const auto & columnKeys : mColumnSortKeys){
+    for(const auto state : columnKeys.keyStateByRow){
+      if(state == Cached){
+        ++n;
+      }
+    }
+  }
+  return n;
+}
+
+}} // namespace Mdt{ namespace ItemModel{
@@ -0,0 +1,114 @@
+/****************************************************************************
+ **
+ ** Copyright (C) 2011-2017 Philippe Steinmann.
+ **
+ ** This file is part of multiDiagTools library.
+ **
+ ** multiDiagTools is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Lesser General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** multiDiagTools is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public License
+ ** along with multiDiagTools.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+#ifndef MDT_ITEM_MODEL_COLLATOR_SORT_KEY_CACHE_H
+#define MDT_ITEM_MODEL_COLLATOR_SORT_KEY_CACHE_H
+
+#include "MdtItemModelExport.h"
+#include <QCollator>
+#include <QHash>
+#include <QVector>
+#include <Qt>
+#include <vector>
+
+class QModelIndex;
+
+namespace Mdt{ namespace ItemModel{
+
+  /*! \brief Cache of collation sort keys used by SortProxyModel
+   *
+   * Comparing strings with a QCollator is expensive,
+   *  and a sort will compare each string many times.
+   *  This cache computes a QCollatorSortKey once for each index,
+   *  the sort then only compares sort keys.
+   *
+   * Sort keys are stored by column.
+   *  For each column, the collator attributes (case sensitivity and numeric mode)
+   *  and the role used to compute the keys are stored.
+   *  If they differ from the ones of a later request,
+   *  all keys of the column are dropped.
+   *
+   * When a column is first used, its key storage is allocated
+   *  for all rows of the model, and keys are then computed in place.
+   *  The keys of a column never move in memory while a sort compares them,
+   *  so the pointer returned for a index stays valid
+   *  while the key of a other index of the same column is requested.
+   *
+   * The cache does not listen to model signals.
+   *  The user of this class has to call invalidate() when data changed,
+   *  and clear() when rows are inserted, removed or moved.
+   *
+   * Only indexes of a table model (that have no parent) are cached.
+   */
+  class MDT_ITEMMODEL_EXPORT CollatorSortKeyCache
+  {
+   public:
+
+    /*! \brief Get the sort key for \a index
+     *
+     * Returns a pointer to the sort key for \a index ,
+     *  computing it with \a collator if it is not allready cached.
+     *  Returns a nullptr if the data of \a index, for \a role, is not a string,
+     *  or if \a index has a parent.
+     *  The returned pointer is valid until clear() or invalidate() is called,
+     *  the row count of the model changes,
+     *  or a key is requested for the same column with a other role or collator attributes.
+     *
+     * \pre \a index must be valid
+     */
+    const QCollatorSortKey *sortKey(const QModelIndex & index, int role, const QCollator & collator);
+
+    /*! \brief Invalidate sort keys in range \a topLeft , \a bottomRight
+     */
+    void invalidate(const QModelIndex & topLeft, const QModelIndex & bottomRight);
+
+    /*! \brief Clear the cache
+     */
+    void clear();
+
+    /*! \brief Get count of cached sort keys
+     */
+    int count() const;
+
+   private:
+
+    enum KeyState
+    {
+      NotCached,
+      NotString,
+      Cached
+    };
+
+    struct ColumnSortKeys
+    {
+      Qt::CaseSensitivity caseSensitivity = Qt::CaseSensitive;
+      bool numericMode = false;
+      int role = -1;
+      QVector<KeyState> keyStateByRow;
+      // One key per row, allocated once, so that keys never move
+      std::vector<QCollatorSortKey> keyByRow;
+    };
+
+    QHash<int, ColumnSortKeys> mColumnSortKeys;
+  };
+
+}} // namespace Mdt{ namespace ItemModel{
+
+#endif // #ifndef MDT_ITEM_MODEL_COLLATOR_SORT_KEY_CACHE_H
@@ -34,6 +34,10 @@ namespace Mdt{ namespace ItemModel{
 
     /*! \brief Const iterator
      */
+    typedef std::vector<ColumnSortOrder>::const_iterator const_iterator;
+
+    /*! \brief Const reverse iterator
+     */
     typedef std::vector<ColumnSortOrder>::const_reverse_iterator const_reverse_iterator;
 
     /*! \brief Add a column to sort order
@@ -43,6 +47,34 @@ namespace Mdt{ namespace ItemModel{
       mList.emplace_back(column, sortOrder);
     }
 
+    /*! \brief Get a iterator to the beginning
+     */
+    const_iterator begin() const
+    {
+      return mList.cbegin();
+    }
+
+    /*! \brief Get a iterator to the end
+     */
+    const_iterator end() const
+    {
+      return mList.cend();
+    }
+
+    /*! \brief Get a iterator to the beginning
+     */
+    const_iterator cbegin() const
+    {
+      return mList.cbegin();
+    }
+
+    /*! \brief Get a iterator to the end
+     */
+    const_iterator cend() const
+    {
+      return mList.cend();
+    }
+
     /*! \brief Get a reverse iterator to the beginning
      */
     const_reverse_iterator crbegin() const
@@ -0,0 +1,145 @@
+/****************************************************************************
+ **
+ ** Copyright (C) 2011-2017 Philippe Steinmann.
+ **
+ ** This file is part of multiDiagTools library.
+ **
+ ** multiDiagTools is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Lesser General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** multiDiagTools is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public License
+ ** along with multiDiagTools.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+#include "ConditionalFormatMap.h"
+#include <QAbstractItemModel>
+#include <algorithm>
+
+namespace Mdt{ namespace ItemModel{
+
+constexpr int ConditionalFormatMap::NotEvaluated;
+constexpr int ConditionalFormatMap::NoMatch;
+
+ConditionalFormatRule::ConditionalFormatRule(const FilterExpression & condition, const QVariant & format)
+ : mCondition(condition),
+   mFormat(format)
+{
+  Q_ASSERT(!mCondition.isNull());
+  Q_ASSERT(!mFormat.isNull());
+}
+
+void ConditionalFormatMap::addRuleExpression(const FilterExpression & condition, const QVariant & format)
+{
+  Q_ASSERT(!condition.isNull());
+  Q_ASSERT(!format.isNull());
+
+  mRules.emplace_back(condition, format);
+  clearCache();
+}
+
+void ConditionalFormatMap::clearRules()
+{
+  mRules.clear();
+  clearCache();
+}
+
+QVariant ConditionalFormatMap::formatForRow(const QAbstractItemModel * const model, int row) const
+{
+  Q_ASSERT(model != nullptr);
+  Q_ASSERT(row >= 0);
+  Q_ASSERT(row < model->rowCount());
+
+  if(mRules.empty()){
+    return QVariant();
+  }
+  if(row >= static_cast<int>(mRuleIndexByRow.size())){
+    mRuleIndexByRow.resize(model->rowCount(), NotEvaluated);
+  }
+  int & ruleIndex = mRuleIndexByRow[row];
+  if(ruleIndex == NotEvaluated){
+    ruleIndex = ruleIndexForRow(model, row);
+  }
+  if(ruleIndex == NoMatch){
+    return QVariant();
+  }
+  Q_ASSERT(ruleIndex < static_cast<int>(mRules.size()));
+
+  return mRules[ruleIndex].format();
+}
+
+bool ConditionalFormatMap::updateRow(const QAbstractItemModel * const model, int row)
+{
+  Q_ASSERT(model != nullptr);
+  Q_ASSERT(row >= 0);
+  Q_ASSERT(row < model->rowCount());
+
+  if(!isRowEvaluated(row)){
+    return false;
+  }
+  const int ruleIndex = ruleIndexForRow(model, row);
+  if(ruleIndex == mRuleIndexByRow[row]){
+    return false;
+  }
+  mRuleIndexByRow[row] = ruleIndex;
+
+  return true;
+}
+
+void ConditionalFormatMap::insertRows(int row, int count)
+{
+  Q_ASSERT(row >= 0);
+  Q_ASSERT(count >= 1);
+
+  if(row > static_cast<int>(mRuleIndexByRow.size())){
+    return;
+  }
+  mRuleIndexByRow.insert(mRuleIndexByRow.begin() + row, count, NotEvaluated);
+}
+
+void ConditionalFormatMap::removeRows(int row, int count)
+{
+  Q_ASSERT(row >= 0);
+  Q_ASSERT(count >= 1);
+
+  const int size = mRuleIndexByRow.size();
+  if(row >= size){
+    return;
+  }
+  const int end = std::min(row + count, size);
+  mRuleIndexByRow.erase(mRuleIndexByRow.begin() + row, mRuleIndexByRow.begin() + end);
+}
+
+void ConditionalFormatMap::clearCache()
+{
+  mRuleIndexByRow.clear();
+}
+
+int ConditionalFormatMap::ruleIndexForRow(const QAbstractItemModel * const model, int row) const
+{
+  Q_ASSERT(model != nullptr);
+  Q_ASSERT(row >= 0);
+  Q_ASSERT(row < model->rowCount());
+
+  const int columnCount = model->columnCount();
+  const int n = mRules.size();
+  for(int i = 0; i < n; ++i){
+    const auto & condition = mRules[i].condition();
+    if(condition.greatestColumn() >= columnCount){
+      continue;
+    }
+    if(condition.eval(model, row, Qt::CaseSensitive)){
+      return i;
+    }
+  }
+
+  return NoMatch;
+}
+
+}} //namespace Mdt{ namespace ItemModel{
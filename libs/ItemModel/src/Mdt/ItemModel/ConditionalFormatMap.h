@@ -0,0 +1,196 @@
+/****************************************************************************
+ **
+ ** Copyright (C) 2011-2017 Philippe Steinmann.
+ **
+ ** This file is part of multiDiagTools library.
+ **
+ ** multiDiagTools is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Lesser General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** multiDiagTools is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public License
+ ** along with multiDiagTools.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+#ifndef MDT_ITEM_MODEL_CONDITIONAL_FORMAT_MAP_H
+#define MDT_ITEM_MODEL_CONDITIONAL_FORMAT_MAP_H
+
+#include "FilterExpression.h"
+#include "MdtItemModelExport.h"
+#include <QVariant>
+#include <QtGlobal>
+#include <vector>
+
+class QAbstractItemModel;
+
+namespace Mdt{ namespace ItemModel{
+
+  /*! \brief Rule of a ConditionalFormatMap
+   */
+  class MDT_ITEMMODEL_EXPORT ConditionalFormatRule
+  {
+   public:
+
+    /*! \brief Construct a rule that gives \a format to rows matching \a condition
+     *
+     * \pre \a condition must not be null
+     * \pre \a format must not be null
+     */
+    explicit ConditionalFormatRule(const FilterExpression & condition, const QVariant & format);
+
+    /*! \brief Get condition
+     */
+    const FilterExpression & condition() const
+    {
+      return mCondition;
+    }
+
+    /*! \brief Get format
+     */
+    QVariant format() const
+    {
+      return mFormat;
+    }
+
+   private:
+
+    FilterExpression mCondition;
+    QVariant mFormat;
+  };
+
+  /*! \brief Stores formats that apply to the rows of a item model matching a condition
+   *
+   * A condition is a filter expression, like the ones used by FilterProxyModel:
+   * \code
+   * using Mdt::ItemModel::FilterColumn;
+   *
+   * FilterColumn amount(3);
+   * ConditionalFormatMap map;
+   * map.addRule( amount < 0, QBrush(Qt::red) );
+   * \endcode
+   *
+   * Rules are checked in the order they have been added,
+   *  the first one that matches gives the format of the whole row.
+   *
+   * Evaluating a rule reads data from the model,
+   *  so the result is cached per row the first time it is needed.
+   *  The cache is only kept correct by telling the map about changes of the model,
+   *  see updateRow(), insertRows(), removeRows() and clearCache().
+   */
+  class MDT_ITEMMODEL_EXPORT ConditionalFormatMap
+  {
+   public:
+
+    /*! \brief Add a rule that gives \a format to rows matching \a condition
+     *
+     * \pre \a condition must be a filter expression type
+     *       (see FilterProxyModel::setFilter() for details)
+     * \pre \a format must not be null
+     */
+    template<typename Expr>
+    void addRule(const Expr & condition, const QVariant & format)
+    {
+      FilterExpression expression;
+      expression.setExpression(condition);
+      addRuleExpression(expression, format);
+    }
+
+    /*! \brief Add a rule that gives \a format to rows matching \a condition
+     *
+     * \pre \a condition must not be null
+     * \pre \a format must not be null
+     */
+    void addRuleExpression(const FilterExpression & condition, const QVariant & format);
+
+    /*! \brief Remove all rules
+     */
+    void clearRules();
+
+    /*! \brief Check if no rule was added
+     */
+    bool isEmpty() const
+    {
+      return mRules.empty();
+    }
+
+    /*! \brief Get count of rules
+     */
+    int ruleCount() const
+    {
+      return mRules.size();
+    }
+
+    /*! \brief Get format for \a row in \a model
+     *
+     * Returns the format of the first rule that matches \a row ,
+     *  otherwise a null QVariant.
+     *  A rule that refers to a column that does not exist in \a model never matches.
+     *  Strings are compared case sensitively.
+     *
+     * \pre \a model must be a valid pointer
+     * \pre \a row must be in valid range ( 0 <= row < model->rowCount() )
+     */
+    QVariant formatForRow(const QAbstractItemModel * const model, int row) const;
+
+    /*! \brief Check if the rules have been evaluated for \a row since the last change
+     *
+     * \pre \a row must be >= 0
+     */
+    bool isRowEvaluated(int row) const
+    {
+      Q_ASSERT(row >= 0);
+      return ( (row < static_cast<int>(mRuleIndexByRow.size())) && (mRuleIndexByRow[row] != NotEvaluated) );
+    }
+
+    /*! \brief Evaluate rules again for \a row after its data changed in \a model
+     *
+     * Rows that have not been evaluated yet are left for formatForRow().
+     *
+     * Returns true if the format of \a row changed.
+     *
+     * \pre \a model must be a valid pointer
+     * \pre \a row must be in valid range ( 0 <= row < model->rowCount() )
+     */
+    bool updateRow(const QAbstractItemModel * const model, int row);
+
+    /*! \brief Tell this map that \a count rows have been inserted before \a row
+     *
+     * \pre \a row must be >= 0
+     * \pre \a count must be >= 1
+     */
+    void insertRows(int row, int count);
+
+    /*! \brief Tell this map that \a count rows have been removed starting from \a row
+     *
+     * \pre \a row must be >= 0
+     * \pre \a count must be >= 1
+     */
+    void removeRows(int row, int count);
+
+    /*! \brief Forget results of all rows
+     *
+     * Must be called when the model has been reset,
+     *  or when its rows or columns have been moved.
+     */
+    void clearCache();
+
+   private:
+
+    int ruleIndexForRow(const QAbstractItemModel * const model, int row) const;
+
+    static constexpr int NotEvaluated = -2;
+    static constexpr int NoMatch = -1;
+
+    std::vector<ConditionalFormatRule> mRules;
+    mutable std::vector<int> mRuleIndexByRow;
+  };
+
+}} //namespace Mdt{ namespace ItemModel{
+
+#endif // #ifndef MDT_ITEM_MODEL_CONDITIONAL_FORMAT_MAP_H
@@ -19,9 +19,7 @@
  **
  ****************************************************************************/
 #include "ComparisonEval.h"
-#include "Mdt/FilterExpression/LikeExpressionRegexTransform.h"
-#include <QRegularExpression>
-#include <QRegularExpressionMatch>
+#include "CompiledLikePattern.h"
 #include <QAbstractItemModel>
 #include <QModelIndex>
 
@@ -55,17 +53,7 @@ QVariant getVariantValue(const ParentModelColumnData & col, const FilterEvalData
 
 bool CompareLikeTo::isLike(const FilterColumnData & col, const QString & like, const FilterEvalData & data) const
 {
-  using Mdt::FilterExpression::LikeExpressionRegexTransform;
-
-  QRegularExpression regex;
-
-  if(data.caseSensitivity() == Qt::CaseInsensitive){
-    regex.setPatternOptions(QRegularExpression::CaseInsensitiveOption);
-  }
-  regex.setPattern( LikeExpressionRegexTransform::getRegexPattern(like) );
-  Q_ASSERT(regex.isValid());
-
-  return regex.match( getStringValue(col, data) ).hasMatch();
+  return CompiledLikePattern(like, data.caseSensitivity()).match( getStringValue(col, data) );
 }
 
 bool CompareEqualTo::isEqual(const FilterColumnData& col, const QString & value, const FilterEvalData & data)
@@ -0,0 +1,113 @@
+/****************************************************************************
+ **
+ ** Copyright (C) 2011-2017 Philippe Steinmann.
+ **
+ ** This file is part of multiDiagTools library.
+ **
+ ** multiDiagTools is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Lesser General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** multiDiagTools is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public License
+ ** along with multiDiagTools.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+#include "CompiledLikePattern.h"
+#include "Mdt/FilterExpression/LikeExpressionRegexTransform.h"
+#include <QRegularExpressionMatch>
+#include <QLatin1Char>
+
+namespace Mdt{ namespace ItemModel{ namespace Expression{
+
+CompiledLikePattern::CompiledLikePattern(const QString & like, Qt::CaseSensitivity cs)
+ : mMatchKind(RegexMatch),
+   mCaseSensitivity(cs)
+{
+  using Mdt::FilterExpression::LikeExpressionRegexTransform;
+
+  /*
+   * The regular expression is allways set,
+   * because it is also used for strings that contains a line break
+   * (see match()).
+   * QRegularExpression only compiles it at first use.
+   */
+  if(cs == Qt::CaseInsensitive){
+    mRegex.setPatternOptions(QRegularExpression::CaseInsensitiveOption);
+  }
+  mRegex.setPattern( LikeExpressionRegexTransform::getRegexPattern(like) );
+  /*
+   * Find if pattern is a literal, optionally preceded and/or followed by '*'
+   */
+  if(like.contains(QLatin1Char('\\'))){
+    return;
+  }
+  int first = 0;
+  int last = like.size();
+  while( (first < last) && (like.at(first) == QLatin1Char('*')) ){
+    ++first;
+  }
+  while( (last > first) && (like.at(last-1) == QLatin1Char('*')) ){
+    --last;
+  }
+  mLiteral = like.mid(first, last - first);
+  if( mLiteral.contains(QLatin1Char('*')) || mLiteral.contains(QLatin1Char('?')) ){
+    mLiteral.clear();
+    return;
+  }
+  const bool hasLeadingWildcard = (first > 0);
+  const bool hasTrailingWildcard = (last < like.size());
+  if( mLiteral.isEmpty() && (hasLeadingWildcard || hasTrailingWildcard) ){
+    mMatchKind = AnyMatch;
+  }else if(hasLeadingWildcard && hasTrailingWildcard){
+    mMatchKind = ContainsMatch;
+  }else if(hasLeadingWildcard){
+    mMatchKind = SuffixMatch;
+  }else if(hasTrailingWildcard){
+    mMatchKind = PrefixMatch;
+  }else{
+    mMatchKind = ExactMatch;
+  }
+}
+
+bool CompiledLikePattern::match(const QString & str) const
+{
+  /*
+   * In the regular expression, a wildcard does not match a line break,
+   * and $ also matches before a final line break.
+   * To allways give the same result, such strings are matched by the regular expression.
+   */
+  if( (mMatchKind == RegexMatch) || str.contains(QLatin1Char('\n')) ){
+    return matchRegex(str);
+  }
+  switch(mMatchKind){
+    case ExactMatch:
+      return (QString::compare(str, mLiteral, mCaseSensitivity) == 0);
+    case PrefixMatch:
+      return str.startsWith(mLiteral, mCaseSensitivity);
+    case SuffixMatch:
+      return str.endsWith(mLiteral, mCaseSensitivity);
+    case ContainsMatch:
+      return str.contains(mLiteral, mCaseSensitivity);
+    case AnyMatch:
+      return true;
+    case RegexMatch:
+      break;
+  }
+
+  return matchRegex(str);
+}
+
+bool CompiledLikePattern::matchRegex(const QString & str) const
+{
+  Q_ASSERT(mRegex.isValid());
+
+  return mRegex.match(str).hasMatch();
+}
+
+}}} // namespace Mdt{ namespace ItemModel{ namespace Expression{
@@ -0,0 +1,82 @@
+/****************************************************************************
+ **
+ ** Copyright (C) 2011-2017 Philippe Steinmann.
+ **
+ ** This file is part of multiDiagTools library.
+ **
+ ** multiDiagTools is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Lesser General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** multiDiagTools is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public License
+ ** along with multiDiagTools.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+#ifndef MDT_ITEM_MODEL_EXPRESSION_COMPILED_LIKE_PATTERN_H
+#define MDT_ITEM_MODEL_EXPRESSION_COMPILED_LIKE_PATTERN_H
+
+#include "MdtItemModelExport.h"
+#include <QString>
+#include <QRegularExpression>
+#include <Qt>
+
+namespace Mdt{ namespace ItemModel{ namespace Expression{
+
+  /*! \brief A LikeExpression pattern, compiled once to be matched against many strings
+   *
+   * Patterns that only have wildcards '*' at their begin and/or end
+   *  (like "ABC", "ABC*", "*ABC" or "*ABC*")
+   *  are matched with a direct string search.
+   *  Other patterns are matched with a QRegularExpression,
+   *  built by Mdt::FilterExpression::LikeExpressionRegexTransform .
+   */
+  class MDT_ITEMMODEL_EXPORT CompiledLikePattern
+  {
+   public:
+
+    /*! \brief How a pattern is matched
+     */
+    enum MatchKind
+    {
+      ExactMatch,     /*!< Pattern without wildcard */
+      PrefixMatch,    /*!< Pattern like "ABC*" */
+      SuffixMatch,    /*!< Pattern like "*ABC" */
+      ContainsMatch,  /*!< Pattern like "*ABC*" */
+      AnyMatch,       /*!< Pattern like "*" */
+      RegexMatch      /*!< Any other pattern */
+    };
+
+    /*! \brief Compile \a like
+     */
+    CompiledLikePattern(const QString & like, Qt::CaseSensitivity cs);
+
+    /*! \brief Get how this pattern is matched
+     */
+    MatchKind matchKind() const
+    {
+      return mMatchKind;
+    }
+
+    /*! \brief Check if \a str matches this pattern
+     */
+    bool match(const QString & str) const;
+
+   private:
+
+    bool matchRegex(const QString & str) const;
+
+    MatchKind mMatchKind;
+    Qt::CaseSensitivity mCaseSensitivity;
+    QString mLiteral;
+    QRegularExpression mRegex;
+  };
+
+}}} // namespace Mdt{ namespace ItemModel{ namespace Expression{
+
+#endif // #ifndef MDT_ITEM_MODEL_EXPRESSION_COMPILED_LIKE_PATTERN_H
@@ -26,6 +26,7 @@
 #include "FilterEvalData.h"
 #include "GetRelationKeyForEquality.h"
 #include "GreatestColumnTransform.h"
+#include "FilterProgram.h"
 #include <QAbstractItemModel>
 #include <Qt>
 #include <boost/proto/deep_copy.hpp>
@@ -46,12 +47,17 @@ namespace Mdt{ namespace ItemModel{ namespace Expression{
      *  the resuling expression is not the same as input expression.
      *  But, caller has not to care about this implementation detail.
      *
+     * The stored expression is also compiled to a FilterProgram,
+     *  which is used by eval().
+     *
      * \tparam Expr The expression to store
      */
     template<typename Expr>
     FilterExpressionContainer(const Expr & expr)
      : mExpression( boost::proto::deep_copy(expr) )
     {
+      FilterProgramCompiler compiler(mProgram);
+      boost::proto::eval(mExpression, compiler);
     }
 
     // Constructors / destructors
@@ -75,8 +81,12 @@ namespace Mdt{ namespace ItemModel{ namespace Expression{
       Q_ASSERT(row >= 0);
       Q_ASSERT(row < model->rowCount());
 
+      const FilterEvalData data(model, row, cs);
+      if(!mProgram.isEmpty()){
+        return mProgram.eval(data);
+      }
       FilterEval ev;
-      return ev(mExpression, 0, FilterEvalData(model, row, cs));
+      return ev(mExpression, 0, data);
     }
 
     /*! \brief Evaluate if row matches stored expression in model
@@ -92,8 +102,12 @@ namespace Mdt{ namespace ItemModel{ namespace Expression{
       Q_ASSERT(row < model->rowCount());
       Q_ASSERT(!parentModelData.isNull());
 
+      const FilterEvalData data(model, row, parentModelData, cs);
+      if(!mProgram.isEmpty()){
+        return mProgram.eval(data);
+      }
       FilterEval ev;
-      return ev(mExpression, 0, FilterEvalData(model, row, parentModelData, cs));
+      return ev(mExpression, 0, data);
     }
 
     /*! \brief Get a relation key that contains pais of equly compared columns of this expression
@@ -132,6 +146,7 @@ namespace Mdt{ namespace ItemModel{ namespace Expression{
    private:
 
     StoredExpr mExpression;
+    FilterProgram mProgram;
   };
 
 }}} // namespace Mdt{ namespace ItemModel{ namespace Expression{
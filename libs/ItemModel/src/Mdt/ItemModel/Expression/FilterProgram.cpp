@@ -0,0 +1,252 @@
+/****************************************************************************
+ **
+ ** Copyright (C) 2011-2017 Philippe Steinmann.
+ **
+ ** This file is part of multiDiagTools library.
+ **
+ ** multiDiagTools is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Lesser General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** multiDiagTools is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public License
+ ** along with multiDiagTools.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+#include "FilterProgram.h"
+#include <QAbstractItemModel>
+#include <QModelIndex>
+#include <QVarLengthArray>
+
+namespace Mdt{ namespace ItemModel{ namespace Expression{
+
+namespace{
+
+  /*
+   * Value of a column, fetched from the model at first use
+   */
+  struct ColumnValue
+  {
+    bool hasVariant = false;
+    bool hasString = false;
+    QVariant variant;
+    QString string;
+  };
+
+  bool comparisonResult(FilterInstruction::Comparison comparison, int cmp)
+  {
+    switch(comparison){
+      case FilterInstruction::Equal:
+        return (cmp == 0);
+      case FilterInstruction::NotEqual:
+        return (cmp != 0);
+      case FilterInstruction::Less:
+        return (cmp < 0);
+      case FilterInstruction::LessEqual:
+        return (cmp <= 0);
+      case FilterInstruction::Greater:
+        return (cmp > 0);
+      case FilterInstruction::GreaterEqual:
+        return (cmp >= 0);
+    }
+    return false;
+  }
+
+  bool compareVariants(FilterInstruction::Comparison comparison, const QVariant & a, const QVariant & b)
+  {
+    switch(comparison){
+      case FilterInstruction::Equal:
+        return (a == b);
+      case FilterInstruction::NotEqual:
+        return (a != b);
+      case FilterInstruction::Less:
+        return (a < b);
+      case FilterInstruction::LessEqual:
+        return (a <= b);
+      case FilterInstruction::Greater:
+        return (a > b);
+      case FilterInstruction::GreaterEqual:
+        return (a >= b);
+    }
+    return false;
+  }
+
+  const QVariant & variantValue(ColumnValue & value, const QAbstractItemModel *model, int row, int column)
+  {
+    if(!value.hasVariant){
+      Q_ASSERT(model != nullptr);
+      Q_ASSERT(column < model->columnCount());
+      const auto index = model->index(row, column);
+      Q_ASSERT(index.isValid());
+      value.variant = model->data(index);
+      value.hasVariant = true;
+    }
+    return value.variant;
+  }
+
+  const QString & stringValue(ColumnValue & value, const QAbstractItemModel *model, int row, int column)
+  {
+    if(!value.hasString){
+      value.string = variantValue(value, model, row, column).toString();
+      value.hasString = true;
+    }
+    return value.string;
+  }
+
+} // namespace{
+
+bool FilterProgram::eval(const FilterEvalData & data) const
+{
+  Q_ASSERT(!isEmpty());
+
+  QVarLengthArray<ColumnValue, 8> values(mColumns.size());
+  QVarLengthArray<ColumnValue, 4> parentValues(mParentModelColumns.size());
+  const auto *model = data.model();
+  const int row = data.row();
+  const auto cs = data.caseSensitivity();
+  const int instructionCount = mInstructions.size();
+  bool result = false;
+
+  int pc = 0;
+  while(pc < instructionCount){
+    const auto & instruction = mInstructions.at(pc);
+    switch(instruction.opCode){
+      case FilterInstruction::CompareString:
+        {
+          const auto & str = stringValue(values[instruction.columnSlot], model, row, mColumns.at(instruction.columnSlot));
+          result = comparisonResult( instruction.comparison, QString::compare(str, mStrings.at(instruction.operand), cs) );
+        }
+        break;
+      case FilterInstruction::CompareVariant:
+        {
+          const auto & var = variantValue(values[instruction.columnSlot], model, row, mColumns.at(instruction.columnSlot));
+          result = compareVariants( instruction.comparison, var, mVariants.at(instruction.operand) );
+        }
+        break;
+      case FilterInstruction::CompareParentColumn:
+        {
+          const auto & var = variantValue(values[instruction.columnSlot], model, row, mColumns.at(instruction.columnSlot));
+          const auto & parentVar = variantValue(parentValues[instruction.operand], data.parentModel(), data.parentModelRow(), mParentModelColumns.at(instruction.operand));
+          result = compareVariants(instruction.comparison, var, parentVar);
+        }
+        break;
+      case FilterInstruction::CompareLike:
+        {
+          const auto & str = stringValue(values[instruction.columnSlot], model, row, mColumns.at(instruction.columnSlot));
+          const int patternIndex = (cs == Qt::CaseSensitive) ? instruction.operand : instruction.operand + 1;
+          Q_ASSERT(patternIndex < static_cast<int>(mLikePatterns.size()));
+          result = mLikePatterns[patternIndex].match(str);
+        }
+        break;
+      case FilterInstruction::JumpIfFalse:
+        if(!result){
+          pc = instruction.operand;
+          continue;
+        }
+        break;
+      case FilterInstruction::JumpIfTrue:
+        if(result){
+          pc = instruction.operand;
+          continue;
+        }
+        break;
+    }
+    ++pc;
+  }
+
+  return result;
+}
+
+void FilterProgram::addStringComparison(FilterInstruction::Comparison comparison, int column, const QString & value)
+{
+  mStrings.append(value);
+  addInstruction( FilterInstruction::CompareString, comparison, slot(mColumns, column), mStrings.size()-1 );
+}
+
+void FilterProgram::addVariantComparison(FilterInstruction::Comparison comparison, int column, const QVariant & value)
+{
+  mVariants.append(value);
+  addInstruction( FilterInstruction::CompareVariant, comparison, slot(mColumns, column), mVariants.size()-1 );
+}
+
+void FilterProgram::addParentColumnComparison(FilterInstruction::Comparison comparison, int column, int parentModelColumn)
+{
+  addInstruction( FilterInstruction::CompareParentColumn, comparison, slot(mColumns, column), slot(mParentModelColumns, parentModelColumn) );
+}
+
+void FilterProgram::addLikeComparison(int column, const QString & like)
+{
+  const int patternIndex = static_cast<int>(mLikePatterns.size());
+  mLikePatterns.emplace_back(like, Qt::CaseSensitive);
+  mLikePatterns.emplace_back(like, Qt::CaseInsensitive);
+  addInstruction( FilterInstruction::CompareLike, FilterInstruction::Equal, slot(mColumns, column), patternIndex );
+}
+
+int FilterProgram::addJump(FilterInstruction::OpCode opCode)
+{
+  Q_ASSERT( (opCode == FilterInstruction::JumpIfFalse) || (opCode == FilterInstruction::JumpIfTrue) );
+
+  addInstruction(opCode, FilterInstruction::Equal, -1, -1);
+
+  return mInstructions.size()-1;
+}
+
+void FilterProgram::setJumpTargetToEnd(int index)
+{
+  Q_ASSERT(index >= 0);
+  Q_ASSERT(index < mInstructions.size());
+
+  mInstructions[index].operand = mInstructions.size();
+}
+
+int FilterProgram::slot(QVector<int> & columns, int column)
+{
+  Q_ASSERT(column >= 0);
+
+  int index = columns.indexOf(column);
+  if(index < 0){
+    columns.append(column);
+    index = columns.size()-1;
+  }
+
+  return index;
+}
+
+void FilterProgram::addInstruction(FilterInstruction::OpCode opCode, FilterInstruction::Comparison comparison, int columnSlot, int operand)
+{
+  FilterInstruction instruction;
+  instruction.opCode = opCode;
+  instruction.comparison = comparison;
+  instruction.columnSlot = columnSlot;
+  instruction.operand = operand;
+  mInstructions.append(instruction);
+}
+
+void FilterProgramCompiler::compileComparison(FilterInstruction::Comparison comparison, const FilterColumnData & col, const QString & like)
+{
+  Q_ASSERT(comparison == FilterInstruction::Equal);
+
+  mProgram.addLikeComparison(col.columnIndex(), like);
+}
+
+void FilterProgramCompiler::compileComparison(FilterInstruction::Comparison comparison, const FilterColumnData & col, const char * value)
+{
+  mProgram.addStringComparison( comparison, col.columnIndex(), QString::fromUtf8(value) );
+}
+
+void FilterProgramCompiler::compileComparison(FilterInstruction::Comparison comparison, const FilterColumnData & col, int value)
+{
+  mProgram.addVariantComparison( comparison, col.columnIndex(), QVariant(value) );
+}
+
+void FilterProgramCompiler::compileComparison(FilterInstruction::Comparison comparison, const FilterColumnData & col, const ParentModelColumnData & parentCol)
+{
+  mProgram.addParentColumnComparison( comparison, col.columnIndex(), parentCol.columnIndex() );
+}
+
+}}} // namespace Mdt{ namespace ItemModel{ namespace Expression{
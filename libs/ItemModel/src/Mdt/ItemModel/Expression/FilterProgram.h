@@ -0,0 +1,266 @@
+/****************************************************************************
+ **
+ ** Copyright (C) 2011-2017 Philippe Steinmann.
+ **
+ ** This file is part of multiDiagTools library.
+ **
+ ** multiDiagTools is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Lesser General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** multiDiagTools is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public License
+ ** along with multiDiagTools.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+#ifndef MDT_ITEM_MODEL_EXPRESSION_FILTER_PROGRAM_H
+#define MDT_ITEM_MODEL_EXPRESSION_FILTER_PROGRAM_H
+
+#include "../FilterColumn.h"
+#include "../ParentModelColumn.h"
+#include "FilterEvalData.h"
+#include "CompiledLikePattern.h"
+#include "MdtItemModelExport.h"
+#include <QString>
+#include <QVariant>
+#include <QVector>
+#include <boost/proto/context.hpp>
+#include <boost/proto/eval.hpp>
+#include <vector>
+
+namespace Mdt{ namespace ItemModel{ namespace Expression{
+
+  /*! \brief Instruction of a FilterProgram
+   */
+  struct FilterInstruction
+  {
+    /*! \brief Operation of a instruction
+     */
+    enum OpCode
+    {
+      CompareString,        /*!< Compare the string value of a column to a string constant */
+      CompareVariant,       /*!< Compare the value of a column to a constant */
+      CompareParentColumn,  /*!< Compare the value of a column to the value of a parent model column */
+      CompareLike,          /*!< Match the string value of a column against a LikeExpression */
+      JumpIfFalse,          /*!< Jump to target if the current result is false */
+      JumpIfTrue            /*!< Jump to target if the current result is true */
+    };
+
+    /*! \brief Comparison operator
+     */
+    enum Comparison
+    {
+      Equal,
+      NotEqual,
+      Less,
+      LessEqual,
+      Greater,
+      GreaterEqual
+    };
+
+    OpCode opCode;
+    Comparison comparison;
+    int columnSlot;   /*!< Index of the column in FilterProgram::columns() */
+    int operand;      /*!< Index of the constant, of the parent model column slot, of the compiled like pattern, or jump target */
+  };
+
+  /*! \brief A FilterExpression compiled to a flat list of instructions
+   *
+   * Walking the boost::proto tree of a expression for each row
+   *  has a cost: each comparison gets its data from the model,
+   *  and converts it again.
+   *
+   * A FilterProgram is compiled once from a expression (see FilterProgramCompiler).
+   *  The columns are resolved up front,
+   *  and each column is only fetched from the model once per evaluated row.
+   *  Constants are converted once, at compile time.
+   *  A LikeExpression is also compiled once, for both case sensitivities,
+   *  instead of once per evaluated row.
+   *  Logical AND and OR become explicit jumps,
+   *  so short-circuit evaluation is kept.
+   *
+   * For example, A > 25 && (B == "X" || B == Like("Y*")) becomes:
+   * \code
+   * 0: CompareVariant  A > 25
+   * 1: JumpIfFalse     5
+   * 2: CompareString   B == "X"
+   * 3: JumpIfTrue      5
+   * 4: CompareLike     B == Like("Y*")
+   * \endcode
+   */
+  class MDT_ITEMMODEL_EXPORT FilterProgram
+  {
+   public:
+
+    /*! \brief Check if this program is empty
+     */
+    bool isEmpty() const
+    {
+      return mInstructions.isEmpty();
+    }
+
+    /*! \brief Get instructions
+     */
+    const QVector<FilterInstruction> & instructions() const
+    {
+      return mInstructions;
+    }
+
+    /*! \brief Get the columns used by this program
+     */
+    const QVector<int> & columns() const
+    {
+      return mColumns;
+    }
+
+    /*! \brief Get the parent model columns used by this program
+     */
+    const QVector<int> & parentModelColumns() const
+    {
+      return mParentModelColumns;
+    }
+
+    /*! \brief Evaluate this program for \a data
+     *
+     * \pre this program must not be empty
+     */
+    bool eval(const FilterEvalData & data) const;
+
+    /*! \brief Add a string comparison
+     */
+    void addStringComparison(FilterInstruction::Comparison comparison, int column, const QString & value);
+
+    /*! \brief Add a comparison with a constant
+     */
+    void addVariantComparison(FilterInstruction::Comparison comparison, int column, const QVariant & value);
+
+    /*! \brief Add a comparison with a parent model column
+     */
+    void addParentColumnComparison(FilterInstruction::Comparison comparison, int column, int parentModelColumn);
+
+    /*! \brief Add a like comparison
+     */
+    void addLikeComparison(int column, const QString & like);
+
+    /*! \brief Add a jump and return its index
+     *
+     * The target of the jump must be set later with setJumpTargetToEnd()
+     *
+     * \pre \a opCode must be JumpIfFalse or JumpIfTrue
+     */
+    int addJump(FilterInstruction::OpCode opCode);
+
+    /*! \brief Set the target of the jump at \a index to the end of this program
+     */
+    void setJumpTargetToEnd(int index);
+
+   private:
+
+    static int slot(QVector<int> & columns, int column);
+    void addInstruction(FilterInstruction::OpCode opCode, FilterInstruction::Comparison comparison, int columnSlot, int operand);
+
+    QVector<FilterInstruction> mInstructions;
+    QVector<int> mColumns;
+    QVector<int> mParentModelColumns;
+    QVector<QString> mStrings;
+    QVector<QVariant> mVariants;
+    // For each like comparison: the case sensitive pattern, followed by the case insensitive one
+    std::vector<CompiledLikePattern> mLikePatterns;
+  };
+
+  /*! \brief Callable context that compiles a filter expression to a FilterProgram
+   *
+   * \code
+   * FilterProgram program;
+   * FilterProgramCompiler compiler(program);
+   * boost::proto::eval(expr, compiler);
+   * \endcode
+   */
+  struct MDT_ITEMMODEL_EXPORT FilterProgramCompiler : boost::proto::callable_context<FilterProgramCompiler, boost::proto::null_context>
+  {
+    typedef void result_type;
+
+    /*! \brief Construct a compiler that appends instructions to \a program
+     */
+    explicit FilterProgramCompiler(FilterProgram & program)
+     : mProgram(program)
+    {
+    }
+
+    template<typename L, typename R>
+    void operator()(boost::proto::tag::logical_and, const L & left, const R & right)
+    {
+      boost::proto::eval(left, *this);
+      const int jump = mProgram.addJump(FilterInstruction::JumpIfFalse);
+      boost::proto::eval(right, *this);
+      mProgram.setJumpTargetToEnd(jump);
+    }
+
+    template<typename L, typename R>
+    void operator()(boost::proto::tag::logical_or, const L & left, const R & right)
+    {
+      boost::proto::eval(left, *this);
+      const int jump = mProgram.addJump(FilterInstruction::JumpIfTrue);
+      boost::proto::eval(right, *this);
+      mProgram.setJumpTargetToEnd(jump);
+    }
+
+    template<typename L, typename R>
+    void operator()(boost::proto::tag::equal_to, const L & left, const R & right)
+    {
+      compileComparison( FilterInstruction::Equal, boost::proto::value(left), boost::proto::value(right) );
+    }
+
+    template<typename L, typename R>
+    void operator()(boost::proto::tag::not_equal_to, const L & left, const R & right)
+    {
+      compileComparison( FilterInstruction::NotEqual, boost::proto::value(left), boost::proto::value(right) );
+    }
+
+    template<typename L, typename R>
+    void operator()(boost::proto::tag::less, const L & left, const R & right)
+    {
+      compileComparison( FilterInstruction::Less, boost::proto::value(left), boost::proto::value(right) );
+    }
+
+    template<typename L, typename R>
+    void operator()(boost::proto::tag::less_equal, const L & left, const R & right)
+    {
+      compileComparison( FilterInstruction::LessEqual, boost::proto::value(left), boost::proto::value(right) );
+    }
+
+    template<typename L, typename R>
+    void operator()(boost::proto::tag::greater, const L & left, const R & right)
+    {
+      compileComparison( FilterInstruction::Greater, boost::proto::value(left), boost::proto::value(right) );
+    }
+
+    template<typename L, typename R>
+    void operator()(boost::proto::tag::greater_equal, const L & left, const R & right)
+    {
+      compileComparison( FilterInstruction::GreaterEqual, boost::proto::value(left), boost::proto::value(right) );
+    }
+
+   private:
+
+    /*
+     * The overloads are the same than the ones of the comparison callables (see ComparisonEval.h),
+     * so the same comparison is choosen for a given expression.
+     * A QString value can only come from a LikeExpression (see FilterComparison grammar).
+     */
+    void compileComparison(FilterInstruction::Comparison comparison, const FilterColumnData & col, const QString & like);
+    void compileComparison(FilterInstruction::Comparison comparison, const FilterColumnData & col, const char * value);
+    void compileComparison(FilterInstruction::Comparison comparison, const FilterColumnData & col, int value);
+    void compileComparison(FilterInstruction::Comparison comparison, const FilterColumnData & col, const ParentModelColumnData & parentCol);
+
+    FilterProgram & mProgram;
+  };
+
+}}} // namespace Mdt{ namespace ItemModel{ namespace Expression{
+
+#endif // #ifndef MDT_ITEM_MODEL_EXPRESSION_FILTER_PROGRAM_H
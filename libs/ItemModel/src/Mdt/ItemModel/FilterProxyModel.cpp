@@ -19,6 +19,7 @@
  **
  ****************************************************************************/
 #include "FilterProxyModel.h"
+#include "TableModelSnapshot.h"
 #include <QModelIndex>
 
 // #include <QDebug>
@@ -26,10 +27,24 @@
 namespace Mdt{ namespace ItemModel{
 
 FilterProxyModel::FilterProxyModel(QObject* parent)
- : QSortFilterProxyModel(parent)
+ : SortFilterProxyModel(parent)
 {
 }
 
+void FilterProxyModel::applyFilter()
+{
+  if(mFilterExpression.isNull()){
+    invalidateFilterWithoutResult();
+    return;
+  }
+  const auto expression = mFilterExpression;
+  const auto caseSensitivity = filterCaseSensitivity();
+  const auto filter = [expression, caseSensitivity](const TableModelSnapshot & snapshot, int row){
+    return expression.eval(&snapshot, row, caseSensitivity);
+  };
+  invalidateFilterInParallel(mFilterExpression.greatestColumn()+1, filter);
+}
+
 bool FilterProxyModel::filterAcceptsRow(int source_row, const QModelIndex& source_parent) const
 {
   if(source_parent.isValid()){
@@ -40,6 +55,9 @@ bool FilterProxyModel::filterAcceptsRow(int source_row, const QModelIndex& sourc
   if(mFilterExpression.isNull()){
     return true;
   }
+  if(hasFilterResult()){
+    return filterResultAcceptsRow(source_row);
+  }
   return mFilterExpression.eval(sourceModel(), source_row, filterCaseSensitivity());
 }
 
@@ -24,8 +24,8 @@
 #include "FilterColumn.h"
 #include "LikeExpression.h"
 #include "FilterExpression.h"
+#include "SortFilterProxyModel.h"
 #include "MdtItemModelExport.h"
-#include <QSortFilterProxyModel>
 
 namespace Mdt{ namespace ItemModel{
 
@@ -56,8 +56,15 @@ namespace Mdt{ namespace ItemModel{
    * FilterColumn clientLastName(2);
    * proxyModel->setFilter( (clientFirstName == "A") && (clientLastName == Like("A?B*\\?*")) );
    * \endcode
+   *
+   * For big source models, the filter can be evaluated in parallel:
+   * \code
+   * proxyModel->setParallelFilterEnabled(true);
+   * proxyModel->setFilter( clientLastName == Like("A*") );
+   * \endcode
+   * See SortFilterProxyModel for details.
    */
-  class MDT_ITEMMODEL_EXPORT FilterProxyModel : public QSortFilterProxyModel
+  class MDT_ITEMMODEL_EXPORT FilterProxyModel : public SortFilterProxyModel
   {
    Q_OBJECT
 
@@ -94,11 +101,15 @@ namespace Mdt{ namespace ItemModel{
     void setFilter(const Expr & expression)
     {
       mFilterExpression.setExpression(expression);
-      invalidateFilter();
+      applyFilter();
     }
 
    private:
 
+    /*! \brief Invalidate filter, evaluating it in parallel if possible
+     */
+    void applyFilter();
+
     /*! \brief Return true if filter expression was set and evaluates true
      */
     bool filterAcceptsRow(int source_row, const QModelIndex& source_parent) const override;
@@ -31,6 +31,7 @@ void ForeignKeyProxyModelMap::addForeignKey(const QString& foreignEntityName, co
   Q_ASSERT(!fk.isNull());
 
   mMap.insert( foreignEntityName, ForeignKeyProxyModelMapItem(fk) );
+  updateFlagsByColumn();
 }
 
 void ForeignKeyProxyModelMap::removeForeignKey(const QString& foreignEntityName)
@@ -38,11 +39,13 @@ void ForeignKeyProxyModelMap::removeForeignKey(const QString& foreignEntityName)
   Q_ASSERT(!foreignEntityName.trimmed().isEmpty());
 
   mMap.remove(foreignEntityName);
+  updateFlagsByColumn();
 }
 
 void ForeignKeyProxyModelMap::removeAllForeignKeys()
 {
   mMap.clear();
+  mFlagsByColumn.clear();
 }
 
 bool ForeignKeyProxyModelMap::hasForeignKeyReferencing(const QString& entityName) const
@@ -65,6 +68,7 @@ void ForeignKeyProxyModelMap::setForeignKeyEditable(const QString& foreignEntity
   Q_ASSERT(mMap.contains(foreignEntityName));
 
   mMap[foreignEntityName].setForeignKeyEditable(editable);
+  updateFlagsByColumn();
 }
 
 void ForeignKeyProxyModelMap::setAllForeignKeysEditable(bool editable)
@@ -72,6 +76,7 @@ void ForeignKeyProxyModelMap::setAllForeignKeysEditable(bool editable)
   for(auto & item : mMap){
     item.setForeignKeyEditable(editable);
   }
+  updateFlagsByColumn();
 }
 
 bool ForeignKeyProxyModelMap::isForeignKeyEditable(const QString& foreignEntityName) const
@@ -88,6 +93,7 @@ void ForeignKeyProxyModelMap::setForeignKeyItemsEnabled(const QString& foreignEn
   Q_ASSERT(mMap.contains(foreignEntityName));
 
   mMap[foreignEntityName].setForeignKeyItemsEnabled(enable);
+  updateFlagsByColumn();
 }
 
 void ForeignKeyProxyModelMap::setAllForeignKeysItemsEnabled(bool enable)
@@ -95,6 +101,7 @@ void ForeignKeyProxyModelMap::setAllForeignKeysItemsEnabled(bool enable)
   for(auto & item : mMap){
     item.setForeignKeyItemsEnabled(enable);
   }
+  updateFlagsByColumn();
 }
 
 bool ForeignKeyProxyModelMap::isForeignKeyItemsEnabled(const QString& foreignEntityName) const
@@ -109,20 +116,11 @@ ForeignKeyProxyModelMapItemFlags ForeignKeyProxyModelMap::getMostRestrictiveFlag
 {
   Q_ASSERT(column >= 0);
 
-  ForeignKeyProxyModelMapItemFlags flags;
-
-  for(const auto & item : mMap){
-    if(item.foreignKeyContainsColumn(column)){
-      if(!item.isForeignKeyEditable()){
-        flags.setForeignKeyEditable(false);
-      }
-      if(!item.isForeignKeyItemsEnabled()){
-        flags.setForeignKeyItemsEnabled(false);
-      }
-    }
+  if(column >= mFlagsByColumn.size()){
+    return ForeignKeyProxyModelMapItemFlags();
   }
 
-  return flags;
+  return mFlagsByColumn.at(column);
 }
 
 ColumnList ForeignKeyProxyModelMap::getColumnsPartOfForeignKey() const
@@ -153,4 +151,24 @@ ForeignKeyList ForeignKeyProxyModelMap::getForeignKeyList() const
   return list;
 }
 
+void ForeignKeyProxyModelMap::updateFlagsByColumn()
+{
+  mFlagsByColumn.clear();
+  for(const auto & item : mMap){
+    const auto fk = item.foreignKey();
+    if(fk.greatestColumn() >= mFlagsByColumn.size()){
+      mFlagsByColumn.resize(fk.greatestColumn() + 1);
+    }
+    for(const int column : fk){
+      auto & flags = mFlagsByColumn[column];
+      if(!item.isForeignKeyEditable()){
+        flags.setForeignKeyEditable(false);
+      }
+      if(!item.isForeignKeyItemsEnabled()){
+        flags.setForeignKeyItemsEnabled(false);
+      }
+    }
+  }
+}
+
 }} // namespace Mdt{ namespace ItemModel{
@@ -28,6 +28,7 @@
 #include "MdtItemModelExport.h"
 #include <QString>
 #include <QHash>
+#include <QVector>
 
 namespace Mdt{ namespace ItemModel{
 
@@ -114,6 +115,10 @@ namespace Mdt{ namespace ItemModel{
     bool isForeignKeyItemsEnabled(const QString & foreignEntityName) const;
 
     /*! \brief Get most restricitive flags for a column
+     *
+     * Flags of each column are computed each time
+     *  a foreign key, or its flags, changes,
+     *  so this function does not iterate the foreign keys.
      *
      * \pre \a column must be >= 0
      */
@@ -129,7 +134,12 @@ namespace Mdt{ namespace ItemModel{
 
    private:
 
+    /*! \brief Compute the most restrictive flags of each column
+     */
+    void updateFlagsByColumn();
+
     QHash<QString, ForeignKeyProxyModelMapItem> mMap;
+    QVector<ForeignKeyProxyModelMapItemFlags> mFlagsByColumn;
   };
 
 }} // namespace Mdt{ namespace ItemModel{
@@ -0,0 +1,230 @@
+/****************************************************************************
+ **
+ ** Copyright (C) 2011-2017 Philippe Steinmann.
+ **
+ ** This file is part of multiDiagTools library.
+ **
+ ** multiDiagTools is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Lesser General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** multiDiagTools is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public License
+ ** along with multiDiagTools.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+#include "ForeignKeyRowIndex.h"
+#include <QAbstractItemModel>
+#include <QModelIndex>
+#include <QVariant>
+#include <QChar>
+
+// #include <QDebug>
+
+namespace Mdt{ namespace ItemModel{
+
+void ForeignKeyRowIndex::setColumnList(const ColumnList & columnList)
+{
+  mColumnList = columnList;
+  clear();
+}
+
+void ForeignKeyRowIndex::build(const QAbstractItemModel * const model)
+{
+  Q_ASSERT(model != nullptr);
+  Q_ASSERT(!mColumnList.isEmpty());
+  Q_ASSERT(mColumnList.greatestColumn() < model->columnCount());
+
+  clear();
+  const int n = model->rowCount();
+  mKeyByRow.reserve(n);
+  mPositionByRow.resize(n);
+  mRowsByKey.reserve(n);
+  for(int row = 0; row < n; ++row){
+    const auto key = keyForRow(model, row, mColumnList);
+    mKeyByRow.append(key);
+    addRow(key, row);
+  }
+  mIsBuilt = true;
+}
+
+void ForeignKeyRowIndex::clear()
+{
+  mIsBuilt = false;
+  mKeyByRow.clear();
+  mPositionByRow.clear();
+  mRowsByKey.clear();
+}
+
+void ForeignKeyRowIndex::insertRows(const QAbstractItemModel * const model, int first, int last)
+{
+  Q_ASSERT(model != nullptr);
+  Q_ASSERT(mIsBuilt);
+  Q_ASSERT(first >= 0);
+  Q_ASSERT(first <= mKeyByRow.size());
+  Q_ASSERT(last >= first);
+
+  const int count = last - first + 1;
+  // Shift rows that follow the inserted ones
+  if(first < mKeyByRow.size()){
+    for(auto & rows : mRowsByKey){
+      for(auto & row : rows){
+        if(row >= first){
+          row += count;
+        }
+      }
+    }
+  }
+  mKeyByRow.insert(first, count, QString());
+  mPositionByRow.insert(first, count, -1);
+  for(int row = first; row <= last; ++row){
+    const auto key = keyForRow(model, row, mColumnList);
+    mKeyByRow[row] = key;
+    addRow(key, row);
+  }
+}
+
+void ForeignKeyRowIndex::removeRows(int first, int last)
+{
+  Q_ASSERT(mIsBuilt);
+  Q_ASSERT(first >= 0);
+  Q_ASSERT(first <= last);
+  Q_ASSERT(last < mKeyByRow.size());
+
+  const int count = last - first + 1;
+  for(int row = first; row <= last; ++row){
+    removeRow(mKeyByRow.at(row), row);
+  }
+  mKeyByRow.remove(first, count);
+  mPositionByRow.remove(first, count);
+  // Shift rows that followed the removed ones
+  if(first < mKeyByRow.size()){
+    for(auto & rows : mRowsByKey){
+      for(auto & row : rows){
+        if(row > last){
+          row -= count;
+        }
+      }
+    }
+  }
+}
+
+void ForeignKeyRowIndex::updateRows(const QAbstractItemModel * const model, int first, int last)
+{
+  Q_ASSERT(model != nullptr);
+  Q_ASSERT(mIsBuilt);
+  Q_ASSERT(first >= 0);
+  Q_ASSERT(first <= last);
+  Q_ASSERT(last < mKeyByRow.size());
+
+  for(int row = first; row <= last; ++row){
+    const auto key = keyForRow(model, row, mColumnList);
+    if(key != mKeyByRow.at(row)){
+      removeRow(mKeyByRow.at(row), row);
+      mKeyByRow[row] = key;
+      addRow(key, row);
+    }
+  }
+}
+
+RowList ForeignKeyRowIndex::findRows(const QString & key) const
+{
+  Q_ASSERT(mIsBuilt);
+
+  RowList rowList;
+  const auto it = mRowsByKey.constFind(key);
+  if(it == mRowsByKey.constEnd()){
+    return rowList;
+  }
+  for(const int row : *it){
+    rowList.append(row);
+  }
+
+  return rowList;
+}
+
+int ForeignKeyRowIndex::rowCountForKey(const QString & key) const
+{
+  Q_ASSERT(mIsBuilt);
+
+  const auto it = mRowsByKey.constFind(key);
+  if(it == mRowsByKey.constEnd()){
+    return 0;
+  }
+
+  return it->size();
+}
+
+QString ForeignKeyRowIndex::keyForRow(const QAbstractItemModel * const model, int row, const ColumnList & columnList)
+{
+  Q_ASSERT(model != nullptr);
+  Q_ASSERT(row >= 0);
+  Q_ASSERT(row < model->rowCount());
+  Q_ASSERT(columnList.greatestColumn() < model->columnCount());
+
+  QString key;
+  for(int i = 0; i < columnList.size(); ++i){
+    appendKeyValue(key, i, model->data(model->index(row, columnList.at(i))));
+  }
+
+  return key;
+}
+
+QString ForeignKeyRowIndex::keyForRecord(const KeyRecord & record, const ColumnList & columnList)
+{
+  QString key;
+  for(int i = 0; i < columnList.size(); ++i){
+    appendKeyValue(key, i, record.dataForColumn(columnList.at(i)));
+  }
+
+  return key;
+}
+
+void ForeignKeyRowIndex::appendKeyValue(QString & key, int i, const QVariant & value)
+{
+  /*
+   * Use the unit separator ASCII control character between values,
+   * it is very unlikely to be part of a key value.
+   */
+  if(i > 0){
+    key += QChar(0x1F);
+  }
+  key += value.toString();
+}
+
+void ForeignKeyRowIndex::addRow(const QString & key, int row)
+{
+  Q_ASSERT(row < mPositionByRow.size());
+
+  auto & rows = mRowsByKey[key];
+  mPositionByRow[row] = rows.size();
+  rows.append(row);
+}
+
+void ForeignKeyRowIndex::removeRow(const QString & key, int row)
+{
+  Q_ASSERT(row < mPositionByRow.size());
+
+  auto it = mRowsByKey.find(key);
+  Q_ASSERT(it != mRowsByKey.end());
+  auto & rows = *it;
+  // Rows are not sorted, move the last one to the place of the removed one
+  const int position = mPositionByRow.at(row);
+  Q_ASSERT(position >= 0);
+  Q_ASSERT(position < rows.size());
+  Q_ASSERT(rows.at(position) == row);
+  const int lastRow = rows.last();
+  rows[position] = lastRow;
+  mPositionByRow[lastRow] = position;
+  rows.removeLast();
+  if(rows.isEmpty()){
+    mRowsByKey.erase(it);
+  }
+}
+
+}} // namespace Mdt{ namespace ItemModel{
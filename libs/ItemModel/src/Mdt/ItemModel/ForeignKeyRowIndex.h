@@ -0,0 +1,182 @@
+/****************************************************************************
+ **
+ ** Copyright (C) 2011-2017 Philippe Steinmann.
+ **
+ ** This file is part of multiDiagTools library.
+ **
+ ** multiDiagTools is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Lesser General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** multiDiagTools is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public License
+ ** along with multiDiagTools.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+#ifndef MDT_ITEM_MODEL_FOREIGN_KEY_ROW_INDEX_H
+#define MDT_ITEM_MODEL_FOREIGN_KEY_ROW_INDEX_H
+
+#include "ColumnList.h"
+#include "RowList.h"
+#include "KeyRecord.h"
+#include "MdtItemModelExport.h"
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+class QAbstractItemModel;
+
+namespace Mdt{ namespace ItemModel{
+
+  /*! \brief Hash index from the values of some columns of a model to its rows
+   *
+   * Typical usage is to find the rows of a child model
+   *  that refer to a row of a parent model,
+   *  without reading data of each row of the child model.
+   *  It is also used to find the row of a primary key record (see PrimaryKeyProxyModel).
+   *
+   * The key of a row is made from the display data of its columns,
+   *  converted to strings (see keyForRow()).
+   *  Values that are equal, but have a different string representation,
+   *  will not be found. The user of this class should check the rows
+   *  returned by findRows(), because some of them could not match
+   *  (for example if a value contains the key separator).
+   *
+   * The index does not listen to model signals.
+   *  The user of this class has to call insertRows(), removeRows() and updateRows()
+   *  each time the model changes, or build() again.
+   */
+  class MDT_ITEMMODEL_EXPORT ForeignKeyRowIndex
+  {
+   public:
+
+    /*! \brief Set the list of indexed columns
+     *
+     * Will also clear the index.
+     */
+    void setColumnList(const ColumnList & columnList);
+
+    /*! \brief Get the list of indexed columns
+     */
+    ColumnList columnList() const
+    {
+      return mColumnList;
+    }
+
+    /*! \brief Build the index for all rows of \a model
+     *
+     * \pre \a model must be a valid pointer
+     * \pre columnList() must not be empty
+     * \pre each column in columnList() must be < model->columnCount()
+     */
+    void build(const QAbstractItemModel * const model);
+
+    /*! \brief Check if this index was built
+     */
+    bool isBuilt() const
+    {
+      return mIsBuilt;
+    }
+
+    /*! \brief Clear the index
+     *
+     * isBuilt() will return false after this call.
+     *  The list of columns is not cleared.
+     */
+    void clear();
+
+    /*! \brief Get count of indexed rows
+     */
+    int rowCount() const
+    {
+      return mKeyByRow.size();
+    }
+
+    /*! \brief Update the index after rows have been inserted into \a model
+     *
+     * \pre isBuilt() must be true
+     * \pre \a first and \a last must be the rows that have been inserted into \a model
+     */
+    void insertRows(const QAbstractItemModel * const model, int first, int last);
+
+    /*! \brief Update the index after rows have been removed from the model
+     *
+     * \pre isBuilt() must be true
+     * \pre \a first and \a last must be in range 0 <= \a first <= \a last < rowCount()
+     */
+    void removeRows(int first, int last);
+
+    /*! \brief Update the index after data of some rows changed in \a model
+     *
+     * \pre isBuilt() must be true
+     * \pre \a first and \a last must be in range 0 <= \a first <= \a last < rowCount()
+     */
+    void updateRows(const QAbstractItemModel * const model, int first, int last);
+
+    /*! \brief Get the key of \a row
+     *
+     * \pre isBuilt() must be true
+     * \pre \a row must be in valid range ( 0 <= \a row < rowCount() )
+     */
+    QString keyAt(int row) const
+    {
+      Q_ASSERT(mIsBuilt);
+      Q_ASSERT(row >= 0);
+      Q_ASSERT(row < mKeyByRow.size());
+      return mKeyByRow.at(row);
+    }
+
+    /*! \brief Find rows for \a key
+     *
+     * Returned rows are not sorted.
+     *
+     * \pre isBuilt() must be true
+     */
+    RowList findRows(const QString & key) const;
+
+    /*! \brief Get the count of rows for \a key
+     *
+     * Returns the same count than findRows(key).size(),
+     *  without building a row list.
+     *
+     * \pre isBuilt() must be true
+     */
+    int rowCountForKey(const QString & key) const;
+
+    /*! \brief Get the key of \a row in \a model for \a columnList
+     *
+     * \pre \a model must be a valid pointer
+     * \pre \a row must be in valid range ( 0 <= \a row < model->rowCount() )
+     * \pre each column in \a columnList must be < model->columnCount()
+     */
+    static QString keyForRow(const QAbstractItemModel * const model, int row, const ColumnList & columnList);
+
+    /*! \brief Get the key of \a record for \a columnList
+     *
+     * Returns the same key than keyForRow() for a row
+     *  that contains the data of \a record in \a columnList .
+     */
+    static QString keyForRecord(const KeyRecord & record, const ColumnList & columnList);
+
+   private:
+
+    static void appendKeyValue(QString & key, int i, const QVariant & value);
+    void addRow(const QString & key, int row);
+    void removeRow(const QString & key, int row);
+
+    bool mIsBuilt = false;
+    ColumnList mColumnList;
+    QVector<QString> mKeyByRow;
+    // Position of each row in its list of mRowsByKey, so that removing a row does not have to search it
+    QVector<int> mPositionByRow;
+    QHash< QString, QVector<int> > mRowsByKey;
+  };
+
+}} // namespace Mdt{ namespace ItemModel{
+
+#endif // #ifndef MDT_ITEM_MODEL_FOREIGN_KEY_ROW_INDEX_H
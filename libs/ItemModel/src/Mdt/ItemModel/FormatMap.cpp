@@ -55,6 +55,20 @@ void FormatMap::clearFormatForColumn(int column)
   mColumnMap.clearFormatForColumn(column);
 }
 
+void FormatMap::clearFormatForRowRange(const RowRange & rowRange)
+{
+  Q_ASSERT(rowRange.isValid());
+
+  mRowRangeMap.clearFormatForRange(rowRange.firstRow(), 0, rowRange.lastRow(), std::numeric_limits<int>::max());
+}
+
+void FormatMap::clearFormatForRange(const RowRange & rowRange, const ColumnRange & columnRange)
+{
+  Q_ASSERT(rowRange.isValid());
+  Q_ASSERT(columnRange.isValid());
+
+  mIndexRangeMap.clearFormatForRange(rowRange.firstRow(), columnRange.firstColumn(), rowRange.lastRow(), columnRange.lastColumn());
+}
 
 QVariant FormatMap::formatForIndex(int row, int column) const
 {
@@ -62,14 +76,23 @@ QVariant FormatMap::formatForIndex(int row, int column) const
   Q_ASSERT(column >= 0);
 
   QVariant format;
-  
+  if(isEmpty()){
+    return format;
+  }
+
   const auto pred = [&format, this, row, column](FormatMapPriority priority){
     switch(priority){
       case FormatMapPriority::Index:
         format = mIndexMap.formatForIndex(row, column);
+        if(format.isNull()){
+          format = mIndexRangeMap.formatForIndex(row, column);
+        }
         break;
       case FormatMapPriority::Row:
         format = mRowMap.formatForRow(row);
+        if(format.isNull()){
+          format = mRowRangeMap.formatForIndex(row, column);
+        }
         break;
       case FormatMapPriority::Column:
         format = mColumnMap.formatForColumn(column);
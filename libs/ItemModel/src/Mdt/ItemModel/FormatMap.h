@@ -24,8 +24,12 @@
 #include "IndexFormatMap.h"
 #include "RowFormatMap.h"
 #include "ColumnFormatMap.h"
+#include "RangeFormatMap.h"
+#include "RowRange.h"
+#include "ColumnRange.h"
 #include "MdtItemModelExport.h"
 #include <array>
+#include <limits>
 
 namespace Mdt{ namespace ItemModel{
 
@@ -39,6 +43,12 @@ namespace Mdt{ namespace ItemModel{
   };
 
   /*! \brief Stores formats for certain row, column and index in a item model
+   *
+   * Formats can also be set for a range of rows (see setFormatForRowRange()),
+   *  which have the priority of row formats,
+   *  and for a rectangular range of indexes (see setFormatForRange()),
+   *  which have the priority of index formats.
+   *  A format set for a single row, or index, takes precedence over a range.
    */
   class MDT_ITEMMODEL_EXPORT FormatMap
   {
@@ -122,10 +132,53 @@ namespace Mdt{ namespace ItemModel{
      */
     void clearFormatForColumn(int column);
 
+    /*! \brief Set format for a range of rows
+     *
+     * \pre \a rowRange must be valid
+     */
+    template<typename T>
+    void setFormatForRowRange(const RowRange & rowRange, const T & format)
+    {
+      Q_ASSERT(rowRange.isValid());
+      mRowRangeMap.setFormatVariantForRange(rowRange.firstRow(), 0, rowRange.lastRow(), std::numeric_limits<int>::max(), QVariant(format));
+    }
+
+    /*! \brief Clear format for a range of rows
+     *
+     * Only clears formats set with setFormatForRowRange().
+     *  Does nothing for rows in \a rowRange that have no such format.
+     *
+     * \pre \a rowRange must be valid
+     */
+    void clearFormatForRowRange(const RowRange & rowRange);
+
+    /*! \brief Set format for each index in \a rowRange and \a columnRange
+     *
+     * \pre \a rowRange must be valid
+     * \pre \a columnRange must be valid
+     */
+    template<typename T>
+    void setFormatForRange(const RowRange & rowRange, const ColumnRange & columnRange, const T & format)
+    {
+      Q_ASSERT(rowRange.isValid());
+      Q_ASSERT(columnRange.isValid());
+      mIndexRangeMap.setFormatVariantForRange(rowRange.firstRow(), columnRange.firstColumn(), rowRange.lastRow(), columnRange.lastColumn(), QVariant(format));
+    }
+
+    /*! \brief Clear format for each index in \a rowRange and \a columnRange
+     *
+     * Only clears formats set with setFormatForRange().
+     *
+     * \pre \a rowRange must be valid
+     * \pre \a columnRange must be valid
+     */
+    void clearFormatForRange(const RowRange & rowRange, const ColumnRange & columnRange);
+
     /*! \brief Get format for given row and column
      *
      * Returns a QVariant with value of type passed in
      *  setFormatForRow() , setFormatForColumn() or setFormatForIndex() ,
+     *  or one of the range variants,
      *  if a format was set for \a row and \a column,
      *  otherwise a null QVariant.
      *
@@ -134,11 +187,23 @@ namespace Mdt{ namespace ItemModel{
      */
     QVariant formatForIndex(int row, int column) const;
 
+    /*! \brief Check if no format was set
+     *
+     * Formats that have been cleared are not counted.
+     */
+    bool isEmpty() const
+    {
+      return ( mIndexMap.isEmpty() && mRowMap.isEmpty() && mColumnMap.isEmpty()
+               && mIndexRangeMap.isEmpty() && mRowRangeMap.isEmpty() );
+    }
+
    private:
 
     IndexFormatMap mIndexMap;
     RowFormatMap mRowMap;
     ColumnFormatMap mColumnMap;
+    RangeFormatMap mIndexRangeMap;
+    RangeFormatMap mRowRangeMap;
     std::array<FormatMapPriority, 3> mPriority;
   };
 
@@ -20,6 +20,7 @@
  ****************************************************************************/
 #include "FormatProxyModel.h"
 #include <QVector>
+#include <QModelIndex>
 
 namespace Mdt{ namespace ItemModel{
 
@@ -28,6 +29,33 @@ FormatProxyModel::FormatProxyModel(QObject* parent)
 {
 }
 
+void FormatProxyModel::setSourceModel(QAbstractItemModel *model)
+{
+  /*
+   * Rules results must be up to date before QIdentityProxyModel
+   * tells the views about a change of the source model.
+   * Because slots are called in the order they have been connected,
+   * we connect before QIdentityProxyModel does.
+   */
+  for(const auto & connection : mSourceModelConnections){
+    disconnect(connection);
+  }
+  mSourceModelConnections.clear();
+  clearFormatRulesCache();
+  if(model != nullptr){
+    mSourceModelConnections.append( connect(model, &QAbstractItemModel::dataChanged, this, &FormatProxyModel::onSourceModelDataChanged) );
+    mSourceModelConnections.append( connect(model, &QAbstractItemModel::rowsInserted, this, &FormatProxyModel::onSourceRowsInserted) );
+    mSourceModelConnections.append( connect(model, &QAbstractItemModel::rowsRemoved, this, &FormatProxyModel::onSourceRowsRemoved) );
+    mSourceModelConnections.append( connect(model, &QAbstractItemModel::rowsMoved, this, &FormatProxyModel::clearFormatRulesCache) );
+    mSourceModelConnections.append( connect(model, &QAbstractItemModel::columnsInserted, this, &FormatProxyModel::clearFormatRulesCache) );
+    mSourceModelConnections.append( connect(model, &QAbstractItemModel::columnsRemoved, this, &FormatProxyModel::clearFormatRulesCache) );
+    mSourceModelConnections.append( connect(model, &QAbstractItemModel::columnsMoved, this, &FormatProxyModel::clearFormatRulesCache) );
+    mSourceModelConnections.append( connect(model, &QAbstractItemModel::layoutChanged, this, &FormatProxyModel::clearFormatRulesCache) );
+    mSourceModelConnections.append( connect(model, &QAbstractItemModel::modelReset, this, &FormatProxyModel::clearFormatRulesCache) );
+  }
+  QIdentityProxyModel::setSourceModel(model);
+}
+
 void FormatProxyModel::setPriority(const std::array<FormatMapPriority, int(3)> & priority)
 {
   mTextAlignmentMap.setPriority(priority);
@@ -86,6 +114,40 @@ void FormatProxyModel::clearTextAlignmentForColumn(int column)
   signalFormatChangedForColumn(column, Qt::TextAlignmentRole);
 }
 
+void FormatProxyModel::setTextAlignmentForRowRange(const RowRange & rowRange, Qt::Alignment alignment)
+{
+  Q_ASSERT(rowRange.isValid());
+
+  mTextAlignmentMap.setFormatForRowRange(rowRange, alignment);
+  signalFormatChangedForRowRange(rowRange, Qt::TextAlignmentRole);
+}
+
+void FormatProxyModel::clearTextAlignmentForRowRange(const RowRange & rowRange)
+{
+  Q_ASSERT(rowRange.isValid());
+
+  mTextAlignmentMap.clearFormatForRowRange(rowRange);
+  signalFormatChangedForRowRange(rowRange, Qt::TextAlignmentRole);
+}
+
+void FormatProxyModel::setTextAlignmentForRange(const RowRange & rowRange, const ColumnRange & columnRange, Qt::Alignment alignment)
+{
+  Q_ASSERT(rowRange.isValid());
+  Q_ASSERT(columnRange.isValid());
+
+  mTextAlignmentMap.setFormatForRange(rowRange, columnRange, alignment);
+  signalFormatChangedForRange(rowRange, columnRange, Qt::TextAlignmentRole);
+}
+
+void FormatProxyModel::clearTextAlignmentForRange(const RowRange & rowRange, const ColumnRange & columnRange)
+{
+  Q_ASSERT(rowRange.isValid());
+  Q_ASSERT(columnRange.isValid());
+
+  mTextAlignmentMap.clearFormatForRange(rowRange, columnRange);
+  signalFormatChangedForRange(rowRange, columnRange, Qt::TextAlignmentRole);
+}
+
 QVariant FormatProxyModel::textAlignment(int row, int column) const
 {
   Q_ASSERT(row >= 0);
@@ -93,7 +155,12 @@ QVariant FormatProxyModel::textAlignment(int row, int column) const
   Q_ASSERT(column >= 0);
   Q_ASSERT(column < columnCount());
 
-  return mTextAlignmentMap.formatForIndex(row, column);
+  const auto format = mTextAlignmentMap.formatForIndex(row, column);
+  if(!format.isNull()){
+    return format;
+  }
+
+  return ruleFormat(mTextAlignmentRules, row);
 }
 
 void FormatProxyModel::setTextFontForIndex(int row, int column, const QFont& font)
@@ -146,6 +213,40 @@ void FormatProxyModel::clearTextFontForColumn(int column)
   signalFormatChangedForColumn(column, Qt::FontRole);
 }
 
+void FormatProxyModel::setTextFontForRowRange(const RowRange & rowRange, const QFont & font)
+{
+  Q_ASSERT(rowRange.isValid());
+
+  mTextFontMap.setFormatForRowRange(rowRange, font);
+  signalFormatChangedForRowRange(rowRange, Qt::FontRole);
+}
+
+void FormatProxyModel::clearTextFontForRowRange(const RowRange & rowRange)
+{
+  Q_ASSERT(rowRange.isValid());
+
+  mTextFontMap.clearFormatForRowRange(rowRange);
+  signalFormatChangedForRowRange(rowRange, Qt::FontRole);
+}
+
+void FormatProxyModel::setTextFontForRange(const RowRange & rowRange, const ColumnRange & columnRange, const QFont & font)
+{
+  Q_ASSERT(rowRange.isValid());
+  Q_ASSERT(columnRange.isValid());
+
+  mTextFontMap.setFormatForRange(rowRange, columnRange, font);
+  signalFormatChangedForRange(rowRange, columnRange, Qt::FontRole);
+}
+
+void FormatProxyModel::clearTextFontForRange(const RowRange & rowRange, const ColumnRange & columnRange)
+{
+  Q_ASSERT(rowRange.isValid());
+  Q_ASSERT(columnRange.isValid());
+
+  mTextFontMap.clearFormatForRange(rowRange, columnRange);
+  signalFormatChangedForRange(rowRange, columnRange, Qt::FontRole);
+}
+
 QVariant FormatProxyModel::textFont(int row, int column) const
 {
   Q_ASSERT(row >= 0);
@@ -153,7 +254,12 @@ QVariant FormatProxyModel::textFont(int row, int column) const
   Q_ASSERT(column >= 0);
   Q_ASSERT(column < columnCount());
 
-  return mTextFontMap.formatForIndex(row, column);
+  const auto format = mTextFontMap.formatForIndex(row, column);
+  if(!format.isNull()){
+    return format;
+  }
+
+  return ruleFormat(mTextFontRules, row);
 }
 
 void FormatProxyModel::setTextColorForIndex(int row, int column, const QColor& color)
@@ -206,6 +312,40 @@ void FormatProxyModel::clearTextColorForColumn(int column)
   signalFormatChangedForColumn(column, Qt::ForegroundRole);
 }
 
+void FormatProxyModel::setTextColorForRowRange(const RowRange & rowRange, const QColor & color)
+{
+  Q_ASSERT(rowRange.isValid());
+
+  mForegroundBrushMap.setFormatForRowRange(rowRange, QBrush(color));
+  signalFormatChangedForRowRange(rowRange, Qt::ForegroundRole);
+}
+
+void FormatProxyModel::clearTextColorForRowRange(const RowRange & rowRange)
+{
+  Q_ASSERT(rowRange.isValid());
+
+  mForegroundBrushMap.clearFormatForRowRange(rowRange);
+  signalFormatChangedForRowRange(rowRange, Qt::ForegroundRole);
+}
+
+void FormatProxyModel::setTextColorForRange(const RowRange & rowRange, const ColumnRange & columnRange, const QColor & color)
+{
+  Q_ASSERT(rowRange.isValid());
+  Q_ASSERT(columnRange.isValid());
+
+  mForegroundBrushMap.setFormatForRange(rowRange, columnRange, QBrush(color));
+  signalFormatChangedForRange(rowRange, columnRange, Qt::ForegroundRole);
+}
+
+void FormatProxyModel::clearTextColorForRange(const RowRange & rowRange, const ColumnRange & columnRange)
+{
+  Q_ASSERT(rowRange.isValid());
+  Q_ASSERT(columnRange.isValid());
+
+  mForegroundBrushMap.clearFormatForRange(rowRange, columnRange);
+  signalFormatChangedForRange(rowRange, columnRange, Qt::ForegroundRole);
+}
+
 QVariant FormatProxyModel::foregroundBrush(int row, int column) const
 {
   Q_ASSERT(row >= 0);
@@ -213,7 +353,12 @@ QVariant FormatProxyModel::foregroundBrush(int row, int column) const
   Q_ASSERT(column >= 0);
   Q_ASSERT(column < columnCount());
 
-  return mForegroundBrushMap.formatForIndex(row, column);
+  const auto format = mForegroundBrushMap.formatForIndex(row, column);
+  if(!format.isNull()){
+    return format;
+  }
+
+  return ruleFormat(mForegroundBrushRules, row);
 }
 
 void FormatProxyModel::setBackgroundBrushForIndex(int row, int column, const QBrush & brush)
@@ -288,6 +433,55 @@ void FormatProxyModel::clearBackgroundBrushForColumn(int column)
   signalFormatChangedForColumn(column, Qt::BackgroundRole);
 }
 
+void FormatProxyModel::setBackgroundBrushForRowRange(const RowRange & rowRange, const QBrush & brush)
+{
+  Q_ASSERT(rowRange.isValid());
+
+  mBackgroundBrushMap.setFormatForRowRange(rowRange, brush);
+  signalFormatChangedForRowRange(rowRange, Qt::BackgroundRole);
+}
+
+void FormatProxyModel::setBackgroundColorForRowRange(const RowRange & rowRange, const QColor & color, Qt::BrushStyle style)
+{
+  Q_ASSERT(rowRange.isValid());
+
+  setBackgroundBrushForRowRange(rowRange, QBrush(color, style));
+}
+
+void FormatProxyModel::clearBackgroundBrushForRowRange(const RowRange & rowRange)
+{
+  Q_ASSERT(rowRange.isValid());
+
+  mBackgroundBrushMap.clearFormatForRowRange(rowRange);
+  signalFormatChangedForRowRange(rowRange, Qt::BackgroundRole);
+}
+
+void FormatProxyModel::setBackgroundBrushForRange(const RowRange & rowRange, const ColumnRange & columnRange, const QBrush & brush)
+{
+  Q_ASSERT(rowRange.isValid());
+  Q_ASSERT(columnRange.isValid());
+
+  mBackgroundBrushMap.setFormatForRange(rowRange, columnRange, brush);
+  signalFormatChangedForRange(rowRange, columnRange, Qt::BackgroundRole);
+}
+
+void FormatProxyModel::setBackgroundColorForRange(const RowRange & rowRange, const ColumnRange & columnRange, const QColor & color, Qt::BrushStyle style)
+{
+  Q_ASSERT(rowRange.isValid());
+  Q_ASSERT(columnRange.isValid());
+
+  setBackgroundBrushForRange(rowRange, columnRange, QBrush(color, style));
+}
+
+void FormatProxyModel::clearBackgroundBrushForRange(const RowRange & rowRange, const ColumnRange & columnRange)
+{
+  Q_ASSERT(rowRange.isValid());
+  Q_ASSERT(columnRange.isValid());
+
+  mBackgroundBrushMap.clearFormatForRange(rowRange, columnRange);
+  signalFormatChangedForRange(rowRange, columnRange, Qt::BackgroundRole);
+}
+
 QVariant FormatProxyModel::backgroundBrush(int row, int column) const
 {
   Q_ASSERT(row >= 0);
@@ -295,7 +489,32 @@ QVariant FormatProxyModel::backgroundBrush(int row, int column) const
   Q_ASSERT(column >= 0);
   Q_ASSERT(column < columnCount());
 
-  return mBackgroundBrushMap.formatForIndex(row, column);
+  const auto format = mBackgroundBrushMap.formatForIndex(row, column);
+  if(!format.isNull()){
+    return format;
+  }
+
+  return ruleFormat(mBackgroundBrushRules, row);
+}
+
+void FormatProxyModel::clearFormatRules()
+{
+  if(!mTextAlignmentRules.isEmpty()){
+    mTextAlignmentRules.clearRules();
+    signalFormatChangedForAllRows(Qt::TextAlignmentRole);
+  }
+  if(!mTextFontRules.isEmpty()){
+    mTextFontRules.clearRules();
+    signalFormatChangedForAllRows(Qt::FontRole);
+  }
+  if(!mForegroundBrushRules.isEmpty()){
+    mForegroundBrushRules.clearRules();
+    signalFormatChangedForAllRows(Qt::ForegroundRole);
+  }
+  if(!mBackgroundBrushRules.isEmpty()){
+    mBackgroundBrushRules.clearRules();
+    signalFormatChangedForAllRows(Qt::BackgroundRole);
+  }
 }
 
 QVariant FormatProxyModel::data(const QModelIndex & index, int role) const
@@ -321,6 +540,97 @@ QVariant FormatProxyModel::data(const QModelIndex & index, int role) const
   return QIdentityProxyModel::data(index, role);
 }
 
+void FormatProxyModel::onSourceModelDataChanged(const QModelIndex & topLeft, const QModelIndex & bottomRight)
+{
+  if( !topLeft.isValid() || topLeft.parent().isValid() ){
+    return;
+  }
+  updateRuleFormatForRows(mTextAlignmentRules, topLeft.row(), bottomRight.row(), Qt::TextAlignmentRole);
+  updateRuleFormatForRows(mTextFontRules, topLeft.row(), bottomRight.row(), Qt::FontRole);
+  updateRuleFormatForRows(mForegroundBrushRules, topLeft.row(), bottomRight.row(), Qt::ForegroundRole);
+  updateRuleFormatForRows(mBackgroundBrushRules, topLeft.row(), bottomRight.row(), Qt::BackgroundRole);
+}
+
+void FormatProxyModel::onSourceRowsInserted(const QModelIndex & parent, int first, int last)
+{
+  if(parent.isValid()){
+    return;
+  }
+  const int count = last - first + 1;
+  mTextAlignmentRules.insertRows(first, count);
+  mTextFontRules.insertRows(first, count);
+  mForegroundBrushRules.insertRows(first, count);
+  mBackgroundBrushRules.insertRows(first, count);
+}
+
+void FormatProxyModel::onSourceRowsRemoved(const QModelIndex & parent, int first, int last)
+{
+  if(parent.isValid()){
+    return;
+  }
+  const int count = last - first + 1;
+  mTextAlignmentRules.removeRows(first, count);
+  mTextFontRules.removeRows(first, count);
+  mForegroundBrushRules.removeRows(first, count);
+  mBackgroundBrushRules.removeRows(first, count);
+}
+
+void FormatProxyModel::clearFormatRulesCache()
+{
+  mTextAlignmentRules.clearCache();
+  mTextFontRules.clearCache();
+  mForegroundBrushRules.clearCache();
+  mBackgroundBrushRules.clearCache();
+}
+
+QVariant FormatProxyModel::ruleFormat(const ConditionalFormatMap & rules, int row) const
+{
+  if( rules.isEmpty() || (sourceModel() == nullptr) ){
+    return QVariant();
+  }
+  return rules.formatForRow(sourceModel(), row);
+}
+
+void FormatProxyModel::updateRuleFormatForRows(ConditionalFormatMap & rules, int firstRow, int lastRow, int role)
+{
+  Q_ASSERT(firstRow >= 0);
+  Q_ASSERT(firstRow <= lastRow);
+
+  if(rules.isEmpty()){
+    return;
+  }
+  const auto *model = sourceModel();
+  Q_ASSERT(model != nullptr);
+  /*
+   * Only rows that have been evaluated before can have been displayed with a format.
+   * Consecutive rows whose format changed are signaled together.
+   */
+  const int lastColumn = model->columnCount() - 1;
+  int firstChangedRow = -1;
+  for(int row = firstRow; row <= lastRow + 1; ++row){
+    const bool changed = (row <= lastRow) && rules.updateRow(model, row);
+    if(changed && (firstChangedRow < 0)){
+      firstChangedRow = row;
+    }else if(!changed && (firstChangedRow >= 0)){
+      emit dataChanged(index(firstChangedRow, 0), index(row - 1, lastColumn), {role});
+      firstChangedRow = -1;
+    }
+  }
+}
+
+void FormatProxyModel::signalFormatChangedForAllRows(int role)
+{
+  if(sourceModel() == nullptr){
+    return;
+  }
+  const int rows = rowCount();
+  const int columns = columnCount();
+  if( (rows < 1) || (columns < 1) ){
+    return;
+  }
+  emit dataChanged(index(0, 0), index(rows - 1, columns - 1), {role});
+}
+
 void FormatProxyModel::signalFormatChangedForIndex(int row, int column, int role)
 {
   Q_ASSERT(row >= 0);
@@ -366,4 +676,42 @@ void FormatProxyModel::signalFormatChangedForColumn(int column, int role)
   }
 }
 
+void FormatProxyModel::signalFormatChangedForRowRange(const RowRange & rowRange, int role)
+{
+  Q_ASSERT(rowRange.isValid());
+
+  if(sourceModel() == nullptr){
+    return;
+  }
+  ColumnRange columnRange;
+  columnRange.setFirstColumn(0);
+  columnRange.setLastColumn(columnCount()-1);
+  if(!columnRange.isValid()){
+    return;
+  }
+  signalFormatChangedForRange(rowRange, columnRange, role);
+}
+
+void FormatProxyModel::signalFormatChangedForRange(const RowRange & rowRange, const ColumnRange & columnRange, int role)
+{
+  Q_ASSERT(rowRange.isValid());
+  Q_ASSERT(columnRange.isValid());
+
+  if(sourceModel() == nullptr){
+    return;
+  }
+  /*
+   * A range can be set before rows or columns exist,
+   * only signal the part that is in this model
+   */
+  const int lastRow = qMin(rowRange.lastRow(), rowCount()-1);
+  const int lastColumn = qMin(columnRange.lastColumn(), columnCount()-1);
+  if( (rowRange.firstRow() > lastRow) || (columnRange.firstColumn() > lastColumn) ){
+    return;
+  }
+  const auto topLeft = index(rowRange.firstRow(), columnRange.firstColumn());
+  const auto bottomRight = index(lastRow, lastColumn);
+  emit dataChanged(topLeft, bottomRight, {role});
+}
+
 }} // namespace Mdt{ namespace ItemModel{
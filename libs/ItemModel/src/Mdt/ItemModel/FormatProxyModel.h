@@ -22,8 +22,13 @@
 #define MDT_ITEM_MODEL_FORMAT_PROXY_MODEL_H
 
 #include "FormatMap.h"
+#include "ConditionalFormatMap.h"
+#include "RowRange.h"
+#include "ColumnRange.h"
 #include "MdtItemModelExport.h"
 #include <QIdentityProxyModel>
+#include <QMetaObject>
+#include <QVector>
 #include <QVariant>
 #include <QFont>
 #include <QBrush>
@@ -33,6 +38,25 @@
 namespace Mdt{ namespace ItemModel{
 
   /*! \brief Proxy model to provide some formatting
+   *
+   * Formats can be set for a index, a row or a column.
+   *  To format many rows, or a block of indexes, prefer the range variants,
+   *  for example setBackgroundBrushForRowRange() or setTextFontForRange():
+   *  a range is stored once, and dataChanged() is emitted once for it.
+   *
+   * Formats can also depend on the data of the source model,
+   *  using rules expressed like a filter of FilterProxyModel:
+   * \code
+   * using Mdt::ItemModel::FilterColumn;
+   *
+   * FilterColumn amount(3);
+   * proxyModel->addTextColorRule( amount < 0, Qt::red );
+   * \endcode
+   *  A rule formats the whole row.
+   *  Rules are evaluated the first time a row is displayed,
+   *  then only again for the rows the source model reports in dataChanged().
+   *  A format set explicitly, for example with setTextColorForIndex(),
+   *  takes precedence over a rule.
    */
   class MDT_ITEMMODEL_EXPORT FormatProxyModel : public QIdentityProxyModel
   {
@@ -44,6 +68,10 @@ namespace Mdt{ namespace ItemModel{
      */
     explicit FormatProxyModel(QObject *parent = nullptr);
 
+    /*! \brief Set source model
+     */
+    void setSourceModel(QAbstractItemModel *model) override;
+
     /*! \brief Set priority when format conflics
      *
      * Define which format should be choosen when
@@ -96,6 +124,42 @@ namespace Mdt{ namespace ItemModel{
      */
     void clearTextAlignmentForColumn(int column);
 
+    /*! \brief Set text alignment for a range of rows
+     *
+     * All columns of each row in \a rowRange get \a alignment ,
+     *  like with setTextAlignmentForRow(),
+     *  but the range is stored once and dataChanged() is emitted once.
+     *
+     * \pre \a rowRange must be valid
+     */
+    void setTextAlignmentForRowRange(const RowRange & rowRange, Qt::Alignment alignment);
+
+    /*! \brief Clear text alignment for a range of rows
+     *
+     * Only clears text alignment set with setTextAlignmentForRowRange().
+     *
+     * \pre \a rowRange must be valid
+     */
+    void clearTextAlignmentForRowRange(const RowRange & rowRange);
+
+    /*! \brief Set text alignment for each index in \a rowRange and \a columnRange
+     *
+     * The range is stored once and dataChanged() is emitted once.
+     *
+     * \pre \a rowRange must be valid
+     * \pre \a columnRange must be valid
+     */
+    void setTextAlignmentForRange(const RowRange & rowRange, const ColumnRange & columnRange, Qt::Alignment alignment);
+
+    /*! \brief Clear text alignment for each index in \a rowRange and \a columnRange
+     *
+     * Only clears text alignment set with setTextAlignmentForRange().
+     *
+     * \pre \a rowRange must be valid
+     * \pre \a columnRange must be valid
+     */
+    void clearTextAlignmentForRange(const RowRange & rowRange, const ColumnRange & columnRange);
+
     /*! \brief Get text alignment for given row and column
      *
      * Returns a QVariant with value of type Qt::Alignment
@@ -145,6 +209,42 @@ namespace Mdt{ namespace ItemModel{
      */
     void clearTextFontForColumn(int column);
 
+    /*! \brief Set text font for a range of rows
+     *
+     * All columns of each row in \a rowRange get \a font ,
+     *  like with setTextFontForRow(),
+     *  but the range is stored once and dataChanged() is emitted once.
+     *
+     * \pre \a rowRange must be valid
+     */
+    void setTextFontForRowRange(const RowRange & rowRange, const QFont & font);
+
+    /*! \brief Clear text font for a range of rows
+     *
+     * Only clears text font set with setTextFontForRowRange().
+     *
+     * \pre \a rowRange must be valid
+     */
+    void clearTextFontForRowRange(const RowRange & rowRange);
+
+    /*! \brief Set text font for each index in \a rowRange and \a columnRange
+     *
+     * The range is stored once and dataChanged() is emitted once.
+     *
+     * \pre \a rowRange must be valid
+     * \pre \a columnRange must be valid
+     */
+    void setTextFontForRange(const RowRange & rowRange, const ColumnRange & columnRange, const QFont & font);
+
+    /*! \brief Clear text font for each index in \a rowRange and \a columnRange
+     *
+     * Only clears text font set with setTextFontForRange().
+     *
+     * \pre \a rowRange must be valid
+     * \pre \a columnRange must be valid
+     */
+    void clearTextFontForRange(const RowRange & rowRange, const ColumnRange & columnRange);
+
     /*! \brief Get text font for given row and column
      *
      * Returns a QVariant with value of type QFont
@@ -194,6 +294,42 @@ namespace Mdt{ namespace ItemModel{
      */
     void clearTextColorForColumn(int column);
 
+    /*! \brief Set text color for a range of rows
+     *
+     * All columns of each row in \a rowRange get \a color ,
+     *  like with setTextColorForRow(),
+     *  but the range is stored once and dataChanged() is emitted once.
+     *
+     * \pre \a rowRange must be valid
+     */
+    void setTextColorForRowRange(const RowRange & rowRange, const QColor & color);
+
+    /*! \brief Clear text color for a range of rows
+     *
+     * Only clears text color set with setTextColorForRowRange().
+     *
+     * \pre \a rowRange must be valid
+     */
+    void clearTextColorForRowRange(const RowRange & rowRange);
+
+    /*! \brief Set text color for each index in \a rowRange and \a columnRange
+     *
+     * The range is stored once and dataChanged() is emitted once.
+     *
+     * \pre \a rowRange must be valid
+     * \pre \a columnRange must be valid
+     */
+    void setTextColorForRange(const RowRange & rowRange, const ColumnRange & columnRange, const QColor & color);
+
+    /*! \brief Clear text color for each index in \a rowRange and \a columnRange
+     *
+     * Only clears text color set with setTextColorForRange().
+     *
+     * \pre \a rowRange must be valid
+     * \pre \a columnRange must be valid
+     */
+    void clearTextColorForRange(const RowRange & rowRange, const ColumnRange & columnRange);
+
     /*! \brief Get foreground brush for given row and column
      *
      * Returns a QVariant with value of type QBrush
@@ -262,6 +398,55 @@ namespace Mdt{ namespace ItemModel{
      */
     void clearBackgroundBrushForColumn(int column);
 
+    /*! \brief Set background brush for a range of rows
+     *
+     * All columns of each row in \a rowRange get \a brush ,
+     *  like with setBackgroundBrushForRow(),
+     *  but the range is stored once and dataChanged() is emitted once.
+     *
+     * \pre \a rowRange must be valid
+     */
+    void setBackgroundBrushForRowRange(const RowRange & rowRange, const QBrush & brush);
+
+    /*! \brief Set background color for a range of rows
+     *
+     * \pre \a rowRange must be valid
+     */
+    void setBackgroundColorForRowRange(const RowRange & rowRange, const QColor & color, Qt::BrushStyle style = Qt::SolidPattern);
+
+    /*! \brief Clear background brush for a range of rows
+     *
+     * Only clears background brush set with setBackgroundBrushForRowRange().
+     *
+     * \pre \a rowRange must be valid
+     */
+    void clearBackgroundBrushForRowRange(const RowRange & rowRange);
+
+    /*! \brief Set background brush for each index in \a rowRange and \a columnRange
+     *
+     * The range is stored once and dataChanged() is emitted once.
+     *
+     * \pre \a rowRange must be valid
+     * \pre \a columnRange must be valid
+     */
+    void setBackgroundBrushForRange(const RowRange & rowRange, const ColumnRange & columnRange, const QBrush & brush);
+
+    /*! \brief Set background color for each index in \a rowRange and \a columnRange
+     *
+     * \pre \a rowRange must be valid
+     * \pre \a columnRange must be valid
+     */
+    void setBackgroundColorForRange(const RowRange & rowRange, const ColumnRange & columnRange, const QColor & color, Qt::BrushStyle style = Qt::SolidPattern);
+
+    /*! \brief Clear background brush for each index in \a rowRange and \a columnRange
+     *
+     * Only clears background brush set with setBackgroundBrushForRange().
+     *
+     * \pre \a rowRange must be valid
+     * \pre \a columnRange must be valid
+     */
+    void clearBackgroundBrushForRange(const RowRange & rowRange, const ColumnRange & columnRange);
+
     /*! \brief Get background brush for given row and column
      *
      * Returns a QVariant with value of type QBrush
@@ -273,20 +458,110 @@ namespace Mdt{ namespace ItemModel{
      */
     QVariant backgroundBrush(int row, int column) const;
 
+    /*! \brief Add a rule that gives \a alignment to rows matching \a condition
+     *
+     * Rules are checked in the order they have been added,
+     *  the first one that matches a row gives its text alignment.
+     *
+     * \pre \a condition must be a filter expression type
+     *       (see FilterProxyModel::setFilter() for details)
+     */
+    template<typename Expr>
+    void addTextAlignmentRule(const Expr & condition, Qt::Alignment alignment)
+    {
+      mTextAlignmentRules.addRule(condition, QVariant(alignment));
+      signalFormatChangedForAllRows(Qt::TextAlignmentRole);
+    }
+
+    /*! \brief Add a rule that gives \a font to rows matching \a condition
+     *
+     * \pre \a condition must be a filter expression type
+     *       (see FilterProxyModel::setFilter() for details)
+     * \sa addTextAlignmentRule()
+     */
+    template<typename Expr>
+    void addTextFontRule(const Expr & condition, const QFont & font)
+    {
+      mTextFontRules.addRule(condition, QVariant(font));
+      signalFormatChangedForAllRows(Qt::FontRole);
+    }
+
+    /*! \brief Add a rule that gives \a color to the text of rows matching \a condition
+     *
+     * \pre \a condition must be a filter expression type
+     *       (see FilterProxyModel::setFilter() for details)
+     * \sa addTextAlignmentRule()
+     */
+    template<typename Expr>
+    void addTextColorRule(const Expr & condition, const QColor & color)
+    {
+      mForegroundBrushRules.addRule(condition, QVariant(QBrush(color)));
+      signalFormatChangedForAllRows(Qt::ForegroundRole);
+    }
+
+    /*! \brief Add a rule that gives \a brush to the background of rows matching \a condition
+     *
+     * \pre \a condition must be a filter expression type
+     *       (see FilterProxyModel::setFilter() for details)
+     * \sa addTextAlignmentRule()
+     */
+    template<typename Expr>
+    void addBackgroundBrushRule(const Expr & condition, const QBrush & brush)
+    {
+      mBackgroundBrushRules.addRule(condition, QVariant(brush));
+      signalFormatChangedForAllRows(Qt::BackgroundRole);
+    }
+
+    /*! \brief Add a rule that gives \a color to the background of rows matching \a condition
+     *
+     * \pre \a condition must be a filter expression type
+     *       (see FilterProxyModel::setFilter() for details)
+     * \sa addTextAlignmentRule()
+     */
+    template<typename Expr>
+    void addBackgroundColorRule(const Expr & condition, const QColor & color, Qt::BrushStyle style = Qt::SolidPattern)
+    {
+      addBackgroundBrushRule(condition, QBrush(color, style));
+    }
+
+    /*! \brief Remove all rules
+     *
+     * Formats set explicitly are not affected.
+     */
+    void clearFormatRules();
+
     /*! \brief Get data for given index and role
      */
     QVariant data(const QModelIndex & index, int role = Qt::DisplayRole) const;
 
+   private slots:
+
+    void onSourceModelDataChanged(const QModelIndex & topLeft, const QModelIndex & bottomRight);
+    void onSourceRowsInserted(const QModelIndex & parent, int first, int last);
+    void onSourceRowsRemoved(const QModelIndex & parent, int first, int last);
+    void clearFormatRulesCache();
+
    private:
 
+    QVariant ruleFormat(const ConditionalFormatMap & rules, int row) const;
+    void updateRuleFormatForRows(ConditionalFormatMap & rules, int firstRow, int lastRow, int role);
+    void signalFormatChangedForAllRows(int role);
+
     void signalFormatChangedForIndex(int row, int column, int role);
     void signalFormatChangedForRow(int row, int role);
     void signalFormatChangedForColumn(int column, int role);
+    void signalFormatChangedForRowRange(const RowRange & rowRange, int role);
+    void signalFormatChangedForRange(const RowRange & rowRange, const ColumnRange & columnRange, int role);
 
     FormatMap mTextAlignmentMap;
     FormatMap mTextFontMap;
     FormatMap mForegroundBrushMap;
     FormatMap mBackgroundBrushMap;
+    ConditionalFormatMap mTextAlignmentRules;
+    ConditionalFormatMap mTextFontRules;
+    ConditionalFormatMap mForegroundBrushRules;
+    ConditionalFormatMap mBackgroundBrushRules;
+    QVector<QMetaObject::Connection> mSourceModelConnections;
   };
 
 }} // namespace Mdt{ namespace ItemModel{
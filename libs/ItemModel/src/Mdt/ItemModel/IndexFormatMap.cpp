@@ -19,7 +19,6 @@
  **
  ****************************************************************************/
 #include "IndexFormatMap.h"
-#include <algorithm>
 
 namespace Mdt{ namespace ItemModel{
 
@@ -28,10 +27,7 @@ void IndexFormatMap::clearFormatForIndex(int row, int column)
   Q_ASSERT(row >= 0);
   Q_ASSERT(column >= 0);
 
-  const auto it = iteratorForIndex(row, column);
-  if(it != mItems.cend()){
-    mItems.erase(it);
-  }
+  mFormats.remove( qMakePair(row, column) );
 }
 
 QVariant IndexFormatMap::formatForIndex(int row, int column) const
@@ -39,12 +35,11 @@ QVariant IndexFormatMap::formatForIndex(int row, int column) const
   Q_ASSERT(row >= 0);
   Q_ASSERT(column >= 0);
 
-  const auto it = iteratorForIndex(row, column);
-  if(it != mItems.cend()){
-    return it->value();
+  if(mFormats.isEmpty()){
+    return QVariant();
   }
 
-  return QVariant();
+  return mFormats.value( qMakePair(row, column) );
 }
 
 void IndexFormatMap::setFormatVariantForIndex(int row, int column, const QVariant & format)
@@ -52,32 +47,7 @@ void IndexFormatMap::setFormatVariantForIndex(int row, int column, const QVarian
   Q_ASSERT(row >= 0);
   Q_ASSERT(column >= 0);
 
-  auto it = iteratorForIndexW(row, column);
-  if(it == mItems.end()){
-    mItems.emplace_back(row, column, format);
-  }else{
-    *it = IndexFormatMapItem(row, column, format);
-  }
-}
-
-IndexFormatMap::const_iterator IndexFormatMap::iteratorForIndex(int row, int column) const
-{
-  Q_ASSERT(column >= 0);
-
-  const auto pred = [row, column](const IndexFormatMapItem & item){
-    return ( item.row() == row && item.column() == column );
-  };
-  return std::find_if(mItems.cbegin(), mItems.cend(), pred);
-}
-
-IndexFormatMap::iterator IndexFormatMap::iteratorForIndexW(int row, int column)
-{
-  Q_ASSERT(column >= 0);
-
-  const auto pred = [row, column](const IndexFormatMapItem & item){
-    return ( item.row() == row && item.column() == column );
-  };
-  return std::find_if(mItems.begin(), mItems.end(), pred);
+  mFormats.insert( qMakePair(row, column), format );
 }
 
 }} //namespace Mdt{ namespace ItemModel{
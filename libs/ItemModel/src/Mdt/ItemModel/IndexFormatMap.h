@@ -21,15 +21,18 @@
 #ifndef MDT_ITEM_MODEL_INDEX_FORMAT_ITEM_H
 #define MDT_ITEM_MODEL_INDEX_FORMAT_ITEM_H
 
-#include "IndexFormatMapItem.h"
 #include "MdtItemModelExport.h"
 #include <QVariant>
+#include <QHash>
+#include <QPair>
 #include <QtGlobal>
-#include <vector>
 
 namespace Mdt{ namespace ItemModel{
 
   /*! \brief Stores format for a index in a item model
+   *
+   * Formats are stored in a hash by row and column,
+   *  so formatForIndex() does not depend on the count of formats.
    */
   class MDT_ITEMMODEL_EXPORT IndexFormatMap
   {
@@ -68,16 +71,18 @@ namespace Mdt{ namespace ItemModel{
      */
     QVariant formatForIndex(int row, int column) const;
 
+    /*! \brief Check if no format was set
+     */
+    bool isEmpty() const
+    {
+      return mFormats.isEmpty();
+    }
+
    private:
 
     void setFormatVariantForIndex(int row, int column, const QVariant & format);
-    using iterator = std::vector<IndexFormatMapItem>::iterator;
-    using const_iterator = std::vector<IndexFormatMapItem>::const_iterator;
-
-    const_iterator iteratorForIndex(int row, int column) const;
-    iterator iteratorForIndexW(int row, int column);
 
-    std::vector<IndexFormatMapItem> mItems;
+    QHash< QPair<int, int>, QVariant > mFormats;
   };
 
 }} //namespace Mdt{ namespace ItemModel{
@@ -0,0 +1,122 @@
+/****************************************************************************
+ **
+ ** Copyright (C) 2011-2017 Philippe Steinmann.
+ **
+ ** This file is part of multiDiagTools library.
+ **
+ ** multiDiagTools is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Lesser General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** multiDiagTools is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public License
+ ** along with multiDiagTools.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+#include "IndexRangeList.h"
+#include <algorithm>
+#include <map>
+#include <utility>
+
+namespace Mdt{ namespace ItemModel{
+
+void IndexRangeList::addRange(int firstRow, int firstColumn, int lastRow, int lastColumn)
+{
+  Q_ASSERT(firstRow >= 0);
+  Q_ASSERT(firstRow <= lastRow);
+  Q_ASSERT(firstColumn >= 0);
+  Q_ASSERT(firstColumn <= lastColumn);
+
+  mRanges.emplace_back(firstRow, firstColumn, lastRow, lastColumn);
+}
+
+void IndexRangeList::clear()
+{
+  mRanges.clear();
+}
+
+std::vector<IndexRange> IndexRangeList::mergedRanges() const
+{
+  if(mRanges.size() < 2){
+    return mRanges;
+  }
+  /*
+   * Sweep the rows from top to bottom.
+   * The columns that are covered can only change at the first row of a range,
+   * or just after its last row. Between 2 such boundaries, the rows make a band
+   * that is handled at once, so a range is never cut into rows.
+   */
+  std::vector<int> boundaries;
+  boundaries.reserve(2*mRanges.size());
+  for(const auto & range : mRanges){
+    boundaries.push_back(range.firstRow());
+    boundaries.push_back(range.lastRow() + 1);
+  }
+  std::sort(boundaries.begin(), boundaries.end());
+  boundaries.erase( std::unique(boundaries.begin(), boundaries.end()), boundaries.end() );
+  auto pendingRanges = mRanges;
+  std::sort(pendingRanges.begin(), pendingRanges.end(), [](const IndexRange & a, const IndexRange & b){
+    return a.firstRow() < b.firstRow();
+  });
+  auto pendingIt = pendingRanges.cbegin();
+  std::vector<IndexRange> activeRanges;
+  std::vector< std::pair<int, int> > bandColumns;
+  std::vector<IndexRange> ranges;
+  std::map< std::pair<int, int>, std::size_t > openRangeByColumns;
+  for(std::size_t i = 0; i+1 < boundaries.size(); ++i){
+    const int bandFirstRow = boundaries[i];
+    const int bandLastRow = boundaries[i+1] - 1;
+    // Update the ranges that cover the band
+    const auto activeEnd = std::remove_if(activeRanges.begin(), activeRanges.end(), [bandFirstRow](const IndexRange & range){
+      return range.lastRow() < bandFirstRow;
+    });
+    activeRanges.erase(activeEnd, activeRanges.end());
+    while( (pendingIt != pendingRanges.cend()) && (pendingIt->firstRow() == bandFirstRow) ){
+      activeRanges.push_back(*pendingIt);
+      ++pendingIt;
+    }
+    // Join overlapping or adjacent columns of the band
+    bandColumns.clear();
+    for(const auto & range : activeRanges){
+      bandColumns.emplace_back(range.firstColumn(), range.lastColumn());
+    }
+    std::sort(bandColumns.begin(), bandColumns.end());
+    std::size_t columnsCount = 0;
+    for(const auto & columns : bandColumns){
+      if( (columnsCount > 0) && (columns.first <= bandColumns[columnsCount-1].second + 1) ){
+        bandColumns[columnsCount-1].second = std::max(bandColumns[columnsCount-1].second, columns.second);
+      }else{
+        bandColumns[columnsCount] = columns;
+        ++columnsCount;
+      }
+    }
+    bandColumns.resize(columnsCount);
+    /*
+     * Join the band to the rectangle that has the same columns
+     * and ends at the row just before it
+     */
+    for(const auto & columns : bandColumns){
+      const auto it = openRangeByColumns.find(columns);
+      if( (it != openRangeByColumns.end()) && (ranges[it->second].lastRow() == bandFirstRow - 1) ){
+        auto & range = ranges[it->second];
+        range = IndexRange(range.firstRow(), range.firstColumn(), bandLastRow, range.lastColumn());
+      }else{
+        openRangeByColumns[columns] = ranges.size();
+        ranges.emplace_back(bandFirstRow, columns.first, bandLastRow, columns.second);
+      }
+    }
+  }
+  Q_ASSERT(pendingIt == pendingRanges.cend());
+  std::sort(ranges.begin(), ranges.end(), [](const IndexRange & a, const IndexRange & b){
+    return (a.firstRow() < b.firstRow()) || ( (a.firstRow() == b.firstRow()) && (a.firstColumn() < b.firstColumn()) );
+  });
+
+  return ranges;
+}
+
+}} // namespace Mdt{ namespace ItemModel{
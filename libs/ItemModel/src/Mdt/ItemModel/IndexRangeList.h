@@ -0,0 +1,149 @@
+/****************************************************************************
+ **
+ ** Copyright (C) 2011-2017 Philippe Steinmann.
+ **
+ ** This file is part of multiDiagTools library.
+ **
+ ** multiDiagTools is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Lesser General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** multiDiagTools is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public License
+ ** along with multiDiagTools.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+#ifndef MDT_ITEM_MODEL_INDEX_RANGE_LIST_H
+#define MDT_ITEM_MODEL_INDEX_RANGE_LIST_H
+
+#include "MdtItemModelExport.h"
+#include <QtGlobal>
+#include <vector>
+
+namespace Mdt{ namespace ItemModel{
+
+  /*! \brief Rectangle of indexes in a item model, from firstRow , firstColumn to lastRow , lastColumn
+   */
+  class MDT_ITEMMODEL_EXPORT IndexRange
+  {
+   public:
+
+    /*! \brief Construct a range
+     *
+     * \pre \a firstRow must be >= 0 and <= \a lastRow
+     * \pre \a firstColumn must be >= 0 and <= \a lastColumn
+     */
+    constexpr IndexRange(int firstRow, int firstColumn, int lastRow, int lastColumn) noexcept
+     : mFirstRow(firstRow),
+       mFirstColumn(firstColumn),
+       mLastRow(lastRow),
+       mLastColumn(lastColumn)
+    {
+    }
+
+    /*! \brief Get first row
+     */
+    constexpr int firstRow() const noexcept
+    {
+      return mFirstRow;
+    }
+
+    /*! \brief Get first column
+     */
+    constexpr int firstColumn() const noexcept
+    {
+      return mFirstColumn;
+    }
+
+    /*! \brief Get last row
+     */
+    constexpr int lastRow() const noexcept
+    {
+      return mLastRow;
+    }
+
+    /*! \brief Get last column
+     */
+    constexpr int lastColumn() const noexcept
+    {
+      return mLastColumn;
+    }
+
+    /*! \brief Check if this range is the same as \a other
+     */
+    constexpr bool operator==(const IndexRange & other) const noexcept
+    {
+      return ( (mFirstRow == other.mFirstRow) && (mFirstColumn == other.mFirstColumn)
+               && (mLastRow == other.mLastRow) && (mLastColumn == other.mLastColumn) );
+    }
+
+   private:
+
+    int mFirstRow;
+    int mFirstColumn;
+    int mLastRow;
+    int mLastColumn;
+  };
+
+  /*! \brief Collects ranges of indexes and merges them into a small set of rectangles
+   *
+   * Used by VariantTableModel to emit dataChanged() once per rectangle
+   *  for many edits done in a batch.
+   *
+   * mergedRanges() covers exactly the indexes that have been added:
+   *  in each row, adjacent or overlapping column ranges are joined,
+   *  then consecutive rows having the same column range are joined.
+   *  This is not always the smallest possible set of rectangles,
+   *  but it is for the usual edits: a single index, some rows, some columns or a block.
+   */
+  class MDT_ITEMMODEL_EXPORT IndexRangeList
+  {
+   public:
+
+    /*! \brief Add a rectangle of indexes from \a firstRow , \a firstColumn to \a lastRow , \a lastColumn
+     *
+     * \pre \a firstRow must be >= 0 and <= \a lastRow
+     * \pre \a firstColumn must be >= 0 and <= \a lastColumn
+     */
+    void addRange(int firstRow, int firstColumn, int lastRow, int lastColumn);
+
+    /*! \brief Add a single index
+     *
+     * \pre \a row must be >= 0
+     * \pre \a column must be >= 0
+     */
+    void addIndex(int row, int column)
+    {
+      addRange(row, column, row, column);
+    }
+
+    /*! \brief Check if no range was added
+     */
+    bool isEmpty() const
+    {
+      return mRanges.empty();
+    }
+
+    /*! \brief Remove all ranges
+     */
+    void clear();
+
+    /*! \brief Get added ranges merged into rectangles
+     *
+     * Rectangles are sorted by first row, then by first column.
+     */
+    std::vector<IndexRange> mergedRanges() const;
+
+   private:
+
+    std::vector<IndexRange> mRanges;
+  };
+
+}} // namespace Mdt{ namespace ItemModel{
+
+#endif // #ifndef MDT_ITEM_MODEL_INDEX_RANGE_LIST_H
@@ -0,0 +1,135 @@
+/****************************************************************************
+ **
+ ** Copyright (C) 2011-2017 Philippe Steinmann.
+ **
+ ** This file is part of multiDiagTools library.
+ **
+ ** multiDiagTools is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Lesser General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** multiDiagTools is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public License
+ ** along with multiDiagTools.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+#ifndef MDT_ITEM_MODEL_PARALLEL_STABLE_SORT_H
+#define MDT_ITEM_MODEL_PARALLEL_STABLE_SORT_H
+
+#include <QThreadPool>
+#include <QRunnable>
+#include <QSemaphore>
+#include <QtGlobal>
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+namespace Mdt{ namespace ItemModel{
+
+  namespace Impl{
+
+    /*! \brief Task that runs a function in a thread pool
+     */
+    class ParallelTask : public QRunnable
+    {
+     public:
+
+      ParallelTask(const std::function<void(int)> & function, int taskIndex, QSemaphore & done)
+       : mFunction(function),
+         mTaskIndex(taskIndex),
+         mDone(done)
+      {
+      }
+
+      void run() override
+      {
+        mFunction(mTaskIndex);
+        mDone.release();
+      }
+
+     private:
+
+      const std::function<void(int)> & mFunction;
+      const int mTaskIndex;
+      QSemaphore & mDone;
+    };
+
+    /*! \brief Call \a function for each task index in range [0, \a taskCount[ , in parallel
+     *
+     * The calling thread runs task 0 itself, then waits until all other tasks are done.
+     */
+    inline
+    void runInParallel(int taskCount, const std::function<void(int)> & function, QThreadPool *pool)
+    {
+      Q_ASSERT(taskCount >= 1);
+      Q_ASSERT(pool != nullptr);
+
+      QSemaphore done;
+      for(int i = 1; i < taskCount; ++i){
+        pool->start( new ParallelTask(function, i, done) );
+      }
+      function(0);
+      done.acquire(taskCount - 1);
+    }
+
+  } // namespace Impl{
+
+  /*! \brief Sort \a values in parallel, preserving the order of equivalent elements
+   *
+   * \a values is split in one chunk per thread of \a pool ,
+   *  each chunk is sorted with std::stable_sort(),
+   *  then chunks are merged pairwise, each round of merges also in parallel.
+   *
+   * \a compare must be safe to call from multiple threads at the same time.
+   *
+   * \pre \a pool must be a valid pointer
+   */
+  template<typename T, typename Compare>
+  void parallelStableSort(std::vector<T> & values, const Compare & compare, QThreadPool *pool = QThreadPool::globalInstance())
+  {
+    Q_ASSERT(pool != nullptr);
+
+    // Below this size, splitting costs more than it gains
+    constexpr int minimumChunkSize = 4096;
+
+    const int n = static_cast<int>(values.size());
+    const int chunkCount = qMax( 1, qMin(pool->maxThreadCount(), n / minimumChunkSize) );
+    if(chunkCount == 1){
+      std::stable_sort(values.begin(), values.end(), compare);
+      return;
+    }
+    std::vector<int> bounds(chunkCount + 1);
+    for(int i = 0; i <= chunkCount; ++i){
+      bounds[i] = static_cast<int>( static_cast<qint64>(n) * i / chunkCount );
+    }
+    Impl::runInParallel(chunkCount, [&values, &bounds, &compare](int chunk){
+      std::stable_sort(values.begin() + bounds[chunk], values.begin() + bounds[chunk+1], compare);
+    }, pool);
+    std::vector<T> buffer(values.size());
+    auto *source = &values;
+    auto *destination = &buffer;
+    for(int width = 1; width < chunkCount; width *= 2){
+      const int mergeCount = (chunkCount + 2*width - 1) / (2*width);
+      Impl::runInParallel(mergeCount, [source, destination, &bounds, &compare, width, chunkCount](int merge){
+        const int first = merge * 2 * width;
+        const int middle = qMin(first + width, chunkCount);
+        const int last = qMin(first + 2 * width, chunkCount);
+        std::merge(source->begin() + bounds[first], source->begin() + bounds[middle],
+                   source->begin() + bounds[middle], source->begin() + bounds[last],
+                   destination->begin() + bounds[first], compare);
+      }, pool);
+      std::swap(source, destination);
+    }
+    if(source != &values){
+      values.swap(buffer);
+    }
+  }
+
+}} // namespace Mdt{ namespace ItemModel{
+
+#endif // #ifndef MDT_ITEM_MODEL_PARALLEL_STABLE_SORT_H
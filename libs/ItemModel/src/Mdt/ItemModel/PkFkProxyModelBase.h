@@ -54,8 +54,10 @@ namespace Mdt{ namespace ItemModel{
      */
     int findFirstRowForKeyRecord(const KeyRecord & record) const;
 
-   private:
-
+    /*! \brief Check if data of \a row matches \a record
+     *
+     * \pre \a row must be in correct range ( 0 <= row < rowCount() )
+     */
     bool rowMatchesKeyRecord(int row, const KeyRecord & record) const;
   };
 
@@ -19,6 +19,9 @@
  **
  ****************************************************************************/
 #include "PrimaryKeyProxyModel.h"
+#include <QAbstractItemModel>
+#include <QModelIndex>
+#include <algorithm>
 
 namespace Mdt{ namespace ItemModel{
 
@@ -27,11 +30,44 @@ PrimaryKeyProxyModel::PrimaryKeyProxyModel(QObject* parent)
 {
 }
 
+void PrimaryKeyProxyModel::setSourceModel(QAbstractItemModel *model)
+{
+  /*
+   * The primary key index must be up to date before QIdentityProxyModel
+   * tells the views about a change of the source model.
+   * Because slots are called in the order they have been connected,
+   * we connect before QIdentityProxyModel does.
+   */
+  for(const auto & connection : mSourceModelConnections){
+    disconnect(connection);
+  }
+  mSourceModelConnections.clear();
+  mPkIndex.clear();
+  if(model != nullptr){
+    mSourceModelConnections.append( connect(model, &QAbstractItemModel::rowsInserted, this, &PrimaryKeyProxyModel::onSourceRowsInserted) );
+    mSourceModelConnections.append( connect(model, &QAbstractItemModel::rowsRemoved, this, &PrimaryKeyProxyModel::onSourceRowsRemoved) );
+    mSourceModelConnections.append( connect(model, &QAbstractItemModel::dataChanged, this, &PrimaryKeyProxyModel::onSourceModelDataChanged) );
+    mSourceModelConnections.append( connect(model, &QAbstractItemModel::rowsMoved, this, &PrimaryKeyProxyModel::buildPrimaryKeyIndex) );
+    mSourceModelConnections.append( connect(model, &QAbstractItemModel::columnsInserted, this, &PrimaryKeyProxyModel::buildPrimaryKeyIndex) );
+    mSourceModelConnections.append( connect(model, &QAbstractItemModel::columnsRemoved, this, &PrimaryKeyProxyModel::buildPrimaryKeyIndex) );
+    mSourceModelConnections.append( connect(model, &QAbstractItemModel::columnsMoved, this, &PrimaryKeyProxyModel::buildPrimaryKeyIndex) );
+    mSourceModelConnections.append( connect(model, &QAbstractItemModel::layoutChanged, this, &PrimaryKeyProxyModel::buildPrimaryKeyIndex) );
+    mSourceModelConnections.append( connect(model, &QAbstractItemModel::modelReset, this, &PrimaryKeyProxyModel::buildPrimaryKeyIndex) );
+  }
+  PkFkProxyModelBase::setSourceModel(model);
+  buildPrimaryKeyIndex();
+}
+
 void PrimaryKeyProxyModel::setPrimaryKey(const PrimaryKey & pk)
 {
   Q_ASSERT(!pk.isNull());
 
   mPk = pk;
+  mIsPkColumn.fill(false, mPk.greatestColumn() + 1);
+  for(const int column : mPk.toColumnList()){
+    mIsPkColumn[column] = true;
+  }
+  buildPrimaryKeyIndex();
 }
 
 void PrimaryKeyProxyModel::setPrimaryKey(std::initializer_list<int> pk)
@@ -42,6 +78,8 @@ void PrimaryKeyProxyModel::setPrimaryKey(std::initializer_list<int> pk)
 void PrimaryKeyProxyModel::clearPrimaryKey()
 {
   mPk.clear();
+  mPkIndex.clear();
+  mIsPkColumn.clear();
 }
 
 PrimaryKey PrimaryKeyProxyModel::primaryKey() const
@@ -67,7 +105,7 @@ Qt::ItemFlags PrimaryKeyProxyModel::flags(const QModelIndex & index) const
   if(mIsPkEditable && mIsPkItemsEnabled){
     return PkFkProxyModelBase::flags(index);
   }
-  if(!mPk.containsColumn(index.column())){
+  if(!isPrimaryKeyColumn(index.column())){
     return PkFkProxyModelBase::flags(index);
   }
   auto f = PkFkProxyModelBase::flags(index);
@@ -92,7 +130,115 @@ int PrimaryKeyProxyModel::findRowForPrimaryKeyRecord(const PrimaryKeyRecord & re
 {
   Q_ASSERT(record.columnCount() == mPk.columnCount());
 
+  if(mPkIndex.isBuilt()){
+    return findRowInPrimaryKeyIndex(record);
+  }
   return findFirstRowForKeyRecord(record);
 }
 
+void PrimaryKeyProxyModel::setPrimaryKeyIndexEnabled(bool enable)
+{
+  mPkIndexEnabled = enable;
+  buildPrimaryKeyIndex();
+}
+
+void PrimaryKeyProxyModel::onSourceRowsInserted(const QModelIndex & parent, int first, int last)
+{
+  if( (!mPkIndex.isBuilt()) || parent.isValid() ){
+    return;
+  }
+  mPkIndex.insertRows(sourceModel(), first, last);
+  checkPrimaryKeyUniqueness(first, last);
+}
+
+void PrimaryKeyProxyModel::onSourceRowsRemoved(const QModelIndex & parent, int first, int last)
+{
+  if( (!mPkIndex.isBuilt()) || parent.isValid() ){
+    return;
+  }
+  mPkIndex.removeRows(first, last);
+}
+
+void PrimaryKeyProxyModel::onSourceModelDataChanged(const QModelIndex & topLeft, const QModelIndex & bottomRight)
+{
+  if( (!mPkIndex.isBuilt()) || topLeft.parent().isValid() ){
+    return;
+  }
+  const auto columnList = mPkIndex.columnList();
+  const bool keyChanged = std::any_of(columnList.cbegin(), columnList.cend(), [&topLeft, &bottomRight](int column){
+    return (column >= topLeft.column()) && (column <= bottomRight.column());
+  });
+  if(keyChanged){
+    mPkIndex.updateRows(sourceModel(), topLeft.row(), bottomRight.row());
+    checkPrimaryKeyUniqueness(topLeft.row(), bottomRight.row());
+  }
+}
+
+void PrimaryKeyProxyModel::buildPrimaryKeyIndex()
+{
+  mPkIndex.clear();
+  const auto *model = sourceModel();
+  if( (!mPkIndexEnabled) || (model == nullptr) || mPk.isNull() ){
+    return;
+  }
+  const auto columnList = mPk.toColumnList();
+  if(columnList.greatestColumn() >= model->columnCount()){
+    return;
+  }
+  mPkIndex.setColumnList(columnList);
+  mPkIndex.build(model);
+  if(mPkIndex.rowCount() > 0){
+    checkPrimaryKeyUniqueness(0, mPkIndex.rowCount() - 1);
+  }
+}
+
+void PrimaryKeyProxyModel::checkPrimaryKeyUniqueness(int first, int last)
+{
+  Q_ASSERT(mPkIndex.isBuilt());
+  Q_ASSERT(first >= 0);
+  Q_ASSERT(last < mPkIndex.rowCount());
+
+  for(int row = first; row <= last; ++row){
+    // Most keys are unique, this check does not have to build a row list
+    const auto key = mPkIndex.keyAt(row);
+    if(mPkIndex.rowCountForKey(key) < 2){
+      continue;
+    }
+    /*
+     * Like in SQL, null values are not compared.
+     * Rows with the same key string could also have different data.
+     */
+    const auto record = getPrimaryKeyRecord(row);
+    if(std::any_of(record.cbegin(), record.cend(), [](const KeyData & kd){ return kd.data().isNull(); })){
+      continue;
+    }
+    const auto rowList = mPkIndex.findRows(key);
+    const bool isDuplicate = std::any_of(rowList.cbegin(), rowList.cend(), [this, row, &record](int otherRow){
+      return (otherRow != row) && rowMatchesKeyRecord(otherRow, record);
+    });
+    if(isDuplicate){
+      emit primaryKeyUniqueConstraintViolated(row);
+    }
+  }
+}
+
+int PrimaryKeyProxyModel::findRowInPrimaryKeyIndex(const PrimaryKeyRecord & record) const
+{
+  Q_ASSERT(mPkIndex.isBuilt());
+
+  /*
+   * If the primary key is not unique, return the first row,
+   * like findFirstRowForKeyRecord() does
+   */
+  int firstRow = -1;
+  const auto rowList = mPkIndex.findRows( ForeignKeyRowIndex::keyForRecord(record, mPkIndex.columnList()) );
+  for(const int row : rowList){
+    if( ( (firstRow < 0) || (row < firstRow) ) && rowMatchesKeyRecord(row, record) ){
+      firstRow = row;
+    }
+  }
+
+  return firstRow;
+}
+
 }} // namespace Mdt{ namespace ItemModel{
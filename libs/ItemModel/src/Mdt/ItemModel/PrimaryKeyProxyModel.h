@@ -24,7 +24,10 @@
 #include "PrimaryKey.h"
 #include "PrimaryKeyRecord.h"
 #include "PkFkProxyModelBase.h"
+#include "ForeignKeyRowIndex.h"
 #include "MdtItemModelExport.h"
+#include <QVector>
+#include <QMetaObject>
 #include <initializer_list>
 
 namespace Mdt{ namespace ItemModel{
@@ -43,6 +46,16 @@ namespace Mdt{ namespace ItemModel{
    *
    * view.setModel(proxyModel);
    * \endcode
+   *
+   * By default, findRowForPrimaryKeyRecord() reads the data of each row
+   *  until it finds the one that matches.
+   *  If the primary key index is enabled (see setPrimaryKeyIndexEnabled()),
+   *  a hash index from the primary key to the row is maintained
+   *  each time rows are inserted, removed, or primary key data changed in source model.
+   *  Like ForeignKeyRowIndex, the index assumes that equal key values
+   *  have the same string representation.
+   *  When a row gets a primary key that another row already has,
+   *  primaryKeyUniqueConstraintViolated() is emitted.
    */
   class MDT_ITEMMODEL_EXPORT PrimaryKeyProxyModel : public PkFkProxyModelBase
   {
@@ -54,6 +67,10 @@ namespace Mdt{ namespace ItemModel{
      */
     explicit PrimaryKeyProxyModel(QObject *parent = nullptr);
 
+    /*! \brief Set source model
+     */
+    void setSourceModel(QAbstractItemModel *model) override;
+
     /*! \brief Set primary key
      *
      * \pre \a pk must not be null
@@ -119,11 +136,78 @@ namespace Mdt{ namespace ItemModel{
      */
     int findRowForPrimaryKeyRecord(const PrimaryKeyRecord & record) const;
 
+    /*! \brief Enable or disable primary key index
+     *
+     * Primary key index is disabled by default.
+     *  Enabling it builds the index if source model and primary key are set.
+     */
+    void setPrimaryKeyIndexEnabled(bool enable);
+
+    /*! \brief Check if primary key index is enabled
+     */
+    bool isPrimaryKeyIndexEnabled() const
+    {
+      return mPkIndexEnabled;
+    }
+
+   signals:
+
+    /*! \brief Emitted when the primary key of \a row is also the primary key of another row
+     *
+     * This signal is only emitted if primary key index is enabled,
+     *  once for each row that has a duplicate primary key
+     *  after the index was built, and after rows were inserted or their primary key data changed.
+     *  Rows that have a null value in their primary key are not reported.
+     */
+    void primaryKeyUniqueConstraintViolated(int row);
+
+   private slots:
+
+    /*! \brief Actions to perform when rows have been inserted into source model
+     */
+    void onSourceRowsInserted(const QModelIndex & parent, int first, int last);
+
+    /*! \brief Actions to perform when rows have been removed from source model
+     */
+    void onSourceRowsRemoved(const QModelIndex & parent, int first, int last);
+
+    /*! \brief Actions to perform when source model data changed
+     */
+    void onSourceModelDataChanged(const QModelIndex & topLeft, const QModelIndex & bottomRight);
+
+    /*! \brief Build the primary key index again if it is enabled
+     */
+    void buildPrimaryKeyIndex();
+
    private:
 
+    /*! \brief Check if \a column is part of primary key
+     *
+     * Used by flags(), that is called for each item by views,
+     *  so the primary key columns are looked up in a table
+     *  built by setPrimaryKey().
+     */
+    bool isPrimaryKeyColumn(int column) const
+    {
+      Q_ASSERT(column >= 0);
+      return ( (column < mIsPkColumn.size()) && mIsPkColumn.at(column) );
+    }
+
+    /*! \brief Emit primaryKeyUniqueConstraintViolated() for each row in range [first,last] that has a duplicate primary key
+     */
+    void checkPrimaryKeyUniqueness(int first, int last);
+
+    /*! \brief Find row that matches primary key record using the primary key index
+     */
+    int findRowInPrimaryKeyIndex(const PrimaryKeyRecord & record) const;
+
     bool mIsPkEditable = true;
     bool mIsPkItemsEnabled = true;
+    bool mPkIndexEnabled = false;
     PrimaryKey mPk;
+    ForeignKeyRowIndex mPkIndex;
+    QVector<bool> mIsPkColumn;
+    QVector<QMetaObject::Connection> mSourceModelConnections;
   };
 
 }} // namespace Mdt{ namespace ItemModel{
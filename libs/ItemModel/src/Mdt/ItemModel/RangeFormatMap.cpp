@@ -0,0 +1,237 @@
+/****************************************************************************
+ **
+ ** Copyright (C) 2011-2017 Philippe Steinmann.
+ **
+ ** This file is part of multiDiagTools library.
+ **
+ ** multiDiagTools is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Lesser General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** multiDiagTools is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public License
+ ** along with multiDiagTools.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+#include "RangeFormatMap.h"
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+
+namespace Mdt{ namespace ItemModel{
+
+RangeFormatMapItem::RangeFormatMapItem(int firstRow, int firstColumn, int lastRow, int lastColumn, const QVariant & value)
+ : mFirstRow(firstRow),
+   mFirstColumn(firstColumn),
+   mLastRow(lastRow),
+   mLastColumn(lastColumn),
+   mValue(value)
+{
+  Q_ASSERT(mFirstRow >= 0);
+  Q_ASSERT(mFirstRow <= mLastRow);
+  Q_ASSERT(mFirstColumn >= 0);
+  Q_ASSERT(mFirstColumn <= mLastColumn);
+  Q_ASSERT(!mValue.isNull());
+}
+
+template<typename Visitor>
+bool RangeFormatMap::visitRowOverlaps(int firstRow, int lastRow, Visitor visitor) const
+{
+  /*
+   * Visit, in index order, each item that has a row in range firstRow to lastRow.
+   * Stops, and returns true, as soon as visitor returns true.
+   */
+  struct Node
+  {
+    std::size_t index;
+    int level;
+    bool leftVisited;
+  };
+
+  if(mMaxLevel < 0){
+    return false;
+  }
+  const std::size_t n = mItems.size();
+  // Each level pushes at most 2 nodes
+  Node stack[64];
+  int top = 0;
+  stack[top++] = Node{ (std::size_t(1) << mMaxLevel) - 1, mMaxLevel, false };
+  while(top > 0){
+    const Node node = stack[--top];
+    if(node.level <= 3){
+      // Small subtree: simply check each item in it
+      const std::size_t first = (node.index >> node.level) << node.level;
+      const std::size_t last = std::min( n, first + (std::size_t(1) << (node.level + 1)) - 1 );
+      for(std::size_t i = first; (i < last) && (mItems[i].firstRow() <= lastRow); ++i){
+        if( (mItems[i].lastRow() >= firstRow) && visitor(i) ){
+          return true;
+        }
+      }
+    }else if(!node.leftVisited){
+      // Left child can be out of range, its subtree then still has items
+      const std::size_t left = node.index - (std::size_t(1) << (node.level - 1));
+      stack[top++] = Node{ node.index, node.level, true };
+      if( (left >= n) || (mMaxLastRows[left] >= firstRow) ){
+        stack[top++] = Node{ left, node.level - 1, false };
+      }
+    }else if( (node.index < n) && (mItems[node.index].firstRow() <= lastRow) ){
+      if( (mItems[node.index].lastRow() >= firstRow) && visitor(node.index) ){
+        return true;
+      }
+      stack[top++] = Node{ node.index + (std::size_t(1) << (node.level - 1)), node.level - 1, false };
+    }
+  }
+
+  return false;
+}
+
+void RangeFormatMap::setFormatVariantForRange(int firstRow, int firstColumn, int lastRow, int lastColumn, const QVariant & format)
+{
+  Q_ASSERT(firstRow >= 0);
+  Q_ASSERT(firstRow <= lastRow);
+  Q_ASSERT(firstColumn >= 0);
+  Q_ASSERT(firstColumn <= lastColumn);
+  Q_ASSERT(!format.isNull());
+
+  removeRange(firstRow, firstColumn, lastRow, lastColumn);
+  const auto it = std::upper_bound(mItems.cbegin(), mItems.cend(), firstRow, [](int row, const RangeFormatMapItem & item){
+    return row < item.firstRow();
+  });
+  mItems.emplace(it, firstRow, firstColumn, lastRow, lastColumn, format);
+  buildIndex();
+}
+
+void RangeFormatMap::clearFormatForRange(int firstRow, int firstColumn, int lastRow, int lastColumn)
+{
+  Q_ASSERT(firstRow >= 0);
+  Q_ASSERT(firstRow <= lastRow);
+  Q_ASSERT(firstColumn >= 0);
+  Q_ASSERT(firstColumn <= lastColumn);
+
+  removeRange(firstRow, firstColumn, lastRow, lastColumn);
+  buildIndex();
+}
+
+QVariant RangeFormatMap::formatForIndex(int row, int column) const
+{
+  Q_ASSERT(row >= 0);
+  Q_ASSERT(column >= 0);
+
+  // Ranges never overlap, so at most one contains row and column
+  QVariant format;
+  visitRowOverlaps(row, row, [this, column, &format](std::size_t i){
+    const auto & item = mItems[i];
+    if( (column >= item.firstColumn()) && (column <= item.lastColumn()) ){
+      format = item.value();
+      return true;
+    }
+    return false;
+  });
+
+  return format;
+}
+
+void RangeFormatMap::removeRange(int firstRow, int firstColumn, int lastRow, int lastColumn)
+{
+  // Find the ranges that intersect the removed one, in the order of mItems
+  std::vector<std::size_t> intersecting;
+  visitRowOverlaps(firstRow, lastRow, [this, firstColumn, lastColumn, &intersecting](std::size_t i){
+    const auto & item = mItems[i];
+    if( (item.firstColumn() <= lastColumn) && (item.lastColumn() >= firstColumn) ){
+      intersecting.push_back(i);
+    }
+    return false;
+  });
+  if(intersecting.empty()){
+    return;
+  }
+  Q_ASSERT(std::is_sorted(intersecting.cbegin(), intersecting.cend()));
+  /*
+   * Each range that intersects the removed one
+   * is replaced by the up to 4 parts that are outside of it:
+   * above, below, then left and right of it.
+   */
+  std::vector<RangeFormatMapItem> parts;
+  for(const auto i : intersecting){
+    const auto & item = mItems[i];
+    if(item.firstRow() < firstRow){
+      parts.emplace_back(item.firstRow(), item.firstColumn(), firstRow - 1, item.lastColumn(), item.value());
+    }
+    if(item.lastRow() > lastRow){
+      parts.emplace_back(lastRow + 1, item.firstColumn(), item.lastRow(), item.lastColumn(), item.value());
+    }
+    const int middleFirstRow = qMax(item.firstRow(), firstRow);
+    const int middleLastRow = qMin(item.lastRow(), lastRow);
+    if(item.firstColumn() < firstColumn){
+      parts.emplace_back(middleFirstRow, item.firstColumn(), middleLastRow, firstColumn - 1, item.value());
+    }
+    if(item.lastColumn() > lastColumn){
+      parts.emplace_back(middleFirstRow, lastColumn + 1, middleLastRow, item.lastColumn(), item.value());
+    }
+  }
+  // Remove intersecting ranges in place, keeping the others sorted
+  auto intersectingIt = intersecting.cbegin();
+  std::size_t out = intersecting.front();
+  for(std::size_t i = out; i < mItems.size(); ++i){
+    if( (intersectingIt != intersecting.cend()) && (*intersectingIt == i) ){
+      ++intersectingIt;
+      continue;
+    }
+    mItems[out] = std::move(mItems[i]);
+    ++out;
+  }
+  mItems.erase(mItems.begin() + out, mItems.end());
+  // Merge the parts into the sorted items
+  const auto compare = [](const RangeFormatMapItem & a, const RangeFormatMapItem & b){
+    return a.firstRow() < b.firstRow();
+  };
+  std::sort(parts.begin(), parts.end(), compare);
+  const auto middle = static_cast<std::ptrdiff_t>(mItems.size());
+  mItems.insert(mItems.end(), parts.cbegin(), parts.cend());
+  std::inplace_merge(mItems.begin(), mItems.begin() + middle, mItems.end(), compare);
+}
+
+void RangeFormatMap::buildIndex()
+{
+  /*
+   * Build the implicit interval tree bottom up.
+   * Leaves (level 0) are at even indexes.
+   * Nodes of level k start at index 2^k - 1, with a step of 2^(k+1).
+   * The tree is complete only if the count of items is 2^n - 1,
+   * so a missing right child takes the value of the rightmost existing node.
+   */
+  const std::size_t n = mItems.size();
+  mMaxLastRows.resize(n);
+  mMaxLevel = -1;
+  if(n == 0){
+    return;
+  }
+  std::size_t lastIndex = 0;
+  int lastMax = -1;
+  for(std::size_t i = 0; i < n; i += 2){
+    lastIndex = i;
+    lastMax = mMaxLastRows[i] = mItems[i].lastRow();
+  }
+  int k = 1;
+  for(; (std::size_t(1) << k) <= n; ++k){
+    const std::size_t x = std::size_t(1) << (k-1);
+    for(std::size_t i = (x << 1) - 1; i < n; i += (x << 2)){
+      const int leftMax = mMaxLastRows[i - x];
+      const int rightMax = (i + x < n) ? mMaxLastRows[i + x] : lastMax;
+      mMaxLastRows[i] = std::max( { mItems[i].lastRow(), leftMax, rightMax } );
+    }
+    // lastIndex becomes the parent of itself
+    lastIndex = ( (lastIndex >> k) & 1 ) ? lastIndex - x : lastIndex + x;
+    if( (lastIndex < n) && (mMaxLastRows[lastIndex] > lastMax) ){
+      lastMax = mMaxLastRows[lastIndex];
+    }
+  }
+  mMaxLevel = k - 1;
+}
+
+}} //namespace Mdt{ namespace ItemModel{
@@ -0,0 +1,171 @@
+/****************************************************************************
+ **
+ ** Copyright (C) 2011-2017 Philippe Steinmann.
+ **
+ ** This file is part of multiDiagTools library.
+ **
+ ** multiDiagTools is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Lesser General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** multiDiagTools is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public License
+ ** along with multiDiagTools.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+#ifndef MDT_ITEM_MODEL_RANGE_FORMAT_MAP_H
+#define MDT_ITEM_MODEL_RANGE_FORMAT_MAP_H
+
+#include "MdtItemModelExport.h"
+#include <QVariant>
+#include <QtGlobal>
+#include <vector>
+
+namespace Mdt{ namespace ItemModel{
+
+  /*! \brief Item of a RangeFormatMap
+   */
+  class MDT_ITEMMODEL_EXPORT RangeFormatMapItem
+  {
+   public:
+
+    /*! \brief Construct a item for the rectangle from \a firstRow , \a firstColumn to \a lastRow , \a lastColumn
+     *
+     * \pre \a firstRow must be >= 0 and <= \a lastRow
+     * \pre \a firstColumn must be >= 0 and <= \a lastColumn
+     * \pre \a value must not be null
+     */
+    explicit RangeFormatMapItem(int firstRow, int firstColumn, int lastRow, int lastColumn, const QVariant & value);
+
+    /*! \brief Get first row
+     */
+    int firstRow() const
+    {
+      return mFirstRow;
+    }
+
+    /*! \brief Get first column
+     */
+    int firstColumn() const
+    {
+      return mFirstColumn;
+    }
+
+    /*! \brief Get last row
+     */
+    int lastRow() const
+    {
+      return mLastRow;
+    }
+
+    /*! \brief Get last column
+     */
+    int lastColumn() const
+    {
+      return mLastColumn;
+    }
+
+    /*! \brief Check if this item contains \a row and \a column
+     */
+    bool contains(int row, int column) const
+    {
+      return ( (row >= mFirstRow) && (row <= mLastRow) && (column >= mFirstColumn) && (column <= mLastColumn) );
+    }
+
+    /*! \brief Get value
+     */
+    QVariant value() const
+    {
+      return mValue;
+    }
+
+   private:
+
+    int mFirstRow;
+    int mFirstColumn;
+    int mLastRow;
+    int mLastColumn;
+    QVariant mValue;
+  };
+
+  /*! \brief Stores formats for rectangular ranges of indexes in a item model
+   *
+   * Ranges never overlap: setting a format for a range
+   *  first removes the part of other ranges that it covers,
+   *  so the last format set for a index wins.
+   *
+   * Ranges are kept sorted by their first row, in a array
+   *  that is also a implicit augmented interval tree on the rows
+   *  (the layout used by cgranges):
+   *  the item at index i is a node of level k, k being the count of trailing 1 bits of i,
+   *  and stores the greatest last row of its subtree.
+   *  formatForIndex() only visits the subtrees that can contain a row,
+   *  which is O(log n + m), m being the count of ranges that cross that row.
+   */
+  class MDT_ITEMMODEL_EXPORT RangeFormatMap
+  {
+   public:
+
+    /*! \brief Set format for the rectangle from \a firstRow , \a firstColumn to \a lastRow , \a lastColumn
+     *
+     * \pre \a firstRow must be >= 0 and <= \a lastRow
+     * \pre \a firstColumn must be >= 0 and <= \a lastColumn
+     * \pre \a format must not be null
+     */
+    void setFormatVariantForRange(int firstRow, int firstColumn, int lastRow, int lastColumn, const QVariant & format);
+
+    /*! \brief Clear format for the rectangle from \a firstRow , \a firstColumn to \a lastRow , \a lastColumn
+     *
+     * Ranges that are partially covered keep their format outside of the rectangle.
+     *
+     * \pre \a firstRow must be >= 0 and <= \a lastRow
+     * \pre \a firstColumn must be >= 0 and <= \a lastColumn
+     */
+    void clearFormatForRange(int firstRow, int firstColumn, int lastRow, int lastColumn);
+
+    /*! \brief Get format for given row and column
+     *
+     * Returns a QVariant with value of type passed in setFormatVariantForRange()
+     *  if a range containing \a row and \a column has a format,
+     *  otherwise a null QVariant.
+     *
+     * \pre \a row must be >= 0
+     * \pre \a column must be >= 0
+     */
+    QVariant formatForIndex(int row, int column) const;
+
+    /*! \brief Check if no format was set
+     */
+    bool isEmpty() const
+    {
+      return mItems.empty();
+    }
+
+    /*! \brief Get count of stored ranges
+     */
+    int rangeCount() const
+    {
+      return mItems.size();
+    }
+
+   private:
+
+    void removeRange(int firstRow, int firstColumn, int lastRow, int lastColumn);
+    void buildIndex();
+    template<typename Visitor>
+    bool visitRowOverlaps(int firstRow, int lastRow, Visitor visitor) const;
+
+    std::vector<RangeFormatMapItem> mItems;
+    // Greatest last row of the subtree of each item
+    std::vector<int> mMaxLastRows;
+    int mMaxLevel = -1;
+  };
+
+}} //namespace Mdt{ namespace ItemModel{
+
+#endif // #ifndef MDT_ITEM_MODEL_RANGE_FORMAT_MAP_H
@@ -22,8 +22,12 @@
 #include "RelationKeyCopier.h"
 #include "RowRange.h"
 #include "ColumnRange.h"
+#include "ColumnList.h"
+#include "RelationColumnPair.h"
+#include "TableModelSnapshot.h"
 #include "Expression/ParentModelEvalData.h"
 #include <algorithm>
+#include <memory>
 
 // #include <QDebug>
 
@@ -54,7 +58,7 @@ void RelationFilterProxyModel::setParentModel(QAbstractItemModel *model)
 //   mParentModelRow = -1;
   setParentModelMatchRow(mParentModelRow);
   mKeyCopier->setParentModel(model);
-  invalidateFilter();
+  applyFilter();
 }
 
 void RelationFilterProxyModel::setFilter(const RelationFilterExpression & expression)
@@ -63,7 +67,9 @@ void RelationFilterProxyModel::setFilter(const RelationFilterExpression & expres
 
   mFilterExpression = expression;
   mKeyCopier->setKey(expression.getRelationKeyForEquality());
-  invalidateFilter();
+  mFilterIsRelationKey = false;
+  mForeignKeyIndex.setColumnList(ColumnList());
+  applyFilter();
 }
 
 void RelationFilterProxyModel::setFilter(const RelationKey & relationKey)
@@ -73,7 +79,13 @@ void RelationFilterProxyModel::setFilter(const RelationKey & relationKey)
 
   mFilterExpression = RelationFilterExpression::fromRelationKey(relationKey);
   mKeyCopier->setKey(relationKey);
-  invalidateFilter();
+  mFilterIsRelationKey = true;
+  ColumnList childModelColumns;
+  for(const auto & columnPair : relationKey){
+    childModelColumns.append(columnPair.childModelColumn());
+  }
+  mForeignKeyIndex.setColumnList(childModelColumns);
+  applyFilter();
 }
 
 void RelationFilterProxyModel::setFilter(const PrimaryKey & parentModelPk, const ForeignKey & childModelFk)
@@ -93,6 +105,14 @@ RelationKey RelationFilterProxyModel::relationKeyForEquality() const
   return mKeyCopier->key();
 }
 
+void RelationFilterProxyModel::setForeignKeyIndexEnabled(bool enable)
+{
+  mForeignKeyIndexEnabled = enable;
+  if(!enable){
+    mForeignKeyIndex.clear();
+  }
+}
+
 void RelationFilterProxyModel::setDynamicSortFilter(bool enable)
 {
   SortFilterProxyModel::setDynamicSortFilter(enable);
@@ -140,7 +160,7 @@ void RelationFilterProxyModel::setParentModelMatchRow(int row)
   }
 //   qDebug() << "RFPM::setParentModelMatchRow() - row set to " << mParentModelRow;
   mKeyCopier->setParentModelCurrentRow(mParentModelRow);
-  invalidateFilter();
+  applyFilter();
 }
 
 void RelationFilterProxyModel::onSourceModelChanged()
@@ -148,12 +168,32 @@ void RelationFilterProxyModel::onSourceModelChanged()
   auto *model = sourceModel();
   Q_ASSERT(model != nullptr);
   disconnect(mRowsInsertedConnection);
+  for(const auto & connection : mSourceModelIndexConnections){
+    disconnect(connection);
+  }
+  mSourceModelIndexConnections.clear();
+  mForeignKeyIndex.clear();
   mKeyCopier->setChildModel(model);
   mRowsInsertedConnection = connect(model, &QAbstractItemModel::rowsInserted, this, &RelationFilterProxyModel::onRowsInserted);
+  mSourceModelIndexConnections.append( connect(model, &QAbstractItemModel::rowsRemoved, this, &RelationFilterProxyModel::onSourceRowsRemoved) );
+  mSourceModelIndexConnections.append( connect(model, &QAbstractItemModel::dataChanged, this, &RelationFilterProxyModel::onSourceModelDataChanged) );
+  mSourceModelIndexConnections.append( connect(model, &QAbstractItemModel::rowsMoved, this, &RelationFilterProxyModel::onSourceModelStructureChanged) );
+  mSourceModelIndexConnections.append( connect(model, &QAbstractItemModel::columnsInserted, this, &RelationFilterProxyModel::onSourceModelStructureChanged) );
+  mSourceModelIndexConnections.append( connect(model, &QAbstractItemModel::columnsRemoved, this, &RelationFilterProxyModel::onSourceModelStructureChanged) );
+  mSourceModelIndexConnections.append( connect(model, &QAbstractItemModel::columnsMoved, this, &RelationFilterProxyModel::onSourceModelStructureChanged) );
+  mSourceModelIndexConnections.append( connect(model, &QAbstractItemModel::layoutChanged, this, &RelationFilterProxyModel::onSourceModelStructureChanged) );
+  mSourceModelIndexConnections.append( connect(model, &QAbstractItemModel::modelReset, this, &RelationFilterProxyModel::onSourceModelStructureChanged) );
 }
 
 void RelationFilterProxyModel::onRowsInserted(const QModelIndex& parent, int first, int last)
 {
+  /*
+   * Update the index before copying key data,
+   * because copying will emit dataChanged()
+   */
+  if( (!parent.isValid()) && mForeignKeyIndex.isBuilt() ){
+    mForeignKeyIndex.insertRows(sourceModel(), first, last);
+  }
   if(!mInserting){
     return;
   }
@@ -163,6 +203,32 @@ void RelationFilterProxyModel::onRowsInserted(const QModelIndex& parent, int fir
   mKeyCopier->copyAllKeyData(r, parent);
 }
 
+void RelationFilterProxyModel::onSourceRowsRemoved(const QModelIndex & parent, int first, int last)
+{
+  if( (!parent.isValid()) && mForeignKeyIndex.isBuilt() ){
+    mForeignKeyIndex.removeRows(first, last);
+  }
+}
+
+void RelationFilterProxyModel::onSourceModelDataChanged(const QModelIndex & topLeft, const QModelIndex & bottomRight)
+{
+  if( (!mForeignKeyIndex.isBuilt()) || topLeft.parent().isValid() ){
+    return;
+  }
+  const auto columnList = mForeignKeyIndex.columnList();
+  const bool keyChanged = std::any_of(columnList.cbegin(), columnList.cend(), [&topLeft, &bottomRight](int column){
+    return (column >= topLeft.column()) && (column <= bottomRight.column());
+  });
+  if(keyChanged){
+    mForeignKeyIndex.updateRows(sourceModel(), topLeft.row(), bottomRight.row());
+  }
+}
+
+void RelationFilterProxyModel::onSourceModelStructureChanged()
+{
+  mForeignKeyIndex.clear();
+}
+
 void RelationFilterProxyModel::onParentModelDataChanged(const QModelIndex& topLeft, const QModelIndex& bottomRight, const QVector<int> & roles)
 {
   if( (!roles.isEmpty()) && (!roles.contains(Qt::EditRole)) && (!roles.contains(Qt::DisplayRole)) ){
@@ -182,7 +248,66 @@ void RelationFilterProxyModel::onParentModelDataChanged(const QModelIndex& topLe
   c.setFirstIndex(topLeft);
   c.setLastIndex(bottomRight);
   mKeyCopier->copyKeyData( getCurrentSourceModelRowList(), c );
-  invalidateFilter();
+  applyFilter();
+}
+
+void RelationFilterProxyModel::applyFilter()
+{
+  if( (mParentModelRow < 0) || mParentModel.isNull() || (sourceModel() == nullptr) || mFilterExpression.isNull() ){
+    invalidateFilterWithoutResult();
+    return;
+  }
+  if( (sourceModel()->columnCount() < (mFilterExpression.greatestColumn()+1))
+   || (mParentModel->columnCount() < (mFilterExpression.greatestParentModelColumn()+1)) )
+  {
+    invalidateFilterWithoutResult();
+    return;
+  }
+  if(mForeignKeyIndexEnabled && mFilterIsRelationKey){
+    applyFilterWithForeignKeyIndex();
+    return;
+  }
+  /*
+   * Worker threads may not access the parent model,
+   * so the parent model row is also copied to a snapshot.
+   */
+  const auto parentSnapshot = std::make_shared<const TableModelSnapshot>(mParentModel, mParentModelRow, 1, mFilterExpression.greatestParentModelColumn()+1);
+  const auto expression = mFilterExpression;
+  const auto caseSensitivity = filterCaseSensitivity();
+  const auto filter = [parentSnapshot, expression, caseSensitivity](const TableModelSnapshot & snapshot, int row){
+    return expression.eval(&snapshot, row, ParentModelEvalData(parentSnapshot.get(), 0), caseSensitivity);
+  };
+  invalidateFilterInParallel(mFilterExpression.greatestColumn()+1, filter);
+}
+
+void RelationFilterProxyModel::applyFilterWithForeignKeyIndex()
+{
+  auto *model = sourceModel();
+  Q_ASSERT(model != nullptr);
+  Q_ASSERT(!mParentModel.isNull());
+  Q_ASSERT(mParentModelRow >= 0);
+
+  if( (!mForeignKeyIndex.isBuilt()) || (mForeignKeyIndex.rowCount() != model->rowCount()) ){
+    mForeignKeyIndex.build(model);
+  }
+  ColumnList parentModelColumns;
+  for(const auto & columnPair : mKeyCopier->key()){
+    parentModelColumns.append(columnPair.parentModelColumn());
+  }
+  const auto rows = mForeignKeyIndex.findRows( ForeignKeyRowIndex::keyForRow(mParentModel, mParentModelRow, parentModelColumns) );
+  /*
+   * Rows found by the index are candidates,
+   * the filter expression has the last word.
+   */
+  QVector<char> result(model->rowCount(), 0);
+  const ParentModelEvalData parentModelData(mParentModel, mParentModelRow);
+  const auto caseSensitivity = filterCaseSensitivity();
+  for(const int row : rows){
+    if(mFilterExpression.eval(model, row, parentModelData, caseSensitivity)){
+      result[row] = 1;
+    }
+  }
+  invalidateFilterWithResult(result);
 }
 
 bool RelationFilterProxyModel::filterAcceptsRow(int source_row, const QModelIndex & source_parent) const
@@ -193,6 +318,9 @@ bool RelationFilterProxyModel::filterAcceptsRow(int source_row, const QModelInde
   if(source_parent.isValid()){
     return false;
   }
+  if(hasFilterResult()){
+    return filterResultAcceptsRow(source_row);
+  }
   Q_ASSERT(!mParentModel.isNull());
   Q_ASSERT(sourceModel() != nullptr);
   Q_ASSERT(mParentModelRow >= 0);
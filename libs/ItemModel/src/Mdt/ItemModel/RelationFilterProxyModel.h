@@ -30,6 +30,7 @@
 #include "RelationKey.h"
 #include "PrimaryKey.h"
 #include "ForeignKey.h"
+#include "ForeignKeyRowIndex.h"
 #include "MdtItemModelExport.h"
 #include <QPointer>
 #include <QModelIndex>
@@ -67,6 +68,21 @@ namespace Mdt{ namespace ItemModel{
    * proxyModel->setFilter( addressClientId == cliendId );
    * proxyModel->setParentModelMatchRow(0);
    * \endcode
+   *
+   * \section foreign_key_index Foreign key index
+   *
+   * Each time the parent model match row changes,
+   *  the filter must be evaluated for each row of the child model.
+   *  For a big child model, a hash index from the foreign key values
+   *  to the child model rows can be used (see setForeignKeyIndexEnabled()).
+   *  Then, only the child model rows that refer to the parent model match row are evaluated.
+   *
+   * The index is only used if the filter was set with a RelationKey,
+   *  or a PrimaryKey and ForeignKey pair (see setFilter()).
+   *  It is updated when rows are inserted, removed or when data changes
+   *  in the child model, and built again for other changes.
+   *  Like ForeignKeyRowIndex, the index assumes that equal key values
+   *  have the same string representation.
    */
   class MDT_ITEMMODEL_EXPORT RelationFilterProxyModel : public SortFilterProxyModel
   {
@@ -142,6 +158,21 @@ namespace Mdt{ namespace ItemModel{
      */
     RelationKey relationKeyForEquality() const;
 
+    /*! \brief Enable or disable the foreign key index
+     *
+     * Foreign key index is disabled by default.
+     *
+     * \sa \ref foreign_key_index
+     */
+    void setForeignKeyIndexEnabled(bool enable);
+
+    /*! \brief Check if foreign key index is enabled
+     */
+    bool isForeignKeyIndexEnabled() const
+    {
+      return mForeignKeyIndexEnabled;
+    }
+
     /*! \brief Get row of parent model for which filter must match
      */
     int parentModelMatchRow() const
@@ -183,23 +214,49 @@ namespace Mdt{ namespace ItemModel{
      */
     void onRowsInserted(const QModelIndex & parent, int first, int last);
 
+    /*! \brief Actions to perform when rows have been removed from source model
+     */
+    void onSourceRowsRemoved(const QModelIndex & parent, int first, int last);
+
+    /*! \brief Actions to perform when source model data changed
+     */
+    void onSourceModelDataChanged(const QModelIndex & topLeft, const QModelIndex & bottomRight);
+
+    /*! \brief Actions to perform when the structure of source model changed
+     *
+     * Clears the foreign key index, that will be built again by the next filter application
+     */
+    void onSourceModelStructureChanged();
+
     /*! \brief Actions to perform when parent model data changed
      */
     void onParentModelDataChanged(const QModelIndex & topLeft, const QModelIndex & bottomRight, const QVector<int> & roles = QVector<int>());
 
    private:
 
+    /*! \brief Invalidate filter, evaluating it in parallel if possible
+     */
+    void applyFilter();
+
+    /*! \brief Invalidate filter, using the foreign key index
+     */
+    void applyFilterWithForeignKeyIndex();
+
     /*! \brief Return true if filter expression was set and evaluates true
      */
     bool filterAcceptsRow(int source_row, const QModelIndex& source_parent) const override;
 
     int mParentModelRow = -1;
     bool mInserting = false;
+    bool mForeignKeyIndexEnabled = false;
+    bool mFilterIsRelationKey = false;
     QPointer<QAbstractItemModel> mParentModel;
     RelationFilterExpression mFilterExpression;
     std::unique_ptr<RelationKeyCopier> mKeyCopier;
+    ForeignKeyRowIndex mForeignKeyIndex;
     QMetaObject::Connection mRowsInsertedConnection;
     QMetaObject::Connection mParentModelDataChangedConnection;
+    QVector<QMetaObject::Connection> mSourceModelIndexConnections;
   };
 
 }} // namespace Mdt{ namespace ItemModel{
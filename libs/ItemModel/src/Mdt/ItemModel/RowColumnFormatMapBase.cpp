@@ -29,9 +29,9 @@ void RowColumnFormatMapBase::setFormatVariantForIndex(int index, const QVariant
 {
   Q_ASSERT(index >= 0);
 
-  auto it = iteratorForIndexW(index);
-  if(it == mItems.end()){
-    mItems.emplace_back(index, format);
+  auto it = lowerBoundW(index);
+  if( (it == mItems.end()) || (it->index() != index) ){
+    mItems.emplace(it, index, format);
   }else{
     *it = RowOrColumnFormatMapItem(index, format);
   }
@@ -41,8 +41,8 @@ void RowColumnFormatMapBase::clearFormatForIndex(int index)
 {
   Q_ASSERT(index >= 0);
 
-  const auto it = iteratorForIndex(index);
-  if(it != mItems.cend()){
+  const auto it = lowerBound(index);
+  if( (it != mItems.cend()) && (it->index() == index) ){
     mItems.erase(it);
   }
 }
@@ -51,46 +51,32 @@ QVariant RowColumnFormatMapBase::formatForIndex(int index) const
 {
   Q_ASSERT(index >= 0);
 
-  const auto it = iteratorForIndex(index);
-  if(it != mItems.cend()){
+  const auto it = lowerBound(index);
+  if( (it != mItems.cend()) && (it->index() == index) ){
     return it->value();
   }
 
   return QVariant();
 }
 
-RowColumnFormatMapBase::const_iterator RowColumnFormatMapBase::iteratorForIndex(int column) const
+RowColumnFormatMapBase::const_iterator RowColumnFormatMapBase::lowerBound(int index) const
 {
-  Q_ASSERT(column >= 0);
+  Q_ASSERT(index >= 0);
 
-  const auto pred = [column](const RowOrColumnFormatMapItem & item){
-    return item.index() == column;
+  const auto indexLessThan = [](const RowOrColumnFormatMapItem & item, int i){
+    return item.index() < i;
   };
-  return std::find_if(mItems.cbegin(), mItems.cend(), pred);
+  return std::lower_bound(mItems.cbegin(), mItems.cend(), index, indexLessThan);
 }
 
-RowColumnFormatMapBase::iterator RowColumnFormatMapBase::iteratorForIndexW(int column)
+RowColumnFormatMapBase::iterator RowColumnFormatMapBase::lowerBoundW(int index)
 {
-  Q_ASSERT(column >= 0);
+  Q_ASSERT(index >= 0);
 
-  const auto pred = [column](const RowOrColumnFormatMapItem & item){
-    return item.index() == column;
+  const auto indexLessThan = [](const RowOrColumnFormatMapItem & item, int i){
+    return item.index() < i;
   };
-  return std::find_if(mItems.begin(), mItems.end(), pred);
+  return std::lower_bound(mItems.begin(), mItems.end(), index, indexLessThan);
 }
 
-// int RowColumnFormatMapBase::itemIndexForColumn(int column) const
-// {
-//   Q_ASSERT(column >= 0);
-// 
-//   const auto it = iteratorForColumn(column);
-//   if(it == mItems.cend()){
-//     return -1;
-//   }
-//   Q_ASSERT((it - mItems.cbegin()) >= 0);
-//   Q_ASSERT((it - mItems.cbegin()) < (int)mItems.size());
-// 
-//   return it - mItems.cbegin();
-// }
-
 }} // namespace Mdt{ namespace ItemModel{
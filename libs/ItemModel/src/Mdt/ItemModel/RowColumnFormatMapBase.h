@@ -30,6 +30,9 @@
 namespace Mdt{ namespace ItemModel{
 
   /*! \brief Base class for RowFormatMap and ColumnFormatMap
+   *
+   * Items are kept sorted by index,
+   *  so formatForIndex() is a binary search.
    */
   class MDT_ITEMMODEL_EXPORT RowColumnFormatMapBase
   {
@@ -59,16 +62,23 @@ namespace Mdt{ namespace ItemModel{
      */
     QVariant formatForIndex(int index) const;
 
+    /*! \brief Check if no format was set
+     */
+    bool isEmpty() const
+    {
+      return mItems.empty();
+    }
+
    private:
 
     using iterator = std::vector<RowOrColumnFormatMapItem>::iterator;
     using const_iterator = std::vector<RowOrColumnFormatMapItem>::const_iterator;
 
-    const_iterator iteratorForIndex(int column) const;
-    iterator iteratorForIndexW(int column);
+    /*! \brief Get iterator to the first item that has a index >= \a index
+     */
+    const_iterator lowerBound(int index) const;
+    iterator lowerBoundW(int index);
 
-//     int itemIndexForColumn(int column) const;
-  
     std::vector<RowOrColumnFormatMapItem> mItems;
   };
 
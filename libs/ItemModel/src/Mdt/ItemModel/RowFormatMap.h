@@ -67,6 +67,13 @@ namespace Mdt{ namespace ItemModel{
       return mBase.formatForIndex(row);
     }
 
+    /*! \brief Check if no format was set
+     */
+    bool isEmpty() const
+    {
+      return mBase.isEmpty();
+    }
+
    private:
 
     RowColumnFormatMapBase mBase;
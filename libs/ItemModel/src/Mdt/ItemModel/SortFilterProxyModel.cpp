@@ -19,6 +19,9 @@
  **
  ****************************************************************************/
 #include "SortFilterProxyModel.h"
+#include "TableModelSnapshot.h"
+#include "ParallelStableSort.h"
+#include <QThreadPool>
 
 // #include <QDebug>
 
@@ -43,4 +46,110 @@ bool SortFilterProxyModel::insertRows(int row, int count, const QModelIndex& par
   return sourceModel()->insertRows(sourceModel()->rowCount(parent), count, parent);
 }
 
+void SortFilterProxyModel::setSourceModel(QAbstractItemModel* model)
+{
+  /*
+   * The filter result must be dropped before QSortFilterProxyModel
+   * handles a change of the source model (it could call filterAcceptsRow()).
+   * Because slots are called in the order they have been connected,
+   * we connect before QSortFilterProxyModel does.
+   */
+  for(const auto & connection : mSourceModelConnections){
+    disconnect(connection);
+  }
+  mSourceModelConnections.clear();
+  clearFilterResult();
+  if(model != nullptr){
+    const auto clearResult = [this](){
+      clearFilterResult();
+    };
+    mSourceModelConnections.append( connect(model, &QAbstractItemModel::dataChanged, this, clearResult) );
+    mSourceModelConnections.append( connect(model, &QAbstractItemModel::rowsAboutToBeInserted, this, clearResult) );
+    mSourceModelConnections.append( connect(model, &QAbstractItemModel::rowsAboutToBeRemoved, this, clearResult) );
+    mSourceModelConnections.append( connect(model, &QAbstractItemModel::rowsAboutToBeMoved, this, clearResult) );
+    mSourceModelConnections.append( connect(model, &QAbstractItemModel::columnsAboutToBeInserted, this, clearResult) );
+    mSourceModelConnections.append( connect(model, &QAbstractItemModel::columnsAboutToBeRemoved, this, clearResult) );
+    mSourceModelConnections.append( connect(model, &QAbstractItemModel::columnsAboutToBeMoved, this, clearResult) );
+    mSourceModelConnections.append( connect(model, &QAbstractItemModel::layoutAboutToBeChanged, this, clearResult) );
+    mSourceModelConnections.append( connect(model, &QAbstractItemModel::modelAboutToBeReset, this, clearResult) );
+  }
+  QSortFilterProxyModel::setSourceModel(model);
+}
+
+void SortFilterProxyModel::setParallelFilterEnabled(bool enable)
+{
+  mParallelFilterEnabled = enable;
+  if(!enable){
+    clearFilterResult();
+  }
+}
+
+void SortFilterProxyModel::setParallelFilterThreshold(int rowCount)
+{
+  Q_ASSERT(rowCount >= 0);
+
+  mParallelFilterThreshold = rowCount;
+}
+
+void SortFilterProxyModel::invalidateFilterInParallel(int columnCount, const SnapshotRowFilter & filter)
+{
+  Q_ASSERT(columnCount >= 0);
+
+  clearFilterResult();
+  const auto *model = sourceModel();
+  if( (!mParallelFilterEnabled) || (model == nullptr) || (model->rowCount() < mParallelFilterThreshold) ){
+    invalidateFilter();
+    return;
+  }
+  /*
+   * Take the snapshot in this thread, then evaluate it in the thread pool.
+   * This thread evaluates the first range of rows itself.
+   */
+  const int rowCount = model->rowCount();
+  const TableModelSnapshot snapshot(model, 0, rowCount, qMin(columnCount, model->columnCount()));
+  mFilterResult.resize(rowCount);
+  char *result = mFilterResult.data();
+  auto *pool = QThreadPool::globalInstance();
+  const int taskCount = qMax( 1, qMin(pool->maxThreadCount(), rowCount) );
+  const int rowsPerTask = (rowCount + taskCount - 1) / taskCount;
+  Impl::runInParallel(taskCount, [&snapshot, &filter, result, rowsPerTask, rowCount](int task){
+    const int firstRow = task * rowsPerTask;
+    const int lastRow = qMin(firstRow + rowsPerTask, rowCount);
+    for(int row = firstRow; row < lastRow; ++row){
+      result[row] = filter(snapshot, row) ? 1 : 0;
+    }
+  }, pool);
+  mFilterResultCaseSensitivity = filterCaseSensitivity();
+  mHasFilterResult = true;
+  invalidateFilter();
+}
+
+void SortFilterProxyModel::invalidateFilterWithResult(const QVector<char> & result)
+{
+  Q_ASSERT(sourceModel() != nullptr);
+  Q_ASSERT(result.size() == sourceModel()->rowCount());
+
+  mFilterResult = result;
+  mFilterResultCaseSensitivity = filterCaseSensitivity();
+  mHasFilterResult = true;
+  invalidateFilter();
+}
+
+void SortFilterProxyModel::invalidateFilterWithoutResult()
+{
+  clearFilterResult();
+  invalidateFilter();
+}
+
+bool SortFilterProxyModel::hasFilterResult() const
+{
+  return mHasFilterResult && (mFilterResultCaseSensitivity == filterCaseSensitivity());
+}
+
+void SortFilterProxyModel::clearFilterResult()
+{
+  mHasFilterResult = false;
+  mFilterResult.clear();
+}
+
 }} // namespace Mdt{ namespace ItemModel{
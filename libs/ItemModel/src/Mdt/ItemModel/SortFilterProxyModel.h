@@ -23,10 +23,30 @@
 
 #include "MdtItemModelExport.h"
 #include <QSortFilterProxyModel>
+#include <QVector>
+#include <QMetaObject>
+#include <functional>
 
 namespace Mdt{ namespace ItemModel{
 
+  class TableModelSnapshot;
+
   /*! \brief Common base class for proxy models that do sorting or filtering
+   *
+   * \section parallel_filter Parallel filter
+   *
+   * With a big source model, evaluating a filter for each row,
+   *  like QSortFilterProxyModel does, can block the user interface.
+   *  When parallel filter is enabled (see setParallelFilterEnabled()),
+   *  a derived class can use invalidateFilterInParallel() :
+   *  a read-only snapshot of the source model is taken (see TableModelSnapshot),
+   *  then the filter is evaluated for all rows in a thread pool,
+   *  the calling thread waiting until all rows are done.
+   *  The result is a accept bitmap, that filterAcceptsRow() only has to read
+   *  (see hasFilterResult() and filterResultAcceptsRow()).
+   *
+   * The result is dropped as soon as the source model changes,
+   *  in which case filterAcceptsRow() must evaluate the filter itself.
    */
   class MDT_ITEMMODEL_EXPORT SortFilterProxyModel : public QSortFilterProxyModel
   {
@@ -48,6 +68,117 @@ namespace Mdt{ namespace ItemModel{
     /*! \brief Reimplemented from QSortFilterProxyModel
      */
     bool insertRows(int row, int count, const QModelIndex & parent = QModelIndex()) override;
+
+    /*! \brief Reimplemented from QSortFilterProxyModel
+     */
+    void setSourceModel(QAbstractItemModel *model) override;
+
+    /*! \brief Enable or disable parallel filter
+     *
+     * Parallel filter is disabled by default.
+     *  Changing this does not filter again.
+     *
+     * \sa \ref parallel_filter
+     */
+    void setParallelFilterEnabled(bool enable);
+
+    /*! \brief Check if parallel filter is enabled
+     */
+    bool isParallelFilterEnabled() const
+    {
+      return mParallelFilterEnabled;
+    }
+
+    /*! \brief Set the minimum count of source model rows to filter in parallel
+     *
+     * For small models, the cost of the snapshot and of the threads
+     *  is greater than the gain, so they are filtered row by row.
+     *  The default threshold is 10000 rows.
+     *
+     * \pre \a rowCount must be >= 0
+     */
+    void setParallelFilterThreshold(int rowCount);
+
+    /*! \brief Get the minimum count of source model rows to filter in parallel
+     */
+    int parallelFilterThreshold() const
+    {
+      return mParallelFilterThreshold;
+    }
+
+   protected:
+
+    /*! \brief Function that evaluates if a row of a snapshot is accepted
+     *
+     * Will be called from multiple threads at the same time.
+     */
+    using SnapshotRowFilter = std::function<bool(const TableModelSnapshot & snapshot, int row)>;
+
+    /*! \brief Evaluate the filter in parallel, then invalidate the filter
+     *
+     * If parallel filter is enabled, and the source model has at least
+     *  parallelFilterThreshold() rows, a snapshot of the first \a columnCount columns
+     *  of the source model is taken,
+     *  and \a filter is called for each row of this snapshot, in a thread pool.
+     *  Else, the filter is simply invalidated.
+     *
+     * This call is synchronous: it returns once all rows have been evaluated.
+     *  The snapshot is taken in the calling thread (model data is read there),
+     *  and the calling thread also evaluates a part of the rows,
+     *  so the user interface stays blocked for the duration of the call.
+     *  The gain is that evaluating the filter is spread over all threads of the pool.
+     *
+     * \pre \a columnCount must be >= 0
+     */
+    void invalidateFilterInParallel(int columnCount, const SnapshotRowFilter & filter);
+
+    /*! \brief Set a filter result, then invalidate the filter
+     *
+     * Can be used by a derived class that evaluated the filter
+     *  by other means, for example using an index.
+     *  \a result must contain a non zero value for each accepted row.
+     *
+     * \pre \a result must have one element for each row of the source model
+     */
+    void invalidateFilterWithResult(const QVector<char> & result);
+
+    /*! \brief Drop the filter result, then invalidate the filter
+     */
+    void invalidateFilterWithoutResult();
+
+    /*! \brief Check if a filter result is available
+     *
+     * A filter result is available after invalidateFilterInParallel()
+     *  evaluated the filter in parallel, or after invalidateFilterWithResult().
+     *  It is dropped when the source model changes,
+     *  or when the filter case sensitivity changed since it was evaluated.
+     */
+    bool hasFilterResult() const;
+
+    /*! \brief Get the filter result for \a sourceRow
+     *
+     * \pre hasFilterResult() must be true
+     * \pre \a sourceRow must be in valid range ( 0 <= \a sourceRow < sourceModel()->rowCount() )
+     */
+    bool filterResultAcceptsRow(int sourceRow) const
+    {
+      Q_ASSERT(hasFilterResult());
+      Q_ASSERT(sourceRow >= 0);
+      Q_ASSERT(sourceRow < mFilterResult.size());
+
+      return mFilterResult.at(sourceRow) != 0;
+    }
+
+   private:
+
+    void clearFilterResult();
+
+    bool mParallelFilterEnabled = false;
+    bool mHasFilterResult = false;
+    int mParallelFilterThreshold = 10000;
+    Qt::CaseSensitivity mFilterResultCaseSensitivity = Qt::CaseSensitive;
+    QVector<char> mFilterResult;
+    QVector<QMetaObject::Connection> mSourceModelConnections;
   };
 
 }} // namespace Mdt{ namespace ItemModel{
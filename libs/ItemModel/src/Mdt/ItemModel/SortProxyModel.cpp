@@ -20,15 +20,163 @@
  ****************************************************************************/
 #include "SortProxyModel.h"
 #include "ColumnSortOrder.h"
+#include "ParallelStableSort.h"
 #include <algorithm>
+#include <numeric>
+#include <vector>
 #include <QVariant>
 #include <QCollator>
 #include <QLocale>
+#include <QTimer>
+#include <iterator>
 
 // #include <QDebug>
 
 namespace Mdt{ namespace ItemModel{
 
+namespace{
+
+  /*
+   * Values of a column of the source model, in a contiguous typed array,
+   * compared like SortProxyModel::lessThanInColumn() does
+   */
+  class SortColumnValues
+  {
+   public:
+
+    explicit SortColumnValues(bool reverse)
+     : mReverse(reverse)
+    {
+    }
+
+    /*
+     * Fetch values of column.
+     * Returns false if a type is not supported,
+     * or if not all values have the same type
+     * (QSortFilterProxyModel::lessThan() then converts them regarding the left value)
+     */
+    bool fetch(const QAbstractItemModel & model, int column, int role, bool useCollator, const QCollator & collator, Qt::CaseSensitivity caseSensitivity)
+    {
+      const int n = model.rowCount();
+      if(n < 1){
+        return false;
+      }
+      const int userType = model.index(0, column).data(role).userType();
+      switch(userType){
+        case QMetaType::Int:
+        case QMetaType::UInt:
+        case QMetaType::LongLong:
+          mType = Integer;
+          mIntegers.reserve(n);
+          break;
+        case QMetaType::Double:
+        case QMetaType::Float:
+          mType = Real;
+          mReals.reserve(n);
+          break;
+        case QMetaType::QString:
+          mType = useCollator ? CollatorKey : String;
+          break;
+        default:
+          return false;
+      }
+      mCaseSensitivity = caseSensitivity;
+      for(int row = 0; row < n; ++row){
+        const auto data = model.index(row, column).data(role);
+        if(data.userType() != userType){
+          return false;
+        }
+        switch(mType){
+          case Integer:
+            mIntegers.push_back(data.toLongLong());
+            break;
+          case Real:
+            mReals.push_back(data.toDouble());
+            break;
+          case String:
+            mStrings.push_back(data.toString());
+            break;
+          case CollatorKey:
+            mKeys.push_back(collator.sortKey(data.toString()));
+            break;
+        }
+      }
+      return true;
+    }
+
+    /*
+     * Returns -1 if row a must be placed before row b,
+     * 1 if it must be placed after, 0 if they are equivalent
+     */
+    int compare(int a, int b) const
+    {
+      int result = 0;
+      switch(mType){
+        case Integer:
+          result = (mIntegers[a] < mIntegers[b]) ? -1 : ( (mIntegers[b] < mIntegers[a]) ? 1 : 0 );
+          break;
+        case Real:
+          result = (mReals[a] < mReals[b]) ? -1 : ( (mReals[b] < mReals[a]) ? 1 : 0 );
+          break;
+        case String:
+          result = QString::compare(mStrings[a], mStrings[b], mCaseSensitivity);
+          break;
+        case CollatorKey:
+          result = mKeys[a].compare(mKeys[b]);
+          break;
+      }
+      return mReverse ? -result : result;
+    }
+
+   private:
+
+    enum Type
+    {
+      Integer,
+      Real,
+      String,
+      CollatorKey
+    };
+
+    Type mType = Integer;
+    bool mReverse;
+    Qt::CaseSensitivity mCaseSensitivity = Qt::CaseSensitive;
+    std::vector<qint64> mIntegers;
+    std::vector<double> mReals;
+    std::vector<QString> mStrings;
+    std::vector<QCollatorSortKey> mKeys;
+  };
+
+  /*
+   * Compares rows regarding each column, like SortProxyModel::lessThanInSortOrder() does
+   */
+  class SortRowLessThan
+  {
+   public:
+
+    explicit SortRowLessThan(const std::vector<SortColumnValues> & columns)
+     : mColumns(columns)
+    {
+    }
+
+    bool operator()(int a, int b) const
+    {
+      for(const auto & column : mColumns){
+        const int result = column.compare(a, b);
+        if(result != 0){
+          return (result < 0);
+        }
+      }
+      return false;
+    }
+
+   private:
+
+    const std::vector<SortColumnValues> & mColumns;
+  };
+
+} // namespace{
+
 SortProxyModel::SortProxyModel(QObject* parent)
  : QSortFilterProxyModel(parent)
 {
@@ -38,6 +186,7 @@ void SortProxyModel::addColumnToSortOrder(int column, Qt::SortOrder sortOrder)
 {
   Q_ASSERT(column >= 0);
 
+  mSortRanks.clear();
   mColumnSortOrderList.addColumn(column, sortOrder);
 }
 
@@ -51,6 +200,7 @@ void SortProxyModel::addColumnToSortOrder(int column, StringNumericMode numericM
 
 void SortProxyModel::clearColumnsSortOrder()
 {
+  mSortRanks.clear();
   mColumnSortOrderList.clear();
 }
 
@@ -58,11 +208,13 @@ void SortProxyModel::setColumnStringSortAttributes(int column, StringNumericMode
 {
   Q_ASSERT(column >= 0);
 
+  mSortRanks.clear();
   mColumnSortStringAttributesList.setColumn(column, caseSensitivity, numericMode == StringNumericMode::Natural);
 }
 
 void SortProxyModel::clearColumnsStringSortAttributes()
 {
+  mSortRanks.clear();
   mColumnSortStringAttributesList.clear();
 }
 
@@ -70,18 +222,56 @@ void SortProxyModel::sort(int column, Qt::SortOrder order)
 {
   Q_ASSERT(column >= -1);
 
+  mIsSortedInSinglePass = false;
+  if(column >= 0){
+    prepareParallelSort({ColumnSortOrder(column, order)}, order);
+  }else{
+    mSortRanks.clear();
+  }
   QSortFilterProxyModel::sort(column, order);
   emit columnSorted(column);
 }
 
 void SortProxyModel::sort()
 {
+  mIsSortScheduled = false;
+  if(mSinglePassSortEnabled){
+    sortSinglePass();
+    emit modelSorted();
+    return;
+  }
   std::for_each(mColumnSortOrderList.crbegin(), mColumnSortOrderList.crend(), [this](const ColumnSortOrder & cso){
                                                                   sort(cso.column(), cso.sortOrder());
                                                                 });
   emit modelSorted();
 }
 
+void SortProxyModel::setSinglePassSortEnabled(bool enable)
+{
+  mSortRanks.clear();
+  mSinglePassSortEnabled = enable;
+}
+
+void SortProxyModel::setParallelSortEnabled(bool enable)
+{
+  mParallelSortEnabled = enable;
+  if(!enable){
+    mSortRanks.clear();
+  }
+}
+
+void SortProxyModel::setParallelSortThreshold(int rowCount)
+{
+  Q_ASSERT(rowCount >= 0);
+
+  mParallelSortThreshold = rowCount;
+}
+
+void SortProxyModel::setIncrementalDynamicSortEnabled(bool enable)
+{
+  mIncrementalDynamicSortEnabled = enable;
+}
+
 void SortProxyModel::setDynamicSortFilter(bool enable)
 {
   /*
@@ -96,6 +286,7 @@ void SortProxyModel::setDynamicSortFilter(bool enable)
 
 void SortProxyModel::setSortCaseSensitivity(Qt::CaseSensitivity caseSensitivity)
 {
+  mSortRanks.clear();
   const bool resort = caseSensitivity != sortCaseSensitivity();
   QSortFilterProxyModel::setSortCaseSensitivity(caseSensitivity);
   if(resort){
@@ -105,6 +296,7 @@ void SortProxyModel::setSortCaseSensitivity(Qt::CaseSensitivity caseSensitivity)
 
 void SortProxyModel::setSortLocaleAware(bool on)
 {
+  mSortRanks.clear();
   const bool resort = on != isSortLocaleAware();
   QSortFilterProxyModel::setSortLocaleAware(on);
   if(resort){
@@ -114,6 +306,7 @@ void SortProxyModel::setSortLocaleAware(bool on)
 
 void SortProxyModel::setSortRole(int role)
 {
+  mSortRanks.clear();
   const bool resort = role != sortRole();
   QSortFilterProxyModel::setSortRole(role);
   if(resort){
@@ -137,6 +330,29 @@ void SortProxyModel::setSourceModel(QAbstractItemModel* sourceModel)
   disconnect( sourceModel, &QAbstractItemModel::modelAboutToBeReset, this, &SortProxyModel::onModelAboutToBeReset );
   disconnect( sourceModel, &QAbstractItemModel::modelReset, this, &SortProxyModel::onModelReset );
   disconnect( sourceModel, &QAbstractItemModel::dataChanged, this, &SortProxyModel::onDataChanged );
+  /*
+   * Sort keys must be invalidated before QSortFilterProxyModel reacts to a change of the source model,
+   * so connect before it does.
+   */
+  disconnect( sourceModel, &QAbstractItemModel::dataChanged, this, &SortProxyModel::invalidateSortKeys );
+  disconnect( sourceModel, &QAbstractItemModel::rowsAboutToBeInserted, this, &SortProxyModel::clearSortKeys );
+  disconnect( sourceModel, &QAbstractItemModel::rowsAboutToBeRemoved, this, &SortProxyModel::clearSortKeys );
+  disconnect( sourceModel, &QAbstractItemModel::rowsAboutToBeMoved, this, &SortProxyModel::clearSortKeys );
+  disconnect( sourceModel, &QAbstractItemModel::columnsAboutToBeInserted, this, &SortProxyModel::clearSortKeys );
+  disconnect( sourceModel, &QAbstractItemModel::columnsAboutToBeRemoved, this, &SortProxyModel::clearSortKeys );
+  disconnect( sourceModel, &QAbstractItemModel::columnsAboutToBeMoved, this, &SortProxyModel::clearSortKeys );
+  disconnect( sourceModel, &QAbstractItemModel::layoutAboutToBeChanged, this, &SortProxyModel::clearSortKeys );
+  disconnect( sourceModel, &QAbstractItemModel::modelAboutToBeReset, this, &SortProxyModel::clearSortKeys );
+  mSortKeyCache.clear();
+  connect( sourceModel, &QAbstractItemModel::dataChanged, this, &SortProxyModel::invalidateSortKeys );
+  connect( sourceModel, &QAbstractItemModel::rowsAboutToBeInserted, this, &SortProxyModel::clearSortKeys );
+  connect( sourceModel, &QAbstractItemModel::rowsAboutToBeRemoved, this, &SortProxyModel::clearSortKeys );
+  connect( sourceModel, &QAbstractItemModel::rowsAboutToBeMoved, this, &SortProxyModel::clearSortKeys );
+  connect( sourceModel, &QAbstractItemModel::columnsAboutToBeInserted, this, &SortProxyModel::clearSortKeys );
+  connect( sourceModel, &QAbstractItemModel::columnsAboutToBeRemoved, this, &SortProxyModel::clearSortKeys );
+  connect( sourceModel, &QAbstractItemModel::columnsAboutToBeMoved, this, &SortProxyModel::clearSortKeys );
+  connect( sourceModel, &QAbstractItemModel::layoutAboutToBeChanged, this, &SortProxyModel::clearSortKeys );
+  connect( sourceModel, &QAbstractItemModel::modelAboutToBeReset, this, &SortProxyModel::clearSortKeys );
   QSortFilterProxyModel::setSourceModel(sourceModel);
   connect( sourceModel, &QAbstractItemModel::rowsInserted, this, &SortProxyModel::onRowsInserted );
   connect( sourceModel, &QAbstractItemModel::modelAboutToBeReset, this, &SortProxyModel::onModelAboutToBeReset );
@@ -148,9 +364,20 @@ void SortProxyModel::setSourceModel(QAbstractItemModel* sourceModel)
 
 void SortProxyModel::onRowsInserted(const QModelIndex &, int, int)
 {
-  if(dynamicSortFilter()){
-    sort();
+  if(!dynamicSortFilter()){
+    return;
+  }
+  if(mIncrementalDynamicSortEnabled){
+    /*
+     * QSortFilterProxyModel allready inserted the new rows at their place,
+     * using lessThan()
+     */
+    if(!isDynamicSortComplete()){
+      scheduleSort();
+    }
+    return;
   }
+  sort();
 }
 
 void SortProxyModel::onModelAboutToBeReset()
@@ -186,11 +413,159 @@ void SortProxyModel::onDataChanged(const QModelIndex & topLeft, const QModelInde
    */
   if(dynamicSortFilter()){
     if( isColumnInSortOrder(topLeft.column(), bottomRight.column()) ){
+      if(mIncrementalDynamicSortEnabled){
+        /*
+         * If the sort column changed, QSortFilterProxyModel allready moved the changed rows,
+         * using lessThan()
+         */
+        const bool sortColumnChanged = (sortColumn() >= topLeft.column()) && (sortColumn() <= bottomRight.column());
+        if( !(sortColumnChanged && isDynamicSortComplete()) ){
+          scheduleSort();
+        }
+        return;
+      }
       sort();
     }
   }
 }
 
+void SortProxyModel::scheduleSort()
+{
+  if(mIsSortScheduled){
+    return;
+  }
+  mIsSortScheduled = true;
+  QTimer::singleShot(0, this, &SortProxyModel::processScheduledSort);
+}
+
+void SortProxyModel::processScheduledSort()
+{
+  /*
+   * sort() could have been called since the sort was scheduled
+   */
+  if(!mIsSortScheduled){
+    return;
+  }
+  mIsSortScheduled = false;
+  if(dynamicSortFilter()){
+    sort();
+  }
+}
+
+bool SortProxyModel::isDynamicSortComplete() const
+{
+  /*
+   * After a single pass sort, lessThan() compares all columns in sort order.
+   * Else, it only compares the sort column,
+   * which is enough if it is the only column in sort order.
+   */
+  if(mIsSortedInSinglePass){
+    return true;
+  }
+  return ( std::distance(mColumnSortOrderList.cbegin(), mColumnSortOrderList.cend()) == 1 )
+      && ( mColumnSortOrderList.cbegin()->column() == sortColumn() );
+}
+
+void SortProxyModel::invalidateSortKeys(const QModelIndex & topLeft, const QModelIndex & bottomRight)
+{
+  mSortKeyCache.invalidate(topLeft, bottomRight);
+  mSortRanks.clear();
+}
+
+void SortProxyModel::clearSortKeys()
+{
+  mSortKeyCache.clear();
+  mSortRanks.clear();
+}
+
+void SortProxyModel::sortSinglePass()
+{
+  if(sourceModel() == nullptr){
+    return;
+  }
+  /*
+   * QSortFilterProxyModel sorts by its sort column,
+   * and reverses the comparison for descending order.
+   * We give it the first column in sort order,
+   * lessThanInSortOrder() then compares all columns.
+   */
+  const int columnCount = sourceModel()->columnCount();
+  const auto first = std::find_if(mColumnSortOrderList.cbegin(), mColumnSortOrderList.cend(), [columnCount](const ColumnSortOrder & cso){
+    return cso.column() < columnCount;
+  });
+  if(first == mColumnSortOrderList.cend()){
+    return;
+  }
+  mIsSortedInSinglePass = true;
+  std::vector<ColumnSortOrder> columns;
+  std::copy_if(first, mColumnSortOrderList.cend(), std::back_inserter(columns), [columnCount](const ColumnSortOrder & cso){
+    return cso.column() < columnCount;
+  });
+  prepareParallelSort(columns, first->sortOrder());
+  /*
+   * QSortFilterProxyModel::sort() does nothing if dynamic sort is enabled
+   * and the model is allready sorted by the same column and order.
+   * Other columns in sort order could have changed, so force sorting.
+   */
+  if( dynamicSortFilter() && (sortColumn() == first->column()) && (sortOrder() == first->sortOrder()) ){
+    invalidate();
+  }else{
+    QSortFilterProxyModel::sort(first->column(), first->sortOrder());
+  }
+  emit columnSorted(first->column());
+}
+
+void SortProxyModel::prepareParallelSort(const std::vector<ColumnSortOrder> & columns, Qt::SortOrder sortOrder)
+{
+  mSortRanks.clear();
+  const auto *model = sourceModel();
+  if( (!mParallelSortEnabled) || (model == nullptr) || columns.empty() ){
+    return;
+  }
+  const int rowCount = model->rowCount();
+  if( (rowCount < 2) || (rowCount < mParallelSortThreshold) ){
+    return;
+  }
+  /*
+   * Fetch values of each column, in this thread,
+   * in the order lessThan() will compare them.
+   * QSortFilterProxyModel reverses the result for descending order,
+   * so a column is reversed if its order is not sortOrder.
+   */
+  std::vector<SortColumnValues> columnValues;
+  columnValues.reserve(columns.size());
+  for(const auto & cso : columns){
+    const auto attributes = mColumnSortStringAttributesList.attributesForColumn(cso.column());
+    const bool useCollator = isSortLocaleAware() || attributes.numericMode();
+    if(useCollator){
+      setupCollator(attributes);
+    }
+    const auto caseSensitivity = attributes.isNull() ? sortCaseSensitivity() : attributes.caseSensitivity();
+    SortColumnValues values(cso.sortOrder() != sortOrder);
+    if(!values.fetch(*model, cso.column(), sortRole(), useCollator, mCollator, caseSensitivity)){
+      return;
+    }
+    columnValues.push_back(std::move(values));
+  }
+  /*
+   * Sort the rows in parallel, then store the rank of each row.
+   * Equivalent rows have the same rank, so QSortFilterProxyModel keeps their current order.
+   */
+  const SortRowLessThan rowLessThan(columnValues);
+  std::vector<int> rows(rowCount);
+  std::iota(rows.begin(), rows.end(), 0);
+  parallelStableSort(rows, rowLessThan);
+  mSortRanks.resize(rowCount);
+  int rank = 0;
+  mSortRanks[rows[0]] = rank;
+  for(int i = 1; i < rowCount; ++i){
+    if(rowLessThan(rows[i-1], rows[i])){
+      ++rank;
+    }
+    mSortRanks[rows[i]] = rank;
+  }
+}
+
 bool SortProxyModel::lessThan(const QModelIndex & source_left, const QModelIndex & source_right) const
 {
   Q_ASSERT( sourceModel() != nullptr );
@@ -198,6 +573,56 @@ bool SortProxyModel::lessThan(const QModelIndex & source_left, const QModelIndex
   if( (!source_left.isValid()) || (!source_right.isValid()) ){
     return QSortFilterProxyModel::lessThan(source_left, source_right);
   }
+  if( (!mSortRanks.isEmpty()) && (!source_left.parent().isValid()) ){
+    Q_ASSERT(source_left.row() < mSortRanks.size());
+    Q_ASSERT(source_right.row() < mSortRanks.size());
+    return ( mSortRanks.at(source_left.row()) < mSortRanks.at(source_right.row()) );
+  }
+  if(mIsSortedInSinglePass){
+    return lessThanInSortOrder(source_left, source_right);
+  }
+  return lessThanInColumn(source_left, source_right);
+}
+
+bool SortProxyModel::lessThanInSortOrder(const QModelIndex & source_left, const QModelIndex & source_right) const
+{
+  /*
+   * QSortFilterProxyModel reverses the result for descending order (see sortOrder()).
+   * For a column that must be sorted in the other order, reverse it again.
+   */
+  const int columnCount = sourceModel()->columnCount(source_left.parent());
+  for(const auto & cso : mColumnSortOrderList){
+    if(cso.column() >= columnCount){
+      continue;
+    }
+    const auto left = source_left.sibling(source_left.row(), cso.column());
+    const auto right = source_right.sibling(source_right.row(), cso.column());
+    const bool reverse = (cso.sortOrder() != sortOrder());
+    if(lessThanInColumn(left, right)){
+      return !reverse;
+    }
+    if(lessThanInColumn(right, left)){
+      return reverse;
+    }
+  }
+  return false;
+}
+
+bool SortProxyModel::lessThanInColumn(const QModelIndex & source_left, const QModelIndex & source_right) const
+{
+  /*
+   * For locale aware or natural sort, compare cached sort keys
+   */
+  const auto attributes = mColumnSortStringAttributesList.attributesForColumn(source_left.column());
+  if( isSortLocaleAware() || attributes.numericMode() ){
+    setupCollator(attributes);
+    // The keys of a column never move, so leftKey stays valid while rightKey is fetched
+    const auto *leftKey = mSortKeyCache.sortKey(source_left, sortRole(), mCollator);
+    const auto *rightKey = mSortKeyCache.sortKey(source_right, sortRole(), mCollator);
+    if( (leftKey != nullptr) && (rightKey != nullptr) ){
+      return (leftKey->compare(*rightKey) < 0);
+    }
+  }
   const auto leftData = sourceModel()->data(source_left, sortRole());
   const auto rightData = sourceModel()->data(source_right, sortRole());
   /*
@@ -225,11 +650,25 @@ bool SortProxyModel::lessThatString(const QString & left, const QString & right,
     return (QString::compare(left, right, caseSensitivity) < 0);
   }
   // Compare locale aware
-  mCollator.setCaseSensitivity(caseSensitivity); // Ignored on some platforms
-  mCollator.setNumericMode(attributes.numericMode());
+  setupCollator(attributes);
   return (mCollator.compare(left, right) < 0 );
 }
 
+void SortProxyModel::setupCollator(const ColumnSortStringAttributes & attributes) const
+{
+  /*
+   * Changing a attribute of the collator makes it initialize again,
+   * so only set attributes that changed
+   */
+  const auto caseSensitivity = attributes.isNull() ? sortCaseSensitivity() : attributes.caseSensitivity();
+  if(mCollator.caseSensitivity() != caseSensitivity){
+    mCollator.setCaseSensitivity(caseSensitivity); // Ignored on some platforms
+  }
+  if(mCollator.numericMode() != attributes.numericMode()){
+    mCollator.setNumericMode(attributes.numericMode());
+  }
+}
+
 bool SortProxyModel::isColumnInSortOrder(int left, int right) const
 {
   return ( std::find_if(mColumnSortOrderList.crbegin(), mColumnSortOrderList.crend(), [left, right](const ColumnSortOrder & cso){
@@ -24,9 +24,12 @@
 #include "ColumnSortOrderList.h"
 #include "StringNumericMode.h"
 #include "ColumnSortStringAttributesList.h"
+#include "CollatorSortKeyCache.h"
 #include "MdtItemModelExport.h"
 #include <QSortFilterProxyModel>
 #include <QCollator>
+#include <QVector>
+#include <vector>
 
 namespace Mdt{ namespace ItemModel{
 
@@ -57,6 +60,37 @@ namespace Mdt{ namespace ItemModel{
    * proxyModel->sort();
    * \endcode
    *
+   * By default, sort() sorts the model once for each column in sort order,
+   *  starting from the last one, relying on the stability of the sort.
+   *  If single pass sort is enabled (see setSinglePassSortEnabled()),
+   *  sort() sorts the model only once, comparing rows column by column.
+   *
+   * \section incremental_sort Incremental dynamic sort
+   *
+   * When dynamic sort is enabled, sort() is called each time rows are inserted,
+   *  or data changed in a column that is in sort order.
+   *  If incremental dynamic sort is enabled (see setIncrementalDynamicSortEnabled()),
+   *  the insertion of rows, and the move of changed rows, done by QSortFilterProxyModel
+   *  is used when it gives the correct order, and sort() is not called.
+   *  In other cases, sort() is called once, after control returns to the event loop,
+   *  so a burst of changes only leads to one sort.
+   *
+   * For locale aware or natural sorting, comparing strings with a collator is expensive.
+   *  A collation sort key is computed once for each string in a sorted column,
+   *  and kept until the source model data changes (see CollatorSortKeyCache).
+   *
+   * \section parallel_sort Parallel sort
+   *
+   * If parallel sort is enabled (see setParallelSortEnabled()),
+   *  and the source model has at least parallelSortThreshold() rows,
+   *  sort() first fetches the values of the sorted columns,
+   *  then sorts the rows in parallel, using QThreadPool::globalInstance().
+   *  QSortFilterProxyModel then only compares the resulting rank of each row.
+   *  Note that the source model is only accessed from the thread of this proxy model.
+   *  If a sorted column contains values of different types, or of a type
+   *  that is not an integral, floating point or string type,
+   *  the sort is done the usual way.
+   *
    * \sa FilterProxyModel
    *
    * \todo Define:
@@ -185,6 +219,86 @@ namespace Mdt{ namespace ItemModel{
      */
     void sort();
 
+    /*! \brief Enable or disable single pass sort
+     *
+     * When single pass sort is enabled, sort() sorts the model once,
+     *  comparing 2 rows by each column in sort order,
+     *  until a column makes a difference.
+     *  The layout of this proxy model then only changes once.
+     *  Rows that are equal for all columns in sort order keep their relative order.
+     *
+     * After such sort, QSortFilterProxyModel::sortColumn() and QSortFilterProxyModel::sortOrder()
+     *  return the first column in sort order and its sort order.
+     *  If dynamic sort is enabled, rows that are inserted or changed are also compared by all columns in sort order.
+     *
+     * Single pass sort is disabled by default.
+     *
+     * \sa \ref sort()
+     */
+    void setSinglePassSortEnabled(bool enable);
+
+    /*! \brief Check if single pass sort is enabled
+     */
+    bool isSinglePassSortEnabled() const
+    {
+      return mSinglePassSortEnabled;
+    }
+
+    /*! \brief Enable or disable parallel sort
+     *
+     * Parallel sort is disabled by default.
+     *
+     * \sa \ref parallel_sort
+     */
+    void setParallelSortEnabled(bool enable);
+
+    /*! \brief Check if parallel sort is enabled
+     */
+    bool isParallelSortEnabled() const
+    {
+      return mParallelSortEnabled;
+    }
+
+    /*! \brief Set the minimum row count of the source model to sort in parallel
+     *
+     * Default threshold is 100000 rows.
+     *
+     * \pre \a rowCount must be >= 0
+     * \sa \ref parallel_sort
+     */
+    void setParallelSortThreshold(int rowCount);
+
+    /*! \brief Get the minimum row count of the source model to sort in parallel
+     */
+    int parallelSortThreshold() const
+    {
+      return mParallelSortThreshold;
+    }
+
+    /*! \brief Enable or disable incremental dynamic sort
+     *
+     * Incremental dynamic sort is disabled by default.
+     *
+     * \sa \ref incremental_sort
+     */
+    void setIncrementalDynamicSortEnabled(bool enable);
+
+    /*! \brief Check if incremental dynamic sort is enabled
+     */
+    bool isIncrementalDynamicSortEnabled() const
+    {
+      return mIncrementalDynamicSortEnabled;
+    }
+
+    /*! \brief Check if a sort is scheduled
+     *
+     * \sa \ref incremental_sort
+     */
+    bool isSortScheduled() const
+    {
+      return mIsSortScheduled;
+    }
+
     /*! \brief Re-implemented from QSortFilterProxyModel
      */
     void setDynamicSortFilter(bool enable);
@@ -217,6 +331,9 @@ namespace Mdt{ namespace ItemModel{
     void modelSorted();
 
     /*! \brief Emitted when a column was sorted
+     *
+     * If single pass sort is enabled, sort() emits this signal only once,
+     *  for the first column in sort order.
      */
     void columnSorted(int column);
 
@@ -226,6 +343,9 @@ namespace Mdt{ namespace ItemModel{
     void onModelAboutToBeReset();
     void onModelReset();
     void onDataChanged(const QModelIndex & topLeft, const QModelIndex & bottomRight, const QVector<int> & roles);
+    void invalidateSortKeys(const QModelIndex & topLeft, const QModelIndex & bottomRight);
+    void clearSortKeys();
+    void processScheduledSort();
 
    private:
 
@@ -233,6 +353,38 @@ namespace Mdt{ namespace ItemModel{
      */
     bool lessThan(const QModelIndex & source_left, const QModelIndex & source_right) const override;
 
+    /*! \brief Compare source_left and source_right regarding their column only
+     */
+    bool lessThanInColumn(const QModelIndex & source_left, const QModelIndex & source_right) const;
+
+    /*! \brief Compare the rows of source_left and source_right by each column in sort order
+     */
+    bool lessThanInSortOrder(const QModelIndex & source_left, const QModelIndex & source_right) const;
+
+    /*! \brief Sort once by all columns in sort order
+     */
+    void sortSinglePass();
+
+    /*! \brief Compute the sort rank of each source row, in parallel, if enabled
+     *
+     * \a columns are compared in given order,
+     *  each one reversed if its sort order is not \a sortOrder .
+     *  If ranks cannot be computed, mSortRanks is left empty.
+     */
+    void prepareParallelSort(const std::vector<ColumnSortOrder> & columns, Qt::SortOrder sortOrder);
+
+    /*! \brief Schedule a call of sort() when control returns to the event loop
+     */
+    void scheduleSort();
+
+    /*! \brief Check if the dynamic sort of QSortFilterProxyModel gives the order of all columns in sort order
+     */
+    bool isDynamicSortComplete() const;
+
+    /*! \brief Set collator attributes regarding string sort attributes of a column
+     */
+    void setupCollator(const ColumnSortStringAttributes & attributes) const;
+
     /*! \brief Helper to sort strings
      */
     bool lessThatString(const QString & left, const QString & right, int column) const;
@@ -244,6 +396,14 @@ namespace Mdt{ namespace ItemModel{
     ColumnSortOrderList mColumnSortOrderList;
     ColumnSortStringAttributesList mColumnSortStringAttributesList;
     mutable QCollator mCollator;
+    mutable CollatorSortKeyCache mSortKeyCache;
+    bool mSinglePassSortEnabled = false;
+    bool mIsSortedInSinglePass = false;
+    bool mIncrementalDynamicSortEnabled = false;
+    bool mIsSortScheduled = false;
+    bool mParallelSortEnabled = false;
+    int mParallelSortThreshold = 100000;
+    QVector<int> mSortRanks;
     bool pvDynamicSortWasEnabled; // Used only by onModelAboutToBeReset() and onModelReset()
   };
 
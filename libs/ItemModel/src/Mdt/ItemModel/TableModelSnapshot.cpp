@@ -0,0 +1,75 @@
+/****************************************************************************
+ **
+ ** Copyright (C) 2011-2017 Philippe Steinmann.
+ **
+ ** This file is part of multiDiagTools library.
+ **
+ ** multiDiagTools is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Lesser General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** multiDiagTools is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public License
+ ** along with multiDiagTools.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+#include "TableModelSnapshot.h"
+
+namespace Mdt{ namespace ItemModel{
+
+TableModelSnapshot::TableModelSnapshot(const QAbstractItemModel * const model, int firstRow, int rowCount, int columnCount)
+ : QAbstractTableModel(),
+   mRowCount(rowCount),
+   mColumnCount(columnCount)
+{
+  Q_ASSERT(model != nullptr);
+  Q_ASSERT(firstRow >= 0);
+  Q_ASSERT(rowCount >= 0);
+  Q_ASSERT( (firstRow + rowCount) <= model->rowCount() );
+  Q_ASSERT(columnCount >= 0);
+  Q_ASSERT(columnCount <= model->columnCount());
+
+  mData.reserve(rowCount * columnCount);
+  for(int row = firstRow; row < firstRow + rowCount; ++row){
+    for(int column = 0; column < columnCount; ++column){
+      mData.append( model->data(model->index(row, column)) );
+    }
+  }
+}
+
+int TableModelSnapshot::rowCount(const QModelIndex & parent) const
+{
+  if(parent.isValid()){
+    return 0;
+  }
+  return mRowCount;
+}
+
+int TableModelSnapshot::columnCount(const QModelIndex & parent) const
+{
+  if(parent.isValid()){
+    return 0;
+  }
+  return mColumnCount;
+}
+
+QVariant TableModelSnapshot::data(const QModelIndex & index, int role) const
+{
+  if(!index.isValid()){
+    return QVariant();
+  }
+  if(role != Qt::DisplayRole){
+    return QVariant();
+  }
+  Q_ASSERT(index.row() < mRowCount);
+  Q_ASSERT(index.column() < mColumnCount);
+
+  return mData.at(index.row() * mColumnCount + index.column());
+}
+
+}} // namespace Mdt{ namespace ItemModel{
@@ -0,0 +1,87 @@
+/****************************************************************************
+ **
+ ** Copyright (C) 2011-2017 Philippe Steinmann.
+ **
+ ** This file is part of multiDiagTools library.
+ **
+ ** multiDiagTools is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Lesser General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** multiDiagTools is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public License
+ ** along with multiDiagTools.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+#ifndef MDT_ITEM_MODEL_TABLE_MODEL_SNAPSHOT_H
+#define MDT_ITEM_MODEL_TABLE_MODEL_SNAPSHOT_H
+
+#include "MdtItemModelExport.h"
+#include <QAbstractTableModel>
+#include <QModelIndex>
+#include <QVariant>
+#include <QVector>
+
+namespace Mdt{ namespace ItemModel{
+
+  /*! \brief Read-only copy of the display data of a table model
+   *
+   * A item model can only be used from the thread it lives in.
+   *  To evaluate data in other threads,
+   *  a snapshot is taken in the thread of the model,
+   *  then only the snapshot is used by the other threads.
+   *
+   * A snapshot never changes after it was constructed,
+   *  so its const functions can be called from multiple threads.
+   *  It does not emit any signal.
+   */
+  class MDT_ITEMMODEL_EXPORT TableModelSnapshot : public QAbstractTableModel
+  {
+   public:
+
+    /*! \brief Take a snapshot of \a rowCount rows, starting at \a firstRow, of \a model
+     *
+     * Only the first \a columnCount columns are copied.
+     *
+     * \pre \a model must be a valid pointer
+     * \pre \a firstRow and \a rowCount must define a valid range of rows in \a model
+     * \pre \a columnCount must be in range 0 <= \a columnCount <= model->columnCount()
+     */
+    TableModelSnapshot(const QAbstractItemModel * const model, int firstRow, int rowCount, int columnCount);
+
+    // Disable copy
+    TableModelSnapshot(const TableModelSnapshot &) = delete;
+    TableModelSnapshot & operator=(const TableModelSnapshot &) = delete;
+    // Disable move
+    TableModelSnapshot(TableModelSnapshot &&) = delete;
+    TableModelSnapshot & operator=(TableModelSnapshot &&) = delete;
+
+    /*! \brief Get row count
+     */
+    int rowCount(const QModelIndex & parent = QModelIndex()) const override;
+
+    /*! \brief Get column count
+     */
+    int columnCount(const QModelIndex & parent = QModelIndex()) const override;
+
+    /*! \brief Get data
+     *
+     * Returns a null QVariant for any other role than Qt::DisplayRole
+     */
+    QVariant data(const QModelIndex & index, int role = Qt::DisplayRole) const override;
+
+   private:
+
+    int mRowCount;
+    int mColumnCount;
+    QVector<QVariant> mData;
+  };
+
+}} // namespace Mdt{ namespace ItemModel{
+
+#endif // #ifndef MDT_ITEM_MODEL_TABLE_MODEL_SNAPSHOT_H
@@ -21,9 +21,27 @@
 #include "VariantTableModel.h"
 #include <QChar>
 #include <algorithm>
+#include <utility>
 
 namespace Mdt{ namespace ItemModel{
 
+namespace{
+
+  /*
+   * Get a value to store: copied from const data, moved from other data
+   */
+  QVariant takeValue(const QVariant & value)
+  {
+    return value;
+  }
+
+  QVariant takeValue(QVariant & value)
+  {
+    return std::move(value);
+  }
+
+} // namespace{
+
 VariantTableModel::VariantTableModel(VariantTableModelStorageRule storageRule, QObject* parent)
  : QAbstractTableModel(parent),
    mStorageRule(storageRule),
@@ -36,11 +54,30 @@ void VariantTableModel::setPassRolesInDataChaged(bool pass)
   mPassRolesInDataChanged = pass;
 }
 
+void VariantTableModel::setStorageLayout(VariantTableModelStorageLayout layout)
+{
+  if(layout == mStorageLayout){
+    return;
+  }
+  emitPendingDataChanged();
+  beginResetModel();
+  if(layout == VariantTableModelStorageLayout::Columns){
+    moveDataToColumns();
+  }else{
+    moveDataToRows();
+  }
+  mStorageLayout = layout;
+  endResetModel();
+}
+
 int VariantTableModel::rowCount(const QModelIndex& parent) const
 {
    if(parent.isValid()){
      return 0;
    }
+   if(isStoredByColumns()){
+     return mRowCountByColumns;
+   }
    return mData.size();
 }
 
@@ -57,10 +94,13 @@ QVariant VariantTableModel::data(const QModelIndex& index, int role) const
   }
   Q_ASSERT(index.row() >= 0);
   Q_ASSERT(index.column() >= 0);
-  if( (index.row() >= (int)mData.size()) || (index.column() >= mColumnCount) ){
+  if( (index.row() >= rowCount()) || (index.column() >= mColumnCount) ){
     return QVariant();
   }
   if( (role == Qt::DisplayRole) || (role == Qt::EditRole) ){
+    if(isStoredByColumns()){
+      return mColumns[index.column()].data(index.row(), role);
+    }
     return mData[index.row()].data(index.column(), role);
   }
   return QVariant();
@@ -82,7 +122,7 @@ QVariant VariantTableModel::data(int row, int column, int role) const
 void VariantTableModel::setItemEnabled(const QModelIndex& index, bool enable)
 {
   Q_ASSERT(index.row() >= 0);
-  Q_ASSERT(index.row() < (int)mData.size());
+  Q_ASSERT(index.row() < rowCount());
   Q_ASSERT(index.column() >= 0);
   Q_ASSERT(index.column() < mColumnCount);
 
@@ -96,13 +136,17 @@ void VariantTableModel::setItemEnabled(int row, int column, bool enable)
   Q_ASSERT(column >= 0);
   Q_ASSERT(column < columnCount());
 
-  mData[row].setItemEnabled(column, enable);
+  if(isStoredByColumns()){
+    mColumns[column].setItemEnabled(row, enable);
+  }else{
+    mData[row].setItemEnabled(column, enable);
+  }
 }
 
 void VariantTableModel::setItemEditable(const QModelIndex& index, bool editable)
 {
   Q_ASSERT(index.row() >= 0);
-  Q_ASSERT(index.row() < (int)mData.size());
+  Q_ASSERT(index.row() < rowCount());
   Q_ASSERT(index.column() >= 0);
   Q_ASSERT(index.column() < mColumnCount);
 
@@ -116,7 +160,11 @@ void VariantTableModel::setItemEditable(int row, int column, bool editable)
   Q_ASSERT(column >= 0);
   Q_ASSERT(column < columnCount());
 
-  mData[row].setItemEditable(column, editable);
+  if(isStoredByColumns()){
+    mColumns[column].setItemEditable(row, editable);
+  }else{
+    mData[row].setItemEditable(column, editable);
+  }
 }
 
 Qt::ItemFlags VariantTableModel::flags(const QModelIndex& index) const
@@ -126,9 +174,12 @@ Qt::ItemFlags VariantTableModel::flags(const QModelIndex& index) const
   }
   Q_ASSERT(index.row() >= 0);
   Q_ASSERT(index.column() >= 0);
-  if( (index.row() >= (int)mData.size()) || (index.column() >= mColumnCount) ){
+  if( (index.row() >= rowCount()) || (index.column() >= mColumnCount) ){
     return QAbstractTableModel::flags(index);
   }
+  if(isStoredByColumns()){
+    return mColumns[index.column()].flags(index.row(), QAbstractTableModel::flags(index));
+  }
   return mData[index.row()].flags(index.column(), QAbstractTableModel::flags(index));
 }
 
@@ -139,20 +190,12 @@ bool VariantTableModel::setData(const QModelIndex& index, const QVariant& value,
   }
   Q_ASSERT(index.row() >= 0);
   Q_ASSERT(index.column() >= 0);
-  if( (index.row() >= (int)mData.size()) || (index.column() >= mColumnCount) ){
+  if( (index.row() >= rowCount()) || (index.column() >= mColumnCount) ){
     return false;
   }
   if( (role == Qt::DisplayRole) || (role == Qt::EditRole) ){
-    mData[index.row()].setData(index.column(), value, role);
-    if(mPassRolesInDataChanged){
-      if(mStorageRule == VariantTableModelStorageRule::SeparateDisplayAndEditRoleData){
-        emit dataChanged(index, index, {role});
-      }else{
-        emit dataChanged(index, index, {Qt::DisplayRole, Qt::EditRole});
-      }
-    }else{
-      emit dataChanged(index, index);
-    }
+    storeData(index.row(), index.column(), QVariant(value), role);
+    signalDataChanged(index.row(), index.column(), index.row(), index.column(), role);
     return true;
   }
   return false;
@@ -171,6 +214,125 @@ bool VariantTableModel::setData(int row, int column, const QVariant& value, int
   return setData(idx, value, role);
 }
 
+template<typename Data>
+bool VariantTableModel::storeDataRange(int firstRow, int firstColumn, Data & data, int role)
+{
+  Q_ASSERT(firstRow >= 0);
+  Q_ASSERT(firstColumn >= 0);
+  Q_ASSERT( (firstColumn + (int)data.size()) <= columnCount() );
+
+  if( (role != Qt::DisplayRole) && (role != Qt::EditRole) ){
+    return false;
+  }
+  if( data.empty() || data[0].empty() ){
+    return true;
+  }
+  const int columns = data.size();
+  const int rows = data[0].size();
+  Q_ASSERT( (firstRow + rows) <= rowCount() );
+  for(int col = 0; col < columns; ++col){
+    auto & columnData = data[col];
+    Q_ASSERT((int)columnData.size() == rows);
+    for(int row = 0; row < rows; ++row){
+      storeData(firstRow + row, firstColumn + col, takeValue(columnData[row]), role);
+    }
+  }
+  signalDataChanged(firstRow, firstColumn, firstRow + rows - 1, firstColumn + columns - 1, role);
+
+  return true;
+}
+
+template<typename Data>
+bool VariantTableModel::storeColumnData(int column, int firstRow, Data & data, int role)
+{
+  Q_ASSERT(column >= 0);
+  Q_ASSERT(column < columnCount());
+  Q_ASSERT(firstRow >= 0);
+  Q_ASSERT( (firstRow + (int)data.size()) <= rowCount() );
+
+  if( (role != Qt::DisplayRole) && (role != Qt::EditRole) ){
+    return false;
+  }
+  if(data.empty()){
+    return true;
+  }
+  const int rows = data.size();
+  for(int row = 0; row < rows; ++row){
+    storeData(firstRow + row, column, takeValue(data[row]), role);
+  }
+  signalDataChanged(firstRow, column, firstRow + rows - 1, column, role);
+
+  return true;
+}
+
+template<typename Data>
+bool VariantTableModel::storeRowData(int row, int firstColumn, Data & data, int role)
+{
+  Q_ASSERT(row >= 0);
+  Q_ASSERT(row < rowCount());
+  Q_ASSERT(firstColumn >= 0);
+  Q_ASSERT( (firstColumn + (int)data.size()) <= columnCount() );
+
+  if( (role != Qt::DisplayRole) && (role != Qt::EditRole) ){
+    return false;
+  }
+  if(data.empty()){
+    return true;
+  }
+  const int columns = data.size();
+  for(int col = 0; col < columns; ++col){
+    storeData(row, firstColumn + col, takeValue(data[col]), role);
+  }
+  signalDataChanged(row, firstColumn, row, firstColumn + columns - 1, role);
+
+  return true;
+}
+
+bool VariantTableModel::setDataRange(int firstRow, int firstColumn, const std::vector< std::vector<QVariant> > & data, int role)
+{
+  return storeDataRange(firstRow, firstColumn, data, role);
+}
+
+bool VariantTableModel::setDataRange(int firstRow, int firstColumn, std::vector< std::vector<QVariant> > && data, int role)
+{
+  return storeDataRange(firstRow, firstColumn, data, role);
+}
+
+bool VariantTableModel::setColumnData(int column, int firstRow, const std::vector<QVariant> & data, int role)
+{
+  return storeColumnData(column, firstRow, data, role);
+}
+
+bool VariantTableModel::setColumnData(int column, int firstRow, std::vector<QVariant> && data, int role)
+{
+  return storeColumnData(column, firstRow, data, role);
+}
+
+bool VariantTableModel::setRowData(int row, int firstColumn, const std::vector<QVariant> & data, int role)
+{
+  return storeRowData(row, firstColumn, data, role);
+}
+
+bool VariantTableModel::setRowData(int row, int firstColumn, std::vector<QVariant> && data, int role)
+{
+  return storeRowData(row, firstColumn, data, role);
+}
+
+void VariantTableModel::beginBatch()
+{
+  ++mBatchLevel;
+}
+
+void VariantTableModel::endBatch()
+{
+  Q_ASSERT(mBatchLevel > 0);
+
+  --mBatchLevel;
+  if(mBatchLevel == 0){
+    emitPendingDataChanged();
+  }
+}
+
 void VariantTableModel::appendRow()
 {
   insertRows(rowCount(), 1);
@@ -190,8 +352,16 @@ bool VariantTableModel::insertRows(int row, int count, const QModelIndex & paren
   if(parent.isValid()){
     return false;
   }
+  emitPendingDataChanged();
   beginInsertRows(parent, row, row+count-1);
-  mData.insert( mData.cbegin() + row, count, VariantTableModelRow(mStorageRule, mColumnCount) );
+  if(isStoredByColumns()){
+    for(auto & columnData : mColumns){
+      columnData.insertRows(row, count);
+    }
+    mRowCountByColumns += count;
+  }else{
+    mData.insert( mData.cbegin() + row, count, VariantTableModelRow(mStorageRule, mColumnCount) );
+  }
   endInsertRows();
 
   return true;
@@ -222,8 +392,16 @@ bool VariantTableModel::removeRows(int row, int count, const QModelIndex& parent
   if(parent.isValid()){
     return false;
   }
+  emitPendingDataChanged();
   beginRemoveRows(parent, row, row+count-1);
-  mData.erase( mData.cbegin() + row, mData.cbegin() + row + count);
+  if(isStoredByColumns()){
+    for(auto & columnData : mColumns){
+      columnData.removeRows(row, count);
+    }
+    mRowCountByColumns -= count;
+  }else{
+    mData.erase( mData.cbegin() + row, mData.cbegin() + row + count);
+  }
   endRemoveRows();
 
   return true;
@@ -248,9 +426,14 @@ bool VariantTableModel::insertColumns(int column, int count, const QModelIndex &
   if(parent.isValid()){
     return false;
   }
+  emitPendingDataChanged();
   beginInsertColumns(parent, column, column+count-1);
-  for(auto & rowData : mData){
-    rowData.insertColumns(column, count, mStorageRule);
+  if(isStoredByColumns()){
+    mColumns.insert( mColumns.cbegin() + column, count, VariantTableModelColumn(mStorageRule, mRowCountByColumns) );
+  }else{
+    for(auto & rowData : mData){
+      rowData.insertColumns(column, count, mStorageRule);
+    }
   }
   mColumnCount += count;
   endInsertColumns();
@@ -283,9 +466,14 @@ bool VariantTableModel::removeColumns(int column, int count, const QModelIndex &
   if(parent.isValid()){
     return false;
   }
+  emitPendingDataChanged();
   beginRemoveColumns(parent, column, column+count-1);
-  for(auto & rowData : mData){
-    rowData.removeColumns(column, count);
+  if(isStoredByColumns()){
+    mColumns.erase( mColumns.cbegin() + column, mColumns.cbegin() + column + count );
+  }else{
+    for(auto & rowData : mData){
+      rowData.removeColumns(column, count);
+    }
   }
   mColumnCount -= count;
   endRemoveColumns();
@@ -298,6 +486,7 @@ void VariantTableModel::resize(int rows, int columns)
   Q_ASSERT(rows >= 0);
   Q_ASSERT(columns >= 0);
 
+  emitPendingDataChanged();
   beginResetModel();
   resizeRowCount(rows);
   resizeColumnCount(columns);
@@ -353,6 +542,7 @@ void VariantTableModel::repopulateByColumns(const std::vector< std::vector<QVari
   const int rows = data[0].size();
   const int columns = data.size();
 
+  emitPendingDataChanged();
   beginResetModel();
   resizeRowCount(rows);
   resizeColumnCount(columns);
@@ -364,46 +554,183 @@ void VariantTableModel::repopulateByColumns(const std::vector< std::vector<QVari
 
 void VariantTableModel::populate(int rows, int columns)
 {
+  emitPendingDataChanged();
   beginResetModel();
   mColumnCount = columns;
-  mData.clear();
-  mData.reserve(rows);
-  for(int i = 0; i < rows; ++i){
-    mData.push_back(generateRowData(i));
+  if(isStoredByColumns()){
+    mRowCountByColumns = rows;
+    mColumns.assign( columns, VariantTableModelColumn(mStorageRule, rows) );
+    for(int col = 0; col < columns; ++col){
+      for(int row = 0; row < rows; ++row){
+        mColumns[col].setData( row, generateData(row, col), Qt::DisplayRole );
+      }
+    }
+  }else{
+    mData.clear();
+    mData.reserve(rows);
+    for(int i = 0; i < rows; ++i){
+      mData.push_back(generateRowData(i));
+    }
   }
   endResetModel();
 }
 
 void VariantTableModel::clear()
 {
+  emitPendingDataChanged();
   beginResetModel();
   mData.clear();
+  mColumns.clear();
+  mRowCountByColumns = 0;
   mColumnCount = 0;
   endResetModel();
 }
 
+void VariantTableModel::storeData(int row, int column, QVariant && value, int role)
+{
+  Q_ASSERT(row >= 0);
+  Q_ASSERT(row < rowCount());
+  Q_ASSERT(column >= 0);
+  Q_ASSERT(column < columnCount());
+  Q_ASSERT( (role == Qt::DisplayRole) || (role == Qt::EditRole) );
+
+  if(isStoredByColumns()){
+    mColumns[column].setData(row, value, role);
+  }else{
+    mData[row].setData(column, std::move(value), role);
+  }
+}
+
+void VariantTableModel::signalDataChanged(int firstRow, int firstColumn, int lastRow, int lastColumn, int role)
+{
+  QVector<int> roles;
+  if(mStorageRule == VariantTableModelStorageRule::SeparateDisplayAndEditRoleData){
+    roles = {role};
+  }else{
+    roles = {Qt::DisplayRole, Qt::EditRole};
+  }
+  if(isInBatch()){
+    mPendingChanges.addRange(firstRow, firstColumn, lastRow, lastColumn);
+    for(const int r : roles){
+      if(!mPendingRoles.contains(r)){
+        mPendingRoles.append(r);
+      }
+    }
+    return;
+  }
+  const auto topLeft = index(firstRow, firstColumn);
+  const auto bottomRight = index(lastRow, lastColumn);
+  if(mPassRolesInDataChanged){
+    emit dataChanged(topLeft, bottomRight, roles);
+  }else{
+    emit dataChanged(topLeft, bottomRight);
+  }
+}
+
+void VariantTableModel::emitPendingDataChanged()
+{
+  if(mPendingChanges.isEmpty()){
+    return;
+  }
+  const auto ranges = mPendingChanges.mergedRanges();
+  const auto roles = mPendingRoles;
+  mPendingChanges.clear();
+  mPendingRoles.clear();
+  for(const auto & range : ranges){
+    const auto topLeft = index(range.firstRow(), range.firstColumn());
+    const auto bottomRight = index(range.lastRow(), range.lastColumn());
+    if(mPassRolesInDataChanged){
+      emit dataChanged(topLeft, bottomRight, roles);
+    }else{
+      emit dataChanged(topLeft, bottomRight);
+    }
+  }
+}
+
 void VariantTableModel::resizeRowCount(int rows)
 {
-  mData.resize( rows, VariantTableModelRow(mStorageRule, mColumnCount) );
+  if(isStoredByColumns()){
+    for(auto & columnData : mColumns){
+      columnData.resize(rows);
+    }
+    mRowCountByColumns = rows;
+  }else{
+    mData.resize( rows, VariantTableModelRow(mStorageRule, mColumnCount) );
+  }
 }
 
 void VariantTableModel::resizeColumnCount(int columns)
 {
-  for(auto & row : mData){
-    row.resize(columns, mStorageRule);
+  if(isStoredByColumns()){
+    mColumns.resize( columns, VariantTableModelColumn(mStorageRule, mRowCountByColumns) );
+  }else{
+    for(auto & row : mData){
+      row.resize(columns, mStorageRule);
+    }
   }
   mColumnCount = columns;
 }
 
+void VariantTableModel::moveDataToColumns()
+{
+  Q_ASSERT(mColumns.empty());
+
+  const int rows = mData.size();
+  mColumns.assign( mColumnCount, VariantTableModelColumn(mStorageRule, rows) );
+  for(int col = 0; col < mColumnCount; ++col){
+    auto & columnData = mColumns[col];
+    for(int row = 0; row < rows; ++row){
+      const auto & rowData = mData[row];
+      const auto flags = rowData.flags(col, Qt::NoItemFlags);
+      columnData.setData( row, rowData.data(col, Qt::DisplayRole), Qt::DisplayRole );
+      if(columnData.isEditRoleDataSeparate()){
+        columnData.setData( row, rowData.data(col, Qt::EditRole), Qt::EditRole );
+      }
+      columnData.setItemEnabled( row, flags.testFlag(Qt::ItemIsEnabled) );
+      columnData.setItemEditable( row, flags.testFlag(Qt::ItemIsEditable) );
+    }
+  }
+  mRowCountByColumns = rows;
+  std::vector<VariantTableModelRow>().swap(mData);
+}
+
+void VariantTableModel::moveDataToRows()
+{
+  Q_ASSERT(mData.empty());
+
+  const int rows = mRowCountByColumns;
+  mData.assign( rows, VariantTableModelRow(mStorageRule, mColumnCount) );
+  for(int col = 0; col < mColumnCount; ++col){
+    const auto & columnData = mColumns[col];
+    for(int row = 0; row < rows; ++row){
+      auto & rowData = mData[row];
+      const auto flags = columnData.flags(row, Qt::NoItemFlags);
+      rowData.setData( col, columnData.data(row, Qt::DisplayRole), Qt::DisplayRole );
+      if(mStorageRule == VariantTableModelStorageRule::SeparateDisplayAndEditRoleData){
+        rowData.setData( col, columnData.data(row, Qt::EditRole), Qt::EditRole );
+      }
+      rowData.setItemEnabled( col, flags.testFlag(Qt::ItemIsEnabled) );
+      rowData.setItemEditable( col, flags.testFlag(Qt::ItemIsEditable) );
+    }
+  }
+  mRowCountByColumns = 0;
+  std::vector<VariantTableModelColumn>().swap(mColumns);
+}
+
 VariantTableModelRow VariantTableModel::generateRowData(int currentRow) const
 {
   VariantTableModelRow rowData(mStorageRule, mColumnCount);
 
   for(int i = 0; i < mColumnCount; ++i){
-    rowData.setData( i, QString("%1%2").arg(currentRow).arg( QChar('A'+i) ) , Qt::DisplayRole );
+    rowData.setData( i, generateData(currentRow, i) , Qt::DisplayRole );
   }
 
   return rowData;
 }
 
+QString VariantTableModel::generateData(int row, int column)
+{
+  return QString("%1%2").arg(row).arg( QChar('A'+column) );
+}
+
 }} // namespace Mdt{ namespace ItemModel{
@@ -22,9 +22,13 @@
 #define MDT_ITEM_MODEL_VARIANT_TABLE_MODEL_H
 
 #include "VariantTableModelRow.h"
+#include "VariantTableModelColumn.h"
 #include "VariantTableModelStorageRule.h"
+#include "VariantTableModelStorageLayout.h"
+#include "IndexRangeList.h"
 #include "MdtItemModelExport.h"
 #include <QAbstractTableModel>
+#include <QVector>
 #include <vector>
 
 namespace Mdt{ namespace ItemModel{
@@ -45,6 +49,13 @@ namespace Mdt{ namespace ItemModel{
    * \endcode
    *
    * This class is mostly used in unit tests in Mdt libraries.
+   *
+   * By default, each row stores a item, with its data and flags, for each column.
+   *  For big tables of numbers or strings, the data can be stored by column instead:
+   * \code
+   * model.setStorageLayout(Mdt::ItemModel::VariantTableModelStorageLayout::Columns);
+   * \endcode
+   *  See VariantTableModelStorageLayout and VariantTableModelColumnData for details.
    */
   class MDT_ITEMMODEL_EXPORT VariantTableModel : public QAbstractTableModel
   {
@@ -62,6 +73,22 @@ namespace Mdt{ namespace ItemModel{
      */
     void setPassRolesInDataChaged(bool pass);
 
+    /*! \brief Set storage layout
+     *
+     * Data and flags already stored are kept.
+     *  This method will also reset the model.
+     *
+     * Default is VariantTableModelStorageLayout::Rows
+     */
+    void setStorageLayout(VariantTableModelStorageLayout layout);
+
+    /*! \brief Get storage layout
+     */
+    VariantTableModelStorageLayout storageLayout() const
+    {
+      return mStorageLayout;
+    }
+
     /*! \brief Get row count
      */
     int rowCount(const QModelIndex & parent = QModelIndex()) const override;
@@ -149,6 +176,106 @@ namespace Mdt{ namespace ItemModel{
      */
     bool setData(int row, int column, const QVariant & value, int role = Qt::EditRole);
 
+    /*! \brief Set data for a block of rows and columns
+     *
+     * \a data is given by columns, like in repopulateByColumns():
+     *  data[0] is set in column \a firstColumn from row \a firstRow ,
+     *  data[1] in the next column, and so on.
+     *
+     * dataChanged() is emitted once for the whole block.
+     *
+     * Returns false if \a role is not Qt::DisplayRole or Qt::EditRole.
+     *
+     * \pre \a firstRow must be >= 0
+     * \pre \a firstColumn must be >= 0
+     * \pre each column of \a data must be the same size
+     * \pre the block must fit in this model:
+     *       \a firstRow + data[0].size() <= rowCount() and
+     *       \a firstColumn + data.size() <= columnCount()
+     */
+    bool setDataRange(int firstRow, int firstColumn, const std::vector< std::vector<QVariant> > & data, int role = Qt::EditRole);
+
+    /*! \brief Set data for a block of rows and columns
+     *
+     * Same as setDataRange(int, int, const std::vector< std::vector<QVariant> > &, int),
+     *  but moves the values out of \a data .
+     */
+    bool setDataRange(int firstRow, int firstColumn, std::vector< std::vector<QVariant> > && data, int role = Qt::EditRole);
+
+    /*! \brief Set data in \a column , starting from \a firstRow
+     *
+     * dataChanged() is emitted once for all rows.
+     *
+     * Returns false if \a role is not Qt::DisplayRole or Qt::EditRole.
+     *
+     * \pre \a column must be in valid range ( 0 <= column < columnCount() )
+     * \pre \a firstRow must be >= 0
+     * \pre \a firstRow + \a data size must be <= rowCount()
+     */
+    bool setColumnData(int column, int firstRow, const std::vector<QVariant> & data, int role = Qt::EditRole);
+
+    /*! \brief Set data in \a column , starting from \a firstRow
+     *
+     * Same as setColumnData(int, int, const std::vector<QVariant> &, int),
+     *  but moves the values out of \a data .
+     */
+    bool setColumnData(int column, int firstRow, std::vector<QVariant> && data, int role = Qt::EditRole);
+
+    /*! \brief Set data in \a row , starting from \a firstColumn
+     *
+     * dataChanged() is emitted once for all columns.
+     *
+     * Returns false if \a role is not Qt::DisplayRole or Qt::EditRole.
+     *
+     * \pre \a row must be in valid range ( 0 <= row < rowCount() )
+     * \pre \a firstColumn must be >= 0
+     * \pre \a firstColumn + \a data size must be <= columnCount()
+     */
+    bool setRowData(int row, int firstColumn, const std::vector<QVariant> & data, int role = Qt::EditRole);
+
+    /*! \brief Set data in \a row , starting from \a firstColumn
+     *
+     * Same as setRowData(int, int, const std::vector<QVariant> &, int),
+     *  but moves the values out of \a data .
+     */
+    bool setRowData(int row, int firstColumn, std::vector<QVariant> && data, int role = Qt::EditRole);
+
+    /*! \brief Begin a batch of edits
+     *
+     * Until endBatch() is called, setData() and the other methods that set data
+     *  do not emit dataChanged().
+     *  endBatch() then emits dataChanged() once for each rectangle of the edited indexes
+     *  (see IndexRangeList for details).
+     *
+     * \code
+     * model.beginBatch();
+     * for(int row = 0; row < model.rowCount(); ++row){
+     *   model.setData(row, 0, row);
+     *   model.setData(row, 1, QString::number(row));
+     * }
+     * model.endBatch(); // emits dataChanged() once
+     * \endcode
+     *
+     * Batches can be nested, dataChanged() is emitted when the outermost one ends.
+     *  Inserting or removing rows or columns during a batch
+     *  first emits dataChanged() for the edits done so far.
+     */
+    void beginBatch();
+
+    /*! \brief End a batch of edits
+     *
+     * \pre beginBatch() must have been called
+     * \sa beginBatch()
+     */
+    void endBatch();
+
+    /*! \brief Check if a batch of edits is running
+     */
+    bool isInBatch() const
+    {
+      return (mBatchLevel > 0);
+    }
+
     /*! \brief Append a row
      */
     void appendRow();
@@ -355,12 +482,55 @@ namespace Mdt{ namespace ItemModel{
      */
     void resizeColumnCount(int columns);
 
+    /*! \brief Copy data and flags from rows to columns, or the reverse
+     */
+    void moveDataToColumns();
+    void moveDataToRows();
+
+    bool isStoredByColumns() const
+    {
+      return (mStorageLayout == VariantTableModelStorageLayout::Columns);
+    }
+
+    /*! \brief Store data without emitting dataChanged()
+     */
+    void storeData(int row, int column, QVariant && value, int role);
+
+    /*! \brief Implementation of setDataRange(), setColumnData() and setRowData()
+     *
+     * If \a data is const, each value is copied into the storage,
+     *  otherwise it is moved.
+     */
+    template<typename Data>
+    bool storeDataRange(int firstRow, int firstColumn, Data & data, int role);
+    template<typename Data>
+    bool storeColumnData(int column, int firstRow, Data & data, int role);
+    template<typename Data>
+    bool storeRowData(int row, int firstColumn, Data & data, int role);
+
+    /*! \brief Emit dataChanged() for the rectangle from firstRow , firstColumn to lastRow , lastColumn
+     *
+     * During a batch, the rectangle is only recorded.
+     */
+    void signalDataChanged(int firstRow, int firstColumn, int lastRow, int lastColumn, int role);
+
+    /*! \brief Emit dataChanged() for the edits recorded during a batch
+     */
+    void emitPendingDataChanged();
+
     VariantTableModelRow generateRowData(int currentRow) const;
+    static QString generateData(int row, int column);
 
     VariantTableModelStorageRule mStorageRule;
+    VariantTableModelStorageLayout mStorageLayout = VariantTableModelStorageLayout::Rows;
     int mColumnCount;
+    int mRowCountByColumns = 0;
     std::vector<VariantTableModelRow> mData;
+    std::vector<VariantTableModelColumn> mColumns;
     bool mPassRolesInDataChanged = true;
+    int mBatchLevel = 0;
+    IndexRangeList mPendingChanges;
+    QVector<int> mPendingRoles;
   };
 
 }} // namespace Mdt{ namespace ItemModel{
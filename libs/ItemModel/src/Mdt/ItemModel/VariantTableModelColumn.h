@@ -0,0 +1,204 @@
+/****************************************************************************
+ **
+ ** Copyright (C) 2011-2017 Philippe Steinmann.
+ **
+ ** This file is part of multiDiagTools library.
+ **
+ ** multiDiagTools is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Lesser General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** multiDiagTools is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public License
+ ** along with multiDiagTools.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+#ifndef MDT_ITEM_MODEL_VARIANT_TABLE_MODEL_COLUMN_H
+#define MDT_ITEM_MODEL_VARIANT_TABLE_MODEL_COLUMN_H
+
+#include "VariantTableModelColumnData.h"
+#include "VariantTableModelItem.h"
+#include "VariantTableModelStorageRule.h"
+#include <vector>
+
+namespace Mdt{ namespace ItemModel{
+
+  /*! \brief Column container for VariantTableModel
+   *
+   * Used when the storage layout of VariantTableModel is
+   *  VariantTableModelStorageLayout::Columns .
+   */
+  class VariantTableModelColumn
+  {
+   public:
+
+    /*! \brief Construct a column with rowCount rows
+     */
+    VariantTableModelColumn(VariantTableModelStorageRule storageRule, int rowCount)
+     : mStorageRule(storageRule),
+       mDisplayRoleData(rowCount),
+       mEditRoleData(isEditRoleDataSeparate() ? rowCount : 0),
+       mIsEnabled(rowCount, true),
+       mIsEditable(rowCount, true)
+    {
+    }
+
+    /*! \brief Check if edit role data is stored separately from display role data
+     */
+    bool isEditRoleDataSeparate() const
+    {
+      return (mStorageRule == VariantTableModelStorageRule::SeparateDisplayAndEditRoleData);
+    }
+
+    /*! \brief Get row count
+     */
+    int rowCount() const
+    {
+      return mDisplayRoleData.rowCount();
+    }
+
+    /*! \brief Get data at row
+     *
+     * If storage rule (passed in constructor) is SeparateDisplayAndEditRoleData,
+     *  data for Qt::EditRole will be distinct from data for Qt::DisplayRole.
+     *
+     * \pre row must be in valid range
+     *      ( 0 <= row < rowCount() )
+     * \pre role must be Qt::DisplayRole or Qt::EditRole
+     */
+    QVariant data(int row, int role) const
+    {
+      Q_ASSERT(row >= 0);
+      Q_ASSERT(row < rowCount());
+      Q_ASSERT( (role == Qt::DisplayRole) || (role == Qt::EditRole) );
+      if( (role == Qt::EditRole) && isEditRoleDataSeparate() ){
+        return mEditRoleData.data(row);
+      }
+      return mDisplayRoleData.data(row);
+    }
+
+    /*! \brief Set item at row enabled/disabled
+     *
+     * \pre row must be in valid range
+     *      ( 0 <= row < rowCount() )
+     */
+    void setItemEnabled(int row, bool enable)
+    {
+      Q_ASSERT(row >= 0);
+      Q_ASSERT(row < rowCount());
+      mIsEnabled[row] = enable;
+    }
+
+    /*! \brief Set item at row editable/read only
+     *
+     * \pre row must be in valid range
+     *      ( 0 <= row < rowCount() )
+     */
+    void setItemEditable(int row, bool editable)
+    {
+      Q_ASSERT(row >= 0);
+      Q_ASSERT(row < rowCount());
+      mIsEditable[row] = editable;
+    }
+
+    /*! \brief Get flags of item at row
+     *
+     * \pre row must be in valid range
+     *      ( 0 <= row < rowCount() )
+     * \sa VariantTableModelItem::flags()
+     */
+    Qt::ItemFlags flags(int row, Qt::ItemFlags currentFlags) const
+    {
+      Q_ASSERT(row >= 0);
+      Q_ASSERT(row < rowCount());
+      return VariantTableModelItem::flags(currentFlags, mIsEnabled[row], mIsEditable[row]);
+    }
+
+    /*! \brief Set data at row
+     *
+     * \pre row must be in valid range
+     *      ( 0 <= row < rowCount() )
+     * \pre role must be Qt::DisplayRole or Qt::EditRole
+     */
+    void setData(int row, const QVariant & value, int role = Qt::EditRole)
+    {
+      Q_ASSERT(row >= 0);
+      Q_ASSERT(row < rowCount());
+      Q_ASSERT( (role == Qt::DisplayRole) || (role == Qt::EditRole) );
+      if( (role == Qt::EditRole) && isEditRoleDataSeparate() ){
+        mEditRoleData.setData(row, value);
+      }else{
+        mDisplayRoleData.setData(row, value);
+      }
+    }
+
+    /*! \brief Resize to rows
+     *
+     * \pre rows must be >= 0
+     */
+    void resize(int rows)
+    {
+      Q_ASSERT(rows >= 0);
+      mDisplayRoleData.resize(rows);
+      if(isEditRoleDataSeparate()){
+        mEditRoleData.resize(rows);
+      }
+      mIsEnabled.resize(rows, true);
+      mIsEditable.resize(rows, true);
+    }
+
+    /*! \brief Insert count rows before row
+     *
+     * \pre row must be in valid range
+     *      ( 0 <= row <= rowCount() )
+     * \pre count must be >= 1
+     */
+    void insertRows(int row, int count)
+    {
+      Q_ASSERT(row >= 0);
+      Q_ASSERT(row <= rowCount());
+      Q_ASSERT(count >= 1);
+      mDisplayRoleData.insertRows(row, count);
+      if(isEditRoleDataSeparate()){
+        mEditRoleData.insertRows(row, count);
+      }
+      mIsEnabled.insert(mIsEnabled.cbegin() + row, count, true);
+      mIsEditable.insert(mIsEditable.cbegin() + row, count, true);
+    }
+
+    /*! \brief Remove count rows starting from row
+     *
+     * \pre row must be >= 0
+     * \pre count must be >= 1
+     * \pre row + count must be <= rowCount()
+     */
+    void removeRows(int row, int count)
+    {
+      Q_ASSERT(row >= 0);
+      Q_ASSERT(count >= 1);
+      Q_ASSERT( (row + count ) <= rowCount() );
+      mDisplayRoleData.removeRows(row, count);
+      if(isEditRoleDataSeparate()){
+        mEditRoleData.removeRows(row, count);
+      }
+      mIsEnabled.erase(mIsEnabled.cbegin()+row, mIsEnabled.cbegin()+row+count);
+      mIsEditable.erase(mIsEditable.cbegin()+row, mIsEditable.cbegin()+row+count);
+    }
+
+   private:
+
+    VariantTableModelStorageRule mStorageRule;
+    VariantTableModelColumnData mDisplayRoleData;
+    VariantTableModelColumnData mEditRoleData;
+    std::vector<bool> mIsEnabled;
+    std::vector<bool> mIsEditable;
+  };
+
+}} // namespace Mdt{ namespace ItemModel{
+
+#endif // #ifndef MDT_ITEM_MODEL_VARIANT_TABLE_MODEL_COLUMN_H
@@ -0,0 +1,269 @@
+/****************************************************************************
+ **
+ ** Copyright (C) 2011-2017 Philippe Steinmann.
+ **
+ ** This file is part of multiDiagTools library.
+ **
+ ** multiDiagTools is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Lesser General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** multiDiagTools is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public License
+ ** along with multiDiagTools.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+#include "VariantTableModelColumnData.h"
+#include <QMetaType>
+
+namespace Mdt{ namespace ItemModel{
+
+namespace{
+
+  template<typename T>
+  void insertItems(std::vector<T> & container, int row, int count, const T & value)
+  {
+    container.insert(container.begin() + row, count, value);
+  }
+
+  template<typename T>
+  void removeItems(std::vector<T> & container, int row, int count)
+  {
+    container.erase(container.begin() + row, container.begin() + row + count);
+  }
+
+} // namespace{
+
+VariantTableModelColumnData::VariantTableModelColumnData(int rowCount)
+ : mMetaType(QMetaType::UnknownType),
+   mRowCount(rowCount)
+{
+  Q_ASSERT(mRowCount >= 0);
+}
+
+QVariant VariantTableModelColumnData::data(int row) const
+{
+  Q_ASSERT(row >= 0);
+  Q_ASSERT(row < rowCount());
+
+  switch(mType){
+    case Type::Null:
+      return QVariant();
+    case Type::Variant:
+      return mVariantData[row];
+    default:
+      break;
+  }
+  if(mIsNull[row]){
+    return QVariant();
+  }
+  switch(mType){
+    case Type::Int64:
+      if(mMetaType == QMetaType::Int){
+        return QVariant( static_cast<int>(mInt64Data[row]) );
+      }
+      return QVariant( static_cast<qlonglong>(mInt64Data[row]) );
+    case Type::Double:
+      return QVariant(mDoubleData[row]);
+    case Type::String:
+      return QVariant(mStringData[row]);
+    default:
+      break;
+  }
+
+  return QVariant();
+}
+
+void VariantTableModelColumnData::setData(int row, const QVariant & value)
+{
+  Q_ASSERT(row >= 0);
+  Q_ASSERT(row < rowCount());
+
+  if(!value.isValid()){
+    switch(mType){
+      case Type::Null:
+        return;
+      case Type::Variant:
+        mVariantData[row] = value;
+        return;
+      default:
+        mIsNull[row] = true;
+        return;
+    }
+  }
+  const auto valueType = typeForValue(value);
+  if(mType == Type::Null){
+    allocate(valueType, value.userType());
+  }else if( (mType != Type::Variant) && ( (valueType != mType) || (value.userType() != mMetaType) ) ){
+    convertToVariant();
+  }
+  switch(mType){
+    case Type::Int64:
+      mInt64Data[row] = value.toLongLong();
+      break;
+    case Type::Double:
+      mDoubleData[row] = value.toDouble();
+      break;
+    case Type::String:
+      mStringData[row] = value.toString();
+      break;
+    case Type::Variant:
+      mVariantData[row] = value;
+      return;
+    case Type::Null:
+      Q_ASSERT(false);
+      return;
+  }
+  mIsNull[row] = false;
+}
+
+void VariantTableModelColumnData::resize(int rowCount)
+{
+  Q_ASSERT(rowCount >= 0);
+
+  mRowCount = rowCount;
+  switch(mType){
+    case Type::Null:
+      return;
+    case Type::Int64:
+      mInt64Data.resize(mRowCount, 0);
+      break;
+    case Type::Double:
+      mDoubleData.resize(mRowCount, 0.0);
+      break;
+    case Type::String:
+      mStringData.resize(mRowCount);
+      break;
+    case Type::Variant:
+      mVariantData.resize(mRowCount);
+      return;
+  }
+  mIsNull.resize(mRowCount, true);
+}
+
+void VariantTableModelColumnData::insertRows(int row, int count)
+{
+  Q_ASSERT(row >= 0);
+  Q_ASSERT(row <= rowCount());
+  Q_ASSERT(count >= 1);
+
+  mRowCount += count;
+  switch(mType){
+    case Type::Null:
+      return;
+    case Type::Int64:
+      insertItems<qint64>(mInt64Data, row, count, 0);
+      break;
+    case Type::Double:
+      insertItems<double>(mDoubleData, row, count, 0.0);
+      break;
+    case Type::String:
+      insertItems(mStringData, row, count, QString());
+      break;
+    case Type::Variant:
+      insertItems(mVariantData, row, count, QVariant());
+      return;
+  }
+  mIsNull.insert(mIsNull.begin() + row, count, true);
+}
+
+void VariantTableModelColumnData::removeRows(int row, int count)
+{
+  Q_ASSERT(row >= 0);
+  Q_ASSERT(count >= 1);
+  Q_ASSERT( (row + count) <= rowCount() );
+
+  mRowCount -= count;
+  switch(mType){
+    case Type::Null:
+      return;
+    case Type::Int64:
+      removeItems(mInt64Data, row, count);
+      break;
+    case Type::Double:
+      removeItems(mDoubleData, row, count);
+      break;
+    case Type::String:
+      removeItems(mStringData, row, count);
+      break;
+    case Type::Variant:
+      removeItems(mVariantData, row, count);
+      return;
+  }
+  removeItems(mIsNull, row, count);
+}
+
+VariantTableModelColumnData::Type VariantTableModelColumnData::typeForValue(const QVariant & value)
+{
+  Q_ASSERT(value.isValid());
+
+  /*
+   * A null int or double can not be restored from the stored value,
+   * but a null QString can
+   */
+  switch(value.userType()){
+    case QMetaType::Int:
+    case QMetaType::LongLong:
+      return value.isNull() ? Type::Variant : Type::Int64;
+    case QMetaType::Double:
+      return value.isNull() ? Type::Variant : Type::Double;
+    case QMetaType::QString:
+      return Type::String;
+    default:
+      break;
+  }
+
+  return Type::Variant;
+}
+
+void VariantTableModelColumnData::allocate(Type type, int metaType)
+{
+  Q_ASSERT(mType == Type::Null);
+  Q_ASSERT(type != Type::Null);
+
+  mType = type;
+  mMetaType = metaType;
+  switch(mType){
+    case Type::Int64:
+      mInt64Data.assign(mRowCount, 0);
+      break;
+    case Type::Double:
+      mDoubleData.assign(mRowCount, 0.0);
+      break;
+    case Type::String:
+      mStringData.assign(mRowCount, QString());
+      break;
+    case Type::Variant:
+      mVariantData.assign(mRowCount, QVariant());
+      return;
+    case Type::Null:
+      return;
+  }
+  mIsNull.assign(mRowCount, true);
+}
+
+void VariantTableModelColumnData::convertToVariant()
+{
+  Q_ASSERT(mType != Type::Null);
+  Q_ASSERT(mType != Type::Variant);
+
+  std::vector<QVariant> variantData;
+  variantData.reserve(mRowCount);
+  for(int row = 0; row < mRowCount; ++row){
+    variantData.push_back( data(row) );
+  }
+  mType = Type::Variant;
+  mMetaType = QMetaType::UnknownType;
+  mVariantData.swap(variantData);
+  std::vector<bool>().swap(mIsNull);
+  std::vector<qint64>().swap(mInt64Data);
+  std::vector<double>().swap(mDoubleData);
+  std::vector<QString>().swap(mStringData);
+}
+
+}} // namespace Mdt{ namespace ItemModel{
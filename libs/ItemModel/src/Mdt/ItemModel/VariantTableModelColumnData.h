@@ -0,0 +1,129 @@
+/****************************************************************************
+ **
+ ** Copyright (C) 2011-2017 Philippe Steinmann.
+ **
+ ** This file is part of multiDiagTools library.
+ **
+ ** multiDiagTools is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Lesser General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** multiDiagTools is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public License
+ ** along with multiDiagTools.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+#ifndef MDT_ITEM_MODEL_VARIANT_TABLE_MODEL_COLUMN_DATA_H
+#define MDT_ITEM_MODEL_VARIANT_TABLE_MODEL_COLUMN_DATA_H
+
+#include "MdtItemModelExport.h"
+#include <QVariant>
+#include <QString>
+#include <QtGlobal>
+#include <vector>
+
+namespace Mdt{ namespace ItemModel{
+
+  /*! \brief Data of one role for a column of VariantTableModel
+   *
+   * Values are stored in a contiguous array of the type of the first value set:
+   *  qint64 for int and qlonglong, double, QString,
+   *  and QVariant for any other type.
+   *  A invalid QVariant is stored as a bit in a null bitset.
+   *
+   * When a value of a other type is set,
+   *  the column falls back to store QVariant for all its rows.
+   *  data() always returns a QVariant of the type that was set.
+   */
+  class MDT_ITEMMODEL_EXPORT VariantTableModelColumnData
+  {
+   public:
+
+    /*! \brief Type of the array that stores values
+     */
+    enum class Type
+    {
+      Null,     /*!< No value was set yet, nothing is allocated */
+      Int64,    /*!< Values are stored as qint64 */
+      Double,   /*!< Values are stored as double */
+      String,   /*!< Values are stored as QString */
+      Variant   /*!< Values are stored as QVariant */
+    };
+
+    /*! \brief Construct column data with \a rowCount rows
+     *
+     * \pre \a rowCount must be >= 0
+     */
+    explicit VariantTableModelColumnData(int rowCount = 0);
+
+    /*! \brief Get row count
+     */
+    int rowCount() const
+    {
+      return mRowCount;
+    }
+
+    /*! \brief Get type of the array that stores values
+     */
+    Type type() const
+    {
+      return mType;
+    }
+
+    /*! \brief Get data at \a row
+     *
+     * \pre \a row must be in valid range ( 0 <= row < rowCount() )
+     */
+    QVariant data(int row) const;
+
+    /*! \brief Set data at \a row
+     *
+     * \pre \a row must be in valid range ( 0 <= row < rowCount() )
+     */
+    void setData(int row, const QVariant & value);
+
+    /*! \brief Resize to \a rowCount rows
+     *
+     * \pre \a rowCount must be >= 0
+     */
+    void resize(int rowCount);
+
+    /*! \brief Insert \a count rows before \a row
+     *
+     * \pre \a row must be in valid range ( 0 <= row <= rowCount() )
+     * \pre \a count must be >= 1
+     */
+    void insertRows(int row, int count);
+
+    /*! \brief Remove \a count rows starting from \a row
+     *
+     * \pre \a row must be >= 0
+     * \pre \a count must be >= 1
+     * \pre \a row + \a count must be <= rowCount()
+     */
+    void removeRows(int row, int count);
+
+   private:
+
+    static Type typeForValue(const QVariant & value);
+    void allocate(Type type, int metaType);
+    void convertToVariant();
+
+    Type mType = Type::Null;
+    int mMetaType;
+    int mRowCount;
+    std::vector<bool> mIsNull;
+    std::vector<qint64> mInt64Data;
+    std::vector<double> mDoubleData;
+    std::vector<QString> mStringData;
+    std::vector<QVariant> mVariantData;
+  };
+
+}} // namespace Mdt{ namespace ItemModel{
+
+#endif // #ifndef MDT_ITEM_MODEL_VARIANT_TABLE_MODEL_COLUMN_DATA_H
@@ -20,44 +20,45 @@
  ****************************************************************************/
 #include "VariantTableModelItem.h"
 #include <Qt>
+#include <utility>
 
 // #include <QDebug>
 
 namespace Mdt{ namespace ItemModel{
 
-void VariantTableModelItem::setDisplayRoleData(const QVariant& data)
+void VariantTableModelItem::setDisplayRoleData(QVariant data)
 {
-  mDisplayRoleData = data;
+  mDisplayRoleData = std::move(data);
 }
 
-void VariantTableModelItem::setEditRoleData(const QVariant& data)
+void VariantTableModelItem::setEditRoleData(QVariant data)
 {
   if( isEditRoleDataSeparate() ){
-    mEditRoleData = data;
+    mEditRoleData = std::move(data);
   }else{
-    mDisplayRoleData = data;
+    mDisplayRoleData = std::move(data);
   }
 }
 
-void VariantTableModelItem::setData(const QVariant& data, int role)
+void VariantTableModelItem::setData(QVariant data, int role)
 {
   Q_ASSERT( (role == Qt::DisplayRole) || (role == Qt::EditRole) );
 
   if(role == Qt::DisplayRole){
-    setDisplayRoleData(data);
+    setDisplayRoleData(std::move(data));
   }else{
-    setEditRoleData(data);
+    setEditRoleData(std::move(data));
   }
 }
 
-Qt::ItemFlags VariantTableModelItem::flags(Qt::ItemFlags currentFlags) const
+Qt::ItemFlags VariantTableModelItem::flags(Qt::ItemFlags currentFlags, bool isEnabled, bool isEditable)
 {
-  if(mIsEnabled){
+  if(isEnabled){
     currentFlags |= Qt::ItemIsEnabled;
   }else{
     currentFlags &= Qt::ItemFlags(~Qt::ItemIsEnabled);
   }
-  if(mIsEditable){
+  if(isEditable){
     currentFlags |= Qt::ItemIsEditable;
   }else{
     currentFlags &= Qt::ItemFlags(~Qt::ItemIsEditable);
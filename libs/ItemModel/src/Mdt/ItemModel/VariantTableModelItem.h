@@ -49,7 +49,7 @@ namespace Mdt{ namespace ItemModel{
 
     /*! \brief Set data for display role
      */
-    void setDisplayRoleData(const QVariant & data);
+    void setDisplayRoleData(QVariant data);
 
     /*! \brief Get data for display role
      */
@@ -63,7 +63,7 @@ namespace Mdt{ namespace ItemModel{
      * If isEditRoleDataSeparate() is false,
      *  this will be the same as setDisplayRoleData()
      */
-    void setEditRoleData(const QVariant & data);
+    void setEditRoleData(QVariant data);
 
     /*! \brief Get data for edit role
      *
@@ -83,7 +83,7 @@ namespace Mdt{ namespace ItemModel{
      *
      * \pre role must be Qt::DisplayRole or Qt::EditRole
      */
-    void setData(const QVariant & data, int role);
+    void setData(QVariant data, int role);
 
     /*! \brief Get data
      *
@@ -137,7 +137,17 @@ namespace Mdt{ namespace ItemModel{
      * Returns currentFlags with Qt::ItemIsEditable and ItemIsEnabled
      *  set or unset regarding isEditable() and isEnabled().
      */
-    Qt::ItemFlags flags(Qt::ItemFlags currentFlags) const;
+    Qt::ItemFlags flags(Qt::ItemFlags currentFlags) const
+    {
+      return flags(currentFlags, mIsEnabled, mIsEditable);
+    }
+
+    /*! \brief Get flags
+     *
+     * Returns currentFlags with Qt::ItemIsEditable and ItemIsEnabled
+     *  set or unset regarding \a isEditable and \a isEnabled .
+     */
+    static Qt::ItemFlags flags(Qt::ItemFlags currentFlags, bool isEnabled, bool isEditable);
 
    private:
 
@@ -23,6 +23,7 @@
 
 #include "VariantTableModelItem.h"
 #include "VariantTableModelStorageRule.h"
+#include <utility>
 #include <vector>
 
 namespace Mdt{ namespace ItemModel{
@@ -112,12 +113,12 @@ namespace Mdt{ namespace ItemModel{
      *      ( 0 <= column < columnCount() )
      * \pre role must be Qt::DisplayRole or Qt::EditRole
      */
-    void setData(int column, const QVariant & value, int role = Qt::EditRole)
+    void setData(int column, QVariant value, int role = Qt::EditRole)
     {
       Q_ASSERT(column >= 0);
       Q_ASSERT(column < columnCount());
       Q_ASSERT( (role == Qt::DisplayRole) || (role == Qt::EditRole) );
-      mRowData[column].setData(value, role);
+      mRowData[column].setData(std::move(value), role);
     }
 
     /*! \brief Resize row to columns count of columns
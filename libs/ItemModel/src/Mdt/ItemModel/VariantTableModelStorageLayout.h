@@ -18,57 +18,22 @@
  ** along with multiDiagTools.  If not, see <http://www.gnu.org/licenses/>.
  **
  ****************************************************************************/
-#ifndef MDT_ITEM_MODEL_INDEX_FORMAT_MAP_ITEM_H
-#define MDT_ITEM_MODEL_INDEX_FORMAT_MAP_ITEM_H
-
-#include "MdtItemModelExport.h"
-#include <QVariant>
-#include <QtGlobal>
+#ifndef MDT_ITEM_MODEL_VARIANT_TABLE_MODEL_STORAGE_LAYOUT_H
+#define MDT_ITEM_MODEL_VARIANT_TABLE_MODEL_STORAGE_LAYOUT_H
 
 namespace Mdt{ namespace ItemModel{
 
-  /*! \brief Item of a IndexFormatMap
+  /*! \brief Describes how VariantTableModel lays out its items in memory
    */
-  class MDT_ITEMMODEL_EXPORT IndexFormatMapItem
+  enum class VariantTableModelStorageLayout
   {
-   public:
-
-    /*! \brief Construct a item
-     *
-     * \pre \a row must be >= 0
-     * \pre \a column must be >= 0
-     * \pre \a value must not be null
-     */
-    explicit IndexFormatMapItem(int row, int column, const QVariant & value);
-
-    /*! \brief Get row
-     */
-    int row() const
-    {
-      return mRow;
-    }
-
-    /*! \brief Get column
-     */
-    int column() const
-    {
-      return mColumn;
-    }
-
-    /*! \brief Get value
-     */
-    QVariant value() const
-    {
-      return mValue;
-    }
-
-   private:
-
-    int mRow;
-    int mColumn;
-    QVariant mValue;
+    Rows,   /*!< Each row stores a item for each column (default). */
+    Columns /*!< Each column stores its data in a contiguous typed array,
+                 and the flags of its items in bitsets.
+                 Uses less memory for numeric and string data,
+                 and scanning a column does not jump between rows. */
   };
 
-}} //namespace Mdt{ namespace ItemModel{
+}} // namespace Mdt{ namespace ItemModel{
 
-#endif // #ifndef MDT_ITEM_MODEL_INDEX_FORMAT_MAP_ITEM_H
+#endif // #ifndef MDT_ITEM_MODEL_VARIANT_TABLE_MODEL_STORAGE_LAYOUT_H
@@ -31,6 +31,9 @@
 #include "Mdt/ItemModel/Expression/ComparisonEval.h"
 #include "Mdt/ItemModel/Expression/FilterEval.h"
 #include "Mdt/ItemModel/Expression/ParentModelEvalData.h"
+#include "Mdt/ItemModel/Expression/CompiledLikePattern.h"
+#include "Mdt/ItemModel/Expression/FilterProgram.h"
+#include "Mdt/FilterExpression/LikeExpressionRegexTransform.h"
 #include "Mdt/ItemModel/FilterExpression.h"
 #include "Mdt/ItemModel/RelationFilterExpression.h"
 #include "Mdt/ItemModel/VariantTableModel.h"
@@ -430,6 +433,75 @@ void FilterExpressionTest::comparisonEvalTest()
   QVERIFY(  eval(intCol >= 2 , 0, data) );
 }
 
+void FilterExpressionTest::likePatternTest()
+{
+  using ItemModel::Expression::CompiledLikePattern;
+  using Mdt::FilterExpression::LikeExpressionRegexTransform;
+
+  QFETCH(QString, like);
+  QFETCH(QString, str);
+  QFETCH(int, matchKind);
+
+  for(const auto cs : {Qt::CaseSensitive, Qt::CaseInsensitive}){
+    CompiledLikePattern pattern(like, cs);
+    QCOMPARE(static_cast<int>(pattern.matchKind()), matchKind);
+    // Result must allways be the same as the one of the regular expression
+    QRegularExpression regex( LikeExpressionRegexTransform::getRegexPattern(like) );
+    if(cs == Qt::CaseInsensitive){
+      regex.setPatternOptions(QRegularExpression::CaseInsensitiveOption);
+    }
+    QCOMPARE(pattern.match(str), regex.match(str).hasMatch());
+  }
+}
+
+void FilterExpressionTest::likePatternTest_data()
+{
+  using ItemModel::Expression::CompiledLikePattern;
+
+  QTest::addColumn<QString>("like");
+  QTest::addColumn<QString>("str");
+  QTest::addColumn<int>("matchKind");
+
+  const int exact = CompiledLikePattern::ExactMatch;
+  const int prefix = CompiledLikePattern::PrefixMatch;
+  const int suffix = CompiledLikePattern::SuffixMatch;
+  const int contains = CompiledLikePattern::ContainsMatch;
+  const int any = CompiledLikePattern::AnyMatch;
+  const int regex = CompiledLikePattern::RegexMatch;
+
+  QTest::newRow("") << "" << "" << exact;
+  QTest::newRow("") << "" << "A" << exact;
+  QTest::newRow("") << "ABC" << "ABC" << exact;
+  QTest::newRow("") << "ABC" << "abc" << exact;
+  QTest::newRow("") << "ABC" << "ABCD" << exact;
+  QTest::newRow("") << "A.C" << "ABC" << exact;
+  QTest::newRow("") << "A.C" << "A.C" << exact;
+  QTest::newRow("") << "ABC" << "ABC\n" << exact;
+  QTest::newRow("") << "AB*" << "ABCD" << prefix;
+  QTest::newRow("") << "AB*" << "abcd" << prefix;
+  QTest::newRow("") << "AB*" << "CAB" << prefix;
+  QTest::newRow("") << "AB**" << "AB" << prefix;
+  QTest::newRow("") << "AB*" << "AB\nC" << prefix;
+  QTest::newRow("") << "*CD" << "ABCD" << suffix;
+  QTest::newRow("") << "*CD" << "abcd" << suffix;
+  QTest::newRow("") << "*CD" << "CDA" << suffix;
+  QTest::newRow("") << "*(C)" << "A(C)" << suffix;
+  QTest::newRow("") << "*BC*" << "ABCD" << contains;
+  QTest::newRow("") << "*BC*" << "abcd" << contains;
+  QTest::newRow("") << "*BC*" << "ACBD" << contains;
+  QTest::newRow("") << "*BC*" << "A\nBC" << contains;
+  QTest::newRow("") << "*" << "" << any;
+  QTest::newRow("") << "*" << "ABC" << any;
+  QTest::newRow("") << "**" << "ABC" << any;
+  QTest::newRow("") << "*" << "A\nB" << any;
+  QTest::newRow("") << "?B?" << "ABC" << regex;
+  QTest::newRow("") << "A*C" << "ABBC" << regex;
+  QTest::newRow("") << "A*C" << "ABBD" << regex;
+  QTest::newRow("") << "A\\*" << "A*" << regex;
+  QTest::newRow("") << "A\\*" << "AB" << regex;
+  QTest::newRow("") << "*A\\*" << "BA*" << regex;
+}
+
 void FilterExpressionTest::filterEvalTest()
 {
   using ItemModel::FilterColumn;
@@ -612,6 +684,156 @@ void FilterExpressionTest::relationFilterEvalTest()
   QVERIFY( !eval((id == parentId) && (code < parentCode || id < parentId), 0, row1EvalData) );
 }
 
+namespace{
+
+  template<typename Expr>
+  Mdt::ItemModel::Expression::FilterProgram compileFilterProgram(const Expr & expr)
+  {
+    using Mdt::ItemModel::Expression::FilterProgram;
+    using Mdt::ItemModel::Expression::FilterProgramCompiler;
+
+    FilterProgram program;
+    FilterProgramCompiler compiler(program);
+    boost::proto::eval(expr, compiler);
+
+    return program;
+  }
+
+} // namespace{
+
+void FilterExpressionTest::filterProgramTest()
+{
+  using ItemModel::Expression::FilterEvalData;
+  using ItemModel::Expression::FilterEval;
+  using ItemModel::Expression::FilterInstruction;
+  using Like = ItemModel::LikeExpression;
+
+  /*
+   * Setup table model:
+   * -------------
+   * | Id | Name |
+   * -------------
+   * | 1  | ABC  |
+   * -------------
+   * | 2  | abd  |
+   * -------------
+   * | 3  | B    |
+   * -------------
+   * | 30 | XA   |
+   * -------------
+   */
+  VariantTableModel model;
+  model.resize(4, 2);
+  model.populateColumn(0, {1,2,3,30});
+  model.populateColumn(1, {"ABC","abd","B","XA"});
+  FilterColumn Id(0);
+  FilterColumn Name(1);
+  /*
+   * Check compiled instructions
+   */
+  auto program = compileFilterProgram( Id > 25 && (Name == "X" || Name == Like("Y*")) );
+  QCOMPARE(program.instructions().size(), 5);
+  QCOMPARE(program.columns().size(), 2);
+  QVERIFY(program.parentModelColumns().isEmpty());
+  QVERIFY(program.instructions().at(0).opCode == FilterInstruction::CompareVariant);
+  QVERIFY(program.instructions().at(0).comparison == FilterInstruction::Greater);
+  QVERIFY(program.instructions().at(1).opCode == FilterInstruction::JumpIfFalse);
+  QCOMPARE(program.instructions().at(1).operand, 5);
+  QVERIFY(program.instructions().at(2).opCode == FilterInstruction::CompareString);
+  QVERIFY(program.instructions().at(3).opCode == FilterInstruction::JumpIfTrue);
+  QCOMPARE(program.instructions().at(3).operand, 5);
+  QVERIFY(program.instructions().at(4).opCode == FilterInstruction::CompareLike);
+  // Same column is only listed once
+  program = compileFilterProgram( Id > 1 && Id < 5 );
+  QCOMPARE(program.columns().size(), 1);
+  /*
+   * Program must give the same result than FilterEval
+   */
+#define MDT_COMPARE_PROGRAM_TO_EVAL(expr) \
+  program = compileFilterProgram(expr); \
+  for(int row = 0; row < model.rowCount(); ++row){ \
+    for(const auto cs : {Qt::CaseSensitive, Qt::CaseInsensitive}){ \
+      const FilterEvalData data(&model, row, cs); \
+      FilterEval eval; \
+      const bool expected = eval(expr, 0, data); \
+      QCOMPARE(program.eval(data), expected); \
+    } \
+  }
+
+  MDT_COMPARE_PROGRAM_TO_EVAL( Id == 1 )
+  MDT_COMPARE_PROGRAM_TO_EVAL( Id != 1 )
+  MDT_COMPARE_PROGRAM_TO_EVAL( Id < 3 )
+  MDT_COMPARE_PROGRAM_TO_EVAL( Id <= 3 )
+  MDT_COMPARE_PROGRAM_TO_EVAL( Id > 2 )
+  MDT_COMPARE_PROGRAM_TO_EVAL( Id >= 2 )
+  MDT_COMPARE_PROGRAM_TO_EVAL( Name == "abc" )
+  MDT_COMPARE_PROGRAM_TO_EVAL( Name != "abc" )
+  MDT_COMPARE_PROGRAM_TO_EVAL( Name < "B" )
+  MDT_COMPARE_PROGRAM_TO_EVAL( Name <= "B" )
+  MDT_COMPARE_PROGRAM_TO_EVAL( Name > "ab" )
+  MDT_COMPARE_PROGRAM_TO_EVAL( Name >= "ab" )
+  MDT_COMPARE_PROGRAM_TO_EVAL( Name == Like("a*") )
+  MDT_COMPARE_PROGRAM_TO_EVAL( Name == Like("?B?") )
+  MDT_COMPARE_PROGRAM_TO_EVAL( Id > 1 && Name == Like("*A") )
+  MDT_COMPARE_PROGRAM_TO_EVAL( Id > 1 || Name == Like("*C") )
+  MDT_COMPARE_PROGRAM_TO_EVAL( Id == 1 && Name == "B" && Name == "C" )
+  MDT_COMPARE_PROGRAM_TO_EVAL( (Id > 5) || (Name == "A") || (Name == "B") )
+  MDT_COMPARE_PROGRAM_TO_EVAL( Id > 10 || ((Id < 5)&&(Name == Like("?B?"))) )
+  MDT_COMPARE_PROGRAM_TO_EVAL( (Id > 0 && ((Name == "abd")||(Name == "B"))) || Id == 30 )
+  MDT_COMPARE_PROGRAM_TO_EVAL( (Id < 3 || Id > 20) && (Name == Like("a*") || Name == Like("x*")) )
+
+#undef MDT_COMPARE_PROGRAM_TO_EVAL
+}
+
+void FilterExpressionTest::relationFilterProgramTest()
+{
+  using ItemModel::Expression::FilterEvalData;
+  using ItemModel::Expression::ParentModelEvalData;
+  using ItemModel::Expression::FilterEval;
+  using ItemModel::Expression::FilterProgram;
+
+  /*
+   * Setup parent table model
+   */
+  VariantTableModel parentModel;
+  parentModel.resize(1, 2);
+  parentModel.populateColumn(0, {2});
+  parentModel.populateColumn(1, {"B"});
+  /*
+   * Setup (child) table model
+   */
+  VariantTableModel model;
+  model.resize(3, 2);
+  model.populateColumn(0, {1,2,3});
+  model.populateColumn(1, {"A","B","C"});
+  ParentModelColumn parentId(0);
+  ParentModelColumn parentCode(1);
+  FilterColumn id(0);
+  FilterColumn code(1);
+  FilterProgram program;
+
+#define MDT_COMPARE_PROGRAM_TO_EVAL(expr) \
+  program = compileFilterProgram(expr); \
+  for(int row = 0; row < model.rowCount(); ++row){ \
+    const FilterEvalData data(&model, row, ParentModelEvalData(&parentModel, 0), Qt::CaseInsensitive); \
+    FilterEval eval; \
+    QCOMPARE(program.eval(data), eval(expr, 0, data)); \
+  }
+
+  MDT_COMPARE_PROGRAM_TO_EVAL( id == parentId )
+  MDT_COMPARE_PROGRAM_TO_EVAL( id != parentId )
+  MDT_COMPARE_PROGRAM_TO_EVAL( id < parentId )
+  MDT_COMPARE_PROGRAM_TO_EVAL( id <= parentId )
+  MDT_COMPARE_PROGRAM_TO_EVAL( id > parentId )
+  MDT_COMPARE_PROGRAM_TO_EVAL( id >= parentId )
+  MDT_COMPARE_PROGRAM_TO_EVAL( (id == parentId) || (code == parentCode && id == parentId) )
+  MDT_COMPARE_PROGRAM_TO_EVAL( (id == parentId) && (code < parentCode || id < parentId) )
+  MDT_COMPARE_PROGRAM_TO_EVAL( code == parentCode && id > 1 )
+  QCOMPARE(program.parentModelColumns().size(), 1);
+
+#undef MDT_COMPARE_PROGRAM_TO_EVAL
+}
+
 void FilterExpressionTest::expressionCopyTest()
 {
   using ItemModel::FilterColumn;
@@ -59,9 +59,13 @@ class FilterExpressionTest : public QObject
   void parentModelEvalDataTest();
   void evalDataTest();
   void comparisonEvalTest();
+  void likePatternTest();
+  void likePatternTest_data();
   void filterEvalTest();
   void filterEvalItemRoleTest();
   void relationFilterEvalTest();
+  void filterProgramTest();
+  void relationFilterProgramTest();
 
   void expressionCopyTest();
   void expressionTest();
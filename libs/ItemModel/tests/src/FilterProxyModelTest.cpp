@@ -235,6 +235,111 @@ void FilterProxyModelTest::filterLikeBenchmark_data()
   QTest::newRow("10'000 el.") << 10000;
 }
 
+void FilterProxyModelTest::parallelFilterTest()
+{
+  QModelIndex index;
+  VariantTableModel model;
+  FilterProxyModel proxyModel;
+  FilterColumn A(0);
+  FilterColumn B(1);
+  /*
+   * Setup models
+   */
+  model.populate(1000, 3);
+  proxyModel.setSourceModel(&model);
+  proxyModel.setFilterCaseSensitivity(Qt::CaseInsensitive);
+  QVERIFY(!proxyModel.isParallelFilterEnabled());
+  QCOMPARE(proxyModel.parallelFilterThreshold(), 10000);
+  proxyModel.setParallelFilterEnabled(true);
+  proxyModel.setParallelFilterThreshold(0);
+  QVERIFY(proxyModel.isParallelFilterEnabled());
+  QCOMPARE(proxyModel.parallelFilterThreshold(), 0);
+  /*
+   * Filter in parallel
+   */
+  proxyModel.setFilter(A == Like("1?A") && B == Like("1?b"));
+  QCOMPARE(proxyModel.rowCount(), 10);
+  QCOMPARE(getModelData(proxyModel, 0, 0), QVariant("10A"));
+  QCOMPARE(getModelData(proxyModel, 9, 0), QVariant("19A"));
+  proxyModel.setFilter(A != "8A" && B == "10B");
+  QCOMPARE(proxyModel.rowCount(), 1);
+  QCOMPARE(getModelData(proxyModel, 0, 1), QVariant("10B"));
+  /*
+   * Change case sensitivity
+   * (filter is evaluated again by QSortFilterProxyModel)
+   */
+  proxyModel.setFilterCaseSensitivity(Qt::CaseSensitive);
+  QCOMPARE(proxyModel.rowCount(), 1);
+  proxyModel.setFilter(A == Like("1?A") && B == Like("1?b"));
+  QCOMPARE(proxyModel.rowCount(), 0);
+  proxyModel.setFilter(A == Like("1?A") && B == Like("1?B"));
+  QCOMPARE(proxyModel.rowCount(), 10);
+  /*
+   * Source model changes must be considered
+   */
+  proxyModel.setDynamicSortFilter(true);
+  index = model.index(500, 0);
+  QVERIFY(model.setData(index, "11A"));
+  index = model.index(500, 1);
+  QVERIFY(model.setData(index, "11B"));
+  QCOMPARE(proxyModel.rowCount(), 11);
+  QVERIFY(model.insertRows(0, 1));
+  index = model.index(0, 0);
+  QVERIFY(model.setData(index, "12A"));
+  index = model.index(0, 1);
+  QVERIFY(model.setData(index, "12B"));
+  QCOMPARE(proxyModel.rowCount(), 12);
+  QVERIFY(model.removeRows(0, 1));
+  QCOMPARE(proxyModel.rowCount(), 11);
+  /*
+   * Disable parallel filter
+   */
+  proxyModel.setParallelFilterEnabled(false);
+  proxyModel.setFilter(A == Like("1?A") && B == Like("1?B"));
+  QCOMPARE(proxyModel.rowCount(), 11);
+}
+
+void FilterProxyModelTest::parallelFilterLikeBenchmark()
+{
+  QFETCH(int, N);
+  QModelIndex index;
+  VariantTableModel model;
+  FilterProxyModel proxyModel;
+  FilterColumn A(0);
+  FilterColumn B(1);
+  /*
+   * Setup models
+   */
+  QVERIFY(N >= 20);
+  model.populate(N, 3);
+  proxyModel.setSourceModel(&model);
+  proxyModel.setFilterCaseSensitivity(Qt::CaseInsensitive);
+  proxyModel.setParallelFilterEnabled(true);
+  proxyModel.setParallelFilterThreshold(0);
+  QCOMPARE(proxyModel.rowCount(), N);
+  QCOMPARE(proxyModel.columnCount(), 3);
+  QBENCHMARK{
+    proxyModel.setFilter(A == Like("1?A") && B == Like("1?B"));
+  }
+  QCOMPARE(proxyModel.rowCount(), 10);
+  index = proxyModel.index(0, 0);
+  QVERIFY(index.isValid());
+  QCOMPARE(proxyModel.data(index), QVariant("10A"));
+  index = proxyModel.index(9, 0);
+  QVERIFY(index.isValid());
+  QCOMPARE(proxyModel.data(index), QVariant("19A"));
+}
+
+void FilterProxyModelTest::parallelFilterLikeBenchmark_data()
+{
+  QTest::addColumn<int>("N");
+
+  QTest::newRow("20 el.") << 20;
+  QTest::newRow("100 el.") << 100;
+  QTest::newRow("1'000 el.") << 1000;
+  QTest::newRow("10'000 el.") << 10000;
+}
+
 void FilterProxyModelTest::filterRoleTest()
 {
   QSKIP("Need more experience to implement");
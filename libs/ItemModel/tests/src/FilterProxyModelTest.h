@@ -42,6 +42,9 @@ class FilterProxyModelTest : public QObject
   void filterBenchmark_data();
   void filterLikeBenchmark();
   void filterLikeBenchmark_data();
+  void parallelFilterTest();
+  void parallelFilterLikeBenchmark();
+  void parallelFilterLikeBenchmark_data();
 
   /*! \todo Implement those tests
    *
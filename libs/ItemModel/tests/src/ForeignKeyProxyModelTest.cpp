@@ -215,6 +215,31 @@ void ForeignKeyProxyModelTest::mapMostRestrictiveFlagsForColumnTest()
   flags = mapB.getMostRestrictiveFlagsForColumn(2);
   QVERIFY(flags.isForeignKeyItemsEnabled());
   QVERIFY(!flags.isForeignKeyEditable());
+  // Columns that are not part of a foreign key
+  flags = mapB.getMostRestrictiveFlagsForColumn(0);
+  QVERIFY(flags.isForeignKeyItemsEnabled());
+  QVERIFY(flags.isForeignKeyEditable());
+  flags = mapB.getMostRestrictiveFlagsForColumn(5);
+  QVERIFY(flags.isForeignKeyItemsEnabled());
+  QVERIFY(flags.isForeignKeyEditable());
+  /*
+   * Flags must follow changes of foreign keys
+   */
+  mapB.setAllForeignKeysItemsEnabled(false);
+  flags = mapB.getMostRestrictiveFlagsForColumn(1);
+  QVERIFY(!flags.isForeignKeyItemsEnabled());
+  QVERIFY(!flags.isForeignKeyEditable());
+  mapB.removeForeignKey("FK12");
+  flags = mapB.getMostRestrictiveFlagsForColumn(1);
+  QVERIFY(!flags.isForeignKeyItemsEnabled());
+  QVERIFY(flags.isForeignKeyEditable());
+  flags = mapB.getMostRestrictiveFlagsForColumn(2);
+  QVERIFY(flags.isForeignKeyItemsEnabled());
+  QVERIFY(flags.isForeignKeyEditable());
+  mapB.removeAllForeignKeys();
+  flags = mapB.getMostRestrictiveFlagsForColumn(1);
+  QVERIFY(flags.isForeignKeyItemsEnabled());
+  QVERIFY(flags.isForeignKeyEditable());
 }
 
 void ForeignKeyProxyModelTest::mapMostRestrictiveFlagsForColumnBenchmark()
@@ -23,6 +23,10 @@
 #include "Mdt/ItemModel/RowFormatMap.h"
 #include "Mdt/ItemModel/ColumnFormatMap.h"
 #include "Mdt/ItemModel/FormatMap.h"
+#include "Mdt/ItemModel/RangeFormatMap.h"
+#include "Mdt/ItemModel/ConditionalFormatMap.h"
+#include "Mdt/ItemModel/FilterColumn.h"
+#include "Mdt/ItemModel/VariantTableModel.h"
 #include <QFont>
 #include <Qt>
 #include <QBrush>
@@ -46,34 +50,6 @@ void FormatMapTest::cleanupTestCase()
  * Tests
  */
 
-void FormatMapTest::indexItemQFontTest()
-{
-  QFont font("Times", 10);
-  IndexFormatMapItem item(1, 2, font);
-  QCOMPARE(item.row(), 1);
-  QCOMPARE(item.column(), 2);
-  QCOMPARE(item.value().value<QFont>().pointSize(), 10);
-}
-
-void FormatMapTest::indexItemQFlagsEnumTest()
-{
-  IndexFormatMapItem item(1, 2, Qt::AlignCenter);
-  QCOMPARE(item.row(), 1);
-  QCOMPARE(item.column(), 2);
-  QCOMPARE(item.value(), QVariant(Qt::AlignCenter));
-}
-
-void FormatMapTest::indexItemQBrushTest()
-{
-  QBrush brush(QColor(50, 100, 200));
-  IndexFormatMapItem item(1, 2, brush);
-  QCOMPARE(item.row(), 1);
-  QCOMPARE(item.column(), 2);
-  QCOMPARE(item.value().value<QBrush>().color().red(), 50);
-  QCOMPARE(item.value().value<QBrush>().color().green(), 100);
-  QCOMPARE(item.value().value<QBrush>().color().blue(), 200);
-}
-
 void FormatMapTest::indexMapQFontTest()
 {
   IndexFormatMap map;
@@ -216,6 +192,7 @@ void FormatMapTest::rowColumnMapBaseQFlagsEnumTest()
    * Initial state
    */
   RowColumnFormatMapBase map;
+  QVERIFY(map.isEmpty());
   QVERIFY(map.formatForIndex(0).isNull());
   QVERIFY(map.formatForIndex(3).isNull());
   QVERIFY(map.formatForIndex(1).isNull());
@@ -224,6 +201,7 @@ void FormatMapTest::rowColumnMapBaseQFlagsEnumTest()
    */
   // Set for column 0
   map.setFormatVariantForIndex(0, Qt::AlignCenter);
+  QVERIFY(!map.isEmpty());
   QCOMPARE(map.formatForIndex(0), QVariant(Qt::AlignCenter));
   QVERIFY(map.formatForIndex(3).isNull());
   QVERIFY(map.formatForIndex(1).isNull());
@@ -277,6 +255,7 @@ void FormatMapTest::rowColumnMapBaseQFlagsEnumTest()
   QVERIFY(map.formatForIndex(0).isNull());
   QVERIFY(map.formatForIndex(3).isNull());
   QVERIFY(map.formatForIndex(1).isNull());
+  QVERIFY(map.isEmpty());
 }
 
 void FormatMapTest::rowColumnMapBaseQBrushTest()
@@ -291,6 +270,51 @@ void FormatMapTest::rowColumnMapBaseQBrushTest()
   QCOMPARE(map.formatForIndex(1).value<QBrush>().color().blue(), 30);
 }
 
+void FormatMapTest::rangeMapQFlagsEnumTest()
+{
+  /*
+   * Initial state
+   */
+  RangeFormatMap map;
+  QVERIFY(map.isEmpty());
+  QVERIFY(map.formatForIndex(0, 0).isNull());
+  /*
+   * Set alignment for rows 1 to 3, columns 0 to 1
+   */
+  map.setFormatVariantForRange(1, 0, 3, 1, Qt::AlignLeft);
+  QVERIFY(!map.isEmpty());
+  QCOMPARE(map.rangeCount(), 1);
+  QVERIFY(map.formatForIndex(0, 0).isNull());
+  QCOMPARE(map.formatForIndex(1, 0), QVariant(Qt::AlignLeft));
+  QCOMPARE(map.formatForIndex(3, 1), QVariant(Qt::AlignLeft));
+  QVERIFY(map.formatForIndex(3, 2).isNull());
+  QVERIFY(map.formatForIndex(4, 0).isNull());
+  /*
+   * Set alignment for a range that overlaps: last set wins
+   */
+  map.setFormatVariantForRange(2, 1, 5, 2, Qt::AlignRight);
+  QCOMPARE(map.formatForIndex(1, 1), QVariant(Qt::AlignLeft));
+  QCOMPARE(map.formatForIndex(2, 0), QVariant(Qt::AlignLeft));
+  QCOMPARE(map.formatForIndex(2, 1), QVariant(Qt::AlignRight));
+  QCOMPARE(map.formatForIndex(5, 2), QVariant(Qt::AlignRight));
+  QVERIFY(map.formatForIndex(5, 0).isNull());
+  /*
+   * Clear a part of both ranges
+   */
+  map.clearFormatForRange(2, 0, 2, 2);
+  QVERIFY(map.formatForIndex(2, 0).isNull());
+  QVERIFY(map.formatForIndex(2, 1).isNull());
+  QCOMPARE(map.formatForIndex(1, 0), QVariant(Qt::AlignLeft));
+  QCOMPARE(map.formatForIndex(3, 0), QVariant(Qt::AlignLeft));
+  QCOMPARE(map.formatForIndex(3, 1), QVariant(Qt::AlignRight));
+  /*
+   * Clear all
+   */
+  map.clearFormatForRange(0, 0, 10, 10);
+  QVERIFY(map.isEmpty());
+  QVERIFY(map.formatForIndex(3, 1).isNull());
+}
+
 void FormatMapTest::rowMapQFlagsEnumTest()
 {
   RowFormatMap map;
@@ -388,6 +412,117 @@ void FormatMapTest::mapPriorityQFlagsEnumTest()
   QCOMPARE(map.formatForIndex(2, 1), QVariant(Qt::AlignRight));
 }
 
+void FormatMapTest::mapIsEmptyTest()
+{
+  FormatMap map;
+  QVERIFY(map.isEmpty());
+  QVERIFY(map.formatForIndex(1, 2).isNull());
+  /*
+   * Index format
+   */
+  map.setFormatForIndex(1, 2, Qt::AlignLeft);
+  QVERIFY(!map.isEmpty());
+  map.clearFormatForIndex(1, 2);
+  QVERIFY(map.isEmpty());
+  /*
+   * Row format
+   */
+  map.setFormatForRow(1, Qt::AlignLeft);
+  QVERIFY(!map.isEmpty());
+  map.clearFormatForRow(1);
+  QVERIFY(map.isEmpty());
+  /*
+   * Column format
+   */
+  map.setFormatForColumn(2, Qt::AlignLeft);
+  QVERIFY(!map.isEmpty());
+  map.clearFormatForColumn(2);
+  QVERIFY(map.isEmpty());
+  QVERIFY(map.formatForIndex(1, 2).isNull());
+}
+
+void FormatMapTest::conditionalMapTest()
+{
+  FilterColumn amount(1);
+  /*
+   * Setup model
+   *  -------
+   *  | A | 5|
+   *  -------
+   *  | B |-3|
+   *  -------
+   *  | C | 0|
+   *  -------
+   */
+  VariantTableModel model;
+  model.resize(3, 2);
+  model.populateColumn(0, {"A","B","C"});
+  model.populateColumn(1, {5,-3,0});
+  /*
+   * Initial state
+   */
+  ConditionalFormatMap map;
+  QVERIFY(map.isEmpty());
+  QCOMPARE(map.ruleCount(), 0);
+  QVERIFY(map.formatForRow(&model, 0).isNull());
+  QVERIFY(!map.isRowEvaluated(0));
+  /*
+   * Add rules, the first one that matches wins
+   */
+  map.addRule(amount < 0, QVariant(Qt::AlignLeft));
+  map.addRule(amount < 10, QVariant(Qt::AlignRight));
+  QVERIFY(!map.isEmpty());
+  QCOMPARE(map.ruleCount(), 2);
+  QVERIFY(!map.isRowEvaluated(0));
+  QCOMPARE(map.formatForRow(&model, 1).toInt(), (int)Qt::AlignLeft);
+  QVERIFY(map.isRowEvaluated(1));
+  QVERIFY(!map.isRowEvaluated(0));
+  QVERIFY(!map.isRowEvaluated(2));
+  QCOMPARE(map.formatForRow(&model, 0).toInt(), (int)Qt::AlignRight);
+  QVERIFY(map.isRowEvaluated(0));
+  /*
+   * Update rows after data changed
+   */
+  QVERIFY(model.setData(0, 1, 20));
+  QVERIFY(map.updateRow(&model, 0));
+  QVERIFY(map.formatForRow(&model, 0).isNull());
+  QVERIFY(!map.updateRow(&model, 0));
+  // Row 2 was never evaluated
+  QVERIFY(model.setData(2, 1, -1));
+  QVERIFY(!map.updateRow(&model, 2));
+  QVERIFY(!map.isRowEvaluated(2));
+  QCOMPARE(map.formatForRow(&model, 2).toInt(), (int)Qt::AlignLeft);
+  /*
+   * Insert and remove rows
+   */
+  model.prependRow();
+  map.insertRows(0, 1);
+  QVERIFY(!map.isRowEvaluated(0));
+  QVERIFY(map.isRowEvaluated(1));
+  QVERIFY(map.isRowEvaluated(2));
+  QCOMPARE(map.formatForRow(&model, 2).toInt(), (int)Qt::AlignLeft);
+  model.removeFirstRow();
+  map.removeRows(0, 1);
+  QVERIFY(map.isRowEvaluated(0));
+  QVERIFY(map.formatForRow(&model, 0).isNull());
+  QCOMPARE(map.formatForRow(&model, 1).toInt(), (int)Qt::AlignLeft);
+  /*
+   * Clear cache
+   */
+  map.clearCache();
+  QVERIFY(!map.isRowEvaluated(0));
+  QVERIFY(!map.isRowEvaluated(1));
+  QCOMPARE(map.formatForRow(&model, 1).toInt(), (int)Qt::AlignLeft);
+  /*
+   * A rule on a column that does not exist never matches
+   */
+  map.clearRules();
+  QVERIFY(map.isEmpty());
+  QVERIFY(!map.isRowEvaluated(1));
+  map.addRule(FilterColumn(5) == 1, QVariant(Qt::AlignLeft));
+  QVERIFY(map.formatForRow(&model, 0).isNull());
+}
+
 void FormatMapTest::mapQFontBenchmark()
 {
   FormatMap map;
@@ -426,6 +561,41 @@ void FormatMapTest::mapQFlagsEnumBenchmark()
   }
 }
 
+void FormatMapTest::mapManyIndexFormatsBenchmark()
+{
+  QFETCH(int, n);
+  FormatMap map;
+  /*
+   * Set a format for each cell in column 1,
+   * and for every second row
+   */
+  for(int row = 0; row < n; ++row){
+    map.setFormatForIndex(row, 1, Qt::AlignLeft);
+    if(row % 2){
+      map.setFormatForRow(row, Qt::AlignRight);
+    }
+  }
+  QBENCHMARK{
+    for(int row = 0; row < n; ++row){
+      QCOMPARE(map.formatForIndex(row, 1).toInt(), (int)Qt::AlignLeft);
+      if(row % 2){
+        QCOMPARE(map.formatForIndex(row, 0).toInt(), (int)Qt::AlignRight);
+      }else{
+        QVERIFY(map.formatForIndex(row, 0).isNull());
+      }
+    }
+  }
+}
+
+void FormatMapTest::mapManyIndexFormatsBenchmark_data()
+{
+  QTest::addColumn<int>("n");
+
+  QTest::newRow("10") << 10;
+  QTest::newRow("1'000") << 1000;
+  QTest::newRow("10'000") << 10000;
+}
+
 /*
  * Main
  */
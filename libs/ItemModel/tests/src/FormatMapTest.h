@@ -32,10 +32,6 @@ class FormatMapTest : public TestBase
   void initTestCase();
   void cleanupTestCase();
 
-  void indexItemQFontTest();
-  void indexItemQFlagsEnumTest();
-  void indexItemQBrushTest();
-
   void indexMapQFontTest();
   void indexMapQFlagsEnumTest();
   void indexMapQBrushTest();
@@ -48,6 +44,7 @@ class FormatMapTest : public TestBase
   void rowColumnMapBaseQFlagsEnumTest();
   void rowColumnMapBaseQBrushTest();
 
+  void rangeMapQFlagsEnumTest();
   void rowMapQFlagsEnumTest();
   void columnMapQFlagsEnumTest();
 
@@ -55,9 +52,13 @@ class FormatMapTest : public TestBase
   void mapRowQFlagsEnumTest();
   void mapColumnQFlagsEnumTest();
   void mapPriorityQFlagsEnumTest();
+  void mapIsEmptyTest();
+  void conditionalMapTest();
 
   void mapQFontBenchmark();
   void mapQFlagsEnumBenchmark();
+  void mapManyIndexFormatsBenchmark();
+  void mapManyIndexFormatsBenchmark_data();
 };
 
 #endif // #ifndef MDT_ITEM_MODEL_FORMAT_MAP_TEST_H
@@ -22,6 +22,7 @@
 #include "qtmodeltest.h"
 #include "Mdt/ItemModel/FormatProxyModel.h"
 #include "Mdt/ItemModel/VariantTableModel.h"
+#include "Mdt/ItemModel/FilterColumn.h"
 #include <QSignalSpy>
 #include <QVariantList>
 #include <QVector>
@@ -783,6 +784,338 @@ void FormatProxyModelTest::backgroundColorSignalTest()
   QCOMPARE(roles.at(0), (int)Qt::BackgroundRole);
 }
 
+void FormatProxyModelTest::rangeFormatTest()
+{
+  RowRange rowRange;
+  ColumnRange columnRange;
+  /*
+   * Setup model
+   */
+  VariantTableModel model;
+  model.resize(5, 3);
+  /*
+   * Setup proxy model
+   */
+  FormatProxyModel proxyModel;
+  proxyModel.setSourceModel(&model);
+  /*
+   * Setup background colors (we only check red part):
+   *         0    1    2
+   *      ----------------
+   *    0 |    |    |    |
+   *      ----------------
+   *    1 | 20 | 20 | 20 |
+   *      ----------------
+   *    2 | 20 | 30 | 30 |
+   *      ----------------
+   *    3 | 20 | 30 | 30 |
+   *      ----------------
+   *    4 |    |    |    |
+   *      ----------------
+   */
+  rowRange.setFirstRow(1);
+  rowRange.setLastRow(3);
+  proxyModel.setBackgroundColorForRowRange(rowRange, QColor(20, 0, 0));
+  rowRange.setFirstRow(2);
+  columnRange.setFirstColumn(1);
+  columnRange.setLastColumn(2);
+  proxyModel.setBackgroundColorForRange(rowRange, columnRange, QColor(30, 0, 0));
+  QVERIFY(proxyModel.backgroundBrush(0, 0).isNull());
+  QCOMPARE(proxyModel.backgroundBrush(1, 0).value<QBrush>().color().red(), 20);
+  QCOMPARE(proxyModel.backgroundBrush(1, 2).value<QBrush>().color().red(), 20);
+  QCOMPARE(proxyModel.backgroundBrush(2, 0).value<QBrush>().color().red(), 20);
+  QCOMPARE(proxyModel.backgroundBrush(2, 1).value<QBrush>().color().red(), 30);
+  QCOMPARE(proxyModel.backgroundBrush(3, 2).value<QBrush>().color().red(), 30);
+  QVERIFY(proxyModel.backgroundBrush(4, 1).isNull());
+  // Check data for BackgroundRole
+  QCOMPARE(getModelData(proxyModel, 3, 1, Qt::BackgroundRole).value<QBrush>().color().red(), 30);
+  /*
+   * A format for a single row or index takes precedence over a range
+   */
+  proxyModel.setBackgroundColorForRow(1, QColor(40, 0, 0));
+  proxyModel.setBackgroundColorForIndex(3, 2, QColor(50, 0, 0));
+  QCOMPARE(proxyModel.backgroundBrush(1, 0).value<QBrush>().color().red(), 40);
+  QCOMPARE(proxyModel.backgroundBrush(3, 2).value<QBrush>().color().red(), 50);
+  QCOMPARE(proxyModel.backgroundBrush(3, 1).value<QBrush>().color().red(), 30);
+  proxyModel.clearBackgroundBrushForRow(1);
+  proxyModel.clearBackgroundBrushForIndex(3, 2);
+  /*
+   * Clear a part of the row range
+   */
+  rowRange.setFirstRow(2);
+  rowRange.setLastRow(2);
+  proxyModel.clearBackgroundBrushForRowRange(rowRange);
+  QCOMPARE(proxyModel.backgroundBrush(1, 0).value<QBrush>().color().red(), 20);
+  QVERIFY(proxyModel.backgroundBrush(2, 0).isNull());
+  QCOMPARE(proxyModel.backgroundBrush(2, 1).value<QBrush>().color().red(), 30);
+  QCOMPARE(proxyModel.backgroundBrush(3, 0).value<QBrush>().color().red(), 20);
+  /*
+   * Clear the index range
+   */
+  rowRange.setFirstRow(0);
+  rowRange.setLastRow(4);
+  columnRange.setFirstColumn(0);
+  columnRange.setLastColumn(2);
+  proxyModel.clearBackgroundBrushForRange(rowRange, columnRange);
+  QVERIFY(proxyModel.backgroundBrush(2, 1).isNull());
+  QVERIFY(proxyModel.backgroundBrush(3, 2).isNull());
+  QCOMPARE(proxyModel.backgroundBrush(3, 0).value<QBrush>().color().red(), 20);
+  /*
+   * Other formats
+   */
+  rowRange.setFirstRow(0);
+  rowRange.setLastRow(1);
+  proxyModel.setTextAlignmentForRowRange(rowRange, Qt::AlignCenter);
+  proxyModel.setTextColorForRowRange(rowRange, QColor(60, 0, 0));
+  columnRange.setFirstColumn(1);
+  columnRange.setLastColumn(1);
+  QFont font;
+  font.setPointSize(15);
+  proxyModel.setTextFontForRange(rowRange, columnRange, font);
+  QCOMPARE(proxyModel.textAlignment(1, 2), QVariant(Qt::AlignCenter));
+  QVERIFY(proxyModel.textAlignment(2, 2).isNull());
+  QCOMPARE(proxyModel.foregroundBrush(0, 0).value<QBrush>().color().red(), 60);
+  QCOMPARE(proxyModel.textFont(1, 1).value<QFont>().pointSize(), 15);
+  QVERIFY(proxyModel.textFont(1, 0).isNull());
+  proxyModel.clearTextAlignmentForRowRange(rowRange);
+  proxyModel.clearTextColorForRowRange(rowRange);
+  proxyModel.clearTextFontForRange(rowRange, columnRange);
+  QVERIFY(proxyModel.textAlignment(1, 2).isNull());
+  QVERIFY(proxyModel.foregroundBrush(0, 0).isNull());
+  QVERIFY(proxyModel.textFont(1, 1).isNull());
+}
+
+void FormatProxyModelTest::rangeFormatSignalTest()
+{
+  QVariantList arguments;
+  QModelIndex index;
+  QVector<int> roles;
+  RowRange rowRange;
+  ColumnRange columnRange;
+  /*
+   * Setup model
+   */
+  VariantTableModel model;
+  model.resize(4, 3);
+  /*
+   * Setup proxy model
+   */
+  FormatProxyModel proxyModel;
+  proxyModel.setSourceModel(&model);
+  QSignalSpy dataChangedSpy(&proxyModel, &FormatProxyModel::dataChanged);
+  QVERIFY(dataChangedSpy.isValid());
+  /*
+   * Row range: one signal for all rows and columns
+   */
+  rowRange.setFirstRow(1);
+  rowRange.setLastRow(2);
+  proxyModel.setBackgroundColorForRowRange(rowRange, Qt::red);
+  QCOMPARE(dataChangedSpy.count(), 1);
+  arguments = dataChangedSpy.takeFirst();
+  QCOMPARE(arguments.count(), 3);
+  index = arguments.at(0).toModelIndex(); // topLeft
+  QCOMPARE(index.row(), 1);
+  QCOMPARE(index.column(), 0);
+  index = arguments.at(1).toModelIndex(); // bottomRight
+  QCOMPARE(index.row(), 2);
+  QCOMPARE(index.column(), 2);
+  roles = arguments.at(2).value< QVector<int> >();
+  QCOMPARE(roles.size(), 1);
+  QCOMPARE(roles.at(0), (int)Qt::BackgroundRole);
+  /*
+   * Index range that goes beyond the model: signal only the part in the model
+   */
+  rowRange.setFirstRow(2);
+  rowRange.setLastRow(100);
+  columnRange.setFirstColumn(1);
+  columnRange.setLastColumn(10);
+  proxyModel.setTextColorForRange(rowRange, columnRange, Qt::blue);
+  QCOMPARE(dataChangedSpy.count(), 1);
+  arguments = dataChangedSpy.takeFirst();
+  index = arguments.at(0).toModelIndex(); // topLeft
+  QCOMPARE(index.row(), 2);
+  QCOMPARE(index.column(), 1);
+  index = arguments.at(1).toModelIndex(); // bottomRight
+  QCOMPARE(index.row(), 3);
+  QCOMPARE(index.column(), 2);
+  roles = arguments.at(2).value< QVector<int> >();
+  QCOMPARE(roles.size(), 1);
+  QCOMPARE(roles.at(0), (int)Qt::ForegroundRole);
+  /*
+   * Range completely outside the model: no signal
+   */
+  rowRange.setFirstRow(10);
+  rowRange.setLastRow(20);
+  proxyModel.clearTextColorForRange(rowRange, columnRange);
+  QCOMPARE(dataChangedSpy.count(), 0);
+}
+
+void FormatProxyModelTest::conditionalFormatTest()
+{
+  FilterColumn amount(1);
+  /*
+   * Setup model
+   */
+  VariantTableModel model;
+  model.resize(4, 2);
+  model.populateColumn(0, {"A","B","C","D"});
+  model.populateColumn(1, {5,-3,0,-20});
+  /*
+   * Setup proxy model
+   */
+  FormatProxyModel proxyModel;
+  proxyModel.setSourceModel(&model);
+  /*
+   * Add rules, the first one that matches a row wins
+   */
+  proxyModel.addTextColorRule(amount < 0, Qt::red);
+  proxyModel.addTextColorRule(amount < -10, Qt::blue);
+  proxyModel.addBackgroundColorRule(amount == 0, QColor(10, 0, 0));
+  proxyModel.addTextFontRule(amount > 0, QFont("Arial", 12));
+  proxyModel.addTextAlignmentRule(amount >= 0, Qt::AlignRight);
+  QVERIFY(proxyModel.foregroundBrush(0, 0).isNull());
+  QCOMPARE(proxyModel.foregroundBrush(1, 0).value<QBrush>().color(), QColor(Qt::red));
+  QCOMPARE(proxyModel.foregroundBrush(1, 1).value<QBrush>().color(), QColor(Qt::red));
+  QVERIFY(proxyModel.foregroundBrush(2, 1).isNull());
+  QCOMPARE(proxyModel.foregroundBrush(3, 1).value<QBrush>().color(), QColor(Qt::red));
+  QVERIFY(proxyModel.backgroundBrush(1, 0).isNull());
+  QCOMPARE(proxyModel.backgroundBrush(2, 0).value<QBrush>().color().red(), 10);
+  QCOMPARE(proxyModel.textFont(0, 1).value<QFont>().pointSize(), 12);
+  QVERIFY(proxyModel.textFont(1, 1).isNull());
+  QCOMPARE(proxyModel.textAlignment(0, 0).toInt(), (int)Qt::AlignRight);
+  QCOMPARE(proxyModel.textAlignment(2, 0).toInt(), (int)Qt::AlignRight);
+  QVERIFY(proxyModel.textAlignment(3, 0).isNull());
+  QCOMPARE(getModelData(proxyModel, 1, 0, Qt::ForegroundRole).value<QBrush>().color(), QColor(Qt::red));
+  QCOMPARE(getModelData(proxyModel, 1, 0, Qt::DisplayRole), QVariant("B"));
+  /*
+   * Explicit formats take precedence over rules
+   */
+  proxyModel.setTextColorForIndex(1, 1, Qt::green);
+  QCOMPARE(proxyModel.foregroundBrush(1, 0).value<QBrush>().color(), QColor(Qt::red));
+  QCOMPARE(proxyModel.foregroundBrush(1, 1).value<QBrush>().color(), QColor(Qt::green));
+  proxyModel.clearTextColorForIndex(1, 1);
+  QCOMPARE(proxyModel.foregroundBrush(1, 1).value<QBrush>().color(), QColor(Qt::red));
+  /*
+   * Change data in source model
+   */
+  QVERIFY(model.setData(1, 1, 3));
+  QVERIFY(proxyModel.foregroundBrush(1, 0).isNull());
+  QCOMPARE(proxyModel.textFont(1, 0).value<QFont>().pointSize(), 12);
+  QVERIFY(model.setData(0, 1, -1));
+  QCOMPARE(proxyModel.foregroundBrush(0, 0).value<QBrush>().color(), QColor(Qt::red));
+  /*
+   * Insert and remove rows in source model
+   */
+  model.prependRow();
+  QVERIFY(proxyModel.foregroundBrush(0, 0).isNull());
+  QCOMPARE(proxyModel.foregroundBrush(1, 0).value<QBrush>().color(), QColor(Qt::red));
+  QVERIFY(proxyModel.foregroundBrush(2, 0).isNull());
+  QCOMPARE(proxyModel.backgroundBrush(3, 0).value<QBrush>().color().red(), 10);
+  model.removeFirstRow();
+  QCOMPARE(proxyModel.foregroundBrush(0, 0).value<QBrush>().color(), QColor(Qt::red));
+  QVERIFY(proxyModel.foregroundBrush(1, 0).isNull());
+  QCOMPARE(proxyModel.backgroundBrush(2, 0).value<QBrush>().color().red(), 10);
+  /*
+   * Reset source model
+   */
+  model.resize(2, 2);
+  model.populateColumn(1, {0,-5});
+  QVERIFY(proxyModel.foregroundBrush(0, 0).isNull());
+  QCOMPARE(proxyModel.foregroundBrush(1, 0).value<QBrush>().color(), QColor(Qt::red));
+  /*
+   * Clear rules
+   */
+  proxyModel.clearFormatRules();
+  QVERIFY(proxyModel.foregroundBrush(1, 0).isNull());
+  QVERIFY(proxyModel.backgroundBrush(0, 0).isNull());
+  QVERIFY(proxyModel.textAlignment(0, 0).isNull());
+}
+
+void FormatProxyModelTest::conditionalFormatSignalTest()
+{
+  QVariantList arguments;
+  QModelIndex index;
+  QVector<int> roles;
+  FilterColumn amount(1);
+  /*
+   * Setup model
+   */
+  VariantTableModel model;
+  model.resize(3, 2);
+  model.populateColumn(1, {5,-3,0});
+  /*
+   * Setup proxy model
+   */
+  FormatProxyModel proxyModel;
+  proxyModel.setSourceModel(&model);
+  QSignalSpy dataChangedSpy(&proxyModel, &FormatProxyModel::dataChanged);
+  QVERIFY(dataChangedSpy.isValid());
+  /*
+   * Adding a rule signals the whole model once
+   */
+  proxyModel.addTextColorRule(amount < 0, Qt::red);
+  QCOMPARE(dataChangedSpy.count(), 1);
+  arguments = dataChangedSpy.takeFirst();
+  index = arguments.at(0).toModelIndex(); // topLeft
+  QCOMPARE(index.row(), 0);
+  QCOMPARE(index.column(), 0);
+  index = arguments.at(1).toModelIndex(); // bottomRight
+  QCOMPARE(index.row(), 2);
+  QCOMPARE(index.column(), 1);
+  roles = arguments.at(2).value< QVector<int> >();
+  QCOMPARE(roles.size(), 1);
+  QCOMPARE(roles.at(0), (int)Qt::ForegroundRole);
+  // Display rows 0 and 1
+  QVERIFY(proxyModel.foregroundBrush(0, 0).isNull());
+  QVERIFY(!proxyModel.foregroundBrush(1, 0).isNull());
+  QCOMPARE(dataChangedSpy.count(), 0);
+  /*
+   * Change data so that format of row 0 changes:
+   *  the whole row is signaled for ForegroundRole,
+   *  then the changed index is forwarded from source model
+   */
+  QVERIFY(model.setData(0, 1, -1));
+  QCOMPARE(dataChangedSpy.count(), 2);
+  arguments = dataChangedSpy.takeFirst();
+  index = arguments.at(0).toModelIndex(); // topLeft
+  QCOMPARE(index.row(), 0);
+  QCOMPARE(index.column(), 0);
+  index = arguments.at(1).toModelIndex(); // bottomRight
+  QCOMPARE(index.row(), 0);
+  QCOMPARE(index.column(), 1);
+  roles = arguments.at(2).value< QVector<int> >();
+  QCOMPARE(roles.size(), 1);
+  QCOMPARE(roles.at(0), (int)Qt::ForegroundRole);
+  arguments = dataChangedSpy.takeFirst();
+  index = arguments.at(0).toModelIndex(); // topLeft
+  QCOMPARE(index.row(), 0);
+  QCOMPARE(index.column(), 1);
+  /*
+   * Change data without changing format: only forwarded signal
+   */
+  QVERIFY(model.setData(1, 1, -4));
+  QCOMPARE(dataChangedSpy.count(), 1);
+  dataChangedSpy.clear();
+  /*
+   * Change data of a row that was never displayed: only forwarded signal
+   */
+  QVERIFY(model.setData(2, 1, -7));
+  QCOMPARE(dataChangedSpy.count(), 1);
+  dataChangedSpy.clear();
+  QVERIFY(!proxyModel.foregroundBrush(2, 0).isNull());
+  /*
+   * Clearing rules signals the whole model once
+   */
+  proxyModel.clearFormatRules();
+  QCOMPARE(dataChangedSpy.count(), 1);
+  arguments = dataChangedSpy.takeFirst();
+  roles = arguments.at(2).value< QVector<int> >();
+  QCOMPARE(roles.size(), 1);
+  QCOMPARE(roles.at(0), (int)Qt::ForegroundRole);
+  proxyModel.clearFormatRules();
+  QCOMPARE(dataChangedSpy.count(), 0);
+}
+
 void FormatProxyModelTest::setModelTest()
 {
   /*
@@ -820,6 +1153,7 @@ void FormatProxyModelTest::qtModelTest()
    */
   FormatProxyModel proxyModel;
   proxyModel.setSourceModel(&model);
+  proxyModel.addTextColorRule(FilterColumn(0) > 1, Qt::red);
   /*
    * Test
    */
@@ -896,6 +1230,83 @@ void FormatProxyModelTest::getTextAlignmentRoleDataBenchmark_data()
   QTest::newRow("10'000") << 10000;
 }
 
+void FormatProxyModelTest::setBackgroundColorForRowsBenchmark()
+{
+  QFETCH(int, n);
+  QFETCH(bool, useRange);
+  /*
+   * Setup model
+   */
+  VariantTableModel model;
+  model.resize(n, 5);
+  /*
+   * Setup proxy model
+   */
+  FormatProxyModel proxyModel;
+  proxyModel.setSourceModel(&model);
+  RowRange rowRange;
+  rowRange.setFirstRow(0);
+  rowRange.setLastRow(n-1);
+  QBENCHMARK{
+    if(useRange){
+      proxyModel.setBackgroundColorForRowRange(rowRange, Qt::yellow);
+    }else{
+      for(int row = 0; row < n; ++row){
+        proxyModel.setBackgroundColorForRow(row, Qt::yellow);
+      }
+    }
+    for(int row = 0; row < n; ++row){
+      QVERIFY(!proxyModel.backgroundBrush(row, 2).isNull());
+    }
+  }
+}
+
+void FormatProxyModelTest::setBackgroundColorForRowsBenchmark_data()
+{
+  QTest::addColumn<int>("n");
+  QTest::addColumn<bool>("useRange");
+
+  QTest::newRow("100") << 100 << false;
+  QTest::newRow("100,range") << 100 << true;
+  QTest::newRow("10'000") << 10000 << false;
+  QTest::newRow("10'000,range") << 10000 << true;
+}
+
+void FormatProxyModelTest::getForegroundRoleDataWithRuleBenchmark()
+{
+  QFETCH(int, n);
+  FilterColumn amount(1);
+  /*
+   * Setup model
+   */
+  VariantTableModel model;
+  model.resize(n, 3);
+  model.populateColumnWithInt(1, -n/2);
+  /*
+   * Setup proxy model
+   */
+  FormatProxyModel proxyModel;
+  proxyModel.setSourceModel(&model);
+  proxyModel.addTextColorRule( (amount < 0) || (amount > 100), Qt::red );
+  QBENCHMARK{
+    for(int row = 0; row < n; ++row){
+      for(int col = 0; col < 3; ++col){
+        getModelData(proxyModel, row, col, Qt::ForegroundRole);
+      }
+    }
+  }
+  QVERIFY(!getModelData(proxyModel, 0, 0, Qt::ForegroundRole).isNull());
+  QVERIFY(getModelData(proxyModel, n/2, 0, Qt::ForegroundRole).isNull());
+}
+
+void FormatProxyModelTest::getForegroundRoleDataWithRuleBenchmark_data()
+{
+  QTest::addColumn<int>("n");
+
+  QTest::newRow("100") << 100;
+  QTest::newRow("10'000") << 10000;
+}
+
 /*
  * Main
  */
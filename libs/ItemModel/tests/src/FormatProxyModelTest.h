@@ -42,6 +42,10 @@ class FormatProxyModelTest : public TestBase
   void textColorSignalTest();
   void backgroundColorTest();
   void backgroundColorSignalTest();
+  void rangeFormatTest();
+  void rangeFormatSignalTest();
+  void conditionalFormatTest();
+  void conditionalFormatSignalTest();
   void setModelTest();
   void qtModelTest();
   
@@ -49,6 +53,10 @@ class FormatProxyModelTest : public TestBase
   void getDiplayRoleDataBenchmark_data();
   void getTextAlignmentRoleDataBenchmark();
   void getTextAlignmentRoleDataBenchmark_data();
+  void setBackgroundColorForRowsBenchmark();
+  void setBackgroundColorForRowsBenchmark_data();
+  void getForegroundRoleDataWithRuleBenchmark();
+  void getForegroundRoleDataWithRuleBenchmark_data();
 };
 
 #endif // #ifndef MDT_ITEM_MODEL_FORMAT_PROXY_MODEL_TEST_H
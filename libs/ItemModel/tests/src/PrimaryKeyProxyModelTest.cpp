@@ -22,6 +22,7 @@
 #include "qtmodeltest.h"
 #include "Mdt/ItemModel/PrimaryKeyProxyModel.h"
 #include "Mdt/ItemModel/VariantTableModel.h"
+#include <QSignalSpy>
 
 using namespace Mdt::ItemModel;
 
@@ -115,6 +116,23 @@ void PrimaryKeyProxyModelTest::flagsTest()
   expectedFlags = getModelFlags(model, 0, 0) & Qt::ItemFlags(~Qt::ItemIsEditable) & Qt::ItemFlags(~Qt::ItemIsEnabled);
   QCOMPARE(getModelFlags(proxyModel, 0, 0), expectedFlags);
   QCOMPARE(getModelFlags(proxyModel, 0, 1), getModelFlags(model, 0, 1));
+  QCOMPARE(getModelFlags(proxyModel, 0, 2), getModelFlags(model, 0, 2));
+  /*
+   * Change primary key
+   */
+  proxyModel.setPrimaryKey({1,2});
+  QCOMPARE(getModelFlags(proxyModel, 0, 0), getModelFlags(model, 0, 0));
+  expectedFlags = getModelFlags(model, 0, 1) & Qt::ItemFlags(~Qt::ItemIsEditable) & Qt::ItemFlags(~Qt::ItemIsEnabled);
+  QCOMPARE(getModelFlags(proxyModel, 0, 1), expectedFlags);
+  expectedFlags = getModelFlags(model, 0, 2) & Qt::ItemFlags(~Qt::ItemIsEditable) & Qt::ItemFlags(~Qt::ItemIsEnabled);
+  QCOMPARE(getModelFlags(proxyModel, 0, 2), expectedFlags);
+  /*
+   * Clear primary key
+   */
+  proxyModel.clearPrimaryKey();
+  QCOMPARE(getModelFlags(proxyModel, 0, 0), getModelFlags(model, 0, 0));
+  QCOMPARE(getModelFlags(proxyModel, 0, 1), getModelFlags(model, 0, 1));
+  QCOMPARE(getModelFlags(proxyModel, 0, 2), getModelFlags(model, 0, 2));
 }
 
 void PrimaryKeyProxyModelTest::recordTest()
@@ -159,6 +177,88 @@ void PrimaryKeyProxyModelTest::recordTest()
   QCOMPARE(proxyModel.findRowForPrimaryKeyRecord(record), -1);
 }
 
+void PrimaryKeyProxyModelTest::primaryKeyIndexTest()
+{
+  PrimaryKeyRecord record;
+  const auto makeRecord = [](int id){
+    PrimaryKeyRecord r;
+    r.append(0, id);
+    return r;
+  };
+  /*
+   * Setup source model
+   */
+  VariantTableModel model;
+  model.resize(3, 2);
+  model.populateColumn(0, {1,2,3});
+  model.populateColumn(1, {"A","B","C"});
+  /*
+   * Setup proxy model
+   */
+  PrimaryKeyProxyModel proxyModel;
+  QSignalSpy violationSpy(&proxyModel, &PrimaryKeyProxyModel::primaryKeyUniqueConstraintViolated);
+  QVERIFY(violationSpy.isValid());
+  QVERIFY(!proxyModel.isPrimaryKeyIndexEnabled());
+  proxyModel.setPrimaryKeyIndexEnabled(true);
+  QVERIFY(proxyModel.isPrimaryKeyIndexEnabled());
+  proxyModel.setSourceModel(&model);
+  proxyModel.setPrimaryKey({0});
+  QCOMPARE(proxyModel.findRowForPrimaryKeyRecord(makeRecord(1)), 0);
+  QCOMPARE(proxyModel.findRowForPrimaryKeyRecord(makeRecord(2)), 1);
+  QCOMPARE(proxyModel.findRowForPrimaryKeyRecord(makeRecord(3)), 2);
+  QCOMPARE(proxyModel.findRowForPrimaryKeyRecord(makeRecord(4)), -1);
+  QCOMPARE(violationSpy.count(), 0);
+  /*
+   * Change primary key data
+   */
+  QVERIFY(model.setData(2, 0, 5));
+  QCOMPARE(proxyModel.findRowForPrimaryKeyRecord(makeRecord(3)), -1);
+  QCOMPARE(proxyModel.findRowForPrimaryKeyRecord(makeRecord(5)), 2);
+  // Changing a non key column does not matter
+  QVERIFY(model.setData(2, 1, "E"));
+  QCOMPARE(proxyModel.findRowForPrimaryKeyRecord(makeRecord(5)), 2);
+  QCOMPARE(violationSpy.count(), 0);
+  /*
+   * Insert a row, then give it a duplicate primary key
+   */
+  model.prependRow();
+  QCOMPARE(proxyModel.findRowForPrimaryKeyRecord(makeRecord(1)), 1);
+  QCOMPARE(proxyModel.findRowForPrimaryKeyRecord(makeRecord(5)), 3);
+  QCOMPARE(violationSpy.count(), 0);
+  // Null primary keys are not compared
+  model.prependRow();
+  QCOMPARE(violationSpy.count(), 0);
+  model.removeFirstRow();
+  QVERIFY(model.setData(0, 0, 2));
+  QCOMPARE(violationSpy.count(), 1);
+  QCOMPARE(violationSpy.takeFirst().at(0), QVariant(0));
+  QCOMPARE(proxyModel.findRowForPrimaryKeyRecord(makeRecord(2)), 0);
+  /*
+   * Remove the duplicate row
+   */
+  model.removeFirstRow();
+  QCOMPARE(proxyModel.findRowForPrimaryKeyRecord(makeRecord(1)), 0);
+  QCOMPARE(proxyModel.findRowForPrimaryKeyRecord(makeRecord(2)), 1);
+  QCOMPARE(proxyModel.findRowForPrimaryKeyRecord(makeRecord(5)), 2);
+  /*
+   * Reset model with a duplicate primary key
+   */
+  model.resize(0, 2);
+  model.resize(3, 2);
+  model.populateColumn(0, {7,8,7});
+  QCOMPARE(proxyModel.findRowForPrimaryKeyRecord(makeRecord(8)), 1);
+  QCOMPARE(proxyModel.findRowForPrimaryKeyRecord(makeRecord(7)), 0);
+  QCOMPARE(violationSpy.count(), 1);
+  QCOMPARE(violationSpy.takeFirst().at(0), QVariant(2));
+  /*
+   * Disable the index
+   */
+  proxyModel.setPrimaryKeyIndexEnabled(false);
+  QCOMPARE(proxyModel.findRowForPrimaryKeyRecord(makeRecord(8)), 1);
+  QVERIFY(model.setData(1, 0, 7));
+  QCOMPARE(violationSpy.count(), 0);
+}
+
 void PrimaryKeyProxyModelTest::qtModelTest()
 {
   /*
@@ -306,6 +406,7 @@ void PrimaryKeyProxyModelTest::primaryKeyModelGetDataBenchmark_data()
 void PrimaryKeyProxyModelTest::findPrimaryKeyRecordBenchmark()
 {
   QFETCH(int, n);
+  QFETCH(bool, indexed);
   /*
    * Setup model
    */
@@ -319,6 +420,7 @@ void PrimaryKeyProxyModelTest::findPrimaryKeyRecordBenchmark()
   PrimaryKeyProxyModel proxyModel;
   proxyModel.setSourceModel(&model);
   proxyModel.setPrimaryKey({0,1});
+  proxyModel.setPrimaryKeyIndexEnabled(indexed);
   /*
    * Setup PK record that must match
    */
@@ -333,9 +435,12 @@ void PrimaryKeyProxyModelTest::findPrimaryKeyRecordBenchmark()
 void PrimaryKeyProxyModelTest::findPrimaryKeyRecordBenchmark_data()
 {
   QTest::addColumn<int>("n");
+  QTest::addColumn<bool>("indexed");
 
-  QTest::newRow("10") << 10;
-  QTest::newRow("10'000") << 10000;
+  QTest::newRow("10") << 10 << false;
+  QTest::newRow("10,indexed") << 10 << true;
+  QTest::newRow("10'000") << 10000 << false;
+  QTest::newRow("10'000,indexed") << 10000 << true;
 }
 
 /*
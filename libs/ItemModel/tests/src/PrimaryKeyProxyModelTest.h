@@ -36,6 +36,7 @@ class PrimaryKeyProxyModelTest : public TestBase
   void setModelTest();
   void flagsTest();
   void recordTest();
+  void primaryKeyIndexTest();
   void qtModelTest();
   void modelGetFlagsBenchmark();
   void modelGetFlagsBenchmark_data();
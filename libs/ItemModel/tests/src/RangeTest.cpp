@@ -23,6 +23,7 @@
 #include "Mdt/ItemModel/Range.h"
 #include "Mdt/ItemModel/RowRange.h"
 #include "Mdt/ItemModel/ColumnRange.h"
+#include "Mdt/ItemModel/IndexRangeList.h"
 #include "Mdt/ItemModel/VariantTableModel.h"
 
 using namespace Mdt::ItemModel;
@@ -352,6 +353,64 @@ void RangeTest::columnSetFirstLastIndexTest()
   QVERIFY(r.isValid());
 }
 
+/*
+ * IndexRangeList test
+ */
+
+void RangeTest::indexRangeListTest()
+{
+  std::vector<IndexRange> ranges;
+  IndexRangeList list;
+  QVERIFY(list.isEmpty());
+  QVERIFY(list.mergedRanges().empty());
+  /*
+   * Single range
+   */
+  list.addRange(1, 2, 3, 4);
+  QVERIFY(!list.isEmpty());
+  ranges = list.mergedRanges();
+  QCOMPARE((int)ranges.size(), 1);
+  QVERIFY(ranges[0] == IndexRange(1, 2, 3, 4));
+  /*
+   * Indexes that fill a block
+   */
+  list.clear();
+  QVERIFY(list.isEmpty());
+  for(int row = 5; row >= 0; --row){
+    for(int column = 0; column < 3; ++column){
+      list.addIndex(row, column);
+    }
+  }
+  ranges = list.mergedRanges();
+  QCOMPARE((int)ranges.size(), 1);
+  QVERIFY(ranges[0] == IndexRange(0, 0, 5, 2));
+  /*
+   * Overlapping ranges
+   *
+   *      0   1   2   3
+   *    -----------------
+   *  0 | x | x |   |   |
+   *    -----------------
+   *  1 | x | x | x | x |
+   *    -----------------
+   *  2 | x | x | x | x |
+   *    -----------------
+   *  3 |   |   |   |   |
+   *    -----------------
+   *  4 |   |   | x |   |
+   *    -----------------
+   */
+  list.clear();
+  list.addRange(0, 0, 2, 1);
+  list.addRange(1, 1, 2, 3);
+  list.addIndex(4, 2);
+  ranges = list.mergedRanges();
+  QCOMPARE((int)ranges.size(), 3);
+  QVERIFY(ranges[0] == IndexRange(0, 0, 0, 1));
+  QVERIFY(ranges[1] == IndexRange(1, 0, 2, 3));
+  QVERIFY(ranges[2] == IndexRange(4, 2, 4, 2));
+}
+
 /*
  * Main
  */
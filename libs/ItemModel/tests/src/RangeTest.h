@@ -49,6 +49,8 @@ class RangeTest : public QObject
   void columnSetFirstLastTest();
   void columnSetFirstCountTest();
   void columnSetFirstLastIndexTest();
+
+  void indexRangeListTest();
 };
 
 #endif // #ifndef MDT_ITEM_MODEL_RANGE_TEST_H
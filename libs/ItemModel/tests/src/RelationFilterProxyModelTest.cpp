@@ -371,6 +371,263 @@ void RelationFilterProxyModelTest::filterBenchmark_data()
   QTest::newRow("10'000") << 10000;
 }
 
+void RelationFilterProxyModelTest::parallelFilterTest()
+{
+  /*
+   * Setup parent table model
+   * ------
+   * | Id |
+   * ------
+   * | 1  |
+   * ------
+   * | 2  |
+   * ------
+   * | 3  |
+   * ------
+   */
+  VariantTableModel parentModel;
+  parentModel.resize(3, 1);
+  parentModel.populateColumn(0, {1,2,3});
+  /*
+   * Setup (child) table model
+   * -----------------
+   * | Id | ParentId |
+   * -----------------
+   * | 0  |    1     |
+   * -----------------
+   * | 1  |    2     |
+   * -----------------
+   * | 2  |    3     |
+   * -----------------
+   * | 3  |    1     |
+   * -----------------
+   * | .. |    ..    |
+   * -----------------
+   */
+  const int n = 1000;
+  std::vector<QVariant> parentIdData;
+  for(int row = 0; row < n; ++row){
+    parentIdData.push_back( (row % 3) + 1 );
+  }
+  VariantTableModel model;
+  model.resize(n, 2);
+  model.populateColumnWithInt(0, 0);
+  model.populateColumn(1, parentIdData);
+  /*
+   * Setup proxy model
+   */
+  ParentModelColumn parentModelId(0);
+  FilterColumn modelParentId(1);
+  RelationFilterProxyModel proxyModel;
+  proxyModel.setParallelFilterEnabled(true);
+  proxyModel.setParallelFilterThreshold(0);
+  proxyModel.setParentModel(&parentModel);
+  proxyModel.setSourceModel(&model);
+  proxyModel.setFilter(modelParentId == parentModelId);
+  QCOMPARE(proxyModel.rowCount(), 0);
+  /*
+   * Filter in parallel
+   */
+  proxyModel.setParentModelMatchRow(0);
+  QCOMPARE(proxyModel.rowCount(), 334);
+  QCOMPARE(getModelData(proxyModel, 0, 0), QVariant(0));
+  QCOMPARE(getModelData(proxyModel, 1, 0), QVariant(3));
+  proxyModel.setParentModelMatchRow(1);
+  QCOMPARE(proxyModel.rowCount(), 333);
+  QCOMPARE(getModelData(proxyModel, 0, 0), QVariant(1));
+  proxyModel.setParentModelMatchRow(2);
+  QCOMPARE(proxyModel.rowCount(), 333);
+  QCOMPARE(getModelData(proxyModel, 0, 0), QVariant(2));
+  proxyModel.setParentModelMatchRow(-1);
+  QCOMPARE(proxyModel.rowCount(), 0);
+  /*
+   * Source model changes must be considered
+   */
+  proxyModel.setParentModelMatchRow(0);
+  QCOMPARE(proxyModel.rowCount(), 334);
+  QVERIFY(model.setData(model.index(1, 1), 1));
+  QCOMPARE(proxyModel.rowCount(), 335);
+  QVERIFY(model.removeRows(0, 1));
+  QCOMPARE(proxyModel.rowCount(), 334);
+  QCOMPARE(getModelData(proxyModel, 0, 0), QVariant(1));
+  /*
+   * Parent model changes must be considered
+   */
+  QVERIFY(parentModel.setData(parentModel.index(0, 0), 10));
+  QCOMPARE(proxyModel.rowCount(), 334);
+  QCOMPARE(getModelData(proxyModel, 0, 1), QVariant(10));
+  /*
+   * Must give the same result than sequential evaluation
+   */
+  proxyModel.setParallelFilterEnabled(false);
+  proxyModel.setParentModelMatchRow(1);
+  QCOMPARE(proxyModel.rowCount(), 332);
+  proxyModel.setParallelFilterEnabled(true);
+  proxyModel.setParentModelMatchRow(1);
+  QCOMPARE(proxyModel.rowCount(), 332);
+}
+
+void RelationFilterProxyModelTest::foreignKeyIndexTest()
+{
+  /*
+   * Setup parent table model
+   * ------
+   * | Id |
+   * ------
+   * | 1  |
+   * ------
+   * | 2  |
+   * ------
+   * | 3  |
+   * ------
+   */
+  VariantTableModel parentModel;
+  parentModel.resize(3, 1);
+  parentModel.populateColumn(0, {1,2,3});
+  /*
+   * Setup (child) table model
+   * -----------------
+   * | Id | ParentId |
+   * -----------------
+   * | 10 |    1     |
+   * -----------------
+   * | 20 |    2     |
+   * -----------------
+   * | 11 |    1     |
+   * -----------------
+   * | 21 |    2     |
+   * -----------------
+   */
+  VariantTableModel model;
+  model.resize(4, 2);
+  model.populateColumn(0, {10,20,11,21});
+  model.populateColumn(1, {1,2,1,2});
+  /*
+   * Setup proxy model
+   */
+  RelationFilterProxyModel proxyModel;
+  QVERIFY(!proxyModel.isForeignKeyIndexEnabled());
+  proxyModel.setForeignKeyIndexEnabled(true);
+  QVERIFY(proxyModel.isForeignKeyIndexEnabled());
+  proxyModel.setParentModel(&parentModel);
+  proxyModel.setSourceModel(&model);
+  proxyModel.setFilter(PrimaryKey({0}), ForeignKey({1}));
+  QCOMPARE(proxyModel.rowCount(), 0);
+  /*
+   * Change parent model match row
+   */
+  proxyModel.setParentModelMatchRow(0);
+  QCOMPARE(proxyModel.rowCount(), 2);
+  QCOMPARE(getModelData(proxyModel, 0, 0), QVariant(10));
+  QCOMPARE(getModelData(proxyModel, 1, 0), QVariant(11));
+  proxyModel.setParentModelMatchRow(1);
+  QCOMPARE(proxyModel.rowCount(), 2);
+  QCOMPARE(getModelData(proxyModel, 0, 0), QVariant(20));
+  QCOMPARE(getModelData(proxyModel, 1, 0), QVariant(21));
+  proxyModel.setParentModelMatchRow(2);
+  QCOMPARE(proxyModel.rowCount(), 0);
+  /*
+   * Insert a row into child model
+   */
+  QVERIFY(model.insertRows(0, 1));
+  QVERIFY(model.setData(model.index(0, 0), 30));
+  QVERIFY(model.setData(model.index(0, 1), 3));
+  QCOMPARE(proxyModel.rowCount(), 1);
+  proxyModel.setParentModelMatchRow(0);
+  QCOMPARE(proxyModel.rowCount(), 2);
+  QCOMPARE(getModelData(proxyModel, 0, 0), QVariant(10));
+  proxyModel.setParentModelMatchRow(2);
+  QCOMPARE(proxyModel.rowCount(), 1);
+  QCOMPARE(getModelData(proxyModel, 0, 0), QVariant(30));
+  /*
+   * Insert a row from proxy model
+   * (key is copied from parent model)
+   */
+  QVERIFY(proxyModel.insertRows(1, 1));
+  QCOMPARE(proxyModel.rowCount(), 2);
+  QCOMPARE(getModelData(proxyModel, 1, 1), QVariant(3));
+  proxyModel.setParentModelMatchRow(0);
+  QCOMPARE(proxyModel.rowCount(), 2);
+  proxyModel.setParentModelMatchRow(2);
+  QCOMPARE(proxyModel.rowCount(), 2);
+  /*
+   * Edit foreign key in child model
+   */
+  QVERIFY(model.setData(model.index(1, 1), 3));
+  QCOMPARE(getModelData(model, 1, 0), QVariant(10));
+  proxyModel.setParentModelMatchRow(0);
+  QCOMPARE(proxyModel.rowCount(), 1);
+  QCOMPARE(getModelData(proxyModel, 0, 0), QVariant(11));
+  proxyModel.setParentModelMatchRow(2);
+  QCOMPARE(proxyModel.rowCount(), 3);
+  /*
+   * Remove rows from child model
+   */
+  QVERIFY(model.removeRows(0, 2));
+  proxyModel.setParentModelMatchRow(2);
+  QCOMPARE(proxyModel.rowCount(), 1);
+  proxyModel.setParentModelMatchRow(1);
+  QCOMPARE(proxyModel.rowCount(), 2);
+  /*
+   * Reset child model
+   */
+  model.resize(2, 2);
+  model.populateColumn(0, {40,41});
+  model.populateColumn(1, {2,1});
+  proxyModel.setParentModelMatchRow(1);
+  QCOMPARE(proxyModel.rowCount(), 1);
+  QCOMPARE(getModelData(proxyModel, 0, 0), QVariant(40));
+}
+
+void RelationFilterProxyModelTest::foreignKeyIndexBenchmark()
+{
+  QFETCH(int, n);
+  QFETCH(bool, useIndex);
+  /*
+   * Setup parent table model with 100 rows
+   */
+  VariantTableModel parentModel;
+  parentModel.resize(100, 1);
+  parentModel.populateColumnWithInt(0, 0);
+  /*
+   * Setup child table model,
+   * each row refers to a parent model row
+   */
+  std::vector<QVariant> parentIdData;
+  for(int row = 0; row < n; ++row){
+    parentIdData.push_back(row % 100);
+  }
+  VariantTableModel model;
+  model.resize(n, 2);
+  model.populateColumnWithInt(0, 0);
+  model.populateColumn(1, parentIdData);
+  /*
+   * Setup proxy model
+   */
+  RelationFilterProxyModel proxyModel;
+  proxyModel.setForeignKeyIndexEnabled(useIndex);
+  proxyModel.setParentModel(&parentModel);
+  proxyModel.setSourceModel(&model);
+  proxyModel.setFilter(PrimaryKey({0}), ForeignKey({1}));
+  QBENCHMARK{
+    for(int parentRow = 0; parentRow < 100; ++parentRow){
+      proxyModel.setParentModelMatchRow(parentRow);
+    }
+  }
+  QCOMPARE(proxyModel.rowCount(), n / 100);
+}
+
+void RelationFilterProxyModelTest::foreignKeyIndexBenchmark_data()
+{
+  QTest::addColumn<int>("n");
+  QTest::addColumn<bool>("useIndex");
+
+  QTest::newRow("1'000 el.") << 1000 << false;
+  QTest::newRow("1'000 el.,index") << 1000 << true;
+  QTest::newRow("10'000 el.") << 10000 << false;
+  QTest::newRow("10'000 el.,index") << 10000 << true;
+}
+
 void RelationFilterProxyModelTest::filterGetCurrentSourceRowListTest()
 {
   RowList list;
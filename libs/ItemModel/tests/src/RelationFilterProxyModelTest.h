@@ -41,6 +41,10 @@ class RelationFilterProxyModelTest : public TestBase
   void filterMultiColumnTest();
   void filterBenchmark();
   void filterBenchmark_data();
+  void parallelFilterTest();
+  void foreignKeyIndexTest();
+  void foreignKeyIndexBenchmark();
+  void foreignKeyIndexBenchmark_data();
 
   void filterGetCurrentSourceRowListTest();
 
@@ -24,6 +24,7 @@
 #include "Mdt/ItemModel/ForeignKey.h"
 #include "Mdt/ItemModel/RelationKey.h"
 #include "Mdt/ItemModel/RelationKeyCopier.h"
+#include "Mdt/ItemModel/ForeignKeyRowIndex.h"
 #include "Mdt/ItemModel/VariantTableModel.h"
 #include <QSignalSpy>
 #include <QVariantList>
@@ -704,6 +705,118 @@ void RelationKeyTest::keyCopierEditParentModelTest()
   QCOMPARE(index.column(), 2);
 }
 
+void RelationKeyTest::foreignKeyRowIndexTest()
+{
+  VariantTableModel model;
+  ForeignKeyRowIndex index;
+  RowList rows;
+  /*
+   * Setup model
+   * -----------------------
+   * | Id | FkA | FkB |
+   * -----------------------
+   * | 1  |  1  |  A  |
+   * -----------------------
+   * | 2  |  2  |  A  |
+   * -----------------------
+   * | 3  |  1  |  A  |
+   * -----------------------
+   * | 4  |  1  |  B  |
+   * -----------------------
+   */
+  model.resize(4, 3);
+  model.populateColumn(0, {1,2,3,4});
+  model.populateColumn(1, {1,2,1,1});
+  model.populateColumn(2, {"A","A","A","B"});
+  /*
+   * Initial state
+   */
+  QVERIFY(!index.isBuilt());
+  QCOMPARE(index.rowCount(), 0);
+  /*
+   * Build a index on FkA, FkB
+   */
+  index.setColumnList(ColumnList({1,2}));
+  QCOMPARE(index.columnList().size(), 2);
+  index.build(&model);
+  QVERIFY(index.isBuilt());
+  QCOMPARE(index.rowCount(), 4);
+  QCOMPARE(ForeignKeyRowIndex::keyForRow(&model, 0, ColumnList({1,2})), ForeignKeyRowIndex::keyForRow(&model, 2, ColumnList({1,2})));
+  rows = index.findRows(ForeignKeyRowIndex::keyForRow(&model, 0, ColumnList({1,2})));
+  QCOMPARE(rows.size(), 2);
+  QVERIFY(rows.contains(0));
+  QVERIFY(rows.contains(2));
+  rows = index.findRows(ForeignKeyRowIndex::keyForRow(&model, 3, ColumnList({1,2})));
+  QCOMPARE(rows.size(), 1);
+  QVERIFY(rows.contains(3));
+  rows = index.findRows("ZZZ");
+  QCOMPARE(rows.size(), 0);
+  QCOMPARE(index.rowCountForKey(ForeignKeyRowIndex::keyForRow(&model, 0, ColumnList({1,2}))), 2);
+  QCOMPARE(index.rowCountForKey(ForeignKeyRowIndex::keyForRow(&model, 3, ColumnList({1,2}))), 1);
+  QCOMPARE(index.rowCountForKey("ZZZ"), 0);
+  const auto key1A = ForeignKeyRowIndex::keyForRow(&model, 0, ColumnList({1,2}));
+  const auto key2A = ForeignKeyRowIndex::keyForRow(&model, 1, ColumnList({1,2}));
+  /*
+   * Insert a row at beginning
+   */
+  QVERIFY(model.insertRows(0, 1));
+  QVERIFY(model.setData(model.index(0, 1), 2));
+  QVERIFY(model.setData(model.index(0, 2), "A"));
+  index.insertRows(&model, 0, 0);
+  QCOMPARE(index.rowCount(), 5);
+  rows = index.findRows(key2A);
+  QCOMPARE(rows.size(), 2);
+  QVERIFY(rows.contains(0));
+  QVERIFY(rows.contains(2));
+  rows = index.findRows(key1A);
+  QCOMPARE(rows.size(), 2);
+  QVERIFY(rows.contains(1));
+  QVERIFY(rows.contains(3));
+  /*
+   * Update a row
+   */
+  QVERIFY(model.setData(model.index(3, 1), 2));
+  index.updateRows(&model, 3, 3);
+  rows = index.findRows(key2A);
+  QCOMPARE(rows.size(), 3);
+  QVERIFY(rows.contains(3));
+  rows = index.findRows(key1A);
+  QCOMPARE(rows.size(), 1);
+  QVERIFY(rows.contains(1));
+  QCOMPARE(index.rowCountForKey(key2A), 3);
+  QCOMPARE(index.rowCountForKey(key1A), 1);
+  /*
+   * Remove rows
+   */
+  QVERIFY(model.removeRows(0, 2));
+  index.removeRows(0, 1);
+  QCOMPARE(index.rowCount(), 3);
+  rows = index.findRows(key2A);
+  QCOMPARE(rows.size(), 2);
+  QVERIFY(rows.contains(0));
+  QVERIFY(rows.contains(1));
+  rows = index.findRows(key1A);
+  QCOMPARE(rows.size(), 0);
+  QCOMPARE(index.rowCountForKey(key1A), 0);
+  /*
+   * Remove a row that is not the last one in the row list of its key
+   */
+  QCOMPARE(index.rowCountForKey(key2A), 2);
+  QVERIFY(model.removeRows(0, 1));
+  index.removeRows(0, 0);
+  QCOMPARE(index.rowCount(), 2);
+  rows = index.findRows(key2A);
+  QCOMPARE(rows.size(), 1);
+  QVERIFY(rows.contains(0));
+  /*
+   * Clear
+   */
+  index.clear();
+  QVERIFY(!index.isBuilt());
+  QCOMPARE(index.rowCount(), 0);
+  QCOMPARE(index.columnList().size(), 2);
+}
+
 /// \todo Add some test that removes rows (something goes wrong with current row..)
 
 /*
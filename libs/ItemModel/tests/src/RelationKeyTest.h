@@ -41,6 +41,7 @@ class RelationKeyTest : public QObject
   void keyCopierParentModelCurrentRowTest();
   void keyCopierInsertIntoChildModelTest();
   void keyCopierEditParentModelTest();
+  void foreignKeyRowIndexTest();
   
   /**
    * \todo Must check that copier only set values (related to key) if they are null
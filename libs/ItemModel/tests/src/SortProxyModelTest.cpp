@@ -24,6 +24,8 @@
 #include "Mdt/ItemModel/VariantTableModel.h"
 #include "Mdt/ItemModel/ColumnSortOrderList.h"
 #include "Mdt/ItemModel/ColumnSortStringAttributesList.h"
+#include "Mdt/ItemModel/CollatorSortKeyCache.h"
+#include "Mdt/ItemModel/ParallelStableSort.h"
 #include <QStringList>
 #include <QModelIndex>
 #include <QTableView>
@@ -35,6 +37,7 @@
 #include <iterator>
 #include <vector>
 #include <array>
+#include <utility>
 #include <algorithm>
 
 #include <QDebug>
@@ -44,6 +47,7 @@ using ItemModel::VariantTableModel;
 using ItemModel::VariantTableModelStorageRule;
 using ItemModel::SortProxyModel;
 using ItemModel::StringNumericMode;
+using ItemModel::CollatorSortKeyCache;
 
 void SortProxyModelTest::initTestCase()
 {
@@ -409,6 +413,285 @@ void SortProxyModelTest::sortIntBenchmark_data()
   QTest::newRow("10'000") << 10000;
 }
 
+void SortProxyModelTest::sortSinglePassTest()
+{
+  VariantTableModel model;
+  SortProxyModel proxyModel;
+  SortProxyModel referenceProxyModel;
+  QSignalSpy layoutChangedSpy(&proxyModel, &SortProxyModel::layoutChanged);
+  QSignalSpy columnSortedSpy(&proxyModel, &SortProxyModel::columnSorted);
+  QVERIFY(layoutChangedSpy.isValid());
+  QVERIFY(columnSortedSpy.isValid());
+  /*
+   * Setup models
+   */
+  const int n = 100;
+  model.resize(n, 4);
+  model.populateColumnWithInt(0, 0);
+  std::vector<QVariant> col1, col2, col3;
+  for(int row = 0; row < n; ++row){
+    col1.push_back( row % 3 );
+    col2.push_back( QString("%1A").arg(row % 7) );
+    col3.push_back( (row * 13) % 5 );
+  }
+  model.populateColumn(1, col1);
+  model.populateColumn(2, col2);
+  model.populateColumn(3, col3);
+  proxyModel.setSourceModel(&model);
+  proxyModel.setDynamicSortFilter(false);
+  referenceProxyModel.setSourceModel(&model);
+  referenceProxyModel.setDynamicSortFilter(false);
+  QVERIFY(!proxyModel.isSinglePassSortEnabled());
+  proxyModel.setSinglePassSortEnabled(true);
+  QVERIFY(proxyModel.isSinglePassSortEnabled());
+  /*
+   * Sort with mixed sort orders
+   * and compare to the sort done for each column
+   */
+  const auto setupSortOrder = [](SortProxyModel & pm){
+    pm.clearColumnsSortOrder();
+    pm.addColumnToSortOrder(1, Qt::DescendingOrder);
+    pm.addColumnToSortOrder(2, StringNumericMode::Natural, Qt::AscendingOrder);
+    pm.addColumnToSortOrder(3, Qt::DescendingOrder);
+    pm.addColumnToSortOrder(0, Qt::AscendingOrder);
+  };
+  setupSortOrder(proxyModel);
+  setupSortOrder(referenceProxyModel);
+  layoutChangedSpy.clear();
+  columnSortedSpy.clear();
+  proxyModel.sort();
+  referenceProxyModel.sort();
+  QCOMPARE(layoutChangedSpy.count(), 1);
+  QCOMPARE(columnSortedSpy.count(), 1);
+  QCOMPARE(columnSortedSpy.takeFirst().at(0), QVariant(1));
+  QCOMPARE(proxyModel.sortColumn(), 1);
+  QCOMPARE(proxyModel.sortOrder(), Qt::DescendingOrder);
+  for(int row = 0; row < n; ++row){
+    QCOMPARE(getModelData(proxyModel, row, 0), getModelData(referenceProxyModel, row, 0));
+  }
+  /*
+   * Dynamic sort: change data of a column that is not the first in sort order
+   */
+  proxyModel.setDynamicSortFilter(true);
+  referenceProxyModel.setDynamicSortFilter(true);
+  QVERIFY(model.setData(model.index(0, 3), 10));
+  QVERIFY(model.setData(model.index(50, 2), "0A"));
+  for(int row = 0; row < n; ++row){
+    QCOMPARE(getModelData(proxyModel, row, 0), getModelData(referenceProxyModel, row, 0));
+  }
+  /*
+   * Restore model sort
+   */
+  proxyModel.sort(-1);
+  for(int row = 0; row < n; ++row){
+    QCOMPARE(getModelData(proxyModel, row, 0), QVariant(row));
+  }
+}
+
+void SortProxyModelTest::sortSinglePassBenchmark()
+{
+  QFETCH(int, n);
+  QFETCH(bool, singlePass);
+  VariantTableModel model;
+  SortProxyModel proxyModel;
+  /*
+   * Setup models
+   */
+  model.resize(n, 5);
+  proxyModel.setSourceModel(&model);
+  proxyModel.setDynamicSortFilter(false);
+  proxyModel.setSinglePassSortEnabled(singlePass);
+  proxyModel.addColumnToSortOrder(1, Qt::DescendingOrder);
+  proxyModel.addColumnToSortOrder(2, Qt::AscendingOrder);
+  proxyModel.addColumnToSortOrder(3, Qt::DescendingOrder);
+  proxyModel.addColumnToSortOrder(0, Qt::DescendingOrder);
+  model.populateColumnWithInt(0, 1);
+  std::vector<QVariant> col1, col2, col3;
+  for(int row = 0; row < n; ++row){
+    col1.push_back( row % 4 );
+    col2.push_back( row % 3 );
+    col3.push_back( row % 2 );
+  }
+  model.populateColumn(1, col1);
+  model.populateColumn(2, col2);
+  model.populateColumn(3, col3);
+  QBENCHMARK{
+    proxyModel.sort();
+  }
+  QCOMPARE(getModelData(proxyModel, 0, 1), QVariant(3));
+  QCOMPARE(getModelData(proxyModel, n-1, 1), QVariant(0));
+}
+
+void SortProxyModelTest::sortSinglePassBenchmark_data()
+{
+  QTest::addColumn<int>("n");
+  QTest::addColumn<bool>("singlePass");
+
+  QTest::newRow("100") << 100 << false;
+  QTest::newRow("100,single pass") << 100 << true;
+  QTest::newRow("1'000") << 1000 << false;
+  QTest::newRow("1'000,single pass") << 1000 << true;
+  QTest::newRow("10'000") << 10000 << false;
+  QTest::newRow("10'000,single pass") << 10000 << true;
+}
+
+void SortProxyModelTest::parallelStableSortTest()
+{
+  using Mdt::ItemModel::parallelStableSort;
+
+  const auto lessThan = [](const std::pair<int, int> & a, const std::pair<int, int> & b){
+    return a.first < b.first;
+  };
+  QThreadPool pool;
+  pool.setMaxThreadCount(4);
+  for(int n : {0, 1, 10, 4096, 10000, 50001}){
+    std::vector< std::pair<int, int> > values, expectedValues;
+    for(int i = 0; i < n; ++i){
+      values.emplace_back( (i * 7919) % 97, i );
+    }
+    expectedValues = values;
+    std::stable_sort(expectedValues.begin(), expectedValues.end(), lessThan);
+    parallelStableSort(values, lessThan, &pool);
+    QVERIFY(values == expectedValues);
+  }
+}
+
+void SortProxyModelTest::parallelSortTest()
+{
+  VariantTableModel model;
+  SortProxyModel proxyModel;
+  SortProxyModel referenceProxyModel;
+  /*
+   * Setup models
+   */
+  const int n = 10000;
+  model.resize(n, 5);
+  model.populateColumnWithInt(0, 0);
+  std::vector<QVariant> col1, col2, col3, col4;
+  for(int row = 0; row < n; ++row){
+    col1.push_back( row % 7 );
+    col2.push_back( QString("%1A").arg(row % 13) );
+    col3.push_back( ((row * 31) % 11) / 4.0 );
+    if(row % 2){
+      col4.push_back( row % 5 );
+    }else{
+      col4.push_back( QString::number(row % 3) );
+    }
+  }
+  model.populateColumn(1, col1);
+  model.populateColumn(2, col2);
+  model.populateColumn(3, col3);
+  model.populateColumn(4, col4);
+  proxyModel.setSourceModel(&model);
+  proxyModel.setDynamicSortFilter(false);
+  referenceProxyModel.setSourceModel(&model);
+  referenceProxyModel.setDynamicSortFilter(false);
+  QVERIFY(!proxyModel.isParallelSortEnabled());
+  QCOMPARE(proxyModel.parallelSortThreshold(), 100000);
+  proxyModel.setParallelSortEnabled(true);
+  proxyModel.setParallelSortThreshold(0);
+  QVERIFY(proxyModel.isParallelSortEnabled());
+  QCOMPARE(proxyModel.parallelSortThreshold(), 0);
+  const auto compareToReference = [&](){
+    for(int row = 0; row < n; ++row){
+      if(getModelData(proxyModel, row, 0) != getModelData(referenceProxyModel, row, 0)){
+        return false;
+      }
+    }
+    return true;
+  };
+  /*
+   * Sort each column
+   */
+  for(int column = 1; column < 5; ++column){
+    proxyModel.sort(column, Qt::AscendingOrder);
+    referenceProxyModel.sort(column, Qt::AscendingOrder);
+    QVERIFY(compareToReference());
+    proxyModel.sort(column, Qt::DescendingOrder);
+    referenceProxyModel.sort(column, Qt::DescendingOrder);
+    QVERIFY(compareToReference());
+  }
+  /*
+   * Sort by multiple columns, for each column and in a single pass
+   */
+  const auto setupSortOrder = [](SortProxyModel & pm){
+    pm.clearColumnsSortOrder();
+    pm.addColumnToSortOrder(1, Qt::DescendingOrder);
+    pm.addColumnToSortOrder(2, StringNumericMode::Natural, Qt::AscendingOrder);
+    pm.addColumnToSortOrder(3, Qt::DescendingOrder);
+    pm.addColumnToSortOrder(0, Qt::AscendingOrder);
+  };
+  setupSortOrder(proxyModel);
+  setupSortOrder(referenceProxyModel);
+  proxyModel.sort();
+  referenceProxyModel.sort();
+  QVERIFY(compareToReference());
+  proxyModel.setSinglePassSortEnabled(true);
+  proxyModel.sort();
+  QVERIFY(compareToReference());
+  /*
+   * Dynamic sort after data changed
+   */
+  proxyModel.setDynamicSortFilter(true);
+  referenceProxyModel.setDynamicSortFilter(true);
+  QVERIFY(model.setData(model.index(10, 1), 20));
+  QVERIFY(model.setData(model.index(20, 2), "0A"));
+  QVERIFY(compareToReference());
+  /*
+   * Restore model sort
+   */
+  proxyModel.sort(-1);
+  for(int row = 0; row < n; ++row){
+    QCOMPARE(getModelData(proxyModel, row, 0), QVariant(row));
+  }
+}
+
+void SortProxyModelTest::parallelSortBenchmark()
+{
+  QFETCH(int, n);
+  QFETCH(bool, parallel);
+  VariantTableModel model;
+  SortProxyModel proxyModel;
+  /*
+   * Setup models
+   */
+  model.resize(n, 3);
+  proxyModel.setSourceModel(&model);
+  proxyModel.setDynamicSortFilter(false);
+  proxyModel.setSinglePassSortEnabled(true);
+  proxyModel.setParallelSortEnabled(parallel);
+  proxyModel.setParallelSortThreshold(0);
+  proxyModel.addColumnToSortOrder(1, Qt::DescendingOrder);
+  proxyModel.addColumnToSortOrder(2, Qt::AscendingOrder);
+  proxyModel.addColumnToSortOrder(0, Qt::DescendingOrder);
+  model.populateColumnWithInt(0, 1);
+  std::vector<QVariant> col1, col2;
+  for(int row = 0; row < n; ++row){
+    col1.push_back( row % 4 );
+    col2.push_back( QString("%1").arg(row % 3) );
+  }
+  model.populateColumn(1, col1);
+  model.populateColumn(2, col2);
+  QBENCHMARK{
+    proxyModel.sort();
+  }
+  QCOMPARE(getModelData(proxyModel, 0, 1), QVariant(3));
+  QCOMPARE(getModelData(proxyModel, n-1, 1), QVariant(0));
+}
+
+void SortProxyModelTest::parallelSortBenchmark_data()
+{
+  QTest::addColumn<int>("n");
+  QTest::addColumn<bool>("parallel");
+
+  QTest::newRow("1'000") << 1000 << false;
+  QTest::newRow("1'000,parallel") << 1000 << true;
+  QTest::newRow("10'000") << 10000 << false;
+  QTest::newRow("10'000,parallel") << 10000 << true;
+  QTest::newRow("100'000") << 100000 << false;
+  QTest::newRow("100'000,parallel") << 100000 << true;
+}
+
 void SortProxyModelTest::sortRoleTest()
 {
   VariantTableModel model(VariantTableModelStorageRule::SeparateDisplayAndEditRoleData);
@@ -588,6 +871,141 @@ void SortProxyModelTest::sortStringNumericModeTest()
   QCOMPARE(getModelData(proxyModel, 2, 0), QVariant("a10"));
 }
 
+void SortProxyModelTest::collatorSortKeyCacheTest()
+{
+  VariantTableModel model;
+  CollatorSortKeyCache cache;
+  QCollator collator;
+  const QCollatorSortKey *key;
+  /*
+   * Setup model
+   */
+  model.resize(3, 2);
+  model.populateColumn(0, {"a10","a2","a1"});
+  model.populateColumn(1, {1,2,3});
+  collator.setNumericMode(true);
+  QCOMPARE(cache.count(), 0);
+  /*
+   * Get keys
+   */
+  key = cache.sortKey(model.index(0, 0), Qt::DisplayRole, collator);
+  QVERIFY(key != nullptr);
+  QCOMPARE(key->compare(collator.sortKey("a10")), 0);
+  QCOMPARE(cache.count(), 1);
+  QVERIFY(cache.sortKey(model.index(0, 0), Qt::DisplayRole, collator) == key);
+  QCOMPARE(cache.count(), 1);
+  key = cache.sortKey(model.index(1, 0), Qt::DisplayRole, collator);
+  QVERIFY(key != nullptr);
+  QVERIFY(key->compare(*cache.sortKey(model.index(0, 0), Qt::DisplayRole, collator)) < 0);
+  QCOMPARE(cache.count(), 2);
+  // Not a string
+  QVERIFY(cache.sortKey(model.index(0, 1), Qt::DisplayRole, collator) == nullptr);
+  QCOMPARE(cache.count(), 2);
+  /*
+   * Invalidate
+   */
+  QVERIFY(model.setData(model.index(0, 0), "a0"));
+  cache.invalidate(model.index(0, 0), model.index(0, 1));
+  QCOMPARE(cache.count(), 1);
+  key = cache.sortKey(model.index(0, 0), Qt::DisplayRole, collator);
+  QVERIFY(key != nullptr);
+  QCOMPARE(key->compare(collator.sortKey("a0")), 0);
+  QCOMPARE(cache.count(), 2);
+  /*
+   * Changing collator attributes drops the column
+   */
+  collator.setNumericMode(false);
+  key = cache.sortKey(model.index(1, 0), Qt::DisplayRole, collator);
+  QVERIFY(key != nullptr);
+  QCOMPARE(cache.count(), 1);
+  /*
+   * Clear
+   */
+  cache.clear();
+  QCOMPARE(cache.count(), 0);
+}
+
+void SortProxyModelTest::collatorSortKeyCacheStableKeysTest()
+{
+  VariantTableModel model;
+  SortProxyModel proxyModel;
+  CollatorSortKeyCache cache;
+  QCollator collator;
+  const int rowCount = 1000;
+  /*
+   * Setup model
+   * Rows are in reverse natural order: a999, a998, ..., a0
+   */
+  model.resize(rowCount, 1);
+  for(int row = 0; row < rowCount; ++row){
+    QVERIFY(model.setData(row, 0, QString("a%1").arg(rowCount - 1 - row)));
+  }
+  collator.setNumericMode(true);
+  /*
+   * A key must stay valid while keys of all other rows of the column are computed
+   */
+  const auto *firstKey = cache.sortKey(model.index(0, 0), Qt::DisplayRole, collator);
+  QVERIFY(firstKey != nullptr);
+  for(int row = 1; row < rowCount; ++row){
+    const auto *key = cache.sortKey(model.index(row, 0), Qt::DisplayRole, collator);
+    QVERIFY(key != nullptr);
+    QVERIFY(key->compare(*firstKey) < 0);
+  }
+  QCOMPARE(cache.count(), rowCount);
+  QVERIFY(cache.sortKey(model.index(0, 0), Qt::DisplayRole, collator) == firstKey);
+  QCOMPARE(firstKey->compare(collator.sortKey("a999")), 0);
+  /*
+   * Sort a column for which no key is cached yet
+   */
+  proxyModel.setSourceModel(&model);
+  proxyModel.addColumnToSortOrder(0, StringNumericMode::Natural);
+  proxyModel.sort();
+  QCOMPARE(proxyModel.rowCount(), rowCount);
+  for(int row = 0; row < rowCount; ++row){
+    QCOMPARE(getModelData(proxyModel, row, 0), QVariant(QString("a%1").arg(row)));
+  }
+}
+
+void SortProxyModelTest::sortStringNumericModeDynamicTest()
+{
+  VariantTableModel model;
+  SortProxyModel proxyModel;
+  /*
+   * Setup models
+   */
+  model.resize(4, 1);
+  model.populateColumn(0, {"a10","a2","a1","a3"});
+  proxyModel.setSourceModel(&model);
+  proxyModel.setDynamicSortFilter(true);
+  proxyModel.addColumnToSortOrder(0, StringNumericMode::Natural);
+  proxyModel.sort();
+  QCOMPARE(getModelData(proxyModel, 0, 0), QVariant("a1"));
+  QCOMPARE(getModelData(proxyModel, 1, 0), QVariant("a2"));
+  QCOMPARE(getModelData(proxyModel, 2, 0), QVariant("a3"));
+  QCOMPARE(getModelData(proxyModel, 3, 0), QVariant("a10"));
+  /*
+   * Change data: cached sort key must be invalidated
+   */
+  QVERIFY(model.setData(model.index(0, 0), "a0"));
+  QCOMPARE(getModelData(proxyModel, 0, 0), QVariant("a0"));
+  QCOMPARE(getModelData(proxyModel, 1, 0), QVariant("a1"));
+  QCOMPARE(getModelData(proxyModel, 2, 0), QVariant("a2"));
+  QCOMPARE(getModelData(proxyModel, 3, 0), QVariant("a3"));
+  /*
+   * Insert a row
+   */
+  QVERIFY(model.insertRows(0, 1));
+  QVERIFY(model.setData(model.index(0, 0), "a20"));
+  QCOMPARE(getModelData(proxyModel, 4, 0), QVariant("a20"));
+  /*
+   * Remove a row
+   */
+  QVERIFY(model.removeRows(1, 1));
+  QCOMPARE(proxyModel.rowCount(), 4);
+  QCOMPARE(getModelData(proxyModel, 0, 0), QVariant("a1"));
+  QCOMPARE(getModelData(proxyModel, 3, 0), QVariant("a20"));
+}
+
 void SortProxyModelTest::sortStringIntMixedTest()
 {
   VariantTableModel model;
@@ -1143,6 +1561,129 @@ void SortProxyModelTest::dynamicSortTest()
   QCOMPARE(modelSortedSpy.count(), 0);
 }
 
+void SortProxyModelTest::incrementalDynamicSortTest()
+{
+  VariantTableModel model;
+  SortProxyModel proxyModel;
+  QSignalSpy modelSortedSpy(&proxyModel, &SortProxyModel::modelSorted);
+  QVERIFY(modelSortedSpy.isValid());
+  /*
+   * Setup models
+   */
+  model.resize(4, 2);
+  model.populateColumn(0, {2,2,1,1});
+  model.populateColumn(1, {2,1,2,1});
+  proxyModel.setSourceModel(&model);
+  proxyModel.setDynamicSortFilter(true);
+  QVERIFY(!proxyModel.isIncrementalDynamicSortEnabled());
+  proxyModel.setIncrementalDynamicSortEnabled(true);
+  QVERIFY(proxyModel.isIncrementalDynamicSortEnabled());
+  proxyModel.addColumnToSortOrder(0, Qt::AscendingOrder);
+  proxyModel.addColumnToSortOrder(1, Qt::AscendingOrder);
+  /*
+   * Sort done for each column:
+   * a change must schedule a sort
+   */
+  proxyModel.sort();
+  QVERIFY(!proxyModel.isSortScheduled());
+  modelSortedSpy.clear();
+  model.appendRow();
+  QVERIFY(model.setData(model.index(4, 0), 1));
+  QVERIFY(model.setData(model.index(4, 1), 0));
+  QVERIFY(proxyModel.isSortScheduled());
+  QCOMPARE(modelSortedSpy.count(), 0);
+  QTRY_VERIFY(!proxyModel.isSortScheduled());
+  QCOMPARE(modelSortedSpy.count(), 1);
+  QCOMPARE(getModelData(proxyModel, 0, 0), QVariant(1));
+  QCOMPARE(getModelData(proxyModel, 0, 1), QVariant(0));
+  QCOMPARE(getModelData(proxyModel, 4, 0), QVariant(2));
+  QCOMPARE(getModelData(proxyModel, 4, 1), QVariant(2));
+  /*
+   * Single pass sort:
+   * changes in the first column are handled by QSortFilterProxyModel
+   */
+  proxyModel.setSinglePassSortEnabled(true);
+  proxyModel.sort();
+  modelSortedSpy.clear();
+  QCOMPARE(getModelData(proxyModel, 0, 0), QVariant(1));
+  QCOMPARE(getModelData(proxyModel, 0, 1), QVariant(0));
+  QVERIFY(model.setData(model.index(4, 0), 2));
+  QVERIFY(!proxyModel.isSortScheduled());
+  QCOMPARE(modelSortedSpy.count(), 0);
+  QCOMPARE(getModelData(proxyModel, 0, 0), QVariant(1));
+  QCOMPARE(getModelData(proxyModel, 0, 1), QVariant(1));
+  QCOMPARE(getModelData(proxyModel, 2, 0), QVariant(2));
+  QCOMPARE(getModelData(proxyModel, 2, 1), QVariant(0));
+  QCOMPARE(getModelData(proxyModel, 4, 0), QVariant(2));
+  QCOMPARE(getModelData(proxyModel, 4, 1), QVariant(2));
+  /*
+   * Single pass sort:
+   * inserted rows are handled by QSortFilterProxyModel,
+   * a burst of changes in another column schedules one sort
+   */
+  model.appendRow();
+  QVERIFY(!proxyModel.isSortScheduled());
+  QVERIFY(model.setData(model.index(5, 1), 0));
+  QVERIFY(model.setData(model.index(5, 0), 1));
+  QVERIFY(model.setData(model.index(0, 1), 3));
+  QVERIFY(proxyModel.isSortScheduled());
+  QCOMPARE(modelSortedSpy.count(), 0);
+  QTRY_VERIFY(!proxyModel.isSortScheduled());
+  QCOMPARE(modelSortedSpy.count(), 1);
+  QCOMPARE(getModelData(proxyModel, 0, 0), QVariant(1));
+  QCOMPARE(getModelData(proxyModel, 0, 1), QVariant(0));
+  QCOMPARE(getModelData(proxyModel, 3, 0), QVariant(2));
+  QCOMPARE(getModelData(proxyModel, 3, 1), QVariant(0));
+  QCOMPARE(getModelData(proxyModel, 5, 0), QVariant(2));
+  QCOMPARE(getModelData(proxyModel, 5, 1), QVariant(3));
+}
+
+void SortProxyModelTest::incrementalDynamicSortBenchmark()
+{
+  QFETCH(int, n);
+  QFETCH(bool, incremental);
+  VariantTableModel model;
+  SortProxyModel proxyModel;
+  /*
+   * Setup models
+   */
+  model.resize(0, 2);
+  proxyModel.setSourceModel(&model);
+  proxyModel.setDynamicSortFilter(true);
+  proxyModel.setSinglePassSortEnabled(true);
+  proxyModel.setIncrementalDynamicSortEnabled(incremental);
+  proxyModel.addColumnToSortOrder(0, Qt::AscendingOrder);
+  proxyModel.addColumnToSortOrder(1, Qt::AscendingOrder);
+  proxyModel.sort();
+  /*
+   * Append rows, in reverse order
+   */
+  QBENCHMARK{
+    model.resize(0, 2);
+    for(int i = n; i > 0; --i){
+      const int row = model.rowCount();
+      model.appendRow();
+      QVERIFY(model.setData(model.index(row, 1), i));
+      QVERIFY(model.setData(model.index(row, 0), i % 10));
+    }
+  }
+  QCOMPARE(proxyModel.rowCount(), n);
+  QTRY_VERIFY(!proxyModel.isSortScheduled());
+  QCOMPARE(getModelData(proxyModel, 0, 0), QVariant(0));
+  QCOMPARE(getModelData(proxyModel, 0, 1), QVariant(10));
+}
+
+void SortProxyModelTest::incrementalDynamicSortBenchmark_data()
+{
+  QTest::addColumn<int>("n");
+  QTest::addColumn<bool>("incremental");
+
+  QTest::newRow("100") << 100 << false;
+  QTest::newRow("100,incremental") << 100 << true;
+  QTest::newRow("1'000") << 1000 << false;
+  QTest::newRow("1'000,incremental") << 1000 << true;
+}
+
 void SortProxyModelTest::fetchTest()
 {
   QSKIP("Need more experience to implement. Maybe should be implemented in ItemModel_Sql ?");
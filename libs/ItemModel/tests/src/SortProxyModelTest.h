@@ -50,11 +50,21 @@ class SortProxyModelTest : public QObject
   void sortIntTest();
   void sortIntBenchmark();
   void sortIntBenchmark_data();
+  void sortSinglePassTest();
+  void sortSinglePassBenchmark();
+  void sortSinglePassBenchmark_data();
+  void parallelStableSortTest();
+  void parallelSortTest();
+  void parallelSortBenchmark();
+  void parallelSortBenchmark_data();
 
   void sortRoleTest();
 
   void sortStringCsTest();
   void sortStringNumericModeTest();
+  void collatorSortKeyCacheTest();
+  void collatorSortKeyCacheStableKeysTest();
+  void sortStringNumericModeDynamicTest();
   void sortStringIntMixedTest();
 
   void sortStringNonLocalAwareBenchmark();
@@ -68,6 +78,9 @@ class SortProxyModelTest : public QObject
   void sortSignalTest();
   void sortSetterEventTest();
   void dynamicSortTest();
+  void incrementalDynamicSortTest();
+  void incrementalDynamicSortBenchmark();
+  void incrementalDynamicSortBenchmark_data();
 
   /*! \todo Implement this test
    *
@@ -22,6 +22,7 @@
 #include "qtmodeltest.h"
 #include "Mdt/Application.h"
 #include "Mdt/ItemModel/VariantTableModel.h"
+#include "Mdt/ItemModel/SortProxyModel.h"
 #include <QSignalSpy>
 #include <QVariantList>
 #include <QTableView>
@@ -35,6 +36,9 @@ using ItemModel::VariantTableModel;
 using ItemModel::VariantTableModelRow;
 using ItemModel::VariantTableModelItem;
 using ItemModel::VariantTableModelStorageRule;
+using ItemModel::VariantTableModelStorageLayout;
+using ItemModel::VariantTableModelColumn;
+using ItemModel::VariantTableModelColumnData;
 
 /*
  * Class used for flags tests
@@ -423,6 +427,140 @@ void VariantTableModelTest::dataRowRemoveColumnsTest()
   QCOMPARE(row.data(0, Qt::DisplayRole), QVariant("D"));
 }
 
+void VariantTableModelTest::columnDataTest()
+{
+  using Type = VariantTableModelColumnData::Type;
+  /*
+   * Initial state
+   */
+  VariantTableModelColumnData data(3);
+  QCOMPARE(data.rowCount(), 3);
+  QCOMPARE(data.type(), Type::Null);
+  QVERIFY(data.data(0).isNull());
+  QVERIFY(data.data(2).isNull());
+  /*
+   * Setting a invalid QVariant allocates nothing
+   */
+  data.setData(1, QVariant());
+  QCOMPARE(data.type(), Type::Null);
+  /*
+   * First value gives the type
+   */
+  data.setData(1, 25);
+  QCOMPARE(data.type(), Type::Int64);
+  QVERIFY(data.data(0).isNull());
+  QCOMPARE(data.data(1), QVariant(25));
+  QCOMPARE(data.data(1).userType(), (int)QMetaType::Int);
+  QVERIFY(data.data(2).isNull());
+  data.setData(2, -4);
+  QCOMPARE(data.data(2), QVariant(-4));
+  data.setData(2, QVariant());
+  QVERIFY(data.data(2).isNull());
+  QCOMPARE(data.type(), Type::Int64);
+  /*
+   * Insert and remove rows
+   */
+  data.insertRows(0, 2);
+  QCOMPARE(data.rowCount(), 5);
+  QVERIFY(data.data(0).isNull());
+  QVERIFY(data.data(1).isNull());
+  QVERIFY(data.data(2).isNull());
+  QCOMPARE(data.data(3), QVariant(25));
+  QVERIFY(data.data(4).isNull());
+  data.removeRows(0, 3);
+  QCOMPARE(data.rowCount(), 2);
+  QCOMPARE(data.data(0), QVariant(25));
+  QVERIFY(data.data(1).isNull());
+  data.resize(3);
+  QCOMPARE(data.rowCount(), 3);
+  QCOMPARE(data.data(0), QVariant(25));
+  QVERIFY(data.data(2).isNull());
+  /*
+   * A value of a other type: fall back to QVariant
+   */
+  data.setData(1, "A");
+  QCOMPARE(data.type(), Type::Variant);
+  QCOMPARE(data.data(0), QVariant(25));
+  QCOMPARE(data.data(0).userType(), (int)QMetaType::Int);
+  QCOMPARE(data.data(1), QVariant("A"));
+  QVERIFY(data.data(2).isNull());
+  /*
+   * Other types
+   */
+  VariantTableModelColumnData doubleData(2);
+  doubleData.setData(0, 1.5);
+  QCOMPARE(doubleData.type(), Type::Double);
+  QCOMPARE(doubleData.data(0), QVariant(1.5));
+  QVERIFY(doubleData.data(1).isNull());
+  VariantTableModelColumnData stringData(2);
+  stringData.setData(1, QString("B"));
+  QCOMPARE(stringData.type(), Type::String);
+  QVERIFY(stringData.data(0).isNull());
+  QCOMPARE(stringData.data(1), QVariant("B"));
+  VariantTableModelColumnData longLongData(2);
+  longLongData.setData(0, qlonglong(5000000000));
+  QCOMPARE(longLongData.type(), Type::Int64);
+  QCOMPARE(longLongData.data(0).userType(), (int)QMetaType::LongLong);
+  QCOMPARE(longLongData.data(0).toLongLong(), qlonglong(5000000000));
+  longLongData.setData(1, 2);
+  QCOMPARE(longLongData.type(), Type::Variant);
+  QCOMPARE(longLongData.data(1).userType(), (int)QMetaType::Int);
+  VariantTableModelColumnData boolData(1);
+  boolData.setData(0, true);
+  QCOMPARE(boolData.type(), Type::Variant);
+  QCOMPARE(boolData.data(0), QVariant(true));
+}
+
+void VariantTableModelTest::dataColumnTest()
+{
+  Qt::ItemFlags flags = Qt::NoItemFlags;
+  Qt::ItemFlags expectedFlags = (Qt::ItemIsEnabled | Qt::ItemIsEditable);
+  /*
+   * Initial state
+   */
+  VariantTableModelColumn column(VariantTableModelStorageRule::SeparateDisplayAndEditRoleData, 3);
+  QCOMPARE(column.rowCount(), 3);
+  QVERIFY(column.data(0, Qt::DisplayRole).isNull());
+  QVERIFY(column.data(0, Qt::EditRole).isNull());
+  QVERIFY(column.data(2, Qt::DisplayRole).isNull());
+  QVERIFY(column.data(2, Qt::EditRole).isNull());
+  QCOMPARE(column.flags(0, flags), expectedFlags);
+  QCOMPARE(column.flags(2, flags), expectedFlags);
+  /*
+   * Set data and flags
+   */
+  column.setData(2, "DA2", Qt::DisplayRole);
+  column.setData(2, "EA2", Qt::EditRole);
+  column.setItemEnabled(1, false);
+  column.setItemEditable(2, false);
+  QVERIFY(column.data(0, Qt::DisplayRole).isNull());
+  QCOMPARE(column.data(2, Qt::DisplayRole) , QVariant("DA2"));
+  QCOMPARE(column.data(2, Qt::EditRole) , QVariant("EA2"));
+  QCOMPARE(column.flags(0, flags), expectedFlags);
+  QCOMPARE(column.flags(1, flags), Qt::ItemFlags(Qt::ItemIsEditable));
+  QCOMPARE(column.flags(2, flags), Qt::ItemFlags(Qt::ItemIsEnabled));
+  /*
+   * Insert and remove rows
+   */
+  column.insertRows(1, 1);
+  QCOMPARE(column.rowCount(), 4);
+  QCOMPARE(column.flags(1, flags), expectedFlags);
+  QCOMPARE(column.flags(2, flags), Qt::ItemFlags(Qt::ItemIsEditable));
+  QCOMPARE(column.data(3, Qt::EditRole) , QVariant("EA2"));
+  column.removeRows(0, 2);
+  QCOMPARE(column.rowCount(), 2);
+  QCOMPARE(column.flags(0, flags), Qt::ItemFlags(Qt::ItemIsEditable));
+  QCOMPARE(column.data(1, Qt::DisplayRole) , QVariant("DA2"));
+  QCOMPARE(column.data(1, Qt::EditRole) , QVariant("EA2"));
+  /*
+   * Group display and edit role data
+   */
+  VariantTableModelColumn groupColumn(VariantTableModelStorageRule::GroupDisplayAndEditRoleData, 1);
+  groupColumn.setData(0, "E0", Qt::EditRole);
+  QCOMPARE(groupColumn.data(0, Qt::DisplayRole) , QVariant("E0"));
+  QCOMPARE(groupColumn.data(0, Qt::EditRole) , QVariant("E0"));
+}
+
 void VariantTableModelTest::tableModelTest()
 {
   QModelIndex index;
@@ -1439,6 +1577,441 @@ void VariantTableModelTest::tableModelQtModelTest()
   QtModelTest mt(&model);
 }
 
+void VariantTableModelTest::tableModelStorageLayoutTest()
+{
+  const Qt::ItemFlags standardFlags = Qt::ItemFlags(getTableModelStandardFlags() | Qt::ItemIsEditable);
+
+  VariantTableModel model;
+  QCOMPARE(model.storageLayout(), VariantTableModelStorageLayout::Rows);
+  model.populate(3, 2);
+  model.setData(1, 1, 15);
+  model.setItemEnabled(2, 0, false);
+  QSignalSpy resetSpy(&model, &VariantTableModel::modelReset);
+  QVERIFY(resetSpy.isValid());
+  /*
+   * Rows -> Columns: data and flags are kept
+   */
+  model.setStorageLayout(VariantTableModelStorageLayout::Columns);
+  QCOMPARE(resetSpy.count(), 1);
+  QCOMPARE(model.storageLayout(), VariantTableModelStorageLayout::Columns);
+  QCOMPARE(model.rowCount(), 3);
+  QCOMPARE(model.columnCount(), 2);
+  QCOMPARE(model.data(0, 0), QVariant("0A"));
+  QCOMPARE(model.data(0, 1), QVariant("0B"));
+  QCOMPARE(model.data(1, 1), QVariant(15));
+  QCOMPARE(model.data(2, 1, Qt::EditRole), QVariant("2B"));
+  QCOMPARE(model.flags(model.index(2, 0)), standardFlags & Qt::ItemFlags(~Qt::ItemIsEnabled));
+  QCOMPARE(model.flags(model.index(2, 1)), standardFlags);
+  /*
+   * Setting the same layout does nothing
+   */
+  model.setStorageLayout(VariantTableModelStorageLayout::Columns);
+  QCOMPARE(resetSpy.count(), 1);
+  /*
+   * Set data and flags in Columns layout
+   */
+  QVERIFY(model.setData(0, 0, "E0A"));
+  model.setItemEditable(0, 1, false);
+  QCOMPARE(model.data(0, 0), QVariant("E0A"));
+  QCOMPARE(model.flags(model.index(0, 1)), Qt::ItemFlags(getTableModelStandardFlags()));
+  /*
+   * Columns -> Rows
+   */
+  model.setStorageLayout(VariantTableModelStorageLayout::Rows);
+  QCOMPARE(resetSpy.count(), 2);
+  QCOMPARE(model.rowCount(), 3);
+  QCOMPARE(model.columnCount(), 2);
+  QCOMPARE(model.data(0, 0), QVariant("E0A"));
+  QCOMPARE(model.data(1, 1), QVariant(15));
+  QCOMPARE(model.data(2, 1), QVariant("2B"));
+  QCOMPARE(model.flags(model.index(2, 0)), standardFlags & Qt::ItemFlags(~Qt::ItemIsEnabled));
+  QCOMPARE(model.flags(model.index(0, 1)), Qt::ItemFlags(getTableModelStandardFlags()));
+  QCOMPARE(model.flags(model.index(1, 1)), standardFlags);
+  /*
+   * Populate and clear in Columns layout
+   */
+  model.setStorageLayout(VariantTableModelStorageLayout::Columns);
+  model.populate(2, 3);
+  QCOMPARE(model.rowCount(), 2);
+  QCOMPARE(model.columnCount(), 3);
+  QCOMPARE(model.data(1, 2), QVariant("1C"));
+  model.clear();
+  QCOMPARE(model.rowCount(), 0);
+  QCOMPARE(model.columnCount(), 0);
+  QCOMPARE(model.storageLayout(), VariantTableModelStorageLayout::Columns);
+}
+
+void VariantTableModelTest::tableModelStorageLayoutSeparateEditTest()
+{
+  VariantTableModel model(VariantTableModelStorageRule::SeparateDisplayAndEditRoleData);
+  model.resize(2, 1);
+  model.populateColumn(0, {"D0","D1"}, Qt::DisplayRole);
+  model.populateColumn(0, {"E0","E1"}, Qt::EditRole);
+  /*
+   * Rows -> Columns
+   */
+  model.setStorageLayout(VariantTableModelStorageLayout::Columns);
+  QCOMPARE(model.data(0, 0, Qt::DisplayRole), QVariant("D0"));
+  QCOMPARE(model.data(0, 0, Qt::EditRole), QVariant("E0"));
+  QCOMPARE(model.data(1, 0, Qt::DisplayRole), QVariant("D1"));
+  QCOMPARE(model.data(1, 0, Qt::EditRole), QVariant("E1"));
+  QVERIFY(model.setData(1, 0, "E1b", Qt::EditRole));
+  QCOMPARE(model.data(1, 0, Qt::DisplayRole), QVariant("D1"));
+  QCOMPARE(model.data(1, 0, Qt::EditRole), QVariant("E1b"));
+  /*
+   * Columns -> Rows
+   */
+  model.setStorageLayout(VariantTableModelStorageLayout::Rows);
+  QCOMPARE(model.data(0, 0, Qt::DisplayRole), QVariant("D0"));
+  QCOMPARE(model.data(0, 0, Qt::EditRole), QVariant("E0"));
+  QCOMPARE(model.data(1, 0, Qt::DisplayRole), QVariant("D1"));
+  QCOMPARE(model.data(1, 0, Qt::EditRole), QVariant("E1b"));
+}
+
+void VariantTableModelTest::tableModelColumnsLayoutRowsColumnsTest()
+{
+  VariantTableModel model;
+  model.setStorageLayout(VariantTableModelStorageLayout::Columns);
+  /*
+   * Rows without columns
+   */
+  model.resize(2, 0);
+  QCOMPARE(model.rowCount(), 2);
+  QCOMPARE(model.columnCount(), 0);
+  model.resize(2, 1);
+  model.populateColumn(0, {1,2});
+  /*
+   * Insert and remove rows
+   */
+  model.appendRow();
+  model.prependRow();
+  QCOMPARE(model.rowCount(), 4);
+  QVERIFY(model.data(0, 0).isNull());
+  QCOMPARE(model.data(1, 0), QVariant(1));
+  QCOMPARE(model.data(2, 0), QVariant(2));
+  QVERIFY(model.data(3, 0).isNull());
+  model.removeFirstRow();
+  model.removeLastRow();
+  QCOMPARE(model.rowCount(), 2);
+  QCOMPARE(model.data(0, 0), QVariant(1));
+  QCOMPARE(model.data(1, 0), QVariant(2));
+  /*
+   * Insert and remove columns
+   */
+  model.prependColumn();
+  model.appendColumn();
+  QCOMPARE(model.columnCount(), 3);
+  QCOMPARE(model.rowCount(), 2);
+  QVERIFY(model.data(0, 0).isNull());
+  QCOMPARE(model.data(0, 1), QVariant(1));
+  QVERIFY(model.data(1, 2).isNull());
+  model.setData(1, 2, "B");
+  QCOMPARE(model.data(1, 2), QVariant("B"));
+  model.removeFirstColumn();
+  QCOMPARE(model.columnCount(), 2);
+  QCOMPARE(model.data(1, 0), QVariant(2));
+  QCOMPARE(model.data(1, 1), QVariant("B"));
+  /*
+   * Resize
+   */
+  model.resize(3, 1);
+  QCOMPARE(model.rowCount(), 3);
+  QCOMPARE(model.columnCount(), 1);
+  QCOMPARE(model.data(1, 0), QVariant(2));
+  QVERIFY(model.data(2, 0).isNull());
+  /*
+   * Repopulate
+   */
+  model.repopulateByColumns({{1,2,3},{"A","B","C"}});
+  QCOMPARE(model.rowCount(), 3);
+  QCOMPARE(model.columnCount(), 2);
+  QCOMPARE(model.data(2, 0), QVariant(3));
+  QCOMPARE(model.data(2, 1), QVariant("C"));
+}
+
+void VariantTableModelTest::tableModelColumnsLayoutQtModelTest()
+{
+  VariantTableModel model;
+  model.setStorageLayout(VariantTableModelStorageLayout::Columns);
+  model.resize(5, 2);
+  model.populateColumnWithInt(0, 1);
+  model.populateColumnWithAscii(1, 'A');
+  QtModelTest mt(&model);
+}
+
+void VariantTableModelTest::tableModelSetDataRangeTest()
+{
+  VariantTableModel model;
+  model.resize(4, 3);
+  /*
+   * Block
+   */
+  QVERIFY(model.setDataRange(1, 1, {{"B1","B2"},{"C1","C2"}}));
+  QVERIFY(model.data(0, 1).isNull());
+  QVERIFY(model.data(1, 0).isNull());
+  QCOMPARE(model.data(1, 1), QVariant("B1"));
+  QCOMPARE(model.data(2, 1), QVariant("B2"));
+  QCOMPARE(model.data(1, 2), QVariant("C1"));
+  QCOMPARE(model.data(2, 2), QVariant("C2"));
+  QVERIFY(model.data(3, 2).isNull());
+  /*
+   * Column
+   */
+  QVERIFY(model.setColumnData(0, 0, {1,2,3,4}));
+  QCOMPARE(model.data(0, 0), QVariant(1));
+  QCOMPARE(model.data(3, 0), QVariant(4));
+  std::vector<QVariant> columnData{"b","c"};
+  QVERIFY(model.setColumnData(2, 2, std::move(columnData)));
+  QCOMPARE(model.data(1, 2), QVariant("C1"));
+  QCOMPARE(model.data(2, 2), QVariant("b"));
+  QCOMPARE(model.data(3, 2), QVariant("c"));
+  /*
+   * Row
+   */
+  QVERIFY(model.setRowData(3, 1, {"R1","R2"}));
+  QCOMPARE(model.data(3, 0), QVariant(4));
+  QCOMPARE(model.data(3, 1), QVariant("R1"));
+  QCOMPARE(model.data(3, 2), QVariant("R2"));
+  /*
+   * Same with Columns storage layout
+   */
+  model.setStorageLayout(VariantTableModelStorageLayout::Columns);
+  std::vector< std::vector<QVariant> > blockData{{10,11},{"X","Y"}};
+  QVERIFY(model.setDataRange(0, 0, std::move(blockData)));
+  QCOMPARE(model.data(0, 0), QVariant(10));
+  QCOMPARE(model.data(1, 0), QVariant(11));
+  QCOMPARE(model.data(0, 1), QVariant("X"));
+  QCOMPARE(model.data(1, 1), QVariant("Y"));
+  QCOMPARE(model.data(2, 1), QVariant("B2"));
+  QVERIFY(model.setRowData(2, 0, {12}));
+  QCOMPARE(model.data(2, 0), QVariant(12));
+  /*
+   * Invalid role
+   */
+  QVERIFY(!model.setColumnData(0, 0, {1}, Qt::ToolTipRole));
+  QCOMPARE(model.data(0, 0), QVariant(10));
+}
+
+void VariantTableModelTest::tableModelSetDataRangeSignalTest()
+{
+  QVariantList arguments;
+  QModelIndex index;
+  QVector<int> roles;
+
+  VariantTableModel model(VariantTableModelStorageRule::SeparateDisplayAndEditRoleData);
+  model.resize(100, 10);
+  QSignalSpy dataChangedSpy(&model, &VariantTableModel::dataChanged);
+  QVERIFY(dataChangedSpy.isValid());
+  /*
+   * A block emits dataChanged once
+   */
+  std::vector< std::vector<QVariant> > blockData(10, std::vector<QVariant>(100, 5));
+  QVERIFY(model.setDataRange(0, 0, std::move(blockData), Qt::DisplayRole));
+  QCOMPARE(dataChangedSpy.count(), 1);
+  arguments = dataChangedSpy.takeFirst();
+  index = arguments.at(0).toModelIndex(); // topLeft
+  QCOMPARE(index.row(), 0);
+  QCOMPARE(index.column(), 0);
+  index = arguments.at(1).toModelIndex(); // bottomRight
+  QCOMPARE(index.row(), 99);
+  QCOMPARE(index.column(), 9);
+  roles = arguments.at(2).value<QVector<int>>();
+  QCOMPARE(roles.size(), 1);
+  QCOMPARE((Qt::ItemDataRole)roles.at(0), Qt::DisplayRole);
+  /*
+   * Column
+   */
+  QVERIFY(model.setColumnData(3, 10, {1,2,3}));
+  QCOMPARE(dataChangedSpy.count(), 1);
+  arguments = dataChangedSpy.takeFirst();
+  index = arguments.at(0).toModelIndex(); // topLeft
+  QCOMPARE(index.row(), 10);
+  QCOMPARE(index.column(), 3);
+  index = arguments.at(1).toModelIndex(); // bottomRight
+  QCOMPARE(index.row(), 12);
+  QCOMPARE(index.column(), 3);
+  roles = arguments.at(2).value<QVector<int>>();
+  QCOMPARE(roles.size(), 1);
+  QCOMPARE((Qt::ItemDataRole)roles.at(0), Qt::EditRole);
+  /*
+   * Row
+   */
+  QVERIFY(model.setRowData(7, 2, {1,2}));
+  QCOMPARE(dataChangedSpy.count(), 1);
+  arguments = dataChangedSpy.takeFirst();
+  index = arguments.at(0).toModelIndex(); // topLeft
+  QCOMPARE(index.row(), 7);
+  QCOMPARE(index.column(), 2);
+  index = arguments.at(1).toModelIndex(); // bottomRight
+  QCOMPARE(index.row(), 7);
+  QCOMPARE(index.column(), 3);
+  /*
+   * Empty data: no signal
+   */
+  QVERIFY(model.setRowData(7, 2, {}));
+  QCOMPARE(dataChangedSpy.count(), 0);
+}
+
+void VariantTableModelTest::tableModelBatchSignalTest()
+{
+  QVariantList arguments;
+  QModelIndex index;
+  QVector<int> roles;
+
+  VariantTableModel model;
+  model.resize(10, 3);
+  QSignalSpy dataChangedSpy(&model, &VariantTableModel::dataChanged);
+  QVERIFY(dataChangedSpy.isValid());
+  /*
+   * Edits of a whole block: one signal at the end
+   */
+  QVERIFY(!model.isInBatch());
+  model.beginBatch();
+  QVERIFY(model.isInBatch());
+  for(int row = 0; row < 10; ++row){
+    QVERIFY(model.setData(row, 0, row));
+    QVERIFY(model.setData(row, 1, QString::number(row)));
+  }
+  QCOMPARE(dataChangedSpy.count(), 0);
+  QCOMPARE(model.data(5, 1), QVariant("5"));
+  model.endBatch();
+  QVERIFY(!model.isInBatch());
+  QCOMPARE(dataChangedSpy.count(), 1);
+  arguments = dataChangedSpy.takeFirst();
+  index = arguments.at(0).toModelIndex(); // topLeft
+  QCOMPARE(index.row(), 0);
+  QCOMPARE(index.column(), 0);
+  index = arguments.at(1).toModelIndex(); // bottomRight
+  QCOMPARE(index.row(), 9);
+  QCOMPARE(index.column(), 1);
+  roles = arguments.at(2).value<QVector<int>>();
+  QCOMPARE(roles.size(), 2);
+  QCOMPARE((Qt::ItemDataRole)roles.at(0), Qt::DisplayRole);
+  QCOMPARE((Qt::ItemDataRole)roles.at(1), Qt::EditRole);
+  /*
+   * Nested batches, disjoint edits
+   */
+  model.beginBatch();
+  QVERIFY(model.setData(0, 2, "A"));
+  model.beginBatch();
+  QVERIFY(model.setColumnData(2, 1, {"B","C"}));
+  QVERIFY(model.setData(8, 0, "D"));
+  model.endBatch();
+  QCOMPARE(dataChangedSpy.count(), 0);
+  model.endBatch();
+  QCOMPARE(dataChangedSpy.count(), 2);
+  arguments = dataChangedSpy.takeFirst();
+  index = arguments.at(0).toModelIndex(); // topLeft
+  QCOMPARE(index.row(), 0);
+  QCOMPARE(index.column(), 2);
+  index = arguments.at(1).toModelIndex(); // bottomRight
+  QCOMPARE(index.row(), 2);
+  QCOMPARE(index.column(), 2);
+  arguments = dataChangedSpy.takeFirst();
+  index = arguments.at(0).toModelIndex(); // topLeft
+  QCOMPARE(index.row(), 8);
+  QCOMPARE(index.column(), 0);
+  index = arguments.at(1).toModelIndex(); // bottomRight
+  QCOMPARE(index.row(), 8);
+  QCOMPARE(index.column(), 0);
+  /*
+   * Inserting rows during a batch first signals the edits done so far
+   */
+  model.beginBatch();
+  QVERIFY(model.setData(1, 1, "E"));
+  model.prependRow();
+  QCOMPARE(dataChangedSpy.count(), 1);
+  arguments = dataChangedSpy.takeFirst();
+  index = arguments.at(0).toModelIndex(); // topLeft
+  QCOMPARE(index.row(), 1);
+  QCOMPARE(index.column(), 1);
+  QVERIFY(model.setData(1, 1, "F"));
+  model.endBatch();
+  QCOMPARE(dataChangedSpy.count(), 1);
+  arguments = dataChangedSpy.takeFirst();
+  index = arguments.at(0).toModelIndex(); // topLeft
+  QCOMPARE(index.row(), 1);
+  QCOMPARE(index.column(), 1);
+  QCOMPARE(model.data(1, 1), QVariant("F"));
+  QCOMPARE(model.data(2, 1), QVariant("E"));
+  /*
+   * Empty batch
+   */
+  model.beginBatch();
+  model.endBatch();
+  QCOMPARE(dataChangedSpy.count(), 0);
+}
+
+void VariantTableModelTest::scanColumnBenchmark()
+{
+  QFETCH(int, n);
+  QFETCH(bool, byColumns);
+
+  VariantTableModel model;
+  if(byColumns){
+    model.setStorageLayout(VariantTableModelStorageLayout::Columns);
+  }
+  model.resize(n, 5);
+  model.populateColumnWithInt(1, 0);
+  qlonglong sum = 0;
+  QBENCHMARK{
+    sum = 0;
+    for(int row = 0; row < n; ++row){
+      sum += model.data(row, 1).toLongLong();
+    }
+  }
+  QCOMPARE(sum, qlonglong(n) * qlonglong(n-1) / 2);
+}
+
+void VariantTableModelTest::scanColumnBenchmark_data()
+{
+  QTest::addColumn<int>("n");
+  QTest::addColumn<bool>("byColumns");
+
+  QTest::newRow("1'000,rows") << 1000 << false;
+  QTest::newRow("1'000,columns") << 1000 << true;
+  QTest::newRow("100'000,rows") << 100000 << false;
+  QTest::newRow("100'000,columns") << 100000 << true;
+}
+
+void VariantTableModelTest::fillBlockWithSortProxyModelBenchmark()
+{
+  QFETCH(int, n);
+  QFETCH(bool, useRange);
+
+  VariantTableModel model;
+  model.resize(n, 10);
+  ItemModel::SortProxyModel proxyModel;
+  proxyModel.setSourceModel(&model);
+  proxyModel.setDynamicSortFilter(true);
+  proxyModel.addColumnToSortOrder(0, Qt::AscendingOrder);
+  proxyModel.sort();
+  QBENCHMARK{
+    if(useRange){
+      std::vector< std::vector<QVariant> > data(10, std::vector<QVariant>(n, 1));
+      QVERIFY(model.setDataRange(0, 0, std::move(data)));
+    }else{
+      for(int col = 0; col < 10; ++col){
+        for(int row = 0; row < n; ++row){
+          QVERIFY(model.setData(row, col, 1));
+        }
+      }
+    }
+  }
+  QCOMPARE(proxyModel.rowCount(), n);
+}
+
+void VariantTableModelTest::fillBlockWithSortProxyModelBenchmark_data()
+{
+  QTest::addColumn<int>("n");
+  QTest::addColumn<bool>("useRange");
+
+  QTest::newRow("100") << 100 << false;
+  QTest::newRow("100,range") << 100 << true;
+  QTest::newRow("1'000") << 1000 << false;
+  QTest::newRow("1'000,range") << 1000 << true;
+}
+
 /*
  * Main
  */
@@ -40,6 +40,9 @@ class VariantTableModelTest : public TestBase
   void dataRowInsertColumnsTest();
   void dataRowRemoveColumnsTest();
 
+  void columnDataTest();
+  void dataColumnTest();
+
   void tableModelTest();
   void tableModelSeparateEditTest();
   void tableModelFlagTest();
@@ -57,6 +60,18 @@ class VariantTableModelTest : public TestBase
   void tableModelRemoveRowsTest();
   void tableModelChangeRowsCountSignalTest();
   void tableModelQtModelTest();
+  void tableModelStorageLayoutTest();
+  void tableModelStorageLayoutSeparateEditTest();
+  void tableModelColumnsLayoutRowsColumnsTest();
+  void tableModelColumnsLayoutQtModelTest();
+  void tableModelSetDataRangeTest();
+  void tableModelSetDataRangeSignalTest();
+  void tableModelBatchSignalTest();
+
+  void scanColumnBenchmark();
+  void scanColumnBenchmark_data();
+  void fillBlockWithSortProxyModelBenchmark();
+  void fillBlockWithSortProxyModelBenchmark_data();
 };
 
 #endif // #ifndef MDT_ITEM_MODEL_VARIANT_TABLE_MODEL_TEST_H
@@ -0,0 +1,252 @@
+/****************************************************************************
+ **
+ ** Copyright (C) 2011-2017 Philippe Steinmann.
+ **
+ ** This file is part of multiDiagTools library.
+ **
+ ** multiDiagTools is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Lesser General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** multiDiagTools is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public License
+ ** along with multiDiagTools.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+#ifndef MDT_PLAIN_TEXT_BYTE_CONST_ITERATOR_H
+#define MDT_PLAIN_TEXT_BYTE_CONST_ITERATOR_H
+
+#include <QtGlobal>
+#include <iterator>
+#include <cstddef>
+
+namespace Mdt{ namespace PlainText{
+
+/*! \brief Iterator that acts on a raw byte buffer
+ *
+ * Iterator that can be used by parsers based on Boost.Spirit
+ *  to be able to parse a buffer of bytes directly,
+ *  typically a memory mapped file.
+ *
+ * Each byte is returned as a unsigned value,
+ *  seen as wchar_t by Spirit.
+ *  For Latin-1 encoded data, this is directly the unicode value.
+ *  For UTF-8 encoded data, all ASCII chars (witch are
+ *  the ones that have a special meaning for a CSV parser)
+ *  are also mapped to their unicode value,
+ *  while the bytes of a multi-byte sequence are all >= 0x80,
+ *  so they can be decoded later, once a field was extracted.
+ *
+ * \sa CsvFileParser::MemoryMappedInput
+ */
+struct ByteConstIterator
+{
+  static_assert(sizeof(wchar_t) >= 2, "wchar_t is < 16 bit");
+
+  using value_type = wchar_t;
+  using reference = const value_type &;
+  using pointer = const value_type*;
+  using difference_type = std::ptrdiff_t;
+  using iterator_category = std::random_access_iterator_tag;
+
+  /*! \brief Default constructor
+   *
+   * Construct a invalid iterator
+   */
+  ByteConstIterator()
+   : mIndex(nullptr)
+  {
+  }
+
+  /*! \brief Constructor
+   */
+  ByteConstIterator(const uchar *it)
+   : mIndex(it)
+  {
+    Q_ASSERT(mIndex != nullptr);
+  }
+
+  /*! \brief Assignement
+   */
+  ByteConstIterator & operator=(const ByteConstIterator & other)
+  {
+    mIndex = other.mIndex;
+    return *this;
+  }
+
+  /*! \brief Increment iterator (pre-increment)
+   */
+  ByteConstIterator & operator++()
+  {
+    Q_ASSERT(mIndex != nullptr);
+    ++mIndex;
+    return *this;
+  }
+
+  /*! \brief Increment iterator (post-increment)
+   */
+  ByteConstIterator operator++(int)
+  {
+    Q_ASSERT(mIndex != nullptr);
+    ByteConstIterator tmp(*this);
+    ++*this;
+    return tmp;
+  }
+
+  /*! \brief Decrement iterator (pre-decrement)
+   */
+  ByteConstIterator & operator--()
+  {
+    Q_ASSERT(mIndex != nullptr);
+    --mIndex;
+    return *this;
+  }
+
+  /*! \brief Decrement iterator (post-decrement)
+   */
+  ByteConstIterator operator--(int)
+  {
+    Q_ASSERT(mIndex != nullptr);
+    ByteConstIterator tmp(*this);
+    --*this;
+    return tmp;
+  }
+
+  /*! \brief Returns a iterator resulting from \a a + \a n
+   */
+  friend
+  ByteConstIterator operator+(const ByteConstIterator & a, difference_type n)
+  {
+    Q_ASSERT(a.mIndex != nullptr);
+    return ByteConstIterator(a.mIndex + n);
+  }
+
+  /*! \brief Returns a iterator resulting from \a n + \a a
+   */
+  friend
+  ByteConstIterator operator+(difference_type n, const ByteConstIterator & a)
+  {
+    Q_ASSERT(a.mIndex != nullptr);
+    return ByteConstIterator(a.mIndex + n);
+  }
+
+  /*! \brief Returns the difference resulting from \a b - \a a
+   */
+  friend
+  difference_type operator-(const ByteConstIterator & b, const ByteConstIterator & a)
+  {
+    Q_ASSERT(a.mIndex != nullptr);
+    Q_ASSERT(b.mIndex != nullptr);
+    return b.mIndex - a.mIndex;
+  }
+
+  /*! \brief Returns a iterator that is rewind by n positions
+   */
+  ByteConstIterator operator-(difference_type n) const
+  {
+    Q_ASSERT(mIndex != nullptr);
+    return ByteConstIterator(mIndex - n);
+  }
+
+  /*! \brief Advance iterator by n positions
+   */
+  ByteConstIterator & operator+=(difference_type n)
+  {
+    Q_ASSERT(mIndex != nullptr);
+    mIndex += n;
+    return *this;
+  }
+
+  /*! \brief Rewind iterator by n positions
+   */
+  ByteConstIterator & operator-=(difference_type n)
+  {
+    Q_ASSERT(mIndex != nullptr);
+    mIndex -= n;
+    return *this;
+  }
+
+  /*! \brief Get pointed value
+   */
+  value_type operator*() const
+  {
+    Q_ASSERT(mIndex != nullptr);
+    return *mIndex;
+  }
+
+  /*! \brief Get value by index
+   */
+  value_type operator[](difference_type i) const
+  {
+    Q_ASSERT(mIndex != nullptr);
+    return mIndex[i];
+  }
+
+  /*! \brief Get a pointer to the referenced byte
+   */
+  const uchar *data() const
+  {
+    return mIndex;
+  }
+
+  /*! \brief Returns true if iterator a refers to same item than iterator b
+   */
+  friend
+  bool operator==(const ByteConstIterator & a, const ByteConstIterator & b)
+  {
+    return (a.mIndex == b.mIndex);
+  }
+
+  /*! \brief Returns true if iterator a refers not to same item than iterator b
+   */
+  friend
+  bool operator!=(const ByteConstIterator & a, const ByteConstIterator & b)
+  {
+    return !(a == b);
+  }
+
+  /*! \brief Returns true if iterator a refers to a element prior to item referenced by iterator b
+   */
+  friend
+  bool operator<(const ByteConstIterator & a, const ByteConstIterator & b)
+  {
+    return (a.mIndex < b.mIndex);
+  }
+
+  /*! \brief Returns true if iterator a <= iterator b
+   */
+  friend
+  bool operator<=(const ByteConstIterator & a, const ByteConstIterator & b)
+  {
+    return (a.mIndex <= b.mIndex);
+  }
+
+  /*! \brief Returns true if iterator a > iterator b
+   */
+  friend
+  bool operator>(const ByteConstIterator & a, const ByteConstIterator & b)
+  {
+    return (a.mIndex > b.mIndex);
+  }
+
+  /*! \brief Returns true if iterator a >= iterator b
+   */
+  friend
+  bool operator>=(const ByteConstIterator & a, const ByteConstIterator & b)
+  {
+    return (a.mIndex >= b.mIndex);
+  }
+
+ private:
+
+  const uchar *mIndex;
+};
+
+}} // namespace Mdt{ namespace PlainText{
+
+#endif // #ifndef MDT_PLAIN_TEXT_BYTE_CONST_ITERATOR_H
@@ -0,0 +1,150 @@
+/****************************************************************************
+ **
+ ** Copyright (C) 2011-2017 Philippe Steinmann.
+ **
+ ** This file is part of multiDiagTools library.
+ **
+ ** multiDiagTools is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Lesser General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** multiDiagTools is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public License
+ ** along with multiDiagTools.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+#include "CharSearch.h"
+#include <QtGlobal>
+#include <QtAlgorithms>
+
+#if defined(__AVX2__)
+ #define MDT_PLAIN_TEXT_CHAR_SEARCH_AVX2
+ #include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+ #define MDT_PLAIN_TEXT_CHAR_SEARCH_SSE2
+ #include <emmintrin.h>
+#endif
+
+namespace Mdt{ namespace PlainText{ namespace Impl{
+
+const uchar *findFirstOf(const uchar *first, const uchar *last, uchar c1, uchar c2, uchar c3, uchar c4)
+{
+  Q_ASSERT(first <= last);
+
+#if defined(MDT_PLAIN_TEXT_CHAR_SEARCH_AVX2)
+  const __m256i v1 = _mm256_set1_epi8(static_cast<char>(c1));
+  const __m256i v2 = _mm256_set1_epi8(static_cast<char>(c2));
+  const __m256i v3 = _mm256_set1_epi8(static_cast<char>(c3));
+  const __m256i v4 = _mm256_set1_epi8(static_cast<char>(c4));
+  while( (last - first) >= 32 ){
+    const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+    const __m256i match = _mm256_or_si256(
+      _mm256_or_si256( _mm256_cmpeq_epi8(block, v1), _mm256_cmpeq_epi8(block, v2) ),
+      _mm256_or_si256( _mm256_cmpeq_epi8(block, v3), _mm256_cmpeq_epi8(block, v4) )
+    );
+    const uint mask = static_cast<uint>(_mm256_movemask_epi8(match));
+    if(mask != 0){
+      return first + qCountTrailingZeroBits(mask);
+    }
+    first += 32;
+  }
+#elif defined(MDT_PLAIN_TEXT_CHAR_SEARCH_SSE2)
+  const __m128i v1 = _mm_set1_epi8(static_cast<char>(c1));
+  const __m128i v2 = _mm_set1_epi8(static_cast<char>(c2));
+  const __m128i v3 = _mm_set1_epi8(static_cast<char>(c3));
+  const __m128i v4 = _mm_set1_epi8(static_cast<char>(c4));
+  while( (last - first) >= 16 ){
+    const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+    const __m128i match = _mm_or_si128(
+      _mm_or_si128( _mm_cmpeq_epi8(block, v1), _mm_cmpeq_epi8(block, v2) ),
+      _mm_or_si128( _mm_cmpeq_epi8(block, v3), _mm_cmpeq_epi8(block, v4) )
+    );
+    const uint mask = static_cast<uint>(_mm_movemask_epi8(match));
+    if(mask != 0){
+      return first + qCountTrailingZeroBits(mask);
+    }
+    first += 16;
+  }
+#endif
+  // Scalar search (also handles the remaining tail of the SIMD versions)
+  for( ; first != last; ++first){
+    const uchar c = *first;
+    if( (c == c1) || (c == c2) || (c == c3) || (c == c4) ){
+      return first;
+    }
+  }
+
+  return last;
+}
+
+const QChar *findFirstOf(const QChar *first, const QChar *last, ushort c1, ushort c2, ushort c3, ushort c4)
+{
+  Q_ASSERT(first <= last);
+
+  /*
+   * For 16 bit chars, _mm_movemask_epi8() gives 2 bits per char,
+   * so the index of the found char is the count of trailing zero bits / 2
+   */
+#if defined(MDT_PLAIN_TEXT_CHAR_SEARCH_AVX2)
+  const __m256i v1 = _mm256_set1_epi16(static_cast<short>(c1));
+  const __m256i v2 = _mm256_set1_epi16(static_cast<short>(c2));
+  const __m256i v3 = _mm256_set1_epi16(static_cast<short>(c3));
+  const __m256i v4 = _mm256_set1_epi16(static_cast<short>(c4));
+  while( (last - first) >= 16 ){
+    const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+    const __m256i match = _mm256_or_si256(
+      _mm256_or_si256( _mm256_cmpeq_epi16(block, v1), _mm256_cmpeq_epi16(block, v2) ),
+      _mm256_or_si256( _mm256_cmpeq_epi16(block, v3), _mm256_cmpeq_epi16(block, v4) )
+    );
+    const uint mask = static_cast<uint>(_mm256_movemask_epi8(match));
+    if(mask != 0){
+      return first + (qCountTrailingZeroBits(mask) / 2);
+    }
+    first += 16;
+  }
+#elif defined(MDT_PLAIN_TEXT_CHAR_SEARCH_SSE2)
+  const __m128i v1 = _mm_set1_epi16(static_cast<short>(c1));
+  const __m128i v2 = _mm_set1_epi16(static_cast<short>(c2));
+  const __m128i v3 = _mm_set1_epi16(static_cast<short>(c3));
+  const __m128i v4 = _mm_set1_epi16(static_cast<short>(c4));
+  while( (last - first) >= 8 ){
+    const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+    const __m128i match = _mm_or_si128(
+      _mm_or_si128( _mm_cmpeq_epi16(block, v1), _mm_cmpeq_epi16(block, v2) ),
+      _mm_or_si128( _mm_cmpeq_epi16(block, v3), _mm_cmpeq_epi16(block, v4) )
+    );
+    const uint mask = static_cast<uint>(_mm_movemask_epi8(match));
+    if(mask != 0){
+      return first + (qCountTrailingZeroBits(mask) / 2);
+    }
+    first += 8;
+  }
+#endif
+  // Scalar search (also handles the remaining tail of the SIMD versions)
+  for( ; first != last; ++first){
+    const ushort c = first->unicode();
+    if( (c == c1) || (c == c2) || (c == c3) || (c == c4) ){
+      return first;
+    }
+  }
+
+  return last;
+}
+
+const char *findFirstOfInstructionSet()
+{
+#if defined(MDT_PLAIN_TEXT_CHAR_SEARCH_AVX2)
+  return "AVX2";
+#elif defined(MDT_PLAIN_TEXT_CHAR_SEARCH_SSE2)
+  return "SSE2";
+#else
+  return "Scalar";
+#endif
+}
+
+}}} // namespace Mdt{ namespace PlainText{ namespace Impl{
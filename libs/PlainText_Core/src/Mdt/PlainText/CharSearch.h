@@ -0,0 +1,73 @@
+/****************************************************************************
+ **
+ ** Copyright (C) 2011-2017 Philippe Steinmann.
+ **
+ ** This file is part of multiDiagTools library.
+ **
+ ** multiDiagTools is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Lesser General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** multiDiagTools is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public License
+ ** along with multiDiagTools.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+#ifndef MDT_PLAIN_TEXT_CHAR_SEARCH_H
+#define MDT_PLAIN_TEXT_CHAR_SEARCH_H
+
+#include <QChar>
+#include <QtGlobal>
+
+namespace Mdt{ namespace PlainText{ namespace Impl{
+
+  /*! \internal Get the code of a char in a UTF-16 buffer
+   */
+  inline
+  ushort charCode(QChar c)
+  {
+    return c.unicode();
+  }
+
+  /*! \internal Get the code of a char in a byte buffer
+   */
+  inline
+  ushort charCode(uchar c)
+  {
+    return c;
+  }
+
+  /*! \internal Find the first byte in [\a first, \a last) that is equal to \a c1, \a c2, \a c3 or \a c4
+   *
+   * Returns \a last if no such byte was found.
+   *
+   * Depending on what the compiler is allowed to generate,
+   *  the search is done by blocks of 32 bytes (AVX2),
+   *  by blocks of 16 bytes (SSE2), or byte by byte.
+   */
+  const uchar *findFirstOf(const uchar *first, const uchar *last, uchar c1, uchar c2, uchar c3, uchar c4);
+
+  /*! \internal Find the first char in [\a first, \a last) that is equal to \a c1, \a c2, \a c3 or \a c4
+   *
+   * Returns \a last if no such char was found.
+   *
+   * Depending on what the compiler is allowed to generate,
+   *  the search is done by blocks of 16 chars (AVX2),
+   *  by blocks of 8 chars (SSE2), or char by char.
+   */
+  const QChar *findFirstOf(const QChar *first, const QChar *last, ushort c1, ushort c2, ushort c3, ushort c4);
+
+  /*! \internal Get the name of the instruction set used by findFirstOf()
+   *
+   * Returns "AVX2", "SSE2" or "Scalar".
+   */
+  const char *findFirstOfInstructionSet();
+
+}}} // namespace Mdt{ namespace PlainText{ namespace Impl{
+
+#endif // #ifndef MDT_PLAIN_TEXT_CHAR_SEARCH_H
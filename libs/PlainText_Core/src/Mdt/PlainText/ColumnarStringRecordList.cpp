@@ -0,0 +1,92 @@
+/****************************************************************************
+ **
+ ** Copyright (C) 2011-2017 Philippe Steinmann.
+ **
+ ** This file is part of multiDiagTools library.
+ **
+ ** multiDiagTools is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Lesser General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** multiDiagTools is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public License
+ ** along with multiDiagTools.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+#include "ColumnarStringRecordList.h"
+
+namespace Mdt{ namespace PlainText{
+
+ColumnarStringRecordList::ColumnarStringRecordList(const StringRecordList & recordList)
+{
+  appendRecordList(recordList);
+}
+
+void ColumnarStringRecordList::appendRecord(const StringRecord & record)
+{
+  const int row = rowCount();
+  const int recordColumnCount = record.columnCount();
+  // Add missing columns, that are empty for all existing rows
+  while(mColumnList.count() < recordColumnCount){
+    Column column;
+    column.offsets.fill(0, row+1);
+    mColumnList.append(column);
+  }
+  Q_ASSERT(mColumnList.count() >= recordColumnCount);
+  for(int col = 0; col < mColumnList.count(); ++col){
+    auto & column = mColumnList[col];
+    Q_ASSERT(column.offsets.count() == row+1);
+    if(col < recordColumnCount){
+      const QString text = record.data(col);
+      Q_ASSERT(text.size() <= maximumColumnTextSize() - column.text.size());
+      column.text.append(text);
+    }
+    column.offsets.append(column.text.size());
+  }
+  mColumnCountList.append(recordColumnCount);
+}
+
+void ColumnarStringRecordList::appendRecordList(const StringRecordList & recordList)
+{
+  reserve(rowCount() + recordList.rowCount());
+  for(const auto & record : recordList){
+    appendRecord(record);
+  }
+}
+
+StringRecord ColumnarStringRecordList::record(int row) const
+{
+  Q_ASSERT(row >= 0);
+  Q_ASSERT(row < rowCount());
+
+  StringRecord record;
+  const int n = columnCount(row);
+  for(int col = 0; col < n; ++col){
+    record.appendColumn(data(row, col).toString());
+  }
+
+  return record;
+}
+
+void ColumnarStringRecordList::reserve(int rowCount)
+{
+  Q_ASSERT(rowCount >= 0);
+
+  mColumnCountList.reserve(rowCount);
+  for(auto & column : mColumnList){
+    column.offsets.reserve(rowCount+1);
+  }
+}
+
+void ColumnarStringRecordList::clear()
+{
+  mColumnCountList.clear();
+  mColumnList.clear();
+}
+
+}} // namespace Mdt{ namespace PlainText{
@@ -0,0 +1,210 @@
+/****************************************************************************
+ **
+ ** Copyright (C) 2011-2017 Philippe Steinmann.
+ **
+ ** This file is part of multiDiagTools library.
+ **
+ ** multiDiagTools is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Lesser General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** multiDiagTools is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public License
+ ** along with multiDiagTools.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+#ifndef MDT_PLAIN_TEXT_COLUMNAR_STRING_RECORD_LIST_H
+#define MDT_PLAIN_TEXT_COLUMNAR_STRING_RECORD_LIST_H
+
+#include "StringRecord.h"
+#include "StringRecordList.h"
+#include <QString>
+#include <QArrayData>
+#include <QStringRef>
+#include <QVector>
+#include <QMetaType>
+#include <limits>
+
+namespace Mdt{ namespace PlainText{
+
+  /*! \brief List of string records stored column by column
+   *
+   * StringRecordList stores each field in its own QString.
+   *  ColumnarStringRecordList stores the text of all fields
+   *  of a column in a single contiguous UTF-16 buffer (the arena),
+   *  and the position of each field in a array of offsets.
+   *
+   * This avoids a heap allocation per field,
+   *  and gives a good locality when scanning a column.
+   *
+   * The read API is similar to RecordListTemplate,
+   *  but data() returns a reference to the text in the arena
+   *  instead of a copy:
+   * \code
+   * ColumnarStringRecordList list;
+   * list.appendRecord({"A","B"});
+   * const QStringRef b = list.data(0, 1);
+   * \endcode
+   *
+   * \note A QStringRef returned by data() is valid
+   *       until this list is modified or destroyed.
+   *
+   * \note Offsets are stored as int, like QString and QStringRef positions.
+   *       The total text of a single column is limited
+   *       to maximumColumnTextSize() chars, which is the capacity of a QString.
+   *       Appending a record that exceeds this limit is a precondition violation.
+   */
+  class ColumnarStringRecordList
+  {
+   public:
+
+    /*! \brief Construct a empty record list
+     */
+    ColumnarStringRecordList() = default;
+
+    /*! \brief Construct a record list with the content of \a recordList
+     */
+    explicit ColumnarStringRecordList(const StringRecordList & recordList);
+
+    /*! \brief Copy construct a record list from \a other
+     */
+    ColumnarStringRecordList(const ColumnarStringRecordList & other) = default;
+
+    /*! \brief Copy assign \a other to this record list
+     */
+    ColumnarStringRecordList & operator=(const ColumnarStringRecordList & other) = default;
+
+    /*! \brief Move construct a record list from \a other
+     */
+    ColumnarStringRecordList(ColumnarStringRecordList && other) = default;
+
+    /*! \brief Move assign \a other to this record list
+     */
+    ColumnarStringRecordList & operator=(ColumnarStringRecordList && other) = default;
+
+    /*! \brief Get the maximum size of the text of a column
+     *
+     * This is the sum of the sizes of all fields of a column.
+     *
+     * The text of a column is stored in a single QString,
+     *  so this is the capacity of a QString:
+     *  its allocation, including the header and the terminating null,
+     *  is limited to INT_MAX bytes, which gives about 2^30 chars.
+     */
+    static constexpr int maximumColumnTextSize() noexcept
+    {
+      return (std::numeric_limits<int>::max() - static_cast<int>(sizeof(QArrayData))) / static_cast<int>(sizeof(QChar)) - 1;
+    }
+
+    /*! \brief Append a record
+     *
+     * \pre For each column, the size of the text of the column,
+     *       after appending \a record , must not exceed maximumColumnTextSize()
+     */
+    void appendRecord(const StringRecord & record);
+
+    /*! \brief Append all records of \a recordList
+     *
+     * \pre Same as appendRecord() applies for each record of \a recordList
+     */
+    void appendRecordList(const StringRecordList & recordList);
+
+    /*! \brief Check if this record list is empty
+     */
+    bool isEmpty() const
+    {
+      return mColumnCountList.isEmpty();
+    }
+
+    /*! \brief Get row count
+     */
+    int rowCount() const
+    {
+      return mColumnCountList.count();
+    }
+
+    /*! \brief Get column count for given row
+     *
+     * \pre \a row must be in valid range ( 0 <= row < rowCount() )
+     */
+    int columnCount(int row) const
+    {
+      Q_ASSERT(row >= 0);
+      Q_ASSERT(row < rowCount());
+      return mColumnCountList.at(row);
+    }
+
+    /*! \brief Get the greatest column count of all rows
+     */
+    int maximumColumnCount() const
+    {
+      return mColumnList.count();
+    }
+
+    /*! \brief Get data for given row and column
+     *
+     * \pre \a row must be in valid range ( 0 <= row < rowCount() )
+     * \pre \a column must be in valid range ( 0 <= column < columnCount(row) )
+     */
+    QStringRef data(int row, int column) const
+    {
+      Q_ASSERT(row >= 0);
+      Q_ASSERT(row < rowCount());
+      Q_ASSERT(column >= 0);
+      Q_ASSERT(column < columnCount(row));
+      const auto & col = mColumnList.at(column);
+      const int position = col.offsets.at(row);
+      return QStringRef(&col.text, position, col.offsets.at(row+1) - position);
+    }
+
+    /*! \brief Get value for given row and column
+     *
+     * If \a row or \a column is out of range,
+     *  a null QStringRef is returned
+     */
+    QStringRef value(int row, int column) const
+    {
+      if( (row < 0) || (row >= rowCount()) || (column < 0) || (column >= columnCount(row)) ){
+        return QStringRef();
+      }
+      return data(row, column);
+    }
+
+    /*! \brief Get the record at \a row
+     *
+     * This function copies the data of each field.
+     *
+     * \pre \a row must be in valid range ( 0 <= row < rowCount() )
+     */
+    StringRecord record(int row) const;
+
+    /*! \brief Attempt to allocate memory for at least \a rowCount rows
+     */
+    void reserve(int rowCount);
+
+    /*! \brief Clear
+     */
+    void clear();
+
+   private:
+
+    struct Column
+    {
+      QString text;
+      // offsets[row] is the start of row, offsets[row+1] its end. Size is rowCount()+1
+      QVector<int> offsets;
+    };
+
+    QVector<int> mColumnCountList;
+    QVector<Column> mColumnList;
+  };
+
+}} // namespace Mdt{ namespace PlainText{
+Q_DECLARE_METATYPE(Mdt::PlainText::ColumnarStringRecordList)
+
+#endif // #ifndef MDT_PLAIN_TEXT_COLUMNAR_STRING_RECORD_LIST_H
@@ -0,0 +1,613 @@
+/****************************************************************************
+ **
+ ** Copyright (C) 2011-2017 Philippe Steinmann.
+ **
+ ** This file is part of multiDiagTools library.
+ **
+ ** multiDiagTools is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Lesser General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** multiDiagTools is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public License
+ ** along with multiDiagTools.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+#include "CsvFileGenerator.h"
+#include "CharSearch.h"
+#include <QAbstractItemModel>
+#include <QModelIndex>
+#include <QVariant>
+#include <QTextCodec>
+#include <QDir>
+#include <QCoreApplication>
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+#define tr(sourceText) QCoreApplication::translate("CsvFileGenerator", sourceText)
+
+namespace Mdt{ namespace PlainText{
+
+namespace Impl{
+
+  /*! \internal Writes buffers to a file in a dedicated thread
+   *
+   * Only one buffer can be pending at a time:
+   *  submit() waits until the previous buffer has been written.
+   */
+  class CsvBackgroundFileWriter
+  {
+   public:
+
+    /*! \internal Start the writer thread
+     *
+     * \a file must stay open until this writer is destroyed.
+     */
+    explicit CsvBackgroundFileWriter(QFile & file)
+     : mFile(file),
+       mThread(&CsvBackgroundFileWriter::run, this)
+    {
+    }
+
+    /*! \internal Wait until pending buffer is written and stop the writer thread
+     */
+    ~CsvBackgroundFileWriter()
+    {
+      {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStop = true;
+      }
+      mCondition.notify_all();
+      mThread.join();
+    }
+
+    CsvBackgroundFileWriter(const CsvBackgroundFileWriter &) = delete;
+    CsvBackgroundFileWriter & operator=(const CsvBackgroundFileWriter &) = delete;
+    CsvBackgroundFileWriter(CsvBackgroundFileWriter &&) = delete;
+    CsvBackgroundFileWriter & operator=(CsvBackgroundFileWriter &&) = delete;
+
+    /*! \internal Submit the \a size first bytes of \a buffer to be written
+     *
+     * \a buffer is swapped with the buffer that was previously written,
+     *  so that it can be reused by the caller.
+     *
+     * Returns false if writing a previous buffer failed.
+     */
+    bool submit(QByteArray & buffer, int size)
+    {
+      std::unique_lock<std::mutex> lock(mMutex);
+      mCondition.wait(lock, [this]{ return !mPending; });
+      if(mFailed){
+        return false;
+      }
+      mPendingBuffer.swap(buffer);
+      mPendingSize = size;
+      mPending = true;
+      lock.unlock();
+      mCondition.notify_all();
+
+      return true;
+    }
+
+    /*! \internal Wait until the pending buffer has been written
+     *
+     * Returns false if writing a buffer failed.
+     */
+    bool waitForDone()
+    {
+      std::unique_lock<std::mutex> lock(mMutex);
+      mCondition.wait(lock, [this]{ return !mPending; });
+
+      return !mFailed;
+    }
+
+   private:
+
+    void run()
+    {
+      std::unique_lock<std::mutex> lock(mMutex);
+      while(true){
+        mCondition.wait(lock, [this]{ return mPending || mStop; });
+        if(!mPending){
+          return;
+        }
+        const int size = mPendingSize;
+        lock.unlock();
+        const bool ok = (mFile.write(mPendingBuffer.constData(), size) == size);
+        lock.lock();
+        if(!ok){
+          mFailed = true;
+        }
+        mPending = false;
+        mCondition.notify_all();
+      }
+    }
+
+    QFile & mFile;
+    QByteArray mPendingBuffer;
+    int mPendingSize = 0;
+    bool mPending = false;
+    bool mFailed = false;
+    bool mStop = false;
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    std::thread mThread;
+  };
+
+  /*! \internal Get the header that \a codec generates at the beginning of a text
+   *
+   * For example, the byte order mark for UTF-16.
+   *  Returns a empty array if \a codec does not generate any header.
+   */
+  QByteArray encodedHeader(const QTextCodec & codec)
+  {
+    const QString text = QStringLiteral("\n");
+    const QByteArray withHeader = codec.fromUnicode(text);
+    QTextCodec::ConverterState state(QTextCodec::IgnoreHeader);
+    const QByteArray withoutHeader = codec.fromUnicode(text.constData(), text.size(), &state);
+    if(!withHeader.endsWith(withoutHeader)){
+      return QByteArray();
+    }
+
+    return withHeader.left(withHeader.size() - withoutHeader.size());
+  }
+
+} // namespace Impl{
+
+CsvFileGenerator::CsvFileGenerator()
+{
+}
+
+CsvFileGenerator::~CsvFileGenerator()
+{
+  closeFile();
+}
+
+void CsvFileGenerator::setCsvSettings(const CsvGeneratorSettings & settings)
+{
+  Q_ASSERT(settings.isValid());
+  Q_ASSERT(!mFile.isOpen());
+
+  mCsvSettings = settings;
+}
+
+void CsvFileGenerator::setBufferSize(int size)
+{
+  Q_ASSERT(size >= 64);
+  Q_ASSERT(!mFile.isOpen());
+
+  mBufferSize = size;
+}
+
+void CsvFileGenerator::setBackgroundFlushEnabled(bool enable)
+{
+  Q_ASSERT(!mFile.isOpen());
+
+  mBackgroundFlushEnabled = enable;
+}
+
+bool CsvFileGenerator::openFile(const QFileInfo & fileInfo, const QByteArray & encoding)
+{
+  // Close possibly previously open file
+  if(mFile.isOpen()){
+    closeFile();
+  }
+  // Get codec
+  auto *codec = QTextCodec::codecForName(encoding);
+  if(codec == nullptr){
+    const auto msg = tr("Could not find a codec for encoding '%1'").arg(QString::fromLatin1(encoding));
+    mLastError = mdtErrorNew(msg, Mdt::Error::Critical, "CsvFileGenerator");
+    mLastError.commit();
+    return false;
+  }
+  switch(codec->mibEnum()){
+    case 106:
+      mEncoding = Utf8Encoding;
+      break;
+    case 4:
+      mEncoding = Latin1Encoding;
+      break;
+    default:
+      mEncoding = CodecEncoding;
+      // The header (f.ex. byte order mark) is written once, after the file is open
+      mEncoder.reset(codec->makeEncoder(QTextCodec::IgnoreHeader));
+      encodeSyntaxChars(*codec);
+  }
+  // Open file. We have our own buffer, QFile must not buffer again
+  mFile.setFileName(fileInfo.absoluteFilePath());
+  if(!mFile.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Unbuffered)){
+    const auto msg = tr("Could not open file '%1'\nDirectory: '%2'").arg(fileInfo.fileName(), fileInfo.dir().absolutePath());
+    mLastError = mdtErrorNew(msg, Mdt::Error::Critical, "CsvFileGenerator");
+    mLastError.stackError(mdtErrorFromQFile(mFile, "CsvFileGenerator"));
+    mLastError.commit();
+    mEncoder.reset();
+    return false;
+  }
+  mBuffer.resize(mBufferSize);
+  mBufferPosition = 0;
+  if(mEncoding == CodecEncoding){
+    const QByteArray header = Impl::encodedHeader(*codec);
+    appendBytes(header.constData(), header.size());
+  }
+  if(mBackgroundFlushEnabled){
+    mBackgroundWriter = std::make_unique<Impl::CsvBackgroundFileWriter>(mFile);
+  }
+
+  return true;
+}
+
+bool CsvFileGenerator::isOpen() const
+{
+  return mFile.isOpen();
+}
+
+bool CsvFileGenerator::flush()
+{
+  Q_ASSERT(mFile.isOpen());
+
+  if(!writeBuffer()){
+    return false;
+  }
+  if(mBackgroundWriter && !mBackgroundWriter->waitForDone()){
+    setWriteError();
+    return false;
+  }
+
+  return true;
+}
+
+bool CsvFileGenerator::closeFile()
+{
+  if(!mFile.isOpen()){
+    return true;
+  }
+  const bool ok = flush();
+  mBackgroundWriter.reset();
+  mFile.close();
+  mEncoder.reset();
+  mBuffer.clear();
+  mBufferPosition = 0;
+
+  return ok;
+}
+
+bool CsvFileGenerator::writeLine(const StringRecord & record)
+{
+  Q_ASSERT(mFile.isOpen());
+
+  for(int col = 0; col < record.columnCount(); ++col){
+    if(!beginField(col)){
+      return false;
+    }
+    if(!appendField(record.data(col))){
+      return false;
+    }
+  }
+
+  return appendEndOfLine();
+}
+
+bool CsvFileGenerator::writeLine(const Record & record)
+{
+  Q_ASSERT(mFile.isOpen());
+
+  for(int col = 0; col < record.columnCount(); ++col){
+    if(!beginField(col)){
+      return false;
+    }
+    if(!appendField(record.data(col).toString())){
+      return false;
+    }
+  }
+
+  return appendEndOfLine();
+}
+
+bool CsvFileGenerator::writeAll(const StringRecordList & recordList)
+{
+  Q_ASSERT(mFile.isOpen());
+
+  for(const auto & record : recordList){
+    if(!writeLine(record)){
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool CsvFileGenerator::writeAll(const RecordList & recordList)
+{
+  Q_ASSERT(mFile.isOpen());
+
+  for(const auto & record : recordList){
+    if(!writeLine(record)){
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool CsvFileGenerator::writeAll(const QAbstractItemModel & model, int role)
+{
+  Q_ASSERT(mFile.isOpen());
+
+  const int rowCount = model.rowCount();
+  const int columnCount = model.columnCount();
+  for(int row = 0; row < rowCount; ++row){
+    for(int col = 0; col < columnCount; ++col){
+      if(!beginField(col)){
+        return false;
+      }
+      if(!appendField(model.data(model.index(row, col), role).toString())){
+        return false;
+      }
+    }
+    if(!appendEndOfLine()){
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool CsvFileGenerator::beginField(int column)
+{
+  if(column == 0){
+    return true;
+  }
+  return appendAscii(mCsvSettings.fieldSeparator(), mEncodedFieldSeparator);
+}
+
+bool CsvFileGenerator::appendField(const QString & field)
+{
+  const QChar *first = field.constData();
+  const QChar *last = first + field.size();
+  const ushort fieldSeparator = static_cast<uchar>(mCsvSettings.fieldSeparator());
+  const ushort fieldProtection = static_cast<uchar>(mCsvSettings.fieldProtection());
+
+  // A leading ~ would be taken as Excel protection marker (EXP, CSV-1203 §10) by the parser
+  const bool beginsWithExp = (first != last) && (first->unicode() == '~');
+
+  bool protect = (mCsvSettings.fieldProtectionMode() == CsvGeneratorSettings::ProtectAllFields) || beginsWithExp;
+  if(!protect){
+    protect = (Impl::findFirstOf(first, last, fieldSeparator, fieldProtection, '\r', '\n') != last);
+  }
+  if(!protect){
+    protect = (Impl::findFirstOf(first, last, '\t', '\t', '\t', '\t') != last);
+  }
+  if(!protect){
+    return appendText(first, last);
+  }
+  // Protected field: each field protection inside the payload is doubled (CSV-1203, rule 9.3)
+  if(!appendAscii(mCsvSettings.fieldProtection(), mEncodedFieldProtection)){
+    return false;
+  }
+  // Emit a EXP, so that the parser only consumes it and keeps the ~ of the payload
+  if(beginsWithExp){
+    const QChar exp = QLatin1Char('~');
+    if(!appendText(&exp, &exp + 1)){
+      return false;
+    }
+  }
+  while(first != last){
+    const QChar *it = Impl::findFirstOf(first, last, fieldProtection, fieldProtection, fieldProtection, fieldProtection);
+    if(it == last){
+      if(!appendText(first, last)){
+        return false;
+      }
+      break;
+    }
+    ++it;
+    if(!appendText(first, it)){
+      return false;
+    }
+    if(!appendAscii(mCsvSettings.fieldProtection(), mEncodedFieldProtection)){
+      return false;
+    }
+    first = it;
+  }
+
+  return appendAscii(mCsvSettings.fieldProtection(), mEncodedFieldProtection);
+}
+
+bool CsvFileGenerator::appendEndOfLine()
+{
+  if(mEncoding == CodecEncoding){
+    return appendBytes(mEncodedEndOfLine.constData(), mEncodedEndOfLine.size());
+  }
+  if(mCsvSettings.endOfLine() == CsvGeneratorSettings::CrLfEndOfLine){
+    if(!appendByte('\r')){
+      return false;
+    }
+  }
+  return appendByte('\n');
+}
+
+bool CsvFileGenerator::appendAscii(char c, const QByteArray & encoded)
+{
+  if(mEncoding == CodecEncoding){
+    return appendBytes(encoded.constData(), encoded.size());
+  }
+  return appendByte(c);
+}
+
+bool CsvFileGenerator::appendByte(char c)
+{
+  Q_ASSERT(mEncoding != CodecEncoding);
+
+  if(mBufferPosition == mBuffer.size()){
+    if(!writeBuffer()){
+      return false;
+    }
+  }
+  mBuffer.data()[mBufferPosition] = c;
+  ++mBufferPosition;
+
+  return true;
+}
+
+bool CsvFileGenerator::appendText(const QChar *first, const QChar *last)
+{
+  if(mEncoding == CodecEncoding){
+    Q_ASSERT(mEncoder);
+    const QByteArray data = mEncoder->fromUnicode(first, static_cast<int>(last - first));
+    return appendBytes(data.constData(), data.size());
+  }
+  /*
+   * Encode by chunks that fit in the free space of the buffer.
+   * In UTF-8, a UTF-16 char is encoded to at most 3 bytes,
+   * and a surrogate pair (2 UTF-16 chars) to 4 bytes.
+   */
+  constexpr int maxBytesPerChar = 3;
+  while(first != last){
+    const int available = (mBuffer.size() - mBufferPosition) / maxBytesPerChar;
+    if(available < 2){
+      if(!writeBuffer()){
+        return false;
+      }
+      continue;
+    }
+    const QChar *chunkLast = first + std::min<qptrdiff>(available, last - first);
+    // Do not split a surrogate pair
+    if( (chunkLast != last) && chunkLast[-1].isHighSurrogate() ){
+      --chunkLast;
+    }
+    if(mEncoding == Utf8Encoding){
+      encodeUtf8(first, chunkLast);
+    }else{
+      encodeLatin1(first, chunkLast);
+    }
+    first = chunkLast;
+  }
+
+  return true;
+}
+
+bool CsvFileGenerator::appendBytes(const char *data, int size)
+{
+  while(size > 0){
+    if(mBufferPosition == mBuffer.size()){
+      if(!writeBuffer()){
+        return false;
+      }
+    }
+    const int n = std::min(size, mBuffer.size() - mBufferPosition);
+    std::memcpy(mBuffer.data() + mBufferPosition, data, static_cast<size_t>(n));
+    mBufferPosition += n;
+    data += n;
+    size -= n;
+  }
+
+  return true;
+}
+
+void CsvFileGenerator::encodeUtf8(const QChar *first, const QChar *last)
+{
+  uchar *out = reinterpret_cast<uchar*>(mBuffer.data() + mBufferPosition);
+
+  for(auto it = first; it != last; ++it){
+    uint code = it->unicode();
+    if(code < 0x80){
+      *out++ = static_cast<uchar>(code);
+    }else if(code < 0x800){
+      *out++ = static_cast<uchar>(0xC0 | (code >> 6));
+      *out++ = static_cast<uchar>(0x80 | (code & 0x3F));
+    }else{
+      if(QChar::isSurrogate(code)){
+        if( QChar::isHighSurrogate(code) && ((it+1) != last) && (it+1)->isLowSurrogate() ){
+          ++it;
+          code = QChar::surrogateToUcs4(static_cast<ushort>(code), it->unicode());
+          *out++ = static_cast<uchar>(0xF0 | (code >> 18));
+          *out++ = static_cast<uchar>(0x80 | ((code >> 12) & 0x3F));
+          *out++ = static_cast<uchar>(0x80 | ((code >> 6) & 0x3F));
+          *out++ = static_cast<uchar>(0x80 | (code & 0x3F));
+          continue;
+        }
+        // Lone surrogate
+        code = QChar::ReplacementCharacter;
+      }
+      *out++ = static_cast<uchar>(0xE0 | (code >> 12));
+      *out++ = static_cast<uchar>(0x80 | ((code >> 6) & 0x3F));
+      *out++ = static_cast<uchar>(0x80 | (code & 0x3F));
+    }
+  }
+
+  mBufferPosition = static_cast<int>(reinterpret_cast<char*>(out) - mBuffer.data());
+}
+
+void CsvFileGenerator::encodeLatin1(const QChar *first, const QChar *last)
+{
+  char *out = mBuffer.data() + mBufferPosition;
+
+  for(auto it = first; it != last; ++it){
+    const ushort code = it->unicode();
+    *out++ = (code < 0x100) ? static_cast<char>(code) : '?';
+  }
+
+  mBufferPosition += static_cast<int>(last - first);
+}
+
+bool CsvFileGenerator::writeBuffer()
+{
+  if(mBufferPosition == 0){
+    return true;
+  }
+  const int size = mBufferPosition;
+  mBufferPosition = 0;
+  if(mBackgroundWriter){
+    if(!mBackgroundWriter->submit(mBuffer, size)){
+      setWriteError();
+      return false;
+    }
+    // The buffer returned by the writer is empty the first time
+    if(mBuffer.size() != mBufferSize){
+      mBuffer.resize(mBufferSize);
+    }
+    return true;
+  }
+  if(mFile.write(mBuffer.constData(), size) != size){
+    setWriteError();
+    return false;
+  }
+
+  return true;
+}
+
+void CsvFileGenerator::setWriteError()
+{
+  const QFileInfo fileInfo(mFile);
+  const auto msg = tr("Could not write to file '%1'\nDirectory: '%2'").arg(fileInfo.fileName(), fileInfo.dir().absolutePath());
+  mLastError = mdtErrorNew(msg, Mdt::Error::Critical, "CsvFileGenerator");
+  mLastError.stackError(mdtErrorFromQFile(mFile, "CsvFileGenerator"));
+  mLastError.commit();
+}
+
+void CsvFileGenerator::encodeSyntaxChars(const QTextCodec & codec)
+{
+  // Use a converter state per string, so that no header is generated
+  const auto encode = [&codec](const QString & text){
+    QTextCodec::ConverterState state(QTextCodec::IgnoreHeader);
+    return codec.fromUnicode(text.constData(), text.size(), &state);
+  };
+  QString endOfLine;
+  if(mCsvSettings.endOfLine() == CsvGeneratorSettings::CrLfEndOfLine){
+    endOfLine = QStringLiteral("\r\n");
+  }else{
+    endOfLine = QStringLiteral("\n");
+  }
+  mEncodedFieldSeparator = encode( QString(QLatin1Char(mCsvSettings.fieldSeparator())) );
+  mEncodedFieldProtection = encode( QString(QLatin1Char(mCsvSettings.fieldProtection())) );
+  mEncodedEndOfLine = encode(endOfLine);
+}
+
+}} // namespace Mdt{ namespace PlainText{
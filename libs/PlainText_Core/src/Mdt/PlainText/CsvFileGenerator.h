@@ -0,0 +1,255 @@
+/****************************************************************************
+ **
+ ** Copyright (C) 2011-2017 Philippe Steinmann.
+ **
+ ** This file is part of multiDiagTools library.
+ **
+ ** multiDiagTools is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Lesser General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** multiDiagTools is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public License
+ ** along with multiDiagTools.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+#ifndef MDT_PLAIN_TEXT_CSV_FILE_GENERATOR_H
+#define MDT_PLAIN_TEXT_CSV_FILE_GENERATOR_H
+
+#include "CsvGeneratorSettings.h"
+#include "StringRecord.h"
+#include "StringRecordList.h"
+#include "Record.h"
+#include "RecordList.h"
+#include "Mdt/Error.h"
+#include <QString>
+#include <QByteArray>
+#include <QFileInfo>
+#include <QFile>
+#include <QChar>
+#include <Qt>
+#include <memory>
+
+class QAbstractItemModel;
+class QTextEncoder;
+class QTextCodec;
+
+namespace Mdt{ namespace PlainText{
+
+  namespace Impl{
+    class CsvBackgroundFileWriter;
+  }
+
+  /*! \brief CSV generator that writes to a file
+   *
+   * Records are encoded into a output buffer,
+   *  that is written to the file each time it is full.
+   *  The buffer is allocated once, when the file is open,
+   *  and then reused.
+   *  For UTF-8 and Latin-1 (ISO-8859-1) encodings,
+   *  fields are encoded directly into the buffer,
+   *  so writing a record does not allocate memory.
+   *  Other encodings supported by QTextCodec go through a QTextEncoder.
+   *
+   * Typical usage:
+   * \code
+   * CsvFileGenerator generator;
+   * generator.setCsvSettings(settings);
+   * if(!generator.openFile(fileInfo, "UTF-8")){
+   *   // Error handling
+   * }
+   * if(!generator.writeAll(recordList)){
+   *   // Error handling
+   * }
+   * if(!generator.closeFile()){
+   *   // Error handling
+   * }
+   * \endcode
+   *
+   * If background flush is enabled,
+   *  a full buffer is written to the file by a dedicated thread,
+   *  while the next records are encoded into a second buffer.
+   *
+   * \note Some part of this API documentation refers to following standards:
+   *       \li CSV-1203 available here: http://mastpoint.com/csv-1203
+   *       \li RFC 4180 available here: https://tools.ietf.org/html/rfc4180
+   */
+  class CsvFileGenerator
+  {
+   public:
+
+    /*! \brief Default constructor
+     */
+    CsvFileGenerator();
+
+    /*! \brief Destructor
+     *
+     * If a file is open, it is closed.
+     */
+    ~CsvFileGenerator();
+
+    // Copy disabled
+    CsvFileGenerator(const CsvFileGenerator &) = delete;
+    CsvFileGenerator & operator=(const CsvFileGenerator &) = delete;
+    // Move disabled
+    CsvFileGenerator(CsvFileGenerator &&) = delete;
+    CsvFileGenerator & operator=(CsvFileGenerator &&) = delete;
+
+    /*! \brief Set CSV settings
+     *
+     * \pre \a settings must be valid
+     * \pre No file must currently be open
+     */
+    void setCsvSettings(const CsvGeneratorSettings & settings);
+
+    /*! \brief Set the size of the output buffer
+     *
+     * The default is 1 MiB.
+     *
+     * \pre \a size must be >= 64
+     * \pre No file must currently be open
+     */
+    void setBufferSize(int size);
+
+    /*! \brief Get the size of the output buffer
+     */
+    int bufferSize() const
+    {
+      return mBufferSize;
+    }
+
+    /*! \brief Enable or disable background flush
+     *
+     * Background flush is disabled by default.
+     *
+     * \pre No file must currently be open
+     */
+    void setBackgroundFlushEnabled(bool enable);
+
+    /*! \brief Check if background flush is enabled
+     */
+    bool isBackgroundFlushEnabled() const
+    {
+      return mBackgroundFlushEnabled;
+    }
+
+    /*! \brief Open CSV file
+     *
+     * If the file allready exists, it is truncated.
+     *
+     * \param fileInfo Path to CSV file that must be open
+     * \param encoding Encoding name of the CSV file format.
+     *               Will use QTextCodec::codecForName() to get apropriate codec.
+     * \return false if CSV file could not be open, or no codec could be found for given encoding,
+     *         true if all goes well.
+     */
+    bool openFile(const QFileInfo & fileInfo, const QByteArray & encoding);
+
+    /*! \brief Check if a CSV file is open
+     */
+    bool isOpen() const;
+
+    /*! \brief Write buffered data to the file
+     *
+     * Returns false if writing to the file failed.
+     */
+    bool flush();
+
+    /*! \brief Flush and close CSV file
+     *
+     * Returns false if writing the remaining data to the file failed.
+     *  The file is closed in all cases.
+     */
+    bool closeFile();
+
+    /*! \brief Write a record
+     *
+     * \pre A file must be open
+     */
+    bool writeLine(const StringRecord & record);
+
+    /*! \brief Write a record
+     *
+     * Each field is converted using QVariant::toString().
+     *
+     * \pre A file must be open
+     */
+    bool writeLine(const Record & record);
+
+    /*! \brief Write all records of \a recordList
+     *
+     * \pre A file must be open
+     */
+    bool writeAll(const StringRecordList & recordList);
+
+    /*! \brief Write all records of \a recordList
+     *
+     * \pre A file must be open
+     */
+    bool writeAll(const RecordList & recordList);
+
+    /*! \brief Write all rows of \a model
+     *
+     * Each row of \a model is written as a record.
+     *  Each field is converted from data returned by \a model for \a role
+     *  using QVariant::toString().
+     *
+     * \note The header of \a model is not written.
+     *       It can be written with writeLine() before calling this function.
+     * \pre A file must be open
+     */
+    bool writeAll(const QAbstractItemModel & model, int role = Qt::DisplayRole);
+
+    /*! \brief Get last error
+     */
+    Mdt::Error lastError() const
+    {
+      return mLastError;
+    }
+
+   private:
+
+    enum Encoding
+    {
+      Utf8Encoding,
+      Latin1Encoding,
+      CodecEncoding
+    };
+
+    bool beginField(int column);
+    bool appendField(const QString & field);
+    bool appendEndOfLine();
+    bool appendAscii(char c, const QByteArray & encoded);
+    bool appendByte(char c);
+    bool appendText(const QChar *first, const QChar *last);
+    bool appendBytes(const char *data, int size);
+    void encodeUtf8(const QChar *first, const QChar *last);
+    void encodeLatin1(const QChar *first, const QChar *last);
+    bool writeBuffer();
+    void setWriteError();
+    void encodeSyntaxChars(const QTextCodec & codec);
+
+    CsvGeneratorSettings mCsvSettings;
+    int mBufferSize = 1024*1024;
+    bool mBackgroundFlushEnabled = false;
+    Encoding mEncoding = Utf8Encoding;
+    QFile mFile;
+    QByteArray mBuffer;
+    int mBufferPosition = 0;
+    std::unique_ptr<QTextEncoder> mEncoder;
+    // Field separator, field protection and end of line, encoded once for CodecEncoding
+    QByteArray mEncodedFieldSeparator;
+    QByteArray mEncodedFieldProtection;
+    QByteArray mEncodedEndOfLine;
+    std::unique_ptr<Impl::CsvBackgroundFileWriter> mBackgroundWriter;
+    Mdt::Error mLastError;
+  };
+
+}} // namespace Mdt{ namespace PlainText{
+
+#endif // #ifndef MDT_PLAIN_TEXT_CSV_FILE_GENERATOR_H
@@ -20,20 +20,28 @@
  ****************************************************************************/
 #include "CsvFileParser.h"
 #include "CsvParserTemplate.h"
+#include "CsvScannerTemplate.h"
+#include "CsvParallelParserTemplate.h"
+#include "FieldConversion.h"
 #include <QDir>
+#include <QTextCodec>
 #include <QCoreApplication>
+#include <algorithm>
 
 #define tr(sourceText) QCoreApplication::translate("MyClass", sourceText)
 
 namespace Mdt{ namespace PlainText{
 
 CsvFileParser::CsvFileParser()
- : mParser( std::make_unique< CsvParserTemplate<FileMultiPassIterator> >() )
+ : mParser( std::make_unique< CsvParserTemplate<FileMultiPassIterator> >() ),
+   mMappedParser( std::make_unique< CsvParserTemplate<ByteConstIterator> >() ),
+   mMappedScanner( std::make_unique< CsvScannerTemplate<ByteConstIterator> >() )
 {
 }
 
 CsvFileParser::~CsvFileParser()
 {
+  unmapFile();
 }
 
 void CsvFileParser::setCsvSettings(const CsvParserSettings & settings)
@@ -41,7 +49,17 @@ void CsvFileParser::setCsvSettings(const CsvParserSettings & settings)
   Q_ASSERT(settings.isValid());
   Q_ASSERT(!mFile.isOpen());
 
+  mCsvSettings = settings;
   mParser->setupParser(settings);
+  mMappedParser->setupParser(settings);
+  mMappedScanner->setupParser(settings);
+}
+
+void CsvFileParser::setInputMode(CsvFileParser::InputMode mode)
+{
+  Q_ASSERT(!mFile.isOpen());
+
+  mInputMode = mode;
 }
 
 bool CsvFileParser::openFile(const QFileInfo & fileInfo, const QByteArray & encoding)
@@ -51,6 +69,7 @@ bool CsvFileParser::openFile(const QFileInfo & fileInfo, const QByteArray & enco
     closeFile();
   }
   // Open file
+  mEncoding = encoding;
   mFile.setFileName(fileInfo.absoluteFilePath());
   if(!mFile.open(QIODevice::ReadOnly)){
     const auto msg = tr("Could not open file '%1'\nDirectory: '%2'").arg(fileInfo.fileName(), fileInfo.dir().absolutePath());
@@ -59,6 +78,13 @@ bool CsvFileParser::openFile(const QFileInfo & fileInfo, const QByteArray & enco
     mLastError.commit();
     return false;
   }
+  if(mInputMode == MemoryMappedInput){
+    if(!mapFile(fileInfo, encoding)){
+      mFile.close();
+      return false;
+    }
+    return true;
+  }
   // Assign file iterator
   if(!mFileIterator.setSource(&mFile, encoding)){
     mLastError = mFileIterator.lastError();
@@ -75,12 +101,16 @@ bool CsvFileParser::isOpen() const
 
 void CsvFileParser::closeFile()
 {
+  unmapFile();
   mFileIterator.clear();
   mFile.close();
 }
 
 bool CsvFileParser::atEnd() const
 {
+  if(mInputMode == MemoryMappedInput){
+    return (mMappedPosition == mMappedEnd);
+  }
   return mFileIterator.isEof();
 }
 
@@ -90,6 +120,18 @@ Expected<StringRecord> CsvFileParser::readLine()
 
   Expected<StringRecord> record;
 
+  if(mInputMode == MemoryMappedInput){
+    if(mCsvSettings.parserEngine() == CsvParserSettings::ScannerEngine){
+      // The scanner decodes fields itself
+      return mMappedScanner->readLine(mMappedPosition, mMappedEnd);
+    }
+    record = mMappedParser->readLine(mMappedPosition, mMappedEnd);
+    if(record && mDecodeUtf8){
+      decodeUtf8Fields(*record);
+    }
+    return record;
+  }
+
   // Create multi pass iterators
   auto first = makeFileMultiPassIterator(mFileIterator);
   auto last = makeFileMultiPassIterator(FileInputIterator());
@@ -105,10 +147,101 @@ Expected<StringRecord> CsvFileParser::readLine()
   return record;
 }
 
+bool CsvFileParser::seekToRow(const CsvRowIndex & index, qint64 row)
+{
+  Q_ASSERT(mFile.isOpen());
+  Q_ASSERT(index.fieldProtection() == mCsvSettings.fieldProtection());
+  Q_ASSERT(row >= 0);
+
+  if(index.fileSize() != mFile.size()){
+    const auto msg = tr("Row index does not match file '%1'").arg(mFile.fileName());
+    mLastError = mdtErrorNew(msg, Mdt::Error::Critical, "CsvFileParser");
+    mLastError.commit();
+    return false;
+  }
+  if(row >= index.rowCount()){
+    const auto msg = tr("Row %1 is out of range, file '%2' contains %3 rows")
+                     .arg(row).arg(mFile.fileName()).arg(index.rowCount());
+    mLastError = mdtErrorNew(msg, Mdt::Error::Critical, "CsvFileParser");
+    mLastError.commit();
+    return false;
+  }
+  const auto position = index.nearestPosition(row);
+  const qint64 recordsToSkip = row - position.row;
+
+  if(mInputMode == MemoryMappedInput){
+    Q_ASSERT(mMappedData != nullptr);
+    const uchar *it = mMappedData + position.offset;
+    const uchar *end = mMappedData + mFile.size();
+    Impl::CsvRecordStartScanner scanner(mCsvSettings.fieldProtection());
+    for(qint64 i = 0; i < recordsToSkip; ++i){
+      it = scanner.findNextRecordStart(it, end);
+      Q_ASSERT(it != nullptr);
+    }
+    mMappedPosition = ByteConstIterator(it);
+    return true;
+  }
+
+  const qint64 offset = findRecordStartInFile(position.offset, recordsToSkip);
+  if(offset < 0){
+    return false;
+  }
+  if(!mFile.seek(offset)){
+    const auto msg = tr("Could not seek in file '%1'").arg(mFile.fileName());
+    mLastError = mdtErrorNew(msg, Mdt::Error::Critical, "CsvFileParser");
+    mLastError.stackError(mdtErrorFromQFile(mFile, "CsvFileParser"));
+    mLastError.commit();
+    return false;
+  }
+  if(!mFileIterator.setSource(&mFile, mEncoding)){
+    mLastError = mFileIterator.lastError();
+    return false;
+  }
+
+  return true;
+}
+
+qint64 CsvFileParser::mappedPosition() const
+{
+  Q_ASSERT(mFile.isOpen());
+  Q_ASSERT(mInputMode == MemoryMappedInput);
+
+  // A empty file is not mapped
+  if(mMappedData == nullptr){
+    return 0;
+  }
+  return mMappedPosition.data() - mMappedData;
+}
+
+void CsvFileParser::seekToMappedPosition(qint64 offset)
+{
+  Q_ASSERT(mFile.isOpen());
+  Q_ASSERT(mInputMode == MemoryMappedInput);
+  Q_ASSERT(offset >= 0);
+  Q_ASSERT(offset <= mFile.size());
+
+  if(mMappedData == nullptr){
+    return;
+  }
+  mMappedPosition = ByteConstIterator(mMappedData + offset);
+}
+
 Expected<StringRecordList> CsvFileParser::readAll()
 {
   Q_ASSERT_X(mParser->isValid(), "CsvFileParser", "No CSV settings set");
 
+  const int threadCount = mCsvSettings.effectiveThreadCount();
+  if( (mInputMode == MemoryMappedInput) && (threadCount > 1) ){
+    CsvParallelParserTemplate<ByteConstIterator> parallelParser(mCsvSettings);
+    parallelParser.setUtf8Source(mDecodeUtf8);
+    if( mDecodeUtf8 && (mCsvSettings.parserEngine() == CsvParserSettings::SpiritEngine) ){
+      parallelParser.setRecordPostProcessor(&CsvFileParser::decodeUtf8Fields);
+    }
+    const auto recList = parallelParser.readAll(mMappedPosition, mMappedEnd, threadCount);
+    mMappedPosition = mMappedEnd;
+    return recList;
+  }
+
   StringRecordList recList;
 
   while(!atEnd()){
@@ -122,5 +255,202 @@ Expected<StringRecordList> CsvFileParser::readAll()
   return recList;
 }
 
+Expected<Record> CsvFileParser::readTypedLine()
+{
+  Q_ASSERT_X(mParser->isValid(), "CsvFileParser", "No CSV settings set");
+
+  if( (mInputMode == MemoryMappedInput) && (mCsvSettings.parserEngine() == CsvParserSettings::ScannerEngine) ){
+    return mMappedScanner->readTypedLine(mMappedPosition, mMappedEnd);
+  }
+  const auto record = readLine();
+  if(!record){
+    return record.error();
+  }
+  return Impl::convertRecord(record.value(), mCsvSettings);
+}
+
+Expected<RecordList> CsvFileParser::readAllTyped()
+{
+  Q_ASSERT_X(mParser->isValid(), "CsvFileParser", "No CSV settings set");
+
+  RecordList recordList;
+
+  if( (mInputMode == MemoryMappedInput) && (mCsvSettings.effectiveThreadCount() > 1) ){
+    const auto stringRecordList = readAll();
+    if(!stringRecordList){
+      return stringRecordList.error();
+    }
+    recordList.reserve(stringRecordList.value().rowCount());
+    for(const auto & stringRecord : stringRecordList.value()){
+      const auto record = Impl::convertRecord(stringRecord, mCsvSettings);
+      if(!record){
+        return record.error();
+      }
+      recordList.appendRecord(record.value());
+    }
+    return recordList;
+  }
+
+  while(!atEnd()){
+    const auto record = readTypedLine();
+    if(!record){
+      return record.error();
+    }
+    recordList.appendRecord(record.value());
+  }
+
+  return recordList;
+}
+
+Expected<qint64> CsvFileParser::readAllInBatches(int batchSize, const RecordBatchHandler & handler)
+{
+  Q_ASSERT_X(mParser->isValid(), "CsvFileParser", "No CSV settings set");
+  Q_ASSERT(batchSize > 0);
+  Q_ASSERT(handler);
+
+  qint64 count = 0;
+  StringRecordList batch;
+  batch.reserve(batchSize);
+
+  while(!atEnd()){
+    batch.clear();
+    while( (batch.rowCount() < batchSize) && !atEnd() ){
+      auto record = readLine();
+      if(!record){
+        return record.error();
+      }
+      batch.appendRecord(*record);
+    }
+    count += batch.rowCount();
+    if(!handler(batch)){
+      break;
+    }
+  }
+
+  return count;
+}
+
+qint64 CsvFileParser::findRecordStartInFile(qint64 offset, qint64 recordsToSkip)
+{
+  Q_ASSERT(mFile.isOpen());
+
+  if(!mFile.seek(offset)){
+    const auto msg = tr("Could not seek in file '%1'").arg(mFile.fileName());
+    mLastError = mdtErrorNew(msg, Mdt::Error::Critical, "CsvFileParser");
+    mLastError.stackError(mdtErrorFromQFile(mFile, "CsvFileParser"));
+    mLastError.commit();
+    return -1;
+  }
+  if(recordsToSkip == 0){
+    return offset;
+  }
+  Impl::CsvRecordStartScanner scanner(mCsvSettings.fieldProtection());
+  QByteArray buffer;
+  buffer.resize(64 * 1024);
+  while(true){
+    const qint64 n = mFile.read(buffer.data(), buffer.size());
+    if(n <= 0){
+      const auto msg = tr("Could not read file '%1'").arg(mFile.fileName());
+      mLastError = mdtErrorNew(msg, Mdt::Error::Critical, "CsvFileParser");
+      mLastError.stackError(mdtErrorFromQFile(mFile, "CsvFileParser"));
+      mLastError.commit();
+      return -1;
+    }
+    const auto *first = reinterpret_cast<const uchar*>(buffer.constData());
+    const auto *last = first + n;
+    const auto *it = first;
+    while( (it = scanner.findNextRecordStart(it, last)) != nullptr ){
+      --recordsToSkip;
+      if(recordsToSkip == 0){
+        return offset + (it - first);
+      }
+    }
+    offset += n;
+  }
+}
+
+bool CsvFileParser::mapFile(const QFileInfo & fileInfo, const QByteArray & encoding)
+{
+  Q_ASSERT(mFile.isOpen());
+  Q_ASSERT(mMappedData == nullptr);
+
+  /*
+   * Only encodings for witch all chars that have a special meaning
+   * for the parser are single bytes with the same value
+   * than their unicode representation are supported.
+   */
+  const auto *codec = QTextCodec::codecForName(encoding);
+  if(codec == nullptr){
+    const QString msg = tr("Could not find a codec for requested encoding '%1'").arg( QString::fromLatin1(encoding) );
+    mLastError = mdtErrorNew(msg, Mdt::Error::Critical, "CsvFileParser");
+    mLastError.commit();
+    return false;
+  }
+  switch(codec->mibEnum()){
+    case 106: // UTF-8
+      mDecodeUtf8 = true;
+      break;
+    case 4:   // ISO-8859-1 (Latin-1)
+      mDecodeUtf8 = false;
+      break;
+    default:
+      {
+        const QString msg = tr("Encoding '%1' is not supported in memory mapped input mode.\nFile: '%2'")
+                            .arg( QString::fromLatin1(encoding), fileInfo.fileName() );
+        mLastError = mdtErrorNew(msg, Mdt::Error::Critical, "CsvFileParser");
+        mLastError.commit();
+      }
+      return false;
+  }
+  mMappedScanner->setUtf8Source(mDecodeUtf8);
+  // A empty file can not be mapped, but is not a error
+  const auto size = mFile.size();
+  if(size <= 0){
+    return true;
+  }
+  mMappedData = mFile.map(0, size);
+  if(mMappedData == nullptr){
+    const auto msg = tr("Could not map file '%1' into memory\nDirectory: '%2'").arg(fileInfo.fileName(), fileInfo.dir().absolutePath());
+    mLastError = mdtErrorNew(msg, Mdt::Error::Critical, "CsvFileParser");
+    mLastError.stackError(mdtErrorFromQFile(mFile, "CsvFileParser"));
+    mLastError.commit();
+    return false;
+  }
+  mMappedPosition = ByteConstIterator(mMappedData);
+  mMappedEnd = ByteConstIterator(mMappedData + size);
+  // Skip a possibly present UTF-8 BOM, like QTextDecoder does
+  if( mDecodeUtf8 && (size >= 3) && (mMappedData[0] == 0xEF) && (mMappedData[1] == 0xBB) && (mMappedData[2] == 0xBF) ){
+    mMappedPosition += 3;
+  }
+
+  return true;
+}
+
+void CsvFileParser::unmapFile()
+{
+  if(mMappedData != nullptr){
+    mFile.unmap(mMappedData);
+    mMappedData = nullptr;
+  }
+  mMappedPosition = ByteConstIterator();
+  mMappedEnd = ByteConstIterator();
+}
+
+void CsvFileParser::decodeUtf8Fields(StringRecord & record)
+{
+  const auto isNonAscii = [](QChar c){
+    return (c.unicode() >= 0x80);
+  };
+  /*
+   * Each byte of the mapped file was stored as a QChar in the field.
+   * Only fields that contains a multi-byte sequence have to be decoded.
+   */
+  for(auto & field : record){
+    if(std::any_of(field.cbegin(), field.cend(), isNonAscii)){
+      field = QString::fromUtf8(field.toLatin1());
+    }
+  }
+}
+
 
 }} // namespace Mdt{ namespace PlainText{
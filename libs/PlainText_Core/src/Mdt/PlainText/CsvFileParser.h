@@ -24,14 +24,20 @@
 #include "CsvParserSettings.h"
 #include "StringRecord.h"
 #include "StringRecordList.h"
+#include "Record.h"
+#include "RecordList.h"
 #include "FileInputIterator.h"
 #include "FileMultiPassIterator.h"
+#include "ByteConstIterator.h"
+#include "CsvRowIndex.h"
 #include "Mdt/Expected.h"
 #include "Mdt/Error.h"
 #include <QString>
 #include <QByteArray>
 #include <QFileInfo>
 #include <QFile>
+#include <QtGlobal>
+#include <functional>
 #include <memory>
 
 namespace Mdt{ namespace PlainText{
@@ -39,7 +45,23 @@ namespace Mdt{ namespace PlainText{
   template <typename InputIterator>
   class CsvParserTemplate;
 
+  template <typename SourceIterator>
+  class CsvScannerTemplate;
+
   /*! \brief CSV parser that acts on a file as input
+   *
+   * By default, the file is read chunk by chunk,
+   *  decoded to unicode and then parsed (BufferedInput).
+   *  For big files encoded in UTF-8 or Latin-1,
+   *  the MemoryMappedInput mode can be used:
+   * \code
+   * CsvFileParser parser;
+   * parser.setCsvSettings(settings);
+   * parser.setInputMode(CsvFileParser::MemoryMappedInput);
+   * if(!parser.openFile(fileInfo, "UTF-8")){
+   *   // Error handling
+   * }
+   * \endcode
    *
    * \note Some part of this API documentation refers to following standards:
    *       \li CSV-1203 available here: http://mastpoint.com/csv-1203
@@ -49,6 +71,17 @@ namespace Mdt{ namespace PlainText{
   {
    public:
 
+    /*! \brief Input mode
+     */
+    enum InputMode
+    {
+      BufferedInput,      /*!< The file is read by chunks, that are decoded to unicode before parsing.
+                               All encodings supported by QTextCodec can be used. */
+      MemoryMappedInput   /*!< The file is mapped into memory and the parser acts directly on the mapped bytes.
+                               Only the extracted fields are decoded.
+                               Only UTF-8 and Latin-1 (ISO-8859-1) encodings are supported. */
+    };
+
     /*! \brief Default constructor
      */
     CsvFileParser();
@@ -63,6 +96,15 @@ namespace Mdt{ namespace PlainText{
     CsvFileParser(CsvFileParser &&) = delete;
     CsvFileParser & operator=(CsvFileParser &&) = delete;
 
+    /*! \brief Function that receives a batch of records
+     *
+     * Must return true to continue reading,
+     *  or false to stop.
+     *
+     * \sa readAllInBatches()
+     */
+    using RecordBatchHandler = std::function<bool(const StringRecordList & batch)>;
+
     /*! \brief Set CSV settings
      *
      * \pre \a settings must be valid
@@ -70,12 +112,28 @@ namespace Mdt{ namespace PlainText{
      */
     void setCsvSettings(const CsvParserSettings & settings);
 
+    /*! \brief Set input mode
+     *
+     * Default input mode is BufferedInput.
+     *
+     * \pre No file must currently be open
+     */
+    void setInputMode(InputMode mode);
+
+    /*! \brief Get input mode
+     */
+    InputMode inputMode() const
+    {
+      return mInputMode;
+    }
+
     /*! \brief Open CSV file
      *
      * \param fileInfo Path to CSV file that must be open
      * \param encoding Encoding name of the CSV file format.
      *               Will use QTextCodec::codecForName() to get apropriate codec.
      * \return false if CSV file could not be open, or no codec could be found for given encoding,
+     *         or, in MemoryMappedInput mode, encoding is not supported or mapping the file failed.
      *         true if all goes well.
      */
     bool openFile(const QFileInfo & fileInfo, const QByteArray & encoding);
@@ -102,12 +160,118 @@ namespace Mdt{ namespace PlainText{
     Mdt::Expected<StringRecord> readLine();
 
     /*! \brief Read the entire CSV file
+     *
+     * In MemoryMappedInput mode, if CsvParserSettings::effectiveThreadCount() is > 1,
+     *  the file is parsed in parallel (see CsvParallelParserTemplate).
      *
      * \pre CSV settings must be set before calling this function
      * \sa setCsvSettings()
      */
     Mdt::Expected<StringRecordList> readAll();
 
+    /*! \brief Read one line as a typed record
+     *
+     * Each field is converted to the data type of its column
+     *  (see CsvParserSettings::columnDataTypes()).
+     *  In MemoryMappedInput mode with CsvParserSettings::ScannerEngine ,
+     *  the conversion is done directly from the mapped bytes,
+     *  without building a intermediate QString for each field.
+     *
+     * \pre CSV settings must be set before calling this function
+     * \sa setCsvSettings()
+     */
+    Mdt::Expected<Record> readTypedLine();
+
+    /*! \brief Read the entire CSV file as typed records
+     *
+     * \pre CSV settings must be set before calling this function
+     * \sa readTypedLine()
+     * \sa readAll()
+     */
+    Mdt::Expected<RecordList> readAllTyped();
+
+    /*! \brief Read the entire CSV file by batches of records
+     *
+     * Reads the file by batches of \a batchSize records,
+     *  and passes each batch to \a handler .
+     *  The same batch buffer is reused for each batch,
+     *  so the memory used to read a file does not depend on its size.
+     *  The last batch can contain less than \a batchSize records.
+     *
+     * A sink object can be used by passing it with std::ref(),
+     *  or by wrapping it in a lambda:
+     * \code
+     * const auto count = parser.readAllInBatches(10000, [&loader](const StringRecordList & batch){
+     *   return loader.store(batch);
+     * });
+     * if(!count){
+     *   // Error handling
+     * }
+     * \endcode
+     *
+     * Returns the count of records that have been passed to \a handler ,
+     *  or a error if parsing failed.
+     *  Records that have been read before the error
+     *  have allready been passed to \a handler .
+     *
+     * \note \a handler should not keep a copy of the batch,
+     *       else the batch buffer can not be reused.
+     *
+     * \pre CSV settings must be set before calling this function
+     * \pre \a batchSize must be > 0
+     * \pre \a handler must be a valid function
+     * \sa setCsvSettings()
+     */
+    Mdt::Expected<qint64> readAllInBatches(int batchSize, const RecordBatchHandler & handler);
+
+    /*! \brief Move the read position to the start of \a row
+     *
+     * The next call to readLine() will return the record \a row .
+     *  \a index gives the nearest indexed record before \a row ,
+     *  the records in between are skipped without being parsed.
+     *
+     * Returns false if \a row is out of range,
+     *  or \a index does not match the open file.
+     *
+     * \pre A file must be open
+     * \pre \a index must have been built with the same field protection
+     *       than the one of the CSV settings set to this parser
+     * \pre \a row must be >= 0
+     * \sa CsvRowIndex
+     */
+    bool seekToRow(const CsvRowIndex & index, qint64 row);
+
+    /*! \brief Get the current read position in the mapped file
+     *
+     * Returns the offset, in bytes, of the record
+     *  that the next call to readLine() will return.
+     *  This offset can later be passed to seekToMappedPosition().
+     *
+     * \pre A file must be open in MemoryMappedInput mode
+     */
+    qint64 mappedPosition() const;
+
+    /*! \brief Move the read position to \a offset in the mapped file
+     *
+     * The next call to readLine() will return the record starting at \a offset .
+     *
+     * \pre A file must be open in MemoryMappedInput mode
+     * \pre \a offset must be the start of a record,
+     *       typically a value returned by mappedPosition()
+     */
+    void seekToMappedPosition(qint64 offset);
+
+    /*! \brief Get counters of the file input
+     *
+     * Only relevant in BufferedInput mode.
+     *
+     * \sa FileInputIteratorSharedData::counters()
+     */
+    FileInputCounters fileInputCounters() const
+    {
+      return mFileIterator.counters();
+    }
+
     /*! \brief Get last error
      */
     Mdt::Error lastError() const
@@ -117,9 +281,23 @@ namespace Mdt{ namespace PlainText{
 
    private:
 
+    bool mapFile(const QFileInfo & fileInfo, const QByteArray & encoding);
+    void unmapFile();
+    static void decodeUtf8Fields(StringRecord & record);
+    qint64 findRecordStartInFile(qint64 offset, qint64 recordsToSkip);
+
+    InputMode mInputMode = BufferedInput;
+    CsvParserSettings mCsvSettings;
+    bool mDecodeUtf8 = false;
+    QByteArray mEncoding;
+    uchar *mMappedData = nullptr;
     QFile mFile;
     FileInputIterator mFileIterator;
+    ByteConstIterator mMappedPosition;
+    ByteConstIterator mMappedEnd;
     std::unique_ptr< CsvParserTemplate<FileMultiPassIterator> > mParser;
+    std::unique_ptr< CsvParserTemplate<ByteConstIterator> > mMappedParser;
+    std::unique_ptr< CsvScannerTemplate<ByteConstIterator> > mMappedScanner;
     Mdt::Error mLastError;
   };
 
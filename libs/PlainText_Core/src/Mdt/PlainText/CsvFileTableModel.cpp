@@ -0,0 +1,255 @@
+/****************************************************************************
+ **
+ ** Copyright (C) 2011-2017 Philippe Steinmann.
+ **
+ ** This file is part of multiDiagTools library.
+ **
+ ** multiDiagTools is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Lesser General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** multiDiagTools is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public License
+ ** along with multiDiagTools.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+#include "CsvFileTableModel.h"
+#include <limits>
+#include <memory>
+
+namespace Mdt{ namespace PlainText{
+
+CsvFileTableModel::CsvFileTableModel(QObject* parent)
+ : QAbstractTableModel(parent)
+{
+  mSequentialParser.setInputMode(CsvFileParser::MemoryMappedInput);
+  mRandomAccessParser.setInputMode(CsvFileParser::MemoryMappedInput);
+  mPageCache.setMaxCost(64);
+}
+
+CsvFileTableModel::~CsvFileTableModel()
+{
+}
+
+void CsvFileTableModel::setCsvSettings(const CsvParserSettings & settings)
+{
+  Q_ASSERT(settings.isValid());
+  Q_ASSERT(!isOpen());
+
+  mCsvSettings = settings;
+  mSequentialParser.setCsvSettings(settings);
+  mRandomAccessParser.setCsvSettings(settings);
+}
+
+void CsvFileTableModel::setPageSize(int size)
+{
+  Q_ASSERT(size > 0);
+  Q_ASSERT(!isOpen());
+
+  mPageSize = size;
+}
+
+void CsvFileTableModel::setMaximumCachedPageCount(int count)
+{
+  Q_ASSERT(count > 0);
+
+  mPageCache.setMaxCost(count);
+}
+
+bool CsvFileTableModel::openFile(const QFileInfo & fileInfo, const QByteArray & encoding)
+{
+  if(isOpen()){
+    closeFile();
+  }
+  beginResetModel();
+  if( !mSequentialParser.openFile(fileInfo, encoding) ){
+    mLastError = mSequentialParser.lastError();
+    endResetModel();
+    return false;
+  }
+  if( !mRandomAccessParser.openFile(fileInfo, encoding) ){
+    mLastError = mRandomAccessParser.lastError();
+    mSequentialParser.closeFile();
+    endResetModel();
+    return false;
+  }
+  // Read the first page
+  mAllRowsFetched = mSequentialParser.atEnd();
+  if(!mAllRowsFetched){
+    std::unique_ptr<StringRecordList> firstPage(readNextPage());
+    if(!firstPage){
+      endResetModel();
+      closeFile();
+      return false;
+    }
+    mColumnCount = maximumColumnCount(*firstPage);
+    mRowCount = firstPage->rowCount();
+    mPageCache.insert(0, firstPage.release(), 1);
+    mAllRowsFetched = mSequentialParser.atEnd();
+  }
+  endResetModel();
+
+  return true;
+}
+
+bool CsvFileTableModel::isOpen() const
+{
+  return mSequentialParser.isOpen();
+}
+
+void CsvFileTableModel::closeFile()
+{
+  beginResetModel();
+  mPageCache.clear();
+  mPageOffsets.clear();
+  mSequentialParser.closeFile();
+  mRandomAccessParser.closeFile();
+  mRowCount = 0;
+  mColumnCount = 0;
+  mAllRowsFetched = true;
+  endResetModel();
+}
+
+int CsvFileTableModel::rowCount(const QModelIndex & parent) const
+{
+  if(parent.isValid()){
+    return 0;
+  }
+  return mRowCount;
+}
+
+int CsvFileTableModel::columnCount(const QModelIndex & parent) const
+{
+  if(parent.isValid()){
+    return 0;
+  }
+  return mColumnCount;
+}
+
+QVariant CsvFileTableModel::data(const QModelIndex & index, int role) const
+{
+  if(!index.isValid()){
+    return QVariant();
+  }
+  if( (role != Qt::DisplayRole) && (role != Qt::EditRole) ){
+    return QVariant();
+  }
+  Q_ASSERT(index.row() >= 0);
+  Q_ASSERT(index.row() < rowCount());
+  Q_ASSERT(index.column() >= 0);
+  const auto *recordList = page(index.row() / mPageSize);
+  if(recordList == nullptr){
+    return QVariant();
+  }
+  const int row = index.row() % mPageSize;
+  Q_ASSERT(row < recordList->rowCount());
+  if(index.column() >= recordList->columnCount(row)){
+    return QVariant();
+  }
+  return recordList->data(row, index.column());
+}
+
+bool CsvFileTableModel::canFetchMore(const QModelIndex & parent) const
+{
+  if(parent.isValid()){
+    return false;
+  }
+  if(mAllRowsFetched){
+    return false;
+  }
+  // Row count of a model is a int
+  return (mRowCount <= std::numeric_limits<int>::max() - mPageSize);
+}
+
+void CsvFileTableModel::fetchMore(const QModelIndex & parent)
+{
+  if(!canFetchMore(parent)){
+    return;
+  }
+  Q_ASSERT( (mRowCount % mPageSize) == 0 );
+  std::unique_ptr<StringRecordList> nextPage(readNextPage());
+  if(!nextPage){
+    // Do not try again to read a invalid file
+    mAllRowsFetched = true;
+    return;
+  }
+  const int newColumnCount = maximumColumnCount(*nextPage);
+  if(newColumnCount > mColumnCount){
+    beginInsertColumns(QModelIndex(), mColumnCount, newColumnCount-1);
+    mColumnCount = newColumnCount;
+    endInsertColumns();
+  }
+  const int n = nextPage->rowCount();
+  if(n > 0){
+    beginInsertRows(QModelIndex(), mRowCount, mRowCount + n - 1);
+    mPageCache.insert(mRowCount / mPageSize, nextPage.release(), 1);
+    mRowCount += n;
+    endInsertRows();
+  }
+  mAllRowsFetched = mSequentialParser.atEnd();
+}
+
+StringRecordList *CsvFileTableModel::readNextPage()
+{
+  Q_ASSERT(mSequentialParser.isOpen());
+
+  std::unique_ptr<StringRecordList> recordList(new StringRecordList);
+  recordList->reserve(mPageSize);
+  const qint64 offset = mSequentialParser.mappedPosition();
+  for(int i = 0; (i < mPageSize) && !mSequentialParser.atEnd(); ++i){
+    const auto record = mSequentialParser.readLine();
+    if(!record){
+      mLastError = record.error();
+      return nullptr;
+    }
+    recordList->appendRecord(record.value());
+  }
+  // Pages are read in order, remember where this one begins
+  Q_ASSERT(mPageOffsets.count() == mRowCount / mPageSize);
+  mPageOffsets.append(offset);
+
+  return recordList.release();
+}
+
+const StringRecordList *CsvFileTableModel::page(int pageIndex) const
+{
+  auto *recordList = mPageCache.object(pageIndex);
+  if(recordList != nullptr){
+    return recordList;
+  }
+  // Page was dropped from the cache, read it again from the position recorded when it was fetched
+  Q_ASSERT(pageIndex < mPageOffsets.count());
+  const int firstRow = pageIndex * mPageSize;
+  mRandomAccessParser.seekToMappedPosition(mPageOffsets.at(pageIndex));
+  const int count = qMin(mPageSize, mRowCount - firstRow);
+  std::unique_ptr<StringRecordList> newPage(new StringRecordList);
+  newPage->reserve(count);
+  for(int i = 0; i < count; ++i){
+    const auto record = mRandomAccessParser.readLine();
+    if(!record){
+      mLastError = record.error();
+      return nullptr;
+    }
+    newPage->appendRecord(record.value());
+  }
+  recordList = newPage.release();
+  mPageCache.insert(pageIndex, recordList, 1);
+
+  return recordList;
+}
+
+int CsvFileTableModel::maximumColumnCount(const StringRecordList & page)
+{
+  int count = 0;
+  for(int row = 0; row < page.rowCount(); ++row){
+    count = qMax(count, page.columnCount(row));
+  }
+  return count;
+}
+
+}} // namespace Mdt{ namespace PlainText{
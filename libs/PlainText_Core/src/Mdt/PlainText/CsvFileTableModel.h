@@ -0,0 +1,204 @@
+/****************************************************************************
+ **
+ ** Copyright (C) 2011-2017 Philippe Steinmann.
+ **
+ ** This file is part of multiDiagTools library.
+ **
+ ** multiDiagTools is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Lesser General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** multiDiagTools is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public License
+ ** along with multiDiagTools.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+#ifndef MDT_PLAIN_TEXT_CSV_FILE_TABLE_MODEL_H
+#define MDT_PLAIN_TEXT_CSV_FILE_TABLE_MODEL_H
+
+#include "CsvParserSettings.h"
+#include "CsvFileParser.h"
+#include "StringRecordList.h"
+#include "Mdt/Error.h"
+#include <QAbstractTableModel>
+#include <QModelIndex>
+#include <QVariant>
+#include <QFileInfo>
+#include <QByteArray>
+#include <QCache>
+#include <QVector>
+#include <QtGlobal>
+
+namespace Mdt{ namespace PlainText{
+
+  /*! \brief Table model that gives access to a CSV file, loading its rows on demand
+   *
+   * Unlike RecordListTableModel, the data is not loaded at once:
+   *  the file is read by pages of pageSize() rows.
+   *  Opening a file only reads its first page,
+   *  the following pages are read when a view asks for them
+   *  (see canFetchMore() and fetchMore()).
+   *
+   * Only the most recently used pages are keeped in memory
+   *  (see setMaximumCachedPageCount()).
+   *  A page that was dropped from the cache is read again when needed,
+   *  starting at the position of its first row,
+   *  that was recorded when the page was fetched.
+   *
+   * The column count is the maximum column count
+   *  of the rows that have been fetched so far,
+   *  so it can grow while rows are fetched.
+   *
+   * Typical usage:
+   * \code
+   * CsvFileTableModel model;
+   * model.setCsvSettings(csvSettings);
+   * if(!model.openFile(fileInfo, "UTF-8")){
+   *   // Error handling
+   * }
+   * QTableView view;
+   * view.setModel(&model);
+   * \endcode
+   *
+   * Because the file is memory mapped,
+   *  only UTF-8 and Latin-1 encodings are supported
+   *  (see CsvFileParser::MemoryMappedInput).
+   */
+  class CsvFileTableModel : public QAbstractTableModel
+  {
+   Q_OBJECT
+
+   public:
+
+    /*! \brief Constructor
+     */
+    explicit CsvFileTableModel(QObject* parent = nullptr);
+
+    /*! \brief Destructor
+     */
+    ~CsvFileTableModel();
+
+    /*! \brief Set CSV settings
+     *
+     * \pre \a settings must be valid
+     * \pre No file must currently be open
+     */
+    void setCsvSettings(const CsvParserSettings & settings);
+
+    /*! \brief Set the count of rows in a page
+     *
+     * The default page size is 1024 rows.
+     *
+     * \pre \a size must be > 0
+     * \pre No file must currently be open
+     */
+    void setPageSize(int size);
+
+    /*! \brief Get the count of rows in a page
+     */
+    int pageSize() const
+    {
+      return mPageSize;
+    }
+
+    /*! \brief Set the maximum count of pages keeped in memory
+     *
+     * The default is 64 pages.
+     *
+     * \pre \a count must be > 0
+     */
+    void setMaximumCachedPageCount(int count);
+
+    /*! \brief Get the maximum count of pages keeped in memory
+     */
+    int maximumCachedPageCount() const
+    {
+      return mPageCache.maxCost();
+    }
+
+    /*! \brief Get the count of pages currently keeped in memory
+     */
+    int cachedPageCount() const
+    {
+      return mPageCache.count();
+    }
+
+    /*! \brief Open a CSV file
+     *
+     * Reads the first page of the file.
+     *  This resets the model.
+     *
+     * Returns false if the file could not be open,
+     *  \a encoding is not supported, or reading the first page failed.
+     */
+    bool openFile(const QFileInfo & fileInfo, const QByteArray & encoding);
+
+    /*! \brief Check if a CSV file is open
+     */
+    bool isOpen() const;
+
+    /*! \brief Close the CSV file
+     *
+     * This resets the model.
+     */
+    void closeFile();
+
+    /*! \brief Get row count
+     *
+     * Returns the count of rows that have been fetched so far.
+     */
+    int rowCount(const QModelIndex & parent = QModelIndex()) const override;
+
+    /*! \brief Get column count
+     */
+    int columnCount(const QModelIndex & parent = QModelIndex()) const override;
+
+    /*! \brief Get data
+     *
+     * If the page containing \a index is not in the cache, it is read again.
+     *  If this fails, a null QVariant is returned, and lastError() is set.
+     */
+    QVariant data(const QModelIndex & index, int role = Qt::DisplayRole) const override;
+
+    /*! \brief Check if more rows can be fetched
+     */
+    bool canFetchMore(const QModelIndex & parent) const override;
+
+    /*! \brief Fetch the next page of rows
+     */
+    void fetchMore(const QModelIndex & parent) override;
+
+    /*! \brief Get last error
+     */
+    Mdt::Error lastError() const
+    {
+      return mLastError;
+    }
+
+   private:
+
+    StringRecordList *readNextPage();
+    const StringRecordList *page(int pageIndex) const;
+    static int maximumColumnCount(const StringRecordList & page);
+
+    CsvParserSettings mCsvSettings;
+    int mPageSize = 1024;
+    int mRowCount = 0;
+    int mColumnCount = 0;
+    bool mAllRowsFetched = true;
+    CsvFileParser mSequentialParser;
+    mutable CsvFileParser mRandomAccessParser;
+    // Offset, in bytes, of the first row of each fetched page
+    QVector<qint64> mPageOffsets;
+    mutable QCache<int, StringRecordList> mPageCache;
+    mutable Mdt::Error mLastError;
+  };
+
+}} // namespace Mdt{ namespace PlainText{
+
+#endif // #ifndef MDT_PLAIN_TEXT_CSV_FILE_TABLE_MODEL_H
@@ -0,0 +1,69 @@
+/****************************************************************************
+ **
+ ** Copyright (C) 2011-2017 Philippe Steinmann.
+ **
+ ** This file is part of multiDiagTools library.
+ **
+ ** multiDiagTools is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Lesser General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** multiDiagTools is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public License
+ ** along with multiDiagTools.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+#include "CsvGeneratorSettings.h"
+#include <QCoreApplication>
+#include <QString>
+
+#define tr(sourceText) QCoreApplication::translate("CsvGeneratorSettings", sourceText)
+
+namespace Mdt{ namespace PlainText{
+
+void CsvGeneratorSettings::setFieldProtectionMode(CsvGeneratorSettings::FieldProtectionMode mode)
+{
+  mFieldProtectionMode = mode;
+}
+
+void CsvGeneratorSettings::setEndOfLine(CsvGeneratorSettings::EndOfLine eol)
+{
+  mEndOfLine = eol;
+}
+
+bool CsvGeneratorSettings::isValid() const
+{
+  // Check basis
+  if(!CsvCommonSettings::isValid()){
+    return false;
+  }
+  // Check that a end of line is not used as a field separator or protection
+  if( (fieldSeparator() == '\r') || (fieldSeparator() == '\n') ){
+    const auto msg = tr("Field separator can not be a end of line.");
+    auto error = mdtErrorNew(msg, Mdt::Error::Warning, "CsvGeneratorSettings");
+    setLastError(error);
+    return false;
+  }
+  if( (fieldProtection() == '\r') || (fieldProtection() == '\n') ){
+    const auto msg = tr("Field protection can not be a end of line.");
+    auto error = mdtErrorNew(msg, Mdt::Error::Warning, "CsvGeneratorSettings");
+    setLastError(error);
+    return false;
+  }
+  // Seems OK
+  return true;
+}
+
+void CsvGeneratorSettings::clear()
+{
+  CsvCommonSettings::clear();
+  mFieldProtectionMode = ProtectWhenRequired;
+  mEndOfLine = CrLfEndOfLine;
+}
+
+}} // namespace Mdt{ namespace PlainText{
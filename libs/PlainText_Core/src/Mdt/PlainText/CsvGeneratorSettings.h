@@ -0,0 +1,137 @@
+/****************************************************************************
+ **
+ ** Copyright (C) 2011-2017 Philippe Steinmann.
+ **
+ ** This file is part of multiDiagTools library.
+ **
+ ** multiDiagTools is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Lesser General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** multiDiagTools is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public License
+ ** along with multiDiagTools.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+#ifndef MDT_PLAIN_TEXT_CSV_GENERATOR_SETTINGS_H
+#define MDT_PLAIN_TEXT_CSV_GENERATOR_SETTINGS_H
+
+#include "CsvCommonSettings.h"
+#include <QMetaType>
+
+namespace Mdt{ namespace PlainText{
+
+  /*! \brief CSV generator settings
+   */
+  class CsvGeneratorSettings : public CsvCommonSettings
+  {
+   public:
+
+    /*! \brief Field protection mode
+     */
+    enum FieldProtectionMode
+    {
+      ProtectWhenRequired,  /*!< A field is protected only if it contains
+                                 the field separator, the field protection,
+                                 a tab or a end of line, or if it begins with a ~.
+                                 This is the default. */
+      ProtectAllFields      /*!< Each field is protected. */
+    };
+
+    /*! \brief End of line
+     */
+    enum EndOfLine
+    {
+      CrLfEndOfLine,  /*!< Lines end with CR LF (\\r\\n). This is the default. */
+      LfEndOfLine     /*!< Lines end with LF (\\n). */
+    };
+
+    /*! \brief Construct default settings
+     */
+    CsvGeneratorSettings()
+     : CsvCommonSettings(),
+       mFieldProtectionMode(ProtectWhenRequired),
+       mEndOfLine(CrLfEndOfLine)
+    {
+    }
+
+    /*! \brief Construct settings as a copy of \a other
+     */
+    CsvGeneratorSettings(const CsvGeneratorSettings & other) = default;
+
+    /*! \brief Construct settings as a copy of \a other
+     */
+    CsvGeneratorSettings & operator=(const CsvGeneratorSettings & other) = default;
+
+    /*! \brief Construct settings as a copy of \a other
+     */
+    CsvGeneratorSettings(CsvGeneratorSettings && other) = default;
+
+    /*! \brief Construct settings as a copy of \a other
+     */
+    CsvGeneratorSettings & operator=(CsvGeneratorSettings && other) = default;
+
+    /*! \brief Set field protection mode
+     *
+     * \sa fieldProtectionMode()
+     */
+    void setFieldProtectionMode(FieldProtectionMode mode);
+
+    /*! \brief Get field protection mode
+     *
+     * Field payload protection is explained
+     *  in CSV-1203 standard, §9.
+     *
+     * \sa setFieldProtectionMode()
+     */
+    FieldProtectionMode fieldProtectionMode() const
+    {
+      return mFieldProtectionMode;
+    }
+
+    /*! \brief Set end of line
+     *
+     * \sa endOfLine()
+     */
+    void setEndOfLine(EndOfLine eol);
+
+    /*! \brief Get end of line
+     *
+     * As required by CSV-1203 standard, rule 4.1,
+     *  and by RFC 4180, the default is CR LF.
+     *
+     * \sa setEndOfLine()
+     */
+    EndOfLine endOfLine() const
+    {
+      return mEndOfLine;
+    }
+
+    /*! \brief Check if settings are valid
+     *
+     * If this settings is not valid,
+     *  use lastError() to get what is wrong.
+     */
+    bool isValid() const;
+
+    /*! \brief Clear
+     *
+     * Will reset to default settings.
+     */
+    void clear();
+
+   private:
+
+    FieldProtectionMode mFieldProtectionMode;
+    EndOfLine mEndOfLine;
+  };
+
+}} // namespace Mdt{ namespace PlainText{
+Q_DECLARE_METATYPE(Mdt::PlainText::CsvGeneratorSettings)
+
+#endif // #ifndef MDT_PLAIN_TEXT_CSV_GENERATOR_SETTINGS_H
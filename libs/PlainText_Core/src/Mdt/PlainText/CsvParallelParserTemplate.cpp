@@ -18,18 +18,7 @@
  ** along with multiDiagTools.  If not, see <http://www.gnu.org/licenses/>.
  **
  ****************************************************************************/
-#include "IndexFormatMapItem.h"
+#include "CsvParallelParserTemplate.h"
 
-namespace Mdt{ namespace ItemModel{
-
-IndexFormatMapItem::IndexFormatMapItem(int row, int column, const QVariant & value)
- : mRow(row),
-   mColumn(column),
-   mValue(value)
-{
-  Q_ASSERT(mRow >= 0);
-  Q_ASSERT(mColumn >= 0);
-  Q_ASSERT(!mValue.isNull());
-}
-
-}} //namespace Mdt{ namespace ItemModel{
+namespace Mdt{ namespace PlainText{
+}} // namespace Mdt{ namespace PlainText{
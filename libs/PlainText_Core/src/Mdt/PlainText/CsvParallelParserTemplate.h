@@ -0,0 +1,282 @@
+/****************************************************************************
+ **
+ ** Copyright (C) 2011-2017 Philippe Steinmann.
+ **
+ ** This file is part of multiDiagTools library.
+ **
+ ** multiDiagTools is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Lesser General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** multiDiagTools is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public License
+ ** along with multiDiagTools.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+#ifndef MDT_PLAIN_TEXT_CSV_PARALLEL_PARSER_TEMPLATE_H
+#define MDT_PLAIN_TEXT_CSV_PARALLEL_PARSER_TEMPLATE_H
+
+#include "CsvParserSettings.h"
+#include "CsvParserTemplate.h"
+#include "CsvScannerTemplate.h"
+#include "CharSearch.h"
+#include "StringRecord.h"
+#include "StringRecordList.h"
+#include "Mdt/Expected.h"
+#include <QtGlobal>
+#include <algorithm>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace Mdt{ namespace PlainText{
+
+  /*! \brief Parse a entire CSV source in parallel
+   *
+   * The source is first splitted into chunks of records.
+   *  The split is only done after a end of line
+   *  that is not in a protected field.
+   *  Each chunk is then parsed by its own parser,
+   *  in its own thread.
+   *  Finally, the resulting record lists are joined in the order of the chunks.
+   *
+   * \tparam SourceIterator Type of iterator that will act on the source.
+   *      Same requirements than for CsvScannerTemplate apply.
+   *
+   * \note Including directly this header in a project can slow down compilation time
+   * \sa CsvParserSettings::setThreadCount()
+   */
+  template <typename SourceIterator>
+  class CsvParallelParserTemplate
+  {
+    using pointer = decltype( SourceIterator().data() );
+
+   public:
+
+    /*! \brief Function that is applied to each parsed record
+     */
+    using RecordPostProcessor = void (*)(StringRecord &);
+
+    /*! \brief Construct a parallel parser
+     *
+     * \pre \a settings must be valid
+     */
+    explicit CsvParallelParserTemplate(const CsvParserSettings & settings)
+     : mSettings(settings)
+    {
+      Q_ASSERT(settings.isValid());
+    }
+
+    // Copy disabled
+    CsvParallelParserTemplate(const CsvParallelParserTemplate &) = delete;
+    CsvParallelParserTemplate & operator=(const CsvParallelParserTemplate &) = delete;
+    // Move disabled
+    CsvParallelParserTemplate(CsvParallelParserTemplate &&) = delete;
+    CsvParallelParserTemplate & operator=(CsvParallelParserTemplate &&) = delete;
+
+    /*! \brief Set if a byte source is UTF-8 encoded
+     *
+     * \sa CsvScannerTemplate::setUtf8Source()
+     */
+    void setUtf8Source(bool utf8)
+    {
+      mUtf8Source = utf8;
+    }
+
+    /*! \brief Set a function that is applied to each parsed record
+     *
+     * \a processor will be called from the parsing threads.
+     */
+    void setRecordPostProcessor(RecordPostProcessor processor)
+    {
+      mRecordPostProcessor = processor;
+    }
+
+    /*! \brief Set the minimum size of a chunk
+     *
+     * A source that is smaller than 2 times \a size will not be splitted.
+     *  The default is 64 Ki chars.
+     *
+     * \pre \a size must be > 0
+     */
+    void setMinimumChunkSize(int size)
+    {
+      Q_ASSERT(size > 0);
+      mMinimumChunkSize = size;
+    }
+
+    /*! \brief Read the entire source from \a first to \a last
+     *
+     * \pre \a threadCount must be >= 1
+     */
+    Mdt::Expected<StringRecordList> readAll(const SourceIterator & first, const SourceIterator & last, int threadCount) const
+    {
+      Q_ASSERT(threadCount >= 1);
+
+      if(first == last){
+        return StringRecordList();
+      }
+      const auto boundaries = findChunkBoundaries(first.data(), last.data(), threadCount, mMinimumChunkSize, mSettings.fieldProtection());
+      Q_ASSERT(boundaries.size() >= 2);
+      const int chunkCount = static_cast<int>(boundaries.size()) - 1;
+      std::vector< Mdt::Expected<StringRecordList> > results(chunkCount);
+      std::vector<std::exception_ptr> exceptions(chunkCount);
+      std::vector<std::thread> threads;
+      threads.reserve(chunkCount-1);
+      /*
+       * Destroying a joinable std::thread, or letting a exception
+       * escape a thread function, calls std::terminate().
+       * Started threads are always joined, and exceptions
+       * are rethrown in the calling thread.
+       */
+      try{
+        for(int i = 1; i < chunkCount; ++i){
+          threads.emplace_back([this, &results, &exceptions, &boundaries, i](){
+            try{
+              results[i] = readChunk(boundaries[i], boundaries[i+1]);
+            }catch(...){
+              exceptions[i] = std::current_exception();
+            }
+          });
+        }
+        // The first chunk is parsed by the calling thread
+        results[0] = readChunk(boundaries[0], boundaries[1]);
+      }catch(...){
+        joinThreads(threads);
+        throw;
+      }
+      joinThreads(threads);
+      for(const auto & exception : exceptions){
+        if(exception){
+          std::rethrow_exception(exception);
+        }
+      }
+      // Join results in order
+      StringRecordList recordList;
+      for(const auto & result : results){
+        if(!result){
+          return result.error();
+        }
+        for(const auto & record : *result){
+          recordList.appendRecord(record);
+        }
+      }
+
+      return recordList;
+    }
+
+    /*! \brief Find where to split a source into chunks
+     *
+     * Returns the boundaries of the chunks,
+     *  including \a first and \a last .
+     *  Each boundary, except \a first and \a last ,
+     *  is just after a end of line that is not in a protected field.
+     *
+     * At most \a chunkCount chunks will be returned.
+     *  Less chunks are returned if the source is small,
+     *  regarding \a minimumChunkSize , or has not enough end of lines.
+     */
+    static std::vector<pointer> findChunkBoundaries(pointer first, pointer last, int chunkCount, int minimumChunkSize, char fieldProtection)
+    {
+      Q_ASSERT(first <= last);
+      Q_ASSERT(chunkCount >= 1);
+      Q_ASSERT(minimumChunkSize > 0);
+
+      std::vector<pointer> boundaries;
+      boundaries.push_back(first);
+      const auto size = last - first;
+      chunkCount = static_cast<int>( std::min<decltype(last - first)>(chunkCount, size / minimumChunkSize) );
+      if(chunkCount > 1){
+        const auto chunkSize = size / chunkCount;
+        const auto fp = static_cast<uchar>(fieldProtection);
+        bool inProtectedField = false;
+        pointer it = first;
+        for(int i = 1; i < chunkCount; ++i){
+          const pointer target = first + i * chunkSize;
+          while(it != last){
+            it = Impl::findFirstOf(it, last, fp, fp, fp, '\n');
+            if(it == last){
+              break;
+            }
+            // A escaped field protection simply toggles the state twice
+            if(Impl::charCode(*it) == fp){
+              inProtectedField = !inProtectedField;
+              ++it;
+              continue;
+            }
+            ++it;
+            if( (!inProtectedField) && (it >= target) ){
+              break;
+            }
+          }
+          if(it == last){
+            break;
+          }
+          boundaries.push_back(it);
+        }
+      }
+      boundaries.push_back(last);
+
+      return boundaries;
+    }
+
+   private:
+
+    static void joinThreads(std::vector<std::thread> & threads)
+    {
+      for(auto & thread : threads){
+        if(thread.joinable()){
+          thread.join();
+        }
+      }
+    }
+
+    Mdt::Expected<StringRecordList> readChunk(pointer first, pointer last) const
+    {
+      if(first == last){
+        return StringRecordList();
+      }
+      SourceIterator it(first);
+      const SourceIterator end(last);
+      if(mSettings.parserEngine() == CsvParserSettings::ScannerEngine){
+        CsvScannerTemplate<SourceIterator> parser;
+        parser.setupParser(mSettings);
+        parser.setUtf8Source(mUtf8Source);
+        return readChunk(parser, it, end);
+      }
+      CsvParserTemplate<SourceIterator> parser;
+      parser.setupParser(mSettings);
+      return readChunk(parser, it, end);
+    }
+
+    template<typename Parser>
+    Mdt::Expected<StringRecordList> readChunk(Parser & parser, SourceIterator & it, const SourceIterator & end) const
+    {
+      StringRecordList recordList;
+      while(it != end){
+        auto record = parser.readLine(it, end);
+        if(!record){
+          return record.error();
+        }
+        if(mRecordPostProcessor != nullptr){
+          mRecordPostProcessor(*record);
+        }
+        recordList.appendRecord(*record);
+      }
+      return recordList;
+    }
+
+    CsvParserSettings mSettings;
+    bool mUtf8Source = false;
+    int mMinimumChunkSize = 64*1024;
+    RecordPostProcessor mRecordPostProcessor = nullptr;
+  };
+
+}} // namespace Mdt{ namespace PlainText{
+
+#endif // #ifndef MDT_PLAIN_TEXT_CSV_PARALLEL_PARSER_TEMPLATE_H
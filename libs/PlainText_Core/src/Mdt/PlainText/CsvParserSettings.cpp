@@ -21,6 +21,8 @@
 #include "CsvParserSettings.h"
 #include <QCoreApplication>
 #include <QString>
+#include <QThread>
+#include <algorithm>
 
 #define tr(sourceText) QCoreApplication::translate("MyClass", sourceText)
 
@@ -31,6 +33,46 @@ void CsvParserSettings::setParseExp(bool parse)
   mParseExp = parse;
 }
 
+void CsvParserSettings::setParserEngine(CsvParserSettings::ParserEngine engine)
+{
+  mParserEngine = engine;
+}
+
+void CsvParserSettings::setThreadCount(int count)
+{
+  Q_ASSERT(count >= 0);
+
+  mThreadCount = count;
+}
+
+void CsvParserSettings::setColumnDataTypes(const QVector<QMetaType::Type> & types)
+{
+  mColumnDataTypes = types;
+}
+
+bool CsvParserSettings::isSupportedColumnDataType(QMetaType::Type type)
+{
+  switch(type){
+    case QMetaType::QString:
+    case QMetaType::Int:
+    case QMetaType::LongLong:
+    case QMetaType::Double:
+    case QMetaType::QDate:
+      return true;
+    default:
+      break;
+  }
+  return false;
+}
+
+int CsvParserSettings::effectiveThreadCount() const
+{
+  if(mThreadCount == 0){
+    return std::max(QThread::idealThreadCount(), 1);
+  }
+  return mThreadCount;
+}
+
 bool CsvParserSettings::isValid() const
 {
   // Check basis
@@ -50,6 +92,15 @@ bool CsvParserSettings::isValid() const
     setLastError(error);
     return false;
   }
+  // Check column data types
+  for(const auto type : mColumnDataTypes){
+    if(!isSupportedColumnDataType(type)){
+      const auto msg = tr("Column data type '%1' is not supported.").arg(QString::fromLatin1(QMetaType::typeName(type)));
+      auto error = mdtErrorNew(msg, Mdt::Error::Warning, "CsvParserSettings");
+      setLastError(error);
+      return false;
+    }
+  }
   // Seems OK
   return true;
 }
@@ -58,6 +109,9 @@ void CsvParserSettings::clear()
 {
   CsvCommonSettings::clear();
   mParseExp = true;
+  mParserEngine = SpiritEngine;
+  mThreadCount = 1;
+  mColumnDataTypes.clear();
 }
 
 }} // namespace Mdt{ namespace PlainText{
@@ -23,6 +23,7 @@
 
 #include "CsvCommonSettings.h"
 #include <QMetaType>
+#include <QVector>
 
 namespace Mdt{ namespace PlainText{
 
@@ -32,11 +33,30 @@ namespace Mdt{ namespace PlainText{
   {
    public:
 
+    /*! \brief Parser engine
+     */
+    enum ParserEngine
+    {
+      SpiritEngine,   /*!< Parser based on a Boost.Spirit grammar.
+                           Works with all sources. This is the default. */
+      ScannerEngine   /*!< Hand written parser that searches field separators,
+                           field protections and end of lines by blocks of chars,
+                           using SIMD instructions when available.
+                           It only acts on contiguous sources (CsvStringParser
+                           and CsvFileParser in CsvFileParser::MemoryMappedInput mode).
+                           For other sources, SpiritEngine is used.
+                           Compared to SpiritEngine, a tab char is a ordinary char
+                           in a unprotected field, and a field protection
+                           inside a unprotected field is reported as a error. */
+    };
+
     /*! \brief Construct default settings
      */
     CsvParserSettings()
      : CsvCommonSettings(),
-       mParseExp(true)
+       mParseExp(true),
+       mParserEngine(SpiritEngine),
+       mThreadCount(1)
     {
     }
 
@@ -81,6 +101,110 @@ namespace Mdt{ namespace PlainText{
       return mParseExp;
     }
 
+    /*! \brief Set parser engine
+     *
+     * \sa parserEngine()
+     */
+    void setParserEngine(ParserEngine engine);
+
+    /*! \brief Get parser engine
+     *
+     * \sa setParserEngine()
+     */
+    ParserEngine parserEngine() const
+    {
+      return mParserEngine;
+    }
+
+    /*! \brief Set the count of threads used by readAll()
+     *
+     * \pre \a count must be >= 0
+     * \sa threadCount()
+     */
+    void setThreadCount(int count);
+
+    /*! \brief Get the count of threads used by readAll()
+     *
+     * When parsing a entire source,
+     *  it can be splitted into chunks of records,
+     *  witch are parsed in parallel.
+     *  The records are then returned in the order they appear in the source.
+     *
+     * The default is 1 (no parallel parsing).
+     *  A value of 0 means that QThread::idealThreadCount() is used.
+     *
+     * Parallel parsing requires a contiguous source (CsvStringParser
+     *  and CsvFileParser in CsvFileParser::MemoryMappedInput mode).
+     *  For other sources, this setting is ignored.
+     *
+     * \sa setThreadCount()
+     * \sa effectiveThreadCount()
+     */
+    int threadCount() const
+    {
+      return mThreadCount;
+    }
+
+    /*! \brief Get the count of threads that readAll() will use
+     *
+     * Returns QThread::idealThreadCount() if threadCount() is 0,
+     *  otherwise threadCount().
+     */
+    int effectiveThreadCount() const;
+
+    /*! \brief Set the data type of each column
+     *
+     * \sa columnDataTypes()
+     */
+    void setColumnDataTypes(const QVector<QMetaType::Type> & types);
+
+    /*! \brief Get the data type of each column
+     *
+     * The column data types are only used when reading typed records,
+     *  for example with CsvFileParser::readAllTyped().
+     *  Each field is then converted to the data type of its column
+     *  and stored in a Record.
+     *
+     * Supported data types are:
+     *  \li QMetaType::QString
+     *  \li QMetaType::Int
+     *  \li QMetaType::LongLong
+     *  \li QMetaType::Double : the decimal point is a dot,
+     *       a exponent can be given (for example 1.5e-3)
+     *  \li QMetaType::QDate : the date must be in ISO 8601 format (yyyy-MM-dd)
+     *
+     * A empty field is converted to a null QVariant of the column data type.
+     *  Columns for witch no type is given are of type QMetaType::QString .
+     *
+     * By default, no column data type is set.
+     *
+     * \sa setColumnDataTypes()
+     * \sa columnDataType()
+     */
+    QVector<QMetaType::Type> columnDataTypes() const
+    {
+      return mColumnDataTypes;
+    }
+
+    /*! \brief Get the data type of \a column
+     *
+     * Returns QMetaType::QString if no type was set for \a column .
+     *
+     * \pre \a column must be >= 0
+     * \sa columnDataTypes()
+     */
+    QMetaType::Type columnDataType(int column) const
+    {
+      Q_ASSERT(column >= 0);
+      return mColumnDataTypes.value(column, QMetaType::QString);
+    }
+
+    /*! \brief Check if \a type is a supported column data type
+     *
+     * \sa columnDataTypes()
+     */
+    static bool isSupportedColumnDataType(QMetaType::Type type);
+
     /*! \brief Check if settings are valid
      *
      * If this settings is not valid,
@@ -97,6 +221,9 @@ namespace Mdt{ namespace PlainText{
    private:
 
     bool mParseExp;
+    ParserEngine mParserEngine;
+    int mThreadCount;
+    QVector<QMetaType::Type> mColumnDataTypes;
   };
 
 }} // namespace Mdt{ namespace PlainText{
@@ -0,0 +1,369 @@
+/****************************************************************************
+ **
+ ** Copyright (C) 2011-2017 Philippe Steinmann.
+ **
+ ** This file is part of multiDiagTools library.
+ **
+ ** multiDiagTools is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Lesser General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** multiDiagTools is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public License
+ ** along with multiDiagTools.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+#include "CsvRowIndex.h"
+#include "CharSearch.h"
+#include <QFile>
+#include <QDir>
+#include <QDateTime>
+#include <QDataStream>
+#include <QTextCodec>
+#include <QCoreApplication>
+#include <algorithm>
+
+#define tr(sourceText) QCoreApplication::translate("CsvRowIndex", sourceText)
+
+namespace Mdt{ namespace PlainText{
+
+namespace Impl{
+
+const uchar *CsvRecordStartScanner::findNextRecordStart(const uchar *first, const uchar *last)
+{
+  Q_ASSERT(first <= last);
+
+  while(first < last){
+    if(mInProtection){
+      // A doubled field protection leaves, then enters again the protected state
+      first = findFirstOf(first, last, mFieldProtection, mFieldProtection, mFieldProtection, mFieldProtection);
+      if(first == last){
+        return nullptr;
+      }
+      mInProtection = false;
+    }else{
+      first = findFirstOf(first, last, '\n', mFieldProtection, mFieldProtection, mFieldProtection);
+      if(first == last){
+        return nullptr;
+      }
+      if(*first == '\n'){
+        return first + 1;
+      }
+      mInProtection = true;
+    }
+    ++first;
+  }
+
+  return nullptr;
+}
+
+} // namespace Impl{
+
+namespace{
+
+  /*
+   * Sidecar file format
+   */
+  const quint32 sidecarMagic = 0x4D435249; // "MCRI"
+  const quint32 sidecarVersion = 1;
+
+  /*
+   * Size of the chunks read while building a index
+   */
+  const qint64 buildChunkSize = 4 * 1024 * 1024;
+
+} // namespace{
+
+CsvRowIndex::~CsvRowIndex()
+{
+  cancel();
+  joinBuildThread();
+}
+
+void CsvRowIndex::setCsvSettings(const CsvParserSettings & settings)
+{
+  Q_ASSERT(settings.isValid());
+  Q_ASSERT(isFinished());
+
+  mFieldProtection = settings.fieldProtection();
+}
+
+void CsvRowIndex::setIndexInterval(int interval)
+{
+  Q_ASSERT(interval > 0);
+  Q_ASSERT(isFinished());
+
+  mIndexInterval = interval;
+}
+
+bool CsvRowIndex::build(const QFileInfo & fileInfo, const QByteArray & encoding)
+{
+  Q_ASSERT(isFinished());
+
+  joinBuildThread();
+  mCancelRequested.store(false);
+  mBuildResult = buildIndex(fileInfo, encoding);
+
+  return mBuildResult;
+}
+
+void CsvRowIndex::startBuild(const QFileInfo & fileInfo, const QByteArray & encoding)
+{
+  Q_ASSERT(isFinished());
+
+  joinBuildThread();
+  mCancelRequested.store(false);
+  mBuildRunning.store(true);
+  mBuildThread = std::thread([this, fileInfo, encoding](){
+    mBuildResult = buildIndex(fileInfo, encoding);
+    mBuildRunning.store(false);
+  });
+}
+
+bool CsvRowIndex::waitForFinished()
+{
+  joinBuildThread();
+
+  return mBuildResult;
+}
+
+void CsvRowIndex::cancel()
+{
+  mCancelRequested.store(true);
+}
+
+CsvRowIndex::Position CsvRowIndex::nearestPosition(qint64 row) const
+{
+  Q_ASSERT(row >= 0);
+  Q_ASSERT(row < mRowCount);
+
+  const qint64 i = row / mIndexInterval;
+  Q_ASSERT(i < mOffsets.size());
+  Position position;
+  position.row = i * mIndexInterval;
+  position.offset = mOffsets.at(static_cast<int>(i));
+
+  return position;
+}
+
+void CsvRowIndex::clear()
+{
+  Q_ASSERT(isFinished());
+
+  mRowCount = 0;
+  mFileSize = 0;
+  mFileLastModified = 0;
+  mOffsets.clear();
+  mIndexedByteCount.store(0);
+}
+
+bool CsvRowIndex::save(const QString & filePath) const
+{
+  Q_ASSERT(isFinished());
+
+  QFile file(filePath);
+  if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate)){
+    const QFileInfo fileInfo(filePath);
+    const auto msg = tr("Could not open file '%1'\nDirectory: '%2'").arg(fileInfo.fileName(), fileInfo.dir().absolutePath());
+    mLastError = mdtErrorNew(msg, Mdt::Error::Critical, "CsvRowIndex");
+    mLastError.stackError(mdtErrorFromQFile(file, "CsvRowIndex"));
+    mLastError.commit();
+    return false;
+  }
+  QDataStream stream(&file);
+  stream.setVersion(QDataStream::Qt_5_0);
+  stream << sidecarMagic << sidecarVersion
+         << mFileSize << mFileLastModified
+         << static_cast<qint8>(mFieldProtection) << static_cast<qint32>(mIndexInterval)
+         << mRowCount << mOffsets;
+  if(stream.status() != QDataStream::Ok){
+    const QFileInfo fileInfo(filePath);
+    const auto msg = tr("Could not write to file '%1'\nDirectory: '%2'").arg(fileInfo.fileName(), fileInfo.dir().absolutePath());
+    mLastError = mdtErrorNew(msg, Mdt::Error::Critical, "CsvRowIndex");
+    mLastError.stackError(mdtErrorFromQFile(file, "CsvRowIndex"));
+    mLastError.commit();
+    return false;
+  }
+
+  return true;
+}
+
+bool CsvRowIndex::load(const QString & filePath, const QFileInfo & csvFileInfo)
+{
+  Q_ASSERT(isFinished());
+
+  clear();
+  QFile file(filePath);
+  const QFileInfo fileInfo(filePath);
+  if(!file.open(QIODevice::ReadOnly)){
+    const auto msg = tr("Could not open file '%1'\nDirectory: '%2'").arg(fileInfo.fileName(), fileInfo.dir().absolutePath());
+    mLastError = mdtErrorNew(msg, Mdt::Error::Critical, "CsvRowIndex");
+    mLastError.stackError(mdtErrorFromQFile(file, "CsvRowIndex"));
+    mLastError.commit();
+    return false;
+  }
+  QDataStream stream(&file);
+  stream.setVersion(QDataStream::Qt_5_0);
+  quint32 magic = 0;
+  quint32 version = 0;
+  qint64 fileSize = 0;
+  qint64 fileLastModified = 0;
+  qint8 fieldProtection = 0;
+  qint32 indexInterval = 0;
+  qint64 rowCount = 0;
+  QVector<qint64> offsets;
+  stream >> magic >> version;
+  if( (stream.status() != QDataStream::Ok) || (magic != sidecarMagic) || (version != sidecarVersion) ){
+    const auto msg = tr("File '%1' is not a CSV row index, or was written by a unsupported version\nDirectory: '%2'")
+                     .arg(fileInfo.fileName(), fileInfo.dir().absolutePath());
+    mLastError = mdtErrorNew(msg, Mdt::Error::Critical, "CsvRowIndex");
+    mLastError.commit();
+    return false;
+  }
+  stream >> fileSize >> fileLastModified >> fieldProtection >> indexInterval >> rowCount >> offsets;
+  const qint64 expectedOffsetCount = (rowCount + indexInterval - 1) / std::max(indexInterval, 1);
+  if( (stream.status() != QDataStream::Ok) || (indexInterval < 1) || (rowCount < 0) || (offsets.size() != expectedOffsetCount) ){
+    const auto msg = tr("CSV row index file '%1' is corrupted\nDirectory: '%2'").arg(fileInfo.fileName(), fileInfo.dir().absolutePath());
+    mLastError = mdtErrorNew(msg, Mdt::Error::Critical, "CsvRowIndex");
+    mLastError.commit();
+    return false;
+  }
+  // Check that the index matches the CSV file and the current settings
+  QFileInfo csvInfo(csvFileInfo);
+  csvInfo.refresh();
+  if( (csvInfo.size() != fileSize) || (csvInfo.lastModified().toMSecsSinceEpoch() != fileLastModified) ){
+    const auto msg = tr("CSV row index file '%1' is outdated: CSV file '%2' was modified after the index was built")
+                     .arg(fileInfo.fileName(), csvInfo.fileName());
+    mLastError = mdtErrorNew(msg, Mdt::Error::Warning, "CsvRowIndex");
+    mLastError.commit();
+    return false;
+  }
+  if( (static_cast<char>(fieldProtection) != mFieldProtection) || (indexInterval != mIndexInterval) ){
+    const auto msg = tr("CSV row index file '%1' was built with other settings")
+                     .arg(fileInfo.fileName());
+    mLastError = mdtErrorNew(msg, Mdt::Error::Warning, "CsvRowIndex");
+    mLastError.commit();
+    return false;
+  }
+  mFileSize = fileSize;
+  mFileLastModified = fileLastModified;
+  mRowCount = rowCount;
+  mOffsets = offsets;
+  mIndexedByteCount.store(fileSize);
+
+  return true;
+}
+
+QString CsvRowIndex::sidecarFilePath(const QFileInfo & csvFileInfo)
+{
+  return csvFileInfo.absoluteFilePath() + QLatin1String(".idx");
+}
+
+bool CsvRowIndex::buildIndex(const QFileInfo & fileInfo, const QByteArray & encoding)
+{
+  mRowCount = 0;
+  mFileSize = 0;
+  mFileLastModified = 0;
+  mOffsets.clear();
+  mIndexedByteCount.store(0);
+  // Only encodings in witch special chars are single bytes are supported
+  auto *codec = QTextCodec::codecForName(encoding);
+  if(codec == nullptr){
+    const auto msg = tr("Could not find a codec for encoding '%1'").arg(QString::fromLatin1(encoding));
+    mLastError = mdtErrorNew(msg, Mdt::Error::Critical, "CsvRowIndex");
+    mLastError.commit();
+    return false;
+  }
+  const int mib = codec->mibEnum();
+  if( (mib != 106) && (mib != 4) ){
+    const auto msg = tr("Encoding '%1' is not supported to index a CSV file (supported: UTF-8 and ISO-8859-1)").arg(QString::fromLatin1(encoding));
+    mLastError = mdtErrorNew(msg, Mdt::Error::Critical, "CsvRowIndex");
+    mLastError.commit();
+    return false;
+  }
+  // Open file
+  QFile file(fileInfo.absoluteFilePath());
+  if(!file.open(QIODevice::ReadOnly)){
+    const auto msg = tr("Could not open file '%1'\nDirectory: '%2'").arg(fileInfo.fileName(), fileInfo.dir().absolutePath());
+    mLastError = mdtErrorNew(msg, Mdt::Error::Critical, "CsvRowIndex");
+    mLastError.stackError(mdtErrorFromQFile(file, "CsvRowIndex"));
+    mLastError.commit();
+    return false;
+  }
+  QFileInfo info(fileInfo);
+  info.refresh();
+  const qint64 fileSize = file.size();
+  const qint64 fileLastModified = info.lastModified().toMSecsSinceEpoch();
+  // Scan the file
+  Impl::CsvRecordStartScanner scanner(mFieldProtection);
+  QByteArray buffer;
+  buffer.resize(static_cast<int>(std::min(buildChunkSize, std::max(fileSize, qint64(1)))));
+  qint64 chunkOffset = 0;
+  qint64 rowCount = 0;
+  QVector<qint64> offsets;
+  bool firstChunk = true;
+  while(chunkOffset < fileSize){
+    if(mCancelRequested.load()){
+      const auto msg = tr("Indexing of file '%1' was cancelled").arg(fileInfo.fileName());
+      mLastError = mdtErrorNew(msg, Mdt::Error::Info, "CsvRowIndex");
+      mLastError.commit();
+      return false;
+    }
+    const qint64 n = file.read(buffer.data(), buffer.size());
+    if(n <= 0){
+      const auto msg = tr("Could not read file '%1'\nDirectory: '%2'").arg(fileInfo.fileName(), fileInfo.dir().absolutePath());
+      mLastError = mdtErrorNew(msg, Mdt::Error::Critical, "CsvRowIndex");
+      mLastError.stackError(mdtErrorFromQFile(file, "CsvRowIndex"));
+      mLastError.commit();
+      return false;
+    }
+    const auto *chunkBegin = reinterpret_cast<const uchar*>(buffer.constData());
+    const auto *chunkEnd = chunkBegin + n;
+    const auto *it = chunkBegin;
+    if(firstChunk){
+      firstChunk = false;
+      // The first record starts after the possible BOM
+      if( (mib == 106) && (n >= 3) && (it[0] == 0xEF) && (it[1] == 0xBB) && (it[2] == 0xBF) ){
+        it += 3;
+      }
+      const qint64 offset = it - chunkBegin;
+      if(offset < fileSize){
+        offsets.append(offset);
+        ++rowCount;
+      }
+    }
+    while( (it = scanner.findNextRecordStart(it, chunkEnd)) != nullptr ){
+      const qint64 offset = chunkOffset + (it - chunkBegin);
+      // A end of line at the end of the file does not start a new record
+      if(offset >= fileSize){
+        break;
+      }
+      if( (rowCount % mIndexInterval) == 0 ){
+        offsets.append(offset);
+      }
+      ++rowCount;
+    }
+    chunkOffset += n;
+    mIndexedByteCount.store(chunkOffset);
+  }
+  mFileSize = fileSize;
+  mFileLastModified = fileLastModified;
+  mRowCount = rowCount;
+  mOffsets = offsets;
+
+  return true;
+}
+
+void CsvRowIndex::joinBuildThread()
+{
+  if(mBuildThread.joinable()){
+    mBuildThread.join();
+  }
+}
+
+}} // namespace Mdt{ namespace PlainText{
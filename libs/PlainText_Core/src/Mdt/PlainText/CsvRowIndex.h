@@ -0,0 +1,310 @@
+/****************************************************************************
+ **
+ ** Copyright (C) 2011-2017 Philippe Steinmann.
+ **
+ ** This file is part of multiDiagTools library.
+ **
+ ** multiDiagTools is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Lesser General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** multiDiagTools is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public License
+ ** along with multiDiagTools.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+#ifndef MDT_PLAIN_TEXT_CSV_ROW_INDEX_H
+#define MDT_PLAIN_TEXT_CSV_ROW_INDEX_H
+
+#include "CsvParserSettings.h"
+#include "Mdt/Error.h"
+#include <QString>
+#include <QByteArray>
+#include <QFileInfo>
+#include <QVector>
+#include <QtGlobal>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+namespace Mdt{ namespace PlainText{
+
+  namespace Impl{
+
+    /*! \internal Finds the start of records in a CSV byte source
+     *
+     * Field protections are tracked,
+     *  so that a end of line inside a protected field
+     *  is not seen as the end of a record.
+     *  The state is keeped between calls,
+     *  so the source can be scanned chunk by chunk.
+     */
+    class CsvRecordStartScanner
+    {
+     public:
+
+      /*! \internal Construct a scanner
+       */
+      explicit CsvRecordStartScanner(char fieldProtection)
+       : mFieldProtection(static_cast<uchar>(fieldProtection))
+      {
+      }
+
+      /*! \internal Find the start of the next record in [\a first, \a last)
+       *
+       * Returns a pointer to the byte that follows the next end of line
+       *  that is not in a protected field (this can be \a last),
+       *  or nullptr if no such end of line exists in [\a first, \a last) .
+       */
+      const uchar *findNextRecordStart(const uchar *first, const uchar *last);
+
+     private:
+
+      uchar mFieldProtection;
+      bool mInProtection = false;
+    };
+
+  } // namespace Impl{
+
+  /*! \brief Sparse index of the records of a CSV file
+   *
+   * A CSV file can be indexed once,
+   *  so that a CsvFileParser can jump to any record
+   *  without parsing the file from its beginning:
+   * \code
+   * CsvRowIndex index;
+   * index.setCsvSettings(settings);
+   * if(!index.build(fileInfo, "UTF-8")){
+   *   // Error handling
+   * }
+   * CsvFileParser parser;
+   * parser.setCsvSettings(settings);
+   * parser.openFile(fileInfo, "UTF-8");
+   * if(!parser.seekToRow(index, 1000000)){
+   *   // Error handling
+   * }
+   * const auto record = parser.readLine();
+   * \endcode
+   *
+   * The index stores the byte offset of one record
+   *  every indexInterval() records.
+   *  Seeking to a record that is not indexed
+   *  starts from the nearest indexed record before it
+   *  and skips the records in between, without parsing them.
+   *
+   * Indexing is done in one pass on the raw bytes of the file.
+   *  Only encodings for witch all chars that have a special meaning
+   *  for the parser are single bytes are supported (UTF-8 and Latin-1).
+   *  A end of line is a LF, optionally preceded by a CR.
+   *
+   * Building the index of a big file can take some time,
+   *  so it can be done in a background thread (see startBuild()),
+   *  and saved to a sidecar file (see save() and load()).
+   */
+  class CsvRowIndex
+  {
+   public:
+
+    /*! \brief Position of a indexed record
+     */
+    struct Position
+    {
+      qint64 row = 0;     /*!< Index of the record (0 is the first one) */
+      qint64 offset = 0;  /*!< Offset, in bytes, of the record in the file */
+    };
+
+    /*! \brief Construct a empty index
+     */
+    CsvRowIndex() = default;
+
+    /*! \brief Destructor
+     *
+     * If a background build is running, it is cancelled.
+     */
+    ~CsvRowIndex();
+
+    // Copy disabled
+    CsvRowIndex(const CsvRowIndex &) = delete;
+    CsvRowIndex & operator=(const CsvRowIndex &) = delete;
+    // Move disabled
+    CsvRowIndex(CsvRowIndex &&) = delete;
+    CsvRowIndex & operator=(CsvRowIndex &&) = delete;
+
+    /*! \brief Set CSV settings
+     *
+     * Only the field protection is used by the index.
+     *
+     * \pre \a settings must be valid
+     * \pre No build must be running
+     */
+    void setCsvSettings(const CsvParserSettings & settings);
+
+    /*! \brief Get the field protection used by this index
+     */
+    char fieldProtection() const
+    {
+      return mFieldProtection;
+    }
+
+    /*! \brief Set the count of records between 2 indexed records
+     *
+     * A smaller interval makes seeking faster,
+     *  but the index takes more memory.
+     *  The default is 1024 .
+     *
+     * \pre \a interval must be > 0
+     * \pre No build must be running
+     */
+    void setIndexInterval(int interval);
+
+    /*! \brief Get the count of records between 2 indexed records
+     */
+    int indexInterval() const
+    {
+      return mIndexInterval;
+    }
+
+    /*! \brief Build the index of a CSV file
+     *
+     * Returns false if the file could not be read,
+     *  \a encoding is not supported, or the build was cancelled.
+     *
+     * \pre No build must be running
+     */
+    bool build(const QFileInfo & fileInfo, const QByteArray & encoding);
+
+    /*! \brief Start building the index of a CSV file in a background thread
+     *
+     * Use isFinished() or waitForFinished() to know when the index is ready.
+     *  Other functions, except indexedByteCount() and cancel(),
+     *  must not be called until the build is finished.
+     *
+     * \pre No build must be running
+     * \sa build()
+     */
+    void startBuild(const QFileInfo & fileInfo, const QByteArray & encoding);
+
+    /*! \brief Check if a background build is finished
+     *
+     * Also returns true if no build was started.
+     */
+    bool isFinished() const
+    {
+      return !mBuildRunning.load();
+    }
+
+    /*! \brief Wait until a background build is finished
+     *
+     * Returns the result of the build.
+     */
+    bool waitForFinished();
+
+    /*! \brief Cancel a running background build
+     *
+     * The build will finish as soon as possible
+     *  and waitForFinished() will return false.
+     */
+    void cancel();
+
+    /*! \brief Get the count of bytes that have been indexed
+     *
+     * Can be called during a background build to get its progress.
+     */
+    qint64 indexedByteCount() const
+    {
+      return mIndexedByteCount.load();
+    }
+
+    /*! \brief Check if this index is empty
+     *
+     * An index is empty if it was never built,
+     *  or the indexed file contains no record.
+     */
+    bool isEmpty() const
+    {
+      return (mRowCount == 0);
+    }
+
+    /*! \brief Get the count of records in the indexed file
+     */
+    qint64 rowCount() const
+    {
+      return mRowCount;
+    }
+
+    /*! \brief Get the size, in bytes, of the indexed file
+     */
+    qint64 fileSize() const
+    {
+      return mFileSize;
+    }
+
+    /*! \brief Get the nearest indexed position at or before \a row
+     *
+     * \pre \a row must be in valid range ( 0 <= \a row < rowCount() )
+     */
+    Position nearestPosition(qint64 row) const;
+
+    /*! \brief Clear
+     *
+     * \pre No build must be running
+     */
+    void clear();
+
+    /*! \brief Save this index to \a filePath
+     *
+     * \sa sidecarFilePath()
+     */
+    bool save(const QString & filePath) const;
+
+    /*! \brief Load a index from \a filePath
+     *
+     * The loaded index is checked against \a csvFileInfo :
+     *  if the CSV file was modified after the index was built,
+     *  or the index was built with other settings than the current ones,
+     *  false is returned and this index is cleared.
+     *
+     * \pre No build must be running
+     */
+    bool load(const QString & filePath, const QFileInfo & csvFileInfo);
+
+    /*! \brief Get the default path of the sidecar index file of \a csvFileInfo
+     *
+     * This is the path of the CSV file with .idx appended.
+     */
+    static QString sidecarFilePath(const QFileInfo & csvFileInfo);
+
+    /*! \brief Get last error
+     */
+    Mdt::Error lastError() const
+    {
+      return mLastError;
+    }
+
+   private:
+
+    bool buildIndex(const QFileInfo & fileInfo, const QByteArray & encoding);
+    void joinBuildThread();
+
+    char mFieldProtection = '\"';
+    int mIndexInterval = 1024;
+    qint64 mRowCount = 0;
+    qint64 mFileSize = 0;
+    qint64 mFileLastModified = 0;
+    QVector<qint64> mOffsets;
+    std::atomic<bool> mBuildRunning{false};
+    std::atomic<bool> mCancelRequested{false};
+    std::atomic<qint64> mIndexedByteCount{0};
+    bool mBuildResult = false;
+    std::thread mBuildThread;
+    mutable Mdt::Error mLastError;
+  };
+
+}} // namespace Mdt{ namespace PlainText{
+
+#endif // #ifndef MDT_PLAIN_TEXT_CSV_ROW_INDEX_H
@@ -0,0 +1,371 @@
+/****************************************************************************
+ **
+ ** Copyright (C) 2011-2017 Philippe Steinmann.
+ **
+ ** This file is part of multiDiagTools library.
+ **
+ ** multiDiagTools is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Lesser General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** multiDiagTools is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public License
+ ** along with multiDiagTools.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+#ifndef MDT_PLAIN_TEXT_CSV_SCANNER_TEMPLATE_H
+#define MDT_PLAIN_TEXT_CSV_SCANNER_TEMPLATE_H
+
+#include "CsvParserSettings.h"
+#include "StringRecord.h"
+#include "Record.h"
+#include "CharSearch.h"
+#include "FieldConversion.h"
+#include "Mdt/Error.h"
+#include "Mdt/Expected.h"
+#include <QCoreApplication>
+#include <QChar>
+#include <QString>
+#include <QVariant>
+#include <QVector>
+#include <QMetaType>
+#include <QtGlobal>
+
+namespace Mdt{ namespace PlainText{
+
+  /*! \brief Hand written CSV parser template
+   *
+   * This class implements CsvParserSettings::ScannerEngine .
+   *
+   * Instead of dispatching each char through a grammar,
+   *  the scanner searches the next char that has a special meaning
+   *  (field separator, field protection, end of line)
+   *  by blocks of chars (see Impl::findFirstOf()),
+   *  and builds each field directly from the source buffer.
+   *
+   * It offers the same readLine() API than CsvParserTemplate,
+   *  but can only act on contiguous sources.
+   *
+   * readTypedLine() converts each field to the data type of its column
+   *  (see CsvParserSettings::columnDataTypes()) directly from the source buffer.
+   *
+   * \tparam SourceIterator Type of iterator that will act on the source.
+   *      It must provide a data() function that returns
+   *      a pointer to a QChar (like StringConstIterator)
+   *      or to a uchar (like ByteConstIterator),
+   *      and must be constructible from such a pointer.
+   *
+   * \sa CsvStringParser
+   * \sa CsvFileParser
+   */
+  template <typename SourceIterator>
+  class CsvScannerTemplate
+  {
+    using pointer = decltype( SourceIterator().data() );
+
+   public:
+
+    /*! \brief Default constructor
+     */
+    CsvScannerTemplate() = default;
+
+    // Copy disabled
+    CsvScannerTemplate(const CsvScannerTemplate &) = delete;
+    CsvScannerTemplate & operator=(const CsvScannerTemplate &) = delete;
+    // Move disabled
+    CsvScannerTemplate(CsvScannerTemplate &&) = delete;
+    CsvScannerTemplate & operator=(CsvScannerTemplate &&) = delete;
+
+    /*! \brief Setup parser
+     *
+     * \pre \a settings must be valid
+     */
+    void setupParser(const CsvParserSettings & settings)
+    {
+      Q_ASSERT(settings.isValid());
+
+      mFieldSeparator = static_cast<uchar>(settings.fieldSeparator());
+      mFieldProtection = static_cast<uchar>(settings.fieldProtection());
+      mParseExp = settings.parseExp();
+      mColumnDataTypes = settings.columnDataTypes();
+      mIsValid = true;
+    }
+
+    /*! \brief Check if parser is valid
+     *
+     * Parser is valid once setupParser() was called at least once
+     */
+    bool isValid() const
+    {
+      return mIsValid;
+    }
+
+    /*! \brief Set if a byte source is UTF-8 encoded
+     *
+     * Only has effect when the source is made of bytes.
+     *  If \a utf8 is true, each field is decoded from UTF-8,
+     *  otherwise from Latin-1 (witch is the default).
+     */
+    void setUtf8Source(bool utf8)
+    {
+      mUtf8Source = utf8;
+    }
+
+    /*! \brief Read one line of CSV data
+     *
+     * \pre setupParser() must be called at least once before
+     */
+    Mdt::Expected<StringRecord> readLine(SourceIterator & first, const SourceIterator & last)
+    {
+      Q_ASSERT(first != last);
+      Q_ASSERT_X(isValid(), "CsvScannerTemplate", "parser setup never done");
+
+      StringRecordBuilder builder(*this);
+      if(!scanLine(first, last, builder)){
+        return builder.error;
+      }
+
+      return builder.record;
+    }
+
+    /*! \brief Read one line of CSV data as a typed record
+     *
+     * Each field is converted to CsvParserSettings::columnDataType()
+     *  directly from the source buffer.
+     *
+     * \pre setupParser() must be called at least once before
+     */
+    Mdt::Expected<Record> readTypedLine(SourceIterator & first, const SourceIterator & last)
+    {
+      Q_ASSERT(first != last);
+      Q_ASSERT_X(isValid(), "CsvScannerTemplate", "parser setup never done");
+
+      TypedRecordBuilder builder(*this);
+      if(!scanLine(first, last, builder)){
+        return builder.error;
+      }
+
+      return builder.record;
+    }
+
+   private:
+
+    /*
+     * A builder receives each field of a line,
+     * either as a range of the source, when it contains no escaped field protection,
+     * or as a QString.
+     */
+
+    struct StringRecordBuilder
+    {
+      explicit StringRecordBuilder(const CsvScannerTemplate & scanner)
+       : scanner(scanner)
+      {
+      }
+
+      bool addField(int, pointer first, pointer last)
+      {
+        QString field;
+        scanner.appendToField(field, first, last);
+        record.push_back(field);
+        return true;
+      }
+
+      bool addField(int, const QString & field)
+      {
+        record.push_back(field);
+        return true;
+      }
+
+      const CsvScannerTemplate & scanner;
+      StringRecord record;
+      Mdt::Error error;
+    };
+
+    struct TypedRecordBuilder
+    {
+      explicit TypedRecordBuilder(const CsvScannerTemplate & scanner)
+       : scanner(scanner)
+      {
+      }
+
+      bool addField(int column, pointer first, pointer last)
+      {
+        const auto type = scanner.mColumnDataTypes.value(column, QMetaType::QString);
+        if(type == QMetaType::QString){
+          QString field;
+          scanner.appendToField(field, first, last);
+          record.push_back(field);
+          return true;
+        }
+        QVariant value;
+        if(!Impl::convertField(first, last, type, value)){
+          QString field;
+          scanner.appendToField(field, first, last);
+          error = Impl::fieldConversionError(field, column, type);
+          return false;
+        }
+        record.push_back(value);
+        return true;
+      }
+
+      bool addField(int column, const QString & field)
+      {
+        const auto type = scanner.mColumnDataTypes.value(column, QMetaType::QString);
+        if(type == QMetaType::QString){
+          record.push_back(field);
+          return true;
+        }
+        QVariant value;
+        if(!Impl::convertField(field.constData(), field.constData() + field.size(), type, value)){
+          error = Impl::fieldConversionError(field, column, type);
+          return false;
+        }
+        record.push_back(value);
+        return true;
+      }
+
+      const CsvScannerTemplate & scanner;
+      Record record;
+      Mdt::Error error;
+    };
+
+    /*
+     * Scan one line and pass each field to builder.
+     * On error, builder.error is set, first is set to last and false is returned.
+     */
+    template<typename RecordBuilder>
+    bool scanLine(SourceIterator & first, const SourceIterator & last, RecordBuilder & builder) const
+    {
+      pointer it = first.data();
+      const pointer end = last.data();
+      int column = 0;
+
+      while(true){
+        if( (it != end) && (Impl::charCode(*it) == mFieldProtection) ){
+          // Protected field
+          ++it;
+          if( mParseExp && (it != end) && (Impl::charCode(*it) == '~') ){
+            ++it;
+          }
+          const pointer fieldBegin = it;
+          pointer quote = Impl::findFirstOf(it, end, mFieldProtection, mFieldProtection, mFieldProtection, mFieldProtection);
+          if(quote == end){
+            first = last;
+            builder.error = parseError();
+            return false;
+          }
+          it = quote + 1;
+          if( (it == end) || (Impl::charCode(*it) != mFieldProtection) ){
+            // No escaped field protection: the field is a range of the source
+            if(!builder.addField(column, fieldBegin, quote)){
+              first = last;
+              return false;
+            }
+          }else{
+            // A doubled field protection is a escaped one
+            QString field;
+            appendToField(field, fieldBegin, quote);
+            field.append(QChar(mFieldProtection));
+            ++it;
+            while(true){
+              quote = Impl::findFirstOf(it, end, mFieldProtection, mFieldProtection, mFieldProtection, mFieldProtection);
+              if(quote == end){
+                first = last;
+                builder.error = parseError();
+                return false;
+              }
+              appendToField(field, it, quote);
+              it = quote + 1;
+              if( (it != end) && (Impl::charCode(*it) == mFieldProtection) ){
+                field.append(QChar(mFieldProtection));
+                ++it;
+              }else{
+                break;
+              }
+            }
+            if(!builder.addField(column, field)){
+              first = last;
+              return false;
+            }
+          }
+        }else{
+          // Unprotected field
+          if( mParseExp && (it != end) && (Impl::charCode(*it) == '~') ){
+            ++it;
+          }
+          const pointer fieldEnd = Impl::findFirstOf(it, end, mFieldSeparator, mFieldProtection, '\r', '\n');
+          if(!builder.addField(column, it, fieldEnd)){
+            first = last;
+            return false;
+          }
+          it = fieldEnd;
+        }
+        ++column;
+        // Field separator, end of line or end of source is expected now
+        if(it == end){
+          break;
+        }
+        const ushort c = Impl::charCode(*it);
+        if(c == mFieldSeparator){
+          ++it;
+          continue;
+        }
+        if(c == '\r'){
+          ++it;
+          if( (it != end) && (Impl::charCode(*it) == '\n') ){
+            ++it;
+          }
+          break;
+        }
+        if(c == '\n'){
+          ++it;
+          break;
+        }
+        first = last;
+        builder.error = parseError();
+        return false;
+      }
+      first = SourceIterator(it);
+
+      return true;
+    }
+
+    void appendToField(QString & field, const QChar *first, const QChar *last) const
+    {
+      field.append(first, static_cast<int>(last - first));
+    }
+
+    void appendToField(QString & field, const uchar *first, const uchar *last) const
+    {
+      const auto *data = reinterpret_cast<const char*>(first);
+      const int size = static_cast<int>(last - first);
+      if(mUtf8Source){
+        field.append(QString::fromUtf8(data, size));
+      }else{
+        field.append(QLatin1String(data, size));
+      }
+    }
+
+    static Mdt::Error parseError()
+    {
+      const auto msg = QCoreApplication::translate("Mdt::PlainText::CsvScannerTemplate", "Parsing error occured.");
+      return mdtErrorNew(msg, Mdt::Error::Critical, "CsvScannerTemplate");
+    }
+
+    bool mIsValid = false;
+    bool mParseExp = true;
+    bool mUtf8Source = false;
+    uchar mFieldSeparator = ',';
+    uchar mFieldProtection = '\"';
+    QVector<QMetaType::Type> mColumnDataTypes;
+  };
+
+}} // namespace Mdt{ namespace PlainText{
+
+#endif // #ifndef MDT_PLAIN_TEXT_CSV_SCANNER_TEMPLATE_H
@@ -20,11 +20,15 @@
  ****************************************************************************/
 #include "CsvStringParser.h"
 #include "CsvParserTemplate.h"
+#include "CsvScannerTemplate.h"
+#include "CsvParallelParserTemplate.h"
+#include "FieldConversion.h"
 
 namespace Mdt{ namespace PlainText{
 
 CsvStringParser::CsvStringParser()
- : mParser(std::make_unique< CsvParserTemplate<StringConstIterator> >())
+ : mParser(std::make_unique< CsvParserTemplate<StringConstIterator> >()),
+   mScanner(std::make_unique< CsvScannerTemplate<StringConstIterator> >())
 {
 }
 
@@ -36,7 +40,9 @@ void CsvStringParser::setCsvSettings(const CsvParserSettings& settings)
 {
   Q_ASSERT(settings.isValid());
 
+  mCsvSettings = settings;
   mParser->setupParser(settings);
+  mScanner->setupParser(settings);
 }
 
 void CsvStringParser::setSource(const QString & source)
@@ -54,6 +60,9 @@ Expected<StringRecord> CsvStringParser::readLine()
 {
   Q_ASSERT_X(mParser->isValid(), "CsvStringParser", "No CSV settings set");
 
+  if(mCsvSettings.parserEngine() == CsvParserSettings::ScannerEngine){
+    return mScanner->readLine(mCurrentPosition, mEnd);
+  }
   return mParser->readLine(mCurrentPosition, mEnd);
 }
 
@@ -61,6 +70,14 @@ Expected<StringRecordList> CsvStringParser::readAll()
 {
   Q_ASSERT_X(mParser->isValid(), "CsvStringParser", "No CSV settings set");
 
+  const int threadCount = mCsvSettings.effectiveThreadCount();
+  if(threadCount > 1){
+    CsvParallelParserTemplate<StringConstIterator> parallelParser(mCsvSettings);
+    const auto recordList = parallelParser.readAll(mCurrentPosition, mEnd, threadCount);
+    mCurrentPosition = mEnd;
+    return recordList;
+  }
+
   StringRecordList recordList;
 
   while(!atEnd()){
@@ -74,6 +91,53 @@ Expected<StringRecordList> CsvStringParser::readAll()
   return recordList;
 }
 
+Expected<Record> CsvStringParser::readTypedLine()
+{
+  Q_ASSERT_X(mParser->isValid(), "CsvStringParser", "No CSV settings set");
+
+  if(mCsvSettings.parserEngine() == CsvParserSettings::ScannerEngine){
+    return mScanner->readTypedLine(mCurrentPosition, mEnd);
+  }
+  const auto record = mParser->readLine(mCurrentPosition, mEnd);
+  if(!record){
+    return record.error();
+  }
+  return Impl::convertRecord(record.value(), mCsvSettings);
+}
+
+Expected<RecordList> CsvStringParser::readAllTyped()
+{
+  Q_ASSERT_X(mParser->isValid(), "CsvStringParser", "No CSV settings set");
+
+  RecordList recordList;
+
+  if(mCsvSettings.effectiveThreadCount() > 1){
+    const auto stringRecordList = readAll();
+    if(!stringRecordList){
+      return stringRecordList.error();
+    }
+    recordList.reserve(stringRecordList.value().rowCount());
+    for(const auto & stringRecord : stringRecordList.value()){
+      const auto record = Impl::convertRecord(stringRecord, mCsvSettings);
+      if(!record){
+        return record.error();
+      }
+      recordList.appendRecord(record.value());
+    }
+    return recordList;
+  }
+
+  while(!atEnd()){
+    const auto record = readTypedLine();
+    if(!record){
+      return record.error();
+    }
+    recordList.appendRecord(record.value());
+  }
+
+  return recordList;
+}
+
 // Error CsvStringParser::lastError() const
 // {
 // }
@@ -25,6 +25,8 @@
 #include "CsvParserSettings.h"
 #include "StringRecord.h"
 #include "StringRecordList.h"
+#include "Record.h"
+#include "RecordList.h"
 #include "Mdt/Expected.h"
 #include <QString>
 #include <memory>
@@ -34,6 +36,9 @@ namespace Mdt{ namespace PlainText{
   template <typename InputIterator>
   class CsvParserTemplate;
 
+  template <typename SourceIterator>
+  class CsvScannerTemplate;
+
   /*! \brief CSV parser that acts on a QString as input
    *
    * CsvStringParser parses a CSV string.
@@ -98,16 +103,42 @@ namespace Mdt{ namespace PlainText{
 
     /*! \brief Read the entire CSV string
     *
+    * If CsvParserSettings::effectiveThreadCount() is > 1,
+    *  the source is parsed in parallel (see CsvParallelParserTemplate).
+    *
     * \pre CSV settings must be set before calling this function
     * \sa setCsvSettings()
     */
     Mdt::Expected<StringRecordList> readAll();
 
+    /*! \brief Read one line as a typed record
+     *
+     * Each field is converted to the data type of its column
+     *  (see CsvParserSettings::columnDataTypes()).
+     *  With CsvParserSettings::ScannerEngine ,
+     *  the conversion is done directly from the source,
+     *  without building a intermediate QString for each field.
+     *
+     * \pre CSV settings must be set before calling this function
+     * \sa setCsvSettings()
+     */
+    Mdt::Expected<Record> readTypedLine();
+
+    /*! \brief Read the entire CSV string as typed records
+     *
+     * \pre CSV settings must be set before calling this function
+     * \sa readTypedLine()
+     * \sa readAll()
+     */
+    Mdt::Expected<RecordList> readAllTyped();
+
    private:
 
     StringConstIterator mCurrentPosition;
     StringConstIterator mEnd;
+    CsvParserSettings mCsvSettings;
     std::unique_ptr<CsvParserTemplate<StringConstIterator> > mParser;
+    std::unique_ptr<CsvScannerTemplate<StringConstIterator> > mScanner;
     Mdt::Error mLastError;
   };
 
@@ -0,0 +1,300 @@
+/****************************************************************************
+ **
+ ** Copyright (C) 2011-2017 Philippe Steinmann.
+ **
+ ** This file is part of multiDiagTools library.
+ **
+ ** multiDiagTools is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Lesser General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** multiDiagTools is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public License
+ ** along with multiDiagTools.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+#include "FieldConversion.h"
+#include "CharSearch.h"
+#include <QByteArray>
+#include <QDate>
+#include <QCoreApplication>
+#include <limits>
+#include <type_traits>
+
+#define tr(sourceText) QCoreApplication::translate("FieldConversion", sourceText)
+
+namespace Mdt{ namespace PlainText{ namespace Impl{
+
+namespace{
+
+  template<typename CharT>
+  bool isDigit(CharT c, uint & digit)
+  {
+    digit = static_cast<uint>(charCode(c)) - static_cast<uint>('0');
+    return (digit <= 9);
+  }
+
+  template<typename IntT, typename CharT>
+  bool parseInteger(const CharT *first, const CharT *last, IntT & value)
+  {
+    using UIntT = typename std::make_unsigned<IntT>::type;
+
+    bool negative = false;
+    if( (first != last) && ((charCode(*first) == '-') || (charCode(*first) == '+')) ){
+      negative = (charCode(*first) == '-');
+      ++first;
+    }
+    if(first == last){
+      return false;
+    }
+    const UIntT limit = negative ? static_cast<UIntT>(std::numeric_limits<IntT>::max()) + 1u
+                                 : static_cast<UIntT>(std::numeric_limits<IntT>::max());
+    UIntT result = 0;
+    uint digit;
+    for(; first != last; ++first){
+      if(!isDigit(*first, digit)){
+        return false;
+      }
+      if(result > (limit - digit) / 10u){
+        return false;
+      }
+      result = result * 10u + digit;
+    }
+    if(negative && (result != 0)){
+      value = -static_cast<IntT>(result - 1u) - 1;
+    }else{
+      value = static_cast<IntT>(result);
+    }
+
+    return true;
+  }
+
+  /*
+   * Uses the fast path described by W. D. Clinger:
+   * if the significant digits fit in a double mantissa
+   * and the power of 10 is exactly representable,
+   * one multiplication or division gives the correctly rounded result.
+   * Other cases are rare in CSV files and are converted by QByteArray::toDouble().
+   */
+  template<typename CharT>
+  bool parseDouble(const CharT *first, const CharT *last, double & value)
+  {
+    static const double powersOf10[] = {
+      1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+      1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    constexpr int maxSignificantDigits = 19;
+    constexpr quint64 maxExactMantissa = Q_UINT64_C(1) << 53;
+
+    const CharT *it = first;
+    bool negative = false;
+    if( (it != last) && ((charCode(*it) == '-') || (charCode(*it) == '+')) ){
+      negative = (charCode(*it) == '-');
+      ++it;
+    }
+    quint64 mantissa = 0;
+    int significantDigits = 0;
+    int exponent = 0;
+    bool hasDigits = false;
+    uint digit;
+    // Integral part
+    while( (it != last) && isDigit(*it, digit) ){
+      if(significantDigits < maxSignificantDigits){
+        mantissa = mantissa * 10u + digit;
+        if(mantissa != 0){
+          ++significantDigits;
+        }
+      }else{
+        ++exponent;
+      }
+      hasDigits = true;
+      ++it;
+    }
+    // Fractional part
+    if( (it != last) && (charCode(*it) == '.') ){
+      ++it;
+      while( (it != last) && isDigit(*it, digit) ){
+        if(significantDigits < maxSignificantDigits){
+          mantissa = mantissa * 10u + digit;
+          if(mantissa != 0){
+            ++significantDigits;
+          }
+          --exponent;
+        }
+        hasDigits = true;
+        ++it;
+      }
+    }
+    if(!hasDigits){
+      return false;
+    }
+    // Exponent
+    if( (it != last) && ((charCode(*it) == 'e') || (charCode(*it) == 'E')) ){
+      ++it;
+      int explicitExponent = 0;
+      if(!parseInteger(it, last, explicitExponent)){
+        return false;
+      }
+      exponent += explicitExponent;
+      it = last;
+    }
+    if(it != last){
+      return false;
+    }
+    // Fast path
+    if(mantissa == 0){
+      value = negative ? -0.0 : 0.0;
+      return true;
+    }
+    if( (mantissa <= maxExactMantissa) && (exponent >= -22) && (exponent <= 22) ){
+      value = static_cast<double>(mantissa);
+      if(exponent < 0){
+        value /= powersOf10[-exponent];
+      }else{
+        value *= powersOf10[exponent];
+      }
+      if(negative){
+        value = -value;
+      }
+      return true;
+    }
+    // Slow path
+    QByteArray text;
+    text.reserve(static_cast<int>(last - first));
+    for(it = first; it != last; ++it){
+      text.append(static_cast<char>(charCode(*it)));
+    }
+    bool ok;
+    value = text.toDouble(&ok);
+
+    return ok;
+  }
+
+  template<typename CharT>
+  bool parseIsoDate(const CharT *first, const CharT *last, QDate & date)
+  {
+    if( (last - first) != 10 ){
+      return false;
+    }
+    if( (charCode(first[4]) != '-') || (charCode(first[7]) != '-') ){
+      return false;
+    }
+    int year, month, day;
+    if(!parseInteger(first, first+4, year)){
+      return false;
+    }
+    if(!parseInteger(first+5, first+7, month)){
+      return false;
+    }
+    if(!parseInteger(first+8, first+10, day)){
+      return false;
+    }
+    // Signs are not allowed
+    if( (charCode(first[0]) == '-') || (charCode(first[0]) == '+') || (charCode(first[5]) == '-') || (charCode(first[5]) == '+') || (charCode(first[8]) == '-') || (charCode(first[8]) == '+') ){
+      return false;
+    }
+    date.setDate(year, month, day);
+
+    return date.isValid();
+  }
+
+  template<typename CharT>
+  bool convertFieldImpl(const CharT *first, const CharT *last, QMetaType::Type type, QVariant & value)
+  {
+    Q_ASSERT(type != QMetaType::QString);
+    Q_ASSERT(CsvParserSettings::isSupportedColumnDataType(type));
+
+    if(first == last){
+      value = QVariant(static_cast<QVariant::Type>(type));
+      return true;
+    }
+    switch(type){
+      case QMetaType::Int:
+      {
+        int x;
+        if(!parseInteger(first, last, x)){
+          return false;
+        }
+        value = x;
+        return true;
+      }
+      case QMetaType::LongLong:
+      {
+        qlonglong x;
+        if(!parseInteger(first, last, x)){
+          return false;
+        }
+        value = x;
+        return true;
+      }
+      case QMetaType::Double:
+      {
+        double x;
+        if(!parseDouble(first, last, x)){
+          return false;
+        }
+        value = x;
+        return true;
+      }
+      case QMetaType::QDate:
+      {
+        QDate date;
+        if(!parseIsoDate(first, last, date)){
+          return false;
+        }
+        value = date;
+        return true;
+      }
+      default:
+        break;
+    }
+
+    return false;
+  }
+
+} // namespace{
+
+bool convertField(const QChar *first, const QChar *last, QMetaType::Type type, QVariant & value)
+{
+  return convertFieldImpl(first, last, type, value);
+}
+
+bool convertField(const uchar *first, const uchar *last, QMetaType::Type type, QVariant & value)
+{
+  return convertFieldImpl(first, last, type, value);
+}
+
+Mdt::Error fieldConversionError(const QString & field, int column, QMetaType::Type type)
+{
+  const auto msg = tr("Could not convert field '%1' of column %2 to type '%3'.")
+                   .arg(field, QString::number(column), QString::fromLatin1(QMetaType::typeName(type)));
+  return mdtErrorNew(msg, Mdt::Error::Critical, "CsvParser");
+}
+
+Mdt::Expected<Record> convertRecord(const StringRecord & record, const CsvParserSettings & settings)
+{
+  Record typedRecord;
+
+  for(int col = 0; col < record.columnCount(); ++col){
+    const auto type = settings.columnDataType(col);
+    const QString field = record.data(col);
+    if(type == QMetaType::QString){
+      typedRecord.push_back(field);
+      continue;
+    }
+    QVariant value;
+    if(!convertField(field.constData(), field.constData() + field.size(), type, value)){
+      return fieldConversionError(field, col, type);
+    }
+    typedRecord.push_back(value);
+  }
+
+  return typedRecord;
+}
+
+}}} // namespace Mdt{ namespace PlainText{ namespace Impl{
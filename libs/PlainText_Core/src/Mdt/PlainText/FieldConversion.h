@@ -0,0 +1,70 @@
+/****************************************************************************
+ **
+ ** Copyright (C) 2011-2017 Philippe Steinmann.
+ **
+ ** This file is part of multiDiagTools library.
+ **
+ ** multiDiagTools is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Lesser General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** multiDiagTools is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public License
+ ** along with multiDiagTools.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+#ifndef MDT_PLAIN_TEXT_FIELD_CONVERSION_H
+#define MDT_PLAIN_TEXT_FIELD_CONVERSION_H
+
+#include "CsvParserSettings.h"
+#include "StringRecord.h"
+#include "Record.h"
+#include "Mdt/Error.h"
+#include "Mdt/Expected.h"
+#include <QChar>
+#include <QString>
+#include <QVariant>
+#include <QMetaType>
+#include <QtGlobal>
+
+namespace Mdt{ namespace PlainText{ namespace Impl{
+
+  /*! \internal Convert the field [\a first, \a last) to \a type
+   *
+   * The conversion is done directly from the source chars,
+   *  without building a intermediate QString.
+   *  Supported types are the ones listed in CsvParserSettings::columnDataTypes(),
+   *  except QMetaType::QString that must be handled by the caller.
+   *
+   * Returns false if the field could not be converted.
+   */
+  bool convertField(const QChar *first, const QChar *last, QMetaType::Type type, QVariant & value);
+
+  /*! \internal Convert the field [\a first, \a last) to \a type
+   *
+   * The field must be encoded in a ASCII compatible encoding
+   *  (like Latin-1 or UTF-8).
+   *
+   * \sa convertField(const QChar*, const QChar*, QMetaType::Type, QVariant &)
+   */
+  bool convertField(const uchar *first, const uchar *last, QMetaType::Type type, QVariant & value);
+
+  /*! \internal Get a error for \a field of \a column that could not be converted to \a type
+   */
+  Mdt::Error fieldConversionError(const QString & field, int column, QMetaType::Type type);
+
+  /*! \internal Convert \a record to a typed record
+   *
+   * Each field is converted regarding CsvParserSettings::columnDataType()
+   *  of \a settings .
+   */
+  Mdt::Expected<Record> convertRecord(const StringRecord & record, const CsvParserSettings & settings);
+
+}}} // namespace Mdt{ namespace PlainText{ namespace Impl{
+
+#endif // #ifndef MDT_PLAIN_TEXT_FIELD_CONVERSION_H
@@ -76,6 +76,14 @@ bool FileInputIterator::isEof() const
   return mShared->atEnd();
 }
 
+FileInputCounters FileInputIterator::counters() const
+{
+  if(!mShared){
+    return FileInputCounters();
+  }
+  return mShared->counters();
+}
+
 Mdt::Error FileInputIterator::lastError() const
 {
   if(!mShared){
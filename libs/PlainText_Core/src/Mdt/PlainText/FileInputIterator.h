@@ -21,6 +21,7 @@
 #ifndef MDT_PLAIN_TEXT_FILE_INPUT_ITERATOR_H
 #define MDT_PLAIN_TEXT_FILE_INPUT_ITERATOR_H
 
+#include "FileInputIteratorSharedData.h"
 #include "Mdt/Error.h"
 #include <QIODevice>
 #include <QByteArray>
@@ -28,8 +29,6 @@
 
 namespace Mdt{ namespace PlainText{
 
-  class FileInputIteratorSharedData;
-
   /*! \brief Iterator that acts on a I/O device
    *
    * This iterator can be used by with Boost Spirit multipass_iterator.
@@ -182,6 +181,14 @@ namespace Mdt{ namespace PlainText{
       return mErrorOccured;
     }
 
+    /*! \brief Get counters of the shared data
+     *
+     * Returns default constructed counters if this iterator has no source.
+     *
+     * \sa FileInputIteratorSharedData::counters()
+     */
+    FileInputCounters counters() const;
+
     /*! \brief Get last error
      *
      * \pre this must be a iterator attached to a device
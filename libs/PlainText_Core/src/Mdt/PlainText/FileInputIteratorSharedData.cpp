@@ -19,22 +19,52 @@
  **
  ****************************************************************************/
 #include "FileInputIteratorSharedData.h"
+#include "TextDecoding.h"
 #include <QCoreApplication>
+#include <QElapsedTimer>
 #include <QTextCodec>
 #include <QTextDecoder>
+#include <algorithm>
+#include <cstring>
 #include <utility>
 
 #define tr(sourceText) QCoreApplication::translate("FileInputIteratorSharedData", sourceText)
 
 namespace Mdt{ namespace PlainText{
 
+namespace{
+
+  /*
+   * Bytes of a incomplete UTF-8 sequence (or of a possible BOM)
+   * are keeped at the beginning of the raw data buffer
+   * until the next chunk is read.
+   */
+  constexpr int maxPendingByteCount = 3;
+
+  /*
+   * A refill that fills the entire buffer faster than this
+   * makes the buffer grow (in nanoseconds).
+   */
+  constexpr qint64 fastRefillTime = 1000000;
+
+} // namespace{
+
+FileInputIteratorSharedData::FileInputIteratorSharedData()
+ : FileInputIteratorSharedData(16*1024)
+{
+  mMaximumRawDataBufferCapacity = 4*1024*1024;
+}
+
 FileInputIteratorSharedData::FileInputIteratorSharedData(int rawDataBufferCapacity)
- : mDecoder(nullptr)
+ : mRawDataBufferCapacity(rawDataBufferCapacity),
+   mMaximumRawDataBufferCapacity(rawDataBufferCapacity),
+   mDecoder(nullptr)
 {
   Q_ASSERT(rawDataBufferCapacity > 0);
   mCurrentPos = mUnicodeBuffer.cbegin();
   mEnd = mUnicodeBuffer.cend();
-  mRawDataBuffer.reserve(rawDataBufferCapacity);
+  mRawDataBuffer.resize(rawDataBufferCapacity + maxPendingByteCount);
+  mCounters.rawDataBufferCapacity = rawDataBufferCapacity;
 }
 
 FileInputIteratorSharedData::~FileInputIteratorSharedData()
@@ -42,6 +72,13 @@ FileInputIteratorSharedData::~FileInputIteratorSharedData()
   delete mDecoder;
 }
 
+void FileInputIteratorSharedData::setMaximumRawDataBufferCapacity(int capacity)
+{
+  Q_ASSERT(capacity >= mRawDataBufferCapacity);
+
+  mMaximumRawDataBufferCapacity = capacity;
+}
+
 bool FileInputIteratorSharedData::setSource(QIODevice* device, const QByteArray& encoding)
 {
   Q_ASSERT(device != nullptr);
@@ -53,6 +90,10 @@ bool FileInputIteratorSharedData::setSource(QIODevice* device, const QByteArray&
   mDevice = nullptr;
   // Clear buffer
   clearUnicodeBuffer();
+  mPendingByteCount = 0;
+  mAtStartOfData = true;
+  mCounters = FileInputCounters();
+  mCounters.rawDataBufferCapacity = mRawDataBufferCapacity;
   /*
     * Find a codec for requested encoding
     * Note: we not have to manage codec lifetime,
@@ -65,9 +106,19 @@ bool FileInputIteratorSharedData::setSource(QIODevice* device, const QByteArray&
     mLastError.commit();
     return false;
   }
-  // Allocate our decoder
+  // Use built-in decoder if possible, else allocate a QTextDecoder
   Q_ASSERT(codec != nullptr);
-  mDecoder = codec->makeDecoder();
+  switch(codec->mibEnum()){
+    case 106:
+      mDecoding = Utf8Decoding;
+      break;
+    case 4:
+      mDecoding = Latin1Decoding;
+      break;
+    default:
+      mDecoding = CodecDecoding;
+      mDecoder = codec->makeDecoder();
+  }
   /*
    * Check that device is open
    * We must do it at runtime,
@@ -95,29 +146,16 @@ bool FileInputIteratorSharedData::setSource(QIODevice* device, const QByteArray&
     return true;
   }
   /*
-   * Try to read and decode the first chunck of data from device
+   * Try to read and decode the first chunck of data from device.
+   * Note: the device can contain only data that gives no char (f.ex. a BOM)
    */
-  while(mCurrentPos == mEnd){
-    if(!readMore()){
-      return false;
-    }
-  }
-  Q_ASSERT(mCurrentPos != mEnd);
-
-  return true;
+  return refill();
 }
 
-bool FileInputIteratorSharedData::advance()
+bool FileInputIteratorSharedData::refill()
 {
   Q_ASSERT(mDevice);
-  Q_ASSERT(mDecoder);
 
-  // Check if we have cached data
-  if(mCurrentPos != mEnd){
-    Q_ASSERT(mCurrentPos < mEnd);
-    ++mCurrentPos;
-  }
-  // Check if we have to read more data
   while(mCurrentPos == mEnd){
     if(!readMore()){
       Q_ASSERT(mCurrentPos == mEnd);
@@ -134,8 +172,8 @@ bool FileInputIteratorSharedData::advance()
 bool FileInputIteratorSharedData::readMore()
 {
   Q_ASSERT(mDevice);
-  Q_ASSERT(mDecoder);
-  Q_ASSERT(mRawDataBuffer.capacity() > 0);
+  Q_ASSERT( (mDecoding != CodecDecoding) || (mDecoder != nullptr) );
+  Q_ASSERT(mRawDataBuffer.size() == static_cast<size_t>(mRawDataBufferCapacity + maxPendingByteCount));
 
   // Clear unicode buffer (also enshure that iterators are valid)
   clearUnicodeBuffer();
@@ -157,8 +195,10 @@ bool FileInputIteratorSharedData::readMore()
     return false;
   }
   Q_ASSERT(mDevice->isReadable());
-  // Read a chunk of data from device
-  auto n = mDevice->read(mRawDataBuffer.data(), mRawDataBuffer.capacity());
+  // Read a chunk of data from device, after possibly pending bytes
+  QElapsedTimer timer;
+  timer.start();
+  const auto n = mDevice->read(mRawDataBuffer.data() + mPendingByteCount, mRawDataBufferCapacity);
   if(n < 0){
     QString msg = tr("Read from device failed.");
     mLastError = mdtErrorNew(msg, Mdt::Error::Critical, "FileInputIteratorSharedData");
@@ -170,17 +210,88 @@ bool FileInputIteratorSharedData::readMore()
     mLastError.commit();
     return false;
   }
+  mCounters.bytesRead += n;
+  ++mCounters.refillCount;
   // Decode readen data into unicode buffer and update iterators
-  mDecoder->toUnicode(&mUnicodeBuffer, mRawDataBuffer.data(), n);
+  const qint64 decodeStartTime = timer.nsecsElapsed();
+  decode(mPendingByteCount + static_cast<int>(n), mDevice->atEnd());
+  const qint64 refillTime = timer.nsecsElapsed();
+  mCounters.decodeTime += refillTime - decodeStartTime;
+  adaptRawDataBufferCapacity(static_cast<int>(n), refillTime);
+
+  return true;
+}
+
+void FileInputIteratorSharedData::decode(int size, bool atEnd)
+{
+  const char *first = mRawDataBuffer.data();
+  const char *last = first + size;
+
+  // Enshure that resizing the unicode buffer will not reallocate it (also when its size is set to 0)
+  if(mUnicodeBuffer.capacity() < size){
+    mUnicodeBuffer.reserve(mRawDataBufferCapacity + maxPendingByteCount);
+  }
+  mPendingByteCount = 0;
+  switch(mDecoding){
+    case Utf8Decoding:
+    {
+      // Skip a BOM, like QTextDecoder does
+      if(mAtStartOfData){
+        static const char bom[] = "\xEF\xBB\xBF";
+        const int n = std::min(size, 3);
+        if( (n < 3) && !atEnd && (std::memcmp(first, bom, static_cast<size_t>(n)) == 0) ){
+          // Could be a BOM, wait for more data
+          mPendingByteCount = size;
+          break;
+        }
+        if( (n == 3) && (std::memcmp(first, bom, 3) == 0) ){
+          first += 3;
+        }
+        mAtStartOfData = false;
+      }
+      const auto *uFirst = reinterpret_cast<const uchar*>(first);
+      const auto *uLast = reinterpret_cast<const uchar*>(last);
+      mUnicodeBuffer.resize(static_cast<int>(last - first));
+      int bytesConsumed;
+      const int charCount = Impl::decodeUtf8(uFirst, uLast, reinterpret_cast<ushort*>(mUnicodeBuffer.data()), bytesConsumed, atEnd);
+      mUnicodeBuffer.resize(charCount);
+      // Keep a incomplete sequence for the next chunk
+      mPendingByteCount = static_cast<int>(last - first) - bytesConsumed;
+      Q_ASSERT(mPendingByteCount <= maxPendingByteCount);
+      std::memmove(mRawDataBuffer.data(), first + bytesConsumed, static_cast<size_t>(mPendingByteCount));
+      break;
+    }
+    case Latin1Decoding:
+      mUnicodeBuffer.resize(size);
+      Impl::decodeLatin1(reinterpret_cast<const uchar*>(first), size, reinterpret_cast<ushort*>(mUnicodeBuffer.data()));
+      break;
+    case CodecDecoding:
+      Q_ASSERT(mDecoder != nullptr);
+      mDecoder->toUnicode(&mUnicodeBuffer, first, size);
+      break;
+  }
   mCurrentPos = mUnicodeBuffer.cbegin();
   mEnd = mUnicodeBuffer.cend();
+}
 
-  return true;
+void FileInputIteratorSharedData::adaptRawDataBufferCapacity(int bytesRead, qint64 refillTime)
+{
+  if(mRawDataBufferCapacity >= mMaximumRawDataBufferCapacity){
+    return;
+  }
+  if( (bytesRead < mRawDataBufferCapacity) || (refillTime >= fastRefillTime) ){
+    return;
+  }
+  mRawDataBufferCapacity = std::min(2*mRawDataBufferCapacity, mMaximumRawDataBufferCapacity);
+  // Pending bytes, at the beginning of the buffer, are preserved
+  mRawDataBuffer.resize(mRawDataBufferCapacity + maxPendingByteCount);
+  mCounters.rawDataBufferCapacity = mRawDataBufferCapacity;
 }
 
 void FileInputIteratorSharedData::clearUnicodeBuffer()
 {
-  mUnicodeBuffer.clear();
+  // Keeps the allocated capacity, if any was reserved
+  mUnicodeBuffer.resize(0);
   mCurrentPos = mUnicodeBuffer.cbegin();
   mEnd = mUnicodeBuffer.cend();
 }
@@ -26,6 +26,7 @@
 #include <QString>
 #include <QByteArray>
 #include <QPointer>
+#include <QtGlobal>
 #include <vector>
 
 class QTextCodec;
@@ -33,15 +34,65 @@ class QTextDecoder;
 
 namespace Mdt{ namespace PlainText{
 
+  /*! \brief Counters of FileInputIteratorSharedData
+   *
+   * Can be used to tune the read buffer.
+   */
+  struct FileInputCounters
+  {
+    /*! \brief Count of bytes read from the device
+     */
+    qint64 bytesRead = 0;
+
+    /*! \brief Time spent to decode the bytes to unicode, in nanoseconds
+     */
+    qint64 decodeTime = 0;
+
+    /*! \brief Count of times the unicode buffer was refilled
+     */
+    int refillCount = 0;
+
+    /*! \brief Current capacity of the raw data buffer, in bytes
+     */
+    int rawDataBufferCapacity = 0;
+  };
+
   /*! \brief Contains shared part of FileInputIterator
+   *
+   * Data is read from the device by chunks into a raw data buffer,
+   *  and then decoded into a unicode buffer.
+   *
+   * The raw data buffer can grow:
+   *  when a refill has filled the entire buffer
+   *  in less than 1 ms, its capacity is doubled,
+   *  up to maximumRawDataBufferCapacity().
+   *  A fast refill means that the fixed cost of each refill
+   *  (device read call, iterators update) is significant
+   *  regarding the amount of data it gives.
+   *
+   * UTF-8 and Latin-1 (ISO-8859-1) data is decoded by a built-in decoder
+   *  (see Impl::decodeUtf8()), that converts ASCII runs by blocks.
+   *  Other encodings are decoded by a QTextDecoder.
    */
   class FileInputIteratorSharedData
   {
    public:
 
     /*! \brief Default constructor
+     *
+     * The raw data buffer starts with a capacity of 16 KiB,
+     *  and can grow up to 4 MiB.
+     */
+    FileInputIteratorSharedData();
+
+    /*! \brief Construct with a fixed raw data buffer capacity
+     *
+     * The raw data buffer will not grow,
+     *  unless setMaximumRawDataBufferCapacity() is called.
+     *
+     * \pre \a rawDataBufferCapacity must be > 0
      */
-    FileInputIteratorSharedData(int rawDataBufferCapacity = 1024);
+    explicit FileInputIteratorSharedData(int rawDataBufferCapacity);
 
     /*! \brief Copy is disabled
      */
@@ -63,6 +114,28 @@ namespace Mdt{ namespace PlainText{
      */
     ~FileInputIteratorSharedData();
 
+    /*! \brief Set the maximum capacity of the raw data buffer
+     *
+     * \pre \a capacity must be >= rawDataBufferCapacity given at construction
+     */
+    void setMaximumRawDataBufferCapacity(int capacity);
+
+    /*! \brief Get the maximum capacity of the raw data buffer
+     */
+    int maximumRawDataBufferCapacity() const
+    {
+      return mMaximumRawDataBufferCapacity;
+    }
+
+    /*! \brief Get counters
+     *
+     * Counters are reset by setSource().
+     */
+    FileInputCounters counters() const
+    {
+      return mCounters;
+    }
+
     /*! \brief Set source
      *
      * First, it is checked that device is open.
@@ -111,7 +184,15 @@ namespace Mdt{ namespace PlainText{
      * \sa lastError()
      * \sa get()
      */
-    bool advance();
+    bool advance()
+    {
+      Q_ASSERT(mDevice);
+
+      if( (mCurrentPos != mEnd) && (++mCurrentPos != mEnd) ){
+        return true;
+      }
+      return refill();
+    }
 
     /*! \brief Get current char in unicode buffer
      *
@@ -137,10 +218,29 @@ namespace Mdt{ namespace PlainText{
 
  private:
 
+    enum Decoding
+    {
+      Utf8Decoding,
+      Latin1Decoding,
+      CodecDecoding
+    };
+
+    /*! \brief Read chunks of data until some is available in unicode buffer, or end of device is reached
+     */
+    bool refill();
+
     /*! \brief Read a chunck of data from I/O device
      */
     bool readMore();
 
+    /*! \brief Decode \a size bytes available in raw data buffer
+     */
+    void decode(int size, bool atEnd);
+
+    /*! \brief Grow raw data buffer if last refill was fast
+     */
+    void adaptRawDataBufferCapacity(int bytesRead, qint64 refillTime);
+
     /*! \brief Clear unicode buffer
      *
      * Will also reset iterators
@@ -149,6 +249,12 @@ namespace Mdt{ namespace PlainText{
 
     QString::const_iterator mCurrentPos, mEnd;
     std::vector<char> mRawDataBuffer;
+    int mRawDataBufferCapacity;
+    int mMaximumRawDataBufferCapacity;
+    int mPendingByteCount = 0;
+    bool mAtStartOfData = true;
+    Decoding mDecoding = CodecDecoding;
+    FileInputCounters mCounters;
     QString mUnicodeBuffer;
     QTextDecoder *mDecoder;
     QPointer<QIODevice> mDevice;
@@ -34,6 +34,9 @@ int RecordListTableModel::rowCount(const QModelIndex & parent) const
   if(parent.isValid()){
     return 0;
   }
+  if(mIsColumnar){
+    return mColumnarRecordList.rowCount();
+  }
   return mRecordList.rowCount();
 }
 
@@ -54,8 +57,14 @@ QVariant RecordListTableModel::data(const QModelIndex & index, int role) const
     return QVariant();
   }
   Q_ASSERT(index.row() >= 0);
-  Q_ASSERT(index.row() < mRecordList.rowCount());
+  Q_ASSERT(index.row() < rowCount());
   Q_ASSERT(index.column() >= 0);
+  if(mIsColumnar){
+    if(index.column() >= mColumnarRecordList.columnCount(index.row())){
+      return QVariant();
+    }
+    return mColumnarRecordList.data(index.row(), index.column()).toString();
+  }
   if(index.column() >= mRecordList.columnCount(index.row())){
     return QVariant();
   }
@@ -65,11 +74,23 @@ QVariant RecordListTableModel::data(const QModelIndex & index, int role) const
 void RecordListTableModel::setRecordList(const RecordList & recordList)
 {
   beginResetModel();
+  mIsColumnar = false;
+  mColumnarRecordList.clear();
   mRecordList = recordList;
   updateColumnCount();
   endResetModel();
 }
 
+void RecordListTableModel::setRecordList(const ColumnarStringRecordList & recordList)
+{
+  beginResetModel();
+  mIsColumnar = true;
+  mRecordList.clear();
+  mColumnarRecordList = recordList;
+  mColumnCount = mColumnarRecordList.maximumColumnCount();
+  endResetModel();
+}
+
 void RecordListTableModel::updateColumnCount()
 {
   const auto cmp = [](const Record & a, const Record & b){
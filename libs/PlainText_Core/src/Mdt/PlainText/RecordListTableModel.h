@@ -22,6 +22,7 @@
 #define MDT_PLAIN_TEXT_RECORD_LIST_TABLE_MODEL_H
 
 #include "RecordList.h"
+#include "ColumnarStringRecordList.h"
 #include <QAbstractTableModel>
 #include <QModelIndex>
 #include <QVariant>
@@ -45,6 +46,9 @@ namespace Mdt{ namespace PlainText{
    * QTableView view;
    * view.setModel(&model);
    * \endcode
+   *
+   * The model can also act on a ColumnarStringRecordList,
+   *  in witch case it is used directly, without any conversion.
    */
   class RecordListTableModel : public QAbstractTableModel
   {
@@ -74,12 +78,20 @@ namespace Mdt{ namespace PlainText{
      */
     void setRecordList(const RecordList & recordList);
 
+    /*! \brief Set columnar record list
+     *
+     * Note that setting a new record list will reset the model.
+     */
+    void setRecordList(const ColumnarStringRecordList & recordList);
+
    private:
 
     void updateColumnCount();
 
+    bool mIsColumnar = false;
     int mColumnCount = 0;
     RecordList mRecordList;
+    ColumnarStringRecordList mColumnarRecordList;
   };
 
 }} // namespace Mdt{ namespace PlainText{
@@ -123,6 +123,13 @@ namespace Mdt{ namespace PlainText{
       return mRecordList.insert(before, record);
     }
 
+    /*! \brief Attempt to allocate memory for at least \a size records
+     */
+    void reserve(int size)
+    {
+      mRecordList.reserve(size);
+    }
+
     /*! \brief Check if this record list is empty
      */
     bool isEmpty() const
@@ -193,6 +193,13 @@ struct StringConstIterator
     return mIndex[i].unicode();
   }
 
+  /*! \brief Get a pointer to the referenced char
+   */
+  QString::const_iterator data() const
+  {
+    return mIndex;
+  }
+
   /*! \brief Returns true if iterator a refers to same item than iterator b
    */
   friend
@@ -0,0 +1,144 @@
+/****************************************************************************
+ **
+ ** Copyright (C) 2011-2017 Philippe Steinmann.
+ **
+ ** This file is part of multiDiagTools library.
+ **
+ ** multiDiagTools is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Lesser General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** multiDiagTools is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public License
+ ** along with multiDiagTools.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+#include "TextDecoding.h"
+#include <QChar>
+#include <QtAlgorithms>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+ #define MDT_PLAIN_TEXT_TEXT_DECODING_SSE2
+ #include <emmintrin.h>
+#endif
+
+namespace Mdt{ namespace PlainText{ namespace Impl{
+
+void decodeLatin1(const uchar *in, int size, ushort *out)
+{
+  Q_ASSERT(size >= 0);
+
+  const uchar *last = in + size;
+#if defined(MDT_PLAIN_TEXT_TEXT_DECODING_SSE2)
+  const __m128i zero = _mm_setzero_si128();
+  while( (last - in) >= 16 ){
+    const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_unpacklo_epi8(block, zero));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 8), _mm_unpackhi_epi8(block, zero));
+    in += 16;
+    out += 16;
+  }
+#endif
+  for( ; in != last; ++in, ++out){
+    *out = *in;
+  }
+}
+
+int decodeUtf8(const uchar *first, const uchar *last, ushort *out, int & bytesConsumed, bool flush)
+{
+  Q_ASSERT(first <= last);
+
+  const uchar *it = first;
+  ushort *o = out;
+#if defined(MDT_PLAIN_TEXT_TEXT_DECODING_SSE2)
+  const __m128i zero = _mm_setzero_si128();
+#endif
+
+  while(it != last){
+    // ASCII run
+#if defined(MDT_PLAIN_TEXT_TEXT_DECODING_SSE2)
+    while( (last - it) >= 16 ){
+      const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(it));
+      const uint mask = static_cast<uint>(_mm_movemask_epi8(block));
+      if(mask != 0){
+        const uint n = qCountTrailingZeroBits(mask);
+        for(uint i = 0; i < n; ++i){
+          *o++ = *it++;
+        }
+        break;
+      }
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(o), _mm_unpacklo_epi8(block, zero));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(o + 8), _mm_unpackhi_epi8(block, zero));
+      it += 16;
+      o += 16;
+    }
+#endif
+    while( (it != last) && (*it < 0x80) ){
+      *o++ = *it++;
+    }
+    if(it == last){
+      break;
+    }
+    // Multi byte sequence
+    const uchar lead = *it;
+    int continuationCount;
+    uint code;
+    uint minCode;
+    if( (lead & 0xE0) == 0xC0 ){
+      continuationCount = 1;
+      code = lead & 0x1F;
+      minCode = 0x80;
+    }else if( (lead & 0xF0) == 0xE0 ){
+      continuationCount = 2;
+      code = lead & 0x0F;
+      minCode = 0x800;
+    }else if( (lead & 0xF8) == 0xF0 ){
+      continuationCount = 3;
+      code = lead & 0x07;
+      minCode = 0x10000;
+    }else{
+      *o++ = QChar::ReplacementCharacter;
+      ++it;
+      continue;
+    }
+    const int available = static_cast<int>(last - it) - 1;
+    bool valid = true;
+    for(int i = 1; i <= qMin(continuationCount, available); ++i){
+      const uchar c = it[i];
+      if( (c & 0xC0) != 0x80 ){
+        valid = false;
+        break;
+      }
+      code = (code << 6) | (c & 0x3F);
+    }
+    if( valid && (available < continuationCount) ){
+      // Incomplete sequence at end of input
+      if(!flush){
+        break;
+      }
+      valid = false;
+    }
+    if( !valid || (code < minCode) || (code > 0x10FFFF) || ((code >= 0xD800) && (code <= 0xDFFF)) ){
+      *o++ = QChar::ReplacementCharacter;
+      ++it;
+      continue;
+    }
+    it += continuationCount + 1;
+    if(QChar::requiresSurrogates(code)){
+      *o++ = QChar::highSurrogate(code);
+      *o++ = QChar::lowSurrogate(code);
+    }else{
+      *o++ = static_cast<ushort>(code);
+    }
+  }
+  bytesConsumed = static_cast<int>(it - first);
+
+  return static_cast<int>(o - out);
+}
+
+}}} // namespace Mdt{ namespace PlainText{ namespace Impl{
@@ -0,0 +1,52 @@
+/****************************************************************************
+ **
+ ** Copyright (C) 2011-2017 Philippe Steinmann.
+ **
+ ** This file is part of multiDiagTools library.
+ **
+ ** multiDiagTools is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Lesser General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** multiDiagTools is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public License
+ ** along with multiDiagTools.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+#ifndef MDT_PLAIN_TEXT_TEXT_DECODING_H
+#define MDT_PLAIN_TEXT_TEXT_DECODING_H
+
+#include <QtGlobal>
+
+namespace Mdt{ namespace PlainText{ namespace Impl{
+
+  /*! \internal Decode \a size Latin-1 bytes from \a in to UTF-16 chars in \a out
+   *
+   * \a out must have room for \a size chars.
+   */
+  void decodeLatin1(const uchar *in, int size, ushort *out);
+
+  /*! \internal Decode UTF-8 bytes [\a first, \a last) to UTF-16 chars in \a out
+   *
+   * Runs of ASCII chars are decoded by blocks of 16 bytes when SSE2 is available.
+   *  Invalid sequences are replaced by U+FFFD (QChar::ReplacementCharacter).
+   *
+   * A incomplete sequence at the end of the input is not decoded,
+   *  so that it can be completed by the next chunk of data,
+   *  unless \a flush is true, in witch case it is replaced by U+FFFD.
+   *
+   * \a out must have room for (\a last - \a first) chars.
+   *
+   * Returns the count of UTF-16 chars written to \a out .
+   *  \a bytesConsumed receives the count of bytes that have been decoded.
+   */
+  int decodeUtf8(const uchar *first, const uchar *last, ushort *out, int & bytesConsumed, bool flush);
+
+}}} // namespace Mdt{ namespace PlainText{ namespace Impl{
+
+#endif // #ifndef MDT_PLAIN_TEXT_TEXT_DECODING_H
@@ -0,0 +1,204 @@
+/****************************************************************************
+ **
+ ** Copyright (C) 2011-2017 Philippe Steinmann.
+ **
+ ** This file is part of multiDiagTools library.
+ **
+ ** multiDiagTools is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Lesser General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** multiDiagTools is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public License
+ ** along with multiDiagTools.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+#include "CsvFileTableModelTest.h"
+#include "Mdt/PlainText/CsvFileTableModel.h"
+#include "Mdt/PlainText/CsvParserSettings.h"
+#include "qtmodeltest.h"
+#include <QTemporaryFile>
+#include <QSignalSpy>
+
+using namespace Mdt::PlainText;
+
+void CsvFileTableModelTest::initTestCase()
+{
+}
+
+void CsvFileTableModelTest::cleanupTestCase()
+{
+}
+
+/*
+ * Tests
+ */
+
+void CsvFileTableModelTest::openFileTest()
+{
+  CsvFileTableModel model;
+  QTemporaryFile file;
+
+  QVERIFY(writeTemporaryTextFile(file, "A,B\n1,2\n"));
+  /*
+   * Initial state
+   */
+  QVERIFY(!model.isOpen());
+  QCOMPARE(model.rowCount(), 0);
+  QCOMPARE(model.columnCount(), 0);
+  QVERIFY(!model.canFetchMore(QModelIndex()));
+  /*
+   * Open
+   */
+  model.setCsvSettings(CsvParserSettings());
+  QVERIFY(model.openFile(file.fileName(), "UTF-8"));
+  QVERIFY(model.isOpen());
+  QCOMPARE(model.rowCount(), 2);
+  QCOMPARE(model.columnCount(), 2);
+  QVERIFY(!model.canFetchMore(QModelIndex()));
+  QCOMPARE(getModelData(&model, 0, 0), QVariant("A"));
+  QCOMPARE(getModelData(&model, 1, 1), QVariant("2"));
+  /*
+   * Close
+   */
+  model.closeFile();
+  QVERIFY(!model.isOpen());
+  QCOMPARE(model.rowCount(), 0);
+  QCOMPARE(model.columnCount(), 0);
+  /*
+   * Unsupported encoding
+   */
+  QVERIFY(!model.openFile(file.fileName(), "UTF-16"));
+  QVERIFY(!model.isOpen());
+}
+
+void CsvFileTableModelTest::fetchMoreTest()
+{
+  QFETCH(int, fileRowCount);
+  QFETCH(int, pageSize);
+  CsvFileTableModel model;
+  QTemporaryFile file;
+  QString fileData;
+
+  for(int i = 0; i < fileRowCount; ++i){
+    fileData += QString("%1,\"R\n%1\"\n").arg(i);
+  }
+  QVERIFY(writeTemporaryTextFile(file, fileData));
+  model.setPageSize(pageSize);
+  QCOMPARE(model.pageSize(), pageSize);
+  QVERIFY(model.openFile(file.fileName(), "UTF-8"));
+  QCOMPARE(model.rowCount(), qMin(fileRowCount, pageSize));
+  QSignalSpy rowsInsertedSpy(&model, &CsvFileTableModel::rowsInserted);
+  QVERIFY(rowsInsertedSpy.isValid());
+  int expectedFetchCount = 0;
+  while(model.canFetchMore(QModelIndex())){
+    model.fetchMore(QModelIndex());
+    ++expectedFetchCount;
+  }
+  QCOMPARE(model.rowCount(), fileRowCount);
+  QCOMPARE(rowsInsertedSpy.count(), expectedFetchCount);
+  for(int row = 0; row < fileRowCount; ++row){
+    QCOMPARE(getModelData(&model, row, 0), QVariant(QString::number(row)));
+    QCOMPARE(getModelData(&model, row, 1), QVariant(QString("R\n%1").arg(row)));
+  }
+}
+
+void CsvFileTableModelTest::fetchMoreTest_data()
+{
+  QTest::addColumn<int>("fileRowCount");
+  QTest::addColumn<int>("pageSize");
+
+  QTest::newRow("0,1") << 0 << 1;
+  QTest::newRow("1,1") << 1 << 1;
+  QTest::newRow("1,3") << 1 << 3;
+  QTest::newRow("3,3") << 3 << 3;
+  QTest::newRow("10,3") << 10 << 3;
+  QTest::newRow("1000,1024") << 1000 << 1024;
+  QTest::newRow("5000,1024") << 5000 << 1024;
+}
+
+void CsvFileTableModelTest::columnCountTest()
+{
+  CsvFileTableModel model;
+  QTemporaryFile file;
+
+  QVERIFY(writeTemporaryTextFile(file, "A\nB\nC,D\nE\nF,G,H\n"));
+  model.setPageSize(2);
+  QVERIFY(model.openFile(file.fileName(), "UTF-8"));
+  QCOMPARE(model.columnCount(), 1);
+  QSignalSpy columnsInsertedSpy(&model, &CsvFileTableModel::columnsInserted);
+  QVERIFY(columnsInsertedSpy.isValid());
+  model.fetchMore(QModelIndex());
+  QCOMPARE(model.rowCount(), 4);
+  QCOMPARE(model.columnCount(), 2);
+  QCOMPARE(columnsInsertedSpy.count(), 1);
+  QCOMPARE(getModelData(&model, 3, 1), QVariant());
+  model.fetchMore(QModelIndex());
+  QCOMPARE(model.rowCount(), 5);
+  QCOMPARE(model.columnCount(), 3);
+  QCOMPARE(columnsInsertedSpy.count(), 2);
+  QVERIFY(!model.canFetchMore(QModelIndex()));
+}
+
+void CsvFileTableModelTest::pageCacheTest()
+{
+  CsvFileTableModel model;
+  QTemporaryFile file;
+  QString fileData;
+
+  for(int i = 0; i < 100; ++i){
+    fileData += QString("%1,\xC3\xA9\r\n").arg(i);
+  }
+  QVERIFY(writeTemporaryTextFile(file, fileData));
+  model.setPageSize(10);
+  model.setMaximumCachedPageCount(2);
+  QCOMPARE(model.maximumCachedPageCount(), 2);
+  QVERIFY(model.openFile(file.fileName(), "UTF-8"));
+  while(model.canFetchMore(QModelIndex())){
+    model.fetchMore(QModelIndex());
+  }
+  QCOMPARE(model.rowCount(), 100);
+  QCOMPARE(model.cachedPageCount(), 2);
+  // Access dropped pages, in random order
+  for(int row : {5, 95, 42, 0, 99, 17, 63}){
+    QCOMPARE(getModelData(&model, row, 0), QVariant(QString::number(row)));
+    QCOMPARE(getModelData(&model, row, 1), QVariant(QString::fromUtf8("\xC3\xA9")));
+    QVERIFY(model.cachedPageCount() <= 2);
+  }
+}
+
+void CsvFileTableModelTest::qtModelTest()
+{
+  CsvFileTableModel model;
+  QTemporaryFile file;
+  QString fileData;
+
+  for(int i = 0; i < 20; ++i){
+    fileData += QString("%1,A,B\n").arg(i);
+  }
+  QVERIFY(writeTemporaryTextFile(file, fileData));
+  model.setPageSize(8);
+  QVERIFY(model.openFile(file.fileName(), "UTF-8"));
+  QtModelTest mt(&model);
+  while(model.canFetchMore(QModelIndex())){
+    model.fetchMore(QModelIndex());
+  }
+  QCOMPARE(model.rowCount(), 20);
+}
+
+/*
+ * Main
+ */
+
+int main(int argc, char **argv)
+{
+  Mdt::CoreApplication app(argc, argv);
+  CsvFileTableModelTest test;
+
+  return QTest::qExec(&test, argc, argv);
+}
@@ -0,0 +1,280 @@
+/****************************************************************************
+ **
+ ** Copyright (C) 2011-2017 Philippe Steinmann.
+ **
+ ** This file is part of multiDiagTools library.
+ **
+ ** multiDiagTools is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Lesser General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** multiDiagTools is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public License
+ ** along with multiDiagTools.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+#include "CsvGeneratorTest.h"
+#include "Mdt/PlainText/CsvGeneratorSettings.h"
+#include "Mdt/PlainText/CsvFileGenerator.h"
+#include "Mdt/PlainText/CsvParserSettings.h"
+#include "Mdt/PlainText/CsvFileParser.h"
+#include "Mdt/PlainText/StringRecordList.h"
+#include "Mdt/PlainText/RecordList.h"
+#include "Mdt/PlainText/RecordListTableModel.h"
+#include <QFile>
+#include <QTemporaryFile>
+#include <QTextCodec>
+
+using namespace Mdt::PlainText;
+
+void CsvGeneratorTest::initTestCase()
+{
+}
+
+void CsvGeneratorTest::cleanupTestCase()
+{
+}
+
+/*
+ * Tests
+ */
+
+void CsvGeneratorTest::fileGeneratorWriteAllTest()
+{
+  QFETCH(StringRecordList, data);
+  QFETCH(QByteArray, expectedFileData);
+  QFETCH(CsvGeneratorSettings, csvSettings);
+  CsvFileGenerator generator;
+  QTemporaryFile file;
+
+  QVERIFY(file.open());
+  file.close();
+  generator.setCsvSettings(csvSettings);
+  QVERIFY(!generator.isOpen());
+  QVERIFY(generator.openFile(file.fileName(), "UTF-8"));
+  QVERIFY(generator.isOpen());
+  QVERIFY(generator.writeAll(data));
+  QVERIFY(generator.closeFile());
+  QVERIFY(!generator.isOpen());
+  QCOMPARE(readFile(file.fileName()), expectedFileData);
+}
+
+void CsvGeneratorTest::fileGeneratorWriteAllTest_data()
+{
+  QTest::addColumn<StringRecordList>("data");
+  QTest::addColumn<QByteArray>("expectedFileData");
+  QTest::addColumn<CsvGeneratorSettings>("csvSettings");
+
+  CsvGeneratorSettings csvSettings;
+  CsvGeneratorSettings lfSettings;
+  lfSettings.setEndOfLine(CsvGeneratorSettings::LfEndOfLine);
+  CsvGeneratorSettings protectAllSettings;
+  protectAllSettings.setFieldProtectionMode(CsvGeneratorSettings::ProtectAllFields);
+  CsvGeneratorSettings semicolonSettings;
+  semicolonSettings.setFieldSeparator(';');
+  semicolonSettings.setFieldProtection('\'');
+
+  QTest::newRow("Empty") << StringRecordList{} << QByteArray() << csvSettings;
+  QTest::newRow("A") << StringRecordList{{"A"}} << QByteArray("A\r\n") << csvSettings;
+  QTest::newRow("A|B") << StringRecordList{{"A","B"}} << QByteArray("A,B\r\n") << csvSettings;
+  QTest::newRow("A|B,C|D") << StringRecordList{{"A","B"},{"C","D"}} << QByteArray("A,B\r\nC,D\r\n") << csvSettings;
+  QTest::newRow("Empty fields") << StringRecordList{{"","B",""}} << QByteArray(",B,\r\n") << csvSettings;
+  QTest::newRow("Separator") << StringRecordList{{"A,B","C"}} << QByteArray("\"A,B\",C\r\n") << csvSettings;
+  QTest::newRow("Protection") << StringRecordList{{"A\"B\"","C"}} << QByteArray("\"A\"\"B\"\"\",C\r\n") << csvSettings;
+  QTest::newRow("LF") << StringRecordList{{"A\nB"}} << QByteArray("\"A\nB\"\r\n") << csvSettings;
+  QTest::newRow("CR") << StringRecordList{{"A\rB"}} << QByteArray("\"A\rB\"\r\n") << csvSettings;
+  QTest::newRow("Tab") << StringRecordList{{"A\tB"}} << QByteArray("\"A\tB\"\r\n") << csvSettings;
+  QTest::newRow("Leading ~") << StringRecordList{{"~A","B~"}} << QByteArray("\"~~A\",B~\r\n") << csvSettings;
+  QTest::newRow("Unicode") << StringRecordList{{QString::fromUtf8("éà"),QString::fromUtf8("€")}} << QByteArray("\xC3\xA9\xC3\xA0,\xE2\x82\xAC\r\n") << csvSettings;
+  QTest::newRow("Surrogate pair") << StringRecordList{{QString::fromUtf8("\xF0\x9F\x98\x80")}} << QByteArray("\xF0\x9F\x98\x80\r\n") << csvSettings;
+  QTest::newRow("LF EOL") << StringRecordList{{"A","B"},{"C"}} << QByteArray("A,B\nC\n") << lfSettings;
+  QTest::newRow("Protect all") << StringRecordList{{"A",""}} << QByteArray("\"A\",\"\"\r\n") << protectAllSettings;
+  QTest::newRow("Semicolon") << StringRecordList{{"A,B","C;D","E'F"}} << QByteArray("A,B;'C;D';'E''F'\r\n") << semicolonSettings;
+}
+
+void CsvGeneratorTest::fileGeneratorEncodingTest()
+{
+  QFETCH(QByteArray, encoding);
+  CsvFileGenerator generator;
+  CsvFileParser parser;
+  CsvGeneratorSettings generatorSettings;
+  CsvParserSettings parserSettings;
+  QTemporaryFile file;
+  const StringRecordList data{
+    {"A","B"},
+    {QString::fromUtf8("éàè"),QString::fromUtf8("ö,\"ä\"")}
+  };
+
+  QVERIFY(file.open());
+  file.close();
+  generator.setCsvSettings(generatorSettings);
+  QVERIFY(generator.openFile(file.fileName(), encoding));
+  QVERIFY(generator.writeAll(data));
+  QVERIFY(generator.closeFile());
+  parser.setCsvSettings(parserSettings);
+  QVERIFY(parser.openFile(file.fileName(), encoding));
+  const auto result = parser.readAll();
+  QVERIFY(result.hasValue());
+  QCOMPARE(result.value().rowCount(), data.rowCount());
+  for(int row = 0; row < data.rowCount(); ++row){
+    QCOMPARE(result.value().columnCount(row), data.columnCount(row));
+    for(int col = 0; col < data.columnCount(row); ++col){
+      QCOMPARE(result.value().data(row, col), data.data(row, col));
+    }
+  }
+}
+
+void CsvGeneratorTest::fileGeneratorEncodingTest_data()
+{
+  QTest::addColumn<QByteArray>("encoding");
+
+  QTest::newRow("UTF-8") << QByteArray("UTF-8");
+  QTest::newRow("ISO-8859-1") << QByteArray("ISO-8859-1");
+  QTest::newRow("UTF-16") << QByteArray("UTF-16");
+}
+
+void CsvGeneratorTest::fileGeneratorSpecialCharsRoundTripTest()
+{
+  CsvFileGenerator generator;
+  CsvFileParser parser;
+  QTemporaryFile file;
+  const StringRecordList data{
+    {"A\tB","\t","~A","~","~~A","~\"A\"","B~"},
+    {"\tA","A\t","~\tA","~,A","A","B","C"}
+  };
+
+  QVERIFY(file.open());
+  file.close();
+  QVERIFY(generator.openFile(file.fileName(), "UTF-8"));
+  QVERIFY(generator.writeAll(data));
+  QVERIFY(generator.closeFile());
+  QVERIFY(parser.openFile(file.fileName(), "UTF-8"));
+  const auto result = parser.readAll();
+  QVERIFY(result.hasValue());
+  QCOMPARE(result.value().rowCount(), data.rowCount());
+  for(int row = 0; row < data.rowCount(); ++row){
+    QCOMPARE(result.value().columnCount(row), data.columnCount(row));
+    for(int col = 0; col < data.columnCount(row); ++col){
+      QCOMPARE(result.value().data(row, col), data.data(row, col));
+    }
+  }
+}
+
+void CsvGeneratorTest::fileGeneratorRecordListTest()
+{
+  CsvFileGenerator generator;
+  QTemporaryFile file;
+  const RecordList data{
+    {1,"A"},
+    {2.5,"B,C"}
+  };
+
+  QVERIFY(file.open());
+  file.close();
+  QVERIFY(generator.openFile(file.fileName(), "UTF-8"));
+  QVERIFY(generator.writeLine(StringRecord{"Id","Name"}));
+  QVERIFY(generator.writeAll(data));
+  QVERIFY(generator.closeFile());
+  QCOMPARE(readFile(file.fileName()), QByteArray("Id,Name\r\n1,A\r\n2.5,\"B,C\"\r\n"));
+}
+
+void CsvGeneratorTest::fileGeneratorModelTest()
+{
+  CsvFileGenerator generator;
+  RecordListTableModel model;
+  QTemporaryFile file;
+
+  model.setRecordList(RecordList{{1,"A"},{2,"B"}});
+  QVERIFY(file.open());
+  file.close();
+  QVERIFY(generator.openFile(file.fileName(), "UTF-8"));
+  QVERIFY(generator.writeAll(model));
+  QVERIFY(generator.closeFile());
+  QCOMPARE(readFile(file.fileName()), QByteArray("1,A\r\n2,B\r\n"));
+}
+
+void CsvGeneratorTest::fileGeneratorBufferTest()
+{
+  QFETCH(QByteArray, encoding);
+  QFETCH(bool, backgroundFlush);
+  CsvFileGenerator generator;
+  CsvFileParser parser;
+  CsvParserSettings parserSettings;
+  QTemporaryFile file;
+  StringRecordList data;
+
+  for(int row = 0; row < 500; ++row){
+    data.appendRecord({QString::number(row), QString::fromUtf8("Fïeld \"%1\"\nwith € and a long text").arg(row), QString(200, QChar('x'))});
+  }
+  QVERIFY(file.open());
+  file.close();
+  /*
+   * Write
+   */
+  generator.setBufferSize(64);
+  generator.setBackgroundFlushEnabled(backgroundFlush);
+  QCOMPARE(generator.bufferSize(), 64);
+  QCOMPARE(generator.isBackgroundFlushEnabled(), backgroundFlush);
+  QVERIFY(generator.openFile(file.fileName(), encoding));
+  QVERIFY(generator.writeAll(data));
+  QVERIFY(generator.flush());
+  QVERIFY(generator.writeAll(data));
+  QVERIFY(generator.closeFile());
+  /*
+   * Read back
+   */
+  parser.setCsvSettings(parserSettings);
+  QVERIFY(parser.openFile(file.fileName(), encoding));
+  const auto result = parser.readAll();
+  QVERIFY(result.hasValue());
+  QCOMPARE(result.value().rowCount(), 2*data.rowCount());
+  for(int row = 0; row < result.value().rowCount(); ++row){
+    const int sourceRow = row % data.rowCount();
+    QCOMPARE(result.value().columnCount(row), 3);
+    for(int col = 0; col < 3; ++col){
+      QCOMPARE(result.value().data(row, col), data.data(sourceRow, col));
+    }
+  }
+}
+
+void CsvGeneratorTest::fileGeneratorBufferTest_data()
+{
+  QTest::addColumn<QByteArray>("encoding");
+  QTest::addColumn<bool>("backgroundFlush");
+
+  QTest::newRow("UTF-8") << QByteArray("UTF-8") << false;
+  QTest::newRow("UTF-8,background") << QByteArray("UTF-8") << true;
+  QTest::newRow("UTF-16") << QByteArray("UTF-16") << false;
+  QTest::newRow("UTF-16,background") << QByteArray("UTF-16") << true;
+}
+
+/*
+ * Helpers
+ */
+
+QByteArray CsvGeneratorTest::readFile(const QString & filePath)
+{
+  QFile file(filePath);
+  if(!file.open(QIODevice::ReadOnly)){
+    qDebug() << "Could not open file " << filePath;
+    return QByteArray();
+  }
+  return file.readAll();
+}
+
+/*
+ * Main
+ */
+
+int main(int argc, char **argv)
+{
+  Mdt::CoreApplication app(argc, argv);
+  CsvGeneratorTest test;
+
+  return QTest::qExec(&test, argc, argv);
+}
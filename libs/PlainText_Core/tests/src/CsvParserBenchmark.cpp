@@ -0,0 +1,157 @@
+/****************************************************************************
+ **
+ ** Copyright (C) 2011-2017 Philippe Steinmann.
+ **
+ ** This file is part of multiDiagTools library.
+ **
+ ** multiDiagTools is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Lesser General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** multiDiagTools is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public License
+ ** along with multiDiagTools.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+#include "CsvParserBenchmark.h"
+#include "Mdt/Expected.h"
+#include "Mdt/PlainText/StringRecordList.h"
+#include "Mdt/PlainText/CsvParserSettings.h"
+#include "Mdt/PlainText/CsvStringParser.h"
+#include "Mdt/PlainText/CsvFileParser.h"
+#include "Mdt/PlainText/CharSearch.h"
+#include <QString>
+#include <QTemporaryFile>
+
+using namespace Mdt::PlainText;
+
+Q_DECLARE_METATYPE(Mdt::PlainText::CsvParserSettings::ParserEngine)
+
+void CsvParserBenchmark::initTestCase()
+{
+  qDebug() << "Scanner instruction set:" << Impl::findFirstOfInstructionSet();
+}
+
+void CsvParserBenchmark::cleanupTestCase()
+{
+}
+
+/*
+ * Benchmarks
+ */
+
+void CsvParserBenchmark::stringParserBenchmark()
+{
+  QFETCH(int, rowCount);
+  QFETCH(int, columnCount);
+  QFETCH(CsvParserSettings::ParserEngine, engine);
+  CsvParserSettings csvSettings;
+  CsvStringParser parser;
+
+  const auto source = buildCsvSource(rowCount, columnCount);
+  csvSettings.setParserEngine(engine);
+  parser.setCsvSettings(csvSettings);
+  StringRecordList data;
+  QBENCHMARK{
+    parser.setSource(source);
+    const auto recList = parser.readAll();
+    QVERIFY(recList.hasValue());
+    data = recList.value();
+  }
+  QCOMPARE(data.rowCount(), rowCount);
+  QCOMPARE(data.columnCount(0), columnCount);
+  QCOMPARE(data.columnCount(rowCount-1), columnCount);
+}
+
+void CsvParserBenchmark::stringParserBenchmark_data()
+{
+  buildBenchmarkData();
+}
+
+void CsvParserBenchmark::fileParserBenchmark()
+{
+  QFETCH(int, rowCount);
+  QFETCH(int, columnCount);
+  QFETCH(CsvParserSettings::ParserEngine, engine);
+  CsvParserSettings csvSettings;
+  CsvFileParser parser;
+  QTemporaryFile file;
+
+  QVERIFY(writeTemporaryTextFile(file, buildCsvSource(rowCount, columnCount), "UTF-8"));
+  csvSettings.setParserEngine(engine);
+  parser.setCsvSettings(csvSettings);
+  parser.setInputMode(CsvFileParser::MemoryMappedInput);
+  StringRecordList data;
+  QBENCHMARK{
+    QVERIFY(parser.openFile(file.fileName(), "UTF-8"));
+    const auto recList = parser.readAll();
+    QVERIFY(recList.hasValue());
+    data = recList.value();
+    parser.closeFile();
+  }
+  QCOMPARE(data.rowCount(), rowCount);
+  QCOMPARE(data.columnCount(0), columnCount);
+  QCOMPARE(data.columnCount(rowCount-1), columnCount);
+}
+
+void CsvParserBenchmark::fileParserBenchmark_data()
+{
+  buildBenchmarkData();
+}
+
+/*
+ * Helpers
+ */
+
+void CsvParserBenchmark::buildBenchmarkData()
+{
+  QTest::addColumn<int>("rowCount");
+  QTest::addColumn<int>("columnCount");
+  QTest::addColumn<CsvParserSettings::ParserEngine>("engine");
+
+  QTest::newRow("Narrow,Spirit") << 20000 << 3 << CsvParserSettings::SpiritEngine;
+  QTest::newRow("Narrow,Scanner") << 20000 << 3 << CsvParserSettings::ScannerEngine;
+  QTest::newRow("Wide,Spirit") << 1000 << 60 << CsvParserSettings::SpiritEngine;
+  QTest::newRow("Wide,Scanner") << 1000 << 60 << CsvParserSettings::ScannerEngine;
+}
+
+QString CsvParserBenchmark::buildCsvSource(int rowCount, int columnCount)
+{
+  Q_ASSERT(rowCount > 0);
+  Q_ASSERT(columnCount > 0);
+
+  QString source;
+  for(int row = 0; row < rowCount; ++row){
+    for(int col = 0; col < columnCount; ++col){
+      if(col > 0){
+        source += QLatin1Char(',');
+      }
+      // Mix unprotected and protected fields
+      if( (col % 3) == 2 ){
+        source += QString("\"Text %1, \"\"%2\"\"\"").arg(row).arg(col);
+      }else{
+        source += QString("Field_%1_%2").arg(row).arg(col);
+      }
+    }
+    source += QLatin1String("\r\n");
+  }
+
+  return source;
+}
+
+/*
+ * Main
+ */
+
+int main(int argc, char **argv)
+{
+  Mdt::CoreApplication app(argc, argv);
+  CsvParserBenchmark test;
+
+  return QTest::qExec(&test, argc, argv);
+}
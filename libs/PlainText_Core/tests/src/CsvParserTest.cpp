@@ -25,10 +25,17 @@
 #include "Mdt/PlainText/CsvParserSettings.h"
 #include "Mdt/PlainText/CsvStringParser.h"
 #include "Mdt/PlainText/CsvFileParser.h"
+#include "Mdt/PlainText/CharSearch.h"
+#include "Mdt/PlainText/CsvParallelParserTemplate.h"
+#include "Mdt/PlainText/FieldConversion.h"
 #include <QString>
 #include <QByteArray>
 #include <QTextCodec>
 #include <QTemporaryFile>
+#include <QVector>
+#include <QVariant>
+#include <QDate>
+#include <QMetaType>
 
 using namespace Mdt::PlainText;
 
@@ -125,6 +132,304 @@ void CsvParserTest::stringParserReadAllTest_data()
   buildParserTestData();
 }
 
+void CsvParserTest::stringParserScannerReadAllTest()
+{
+  QFETCH(QString, sourceData);
+  QFETCH(StringRecordList, expectedData);
+  QFETCH(bool, expectedOk);
+  QFETCH(CsvParserSettings, csvSettings);
+  CsvStringParser parser;
+  Mdt::Expected<StringRecordList> recList;
+
+  csvSettings.setParserEngine(CsvParserSettings::ScannerEngine);
+  parser.setCsvSettings(csvSettings);
+  parser.setSource(sourceData);
+  // Parse the entires string
+  recList = parser.readAll();
+  if(expectedOk){
+    QVERIFY(recList.hasValue());
+  }else{
+    QVERIFY(recList.hasError());
+    return;
+  }
+  QVERIFY(recList.hasValue());
+  const auto data = recList.value();
+  // Check
+  QCOMPARE(data.rowCount(), expectedData.rowCount());
+  for(int row = 0; row < data.rowCount(); ++row){
+    QCOMPARE(data.columnCount(row), expectedData.columnCount(row));
+    for(int col = 0; col < data.columnCount(row); ++col){
+      QCOMPARE(data.data(row, col), expectedData.data(row, col));
+    }
+  }
+}
+
+void CsvParserTest::stringParserScannerReadAllTest_data()
+{
+  buildParserTestData();
+}
+
+void CsvParserTest::scannerErrorTest()
+{
+  CsvStringParser parser;
+  CsvParserSettings csvSettings;
+  csvSettings.setParserEngine(CsvParserSettings::ScannerEngine);
+  parser.setCsvSettings(csvSettings);
+  // Field protection not closed
+  QString source = "\"A,B\n";
+  parser.setSource(source);
+  QVERIFY(parser.readAll().hasError());
+  QVERIFY(parser.atEnd());
+  // Garbage after a protected field
+  source = "\"A\"B,C\n";
+  parser.setSource(source);
+  QVERIFY(parser.readAll().hasError());
+  QVERIFY(parser.atEnd());
+}
+
+void CsvParserTest::findFirstOfTest()
+{
+  using Mdt::PlainText::Impl::findFirstOf;
+
+  /*
+   * Check around the sizes of the blocks handled by SIMD versions
+   */
+  for(int size = 0; size < 80; ++size){
+    for(int pos = 0; pos <= size; ++pos){
+      QByteArray bytes(size, 'a');
+      QString str(size, QChar('a'));
+      if(pos < size){
+        bytes[pos] = ',';
+        str[pos] = QChar(0x2C);
+      }
+      const auto *bytesFirst = reinterpret_cast<const uchar*>(bytes.constData());
+      const auto *bytesLast = bytesFirst + bytes.size();
+      QCOMPARE(findFirstOf(bytesFirst, bytesLast, ',', '"', '\r', '\n') - bytesFirst, static_cast<std::ptrdiff_t>(pos));
+      QCOMPARE(findFirstOf(str.cbegin(), str.cend(), ',', '"', '\r', '\n') - str.cbegin(), static_cast<std::ptrdiff_t>(pos));
+    }
+  }
+  // Non ASCII chars must not match
+  const QString str = QString::fromUtf8(u8"\u012C\u022C\u032C\u0A2C\u2C2C\u2C00\u0D0A\u222Cé,");
+  QCOMPARE(findFirstOf(str.cbegin(), str.cend(), ',', '"', '\r', '\n') - str.cbegin(), static_cast<std::ptrdiff_t>(str.size() - 1));
+  const QByteArray bytes = str.toUtf8();
+  const auto *bytesFirst = reinterpret_cast<const uchar*>(bytes.constData());
+  QCOMPARE(findFirstOf(bytesFirst, bytesFirst + bytes.size(), ',', '"', '\r', '\n') - bytesFirst, static_cast<std::ptrdiff_t>(bytes.size() - 1));
+}
+
+void CsvParserTest::parallelChunkBoundariesTest()
+{
+  using Parser = CsvParallelParserTemplate<StringConstIterator>;
+
+  const QString source = "A,B\n\"C\nD\",E\nF,\"\"\"\n\"\nG,H\n";
+  const auto first = source.cbegin();
+  const auto last = source.cend();
+  // Small source, or only 1 chunk requested
+  auto boundaries = Parser::findChunkBoundaries(first, last, 4, source.size(), '"');
+  QCOMPARE(static_cast<int>(boundaries.size()), 2);
+  boundaries = Parser::findChunkBoundaries(first, last, 1, 1, '"');
+  QCOMPARE(static_cast<int>(boundaries.size()), 2);
+  QVERIFY(boundaries.front() == first);
+  QVERIFY(boundaries.back() == last);
+  // Split as much as possible: only EOL outside protected fields must be used
+  boundaries = Parser::findChunkBoundaries(first, last, source.size(), 1, '"');
+  QCOMPARE(static_cast<int>(boundaries.size()), 5);
+  QVERIFY(boundaries[0] == first);
+  QCOMPARE(static_cast<int>(boundaries[1] - first), 4);
+  QCOMPARE(static_cast<int>(boundaries[2] - first), 12);
+  QCOMPARE(static_cast<int>(boundaries[3] - first), 20);
+  QVERIFY(boundaries[4] == last);
+}
+
+void CsvParserTest::parallelParserReadAllTest()
+{
+  QFETCH(QString, sourceData);
+  QFETCH(StringRecordList, expectedData);
+  QFETCH(bool, expectedOk);
+  QFETCH(CsvParserSettings, csvSettings);
+
+  const CsvParserSettings::ParserEngine engines[] = {CsvParserSettings::SpiritEngine, CsvParserSettings::ScannerEngine};
+  for(const auto engine : engines){
+    csvSettings.setParserEngine(engine);
+    CsvParallelParserTemplate<StringConstIterator> parser(csvSettings);
+    parser.setMinimumChunkSize(1);
+    const auto recList = parser.readAll(sourceData.cbegin(), sourceData.cend(), 4);
+    if(expectedOk){
+      QVERIFY(recList.hasValue());
+    }else{
+      QVERIFY(recList.hasError());
+      continue;
+    }
+    const auto data = recList.value();
+    // Check
+    QCOMPARE(data.rowCount(), expectedData.rowCount());
+    for(int row = 0; row < data.rowCount(); ++row){
+      QCOMPARE(data.columnCount(row), expectedData.columnCount(row));
+      for(int col = 0; col < data.columnCount(row); ++col){
+        QCOMPARE(data.data(row, col), expectedData.data(row, col));
+      }
+    }
+  }
+}
+
+void CsvParserTest::parallelParserReadAllTest_data()
+{
+  buildParserTestData();
+}
+
+void CsvParserTest::stringParserParallelReadAllTest()
+{
+  CsvParserSettings csvSettings;
+  CsvStringParser parser;
+  QString source;
+
+  /*
+   * Build a source that is big enough to be splitted
+   */
+  for(int row = 0; row < 20000; ++row){
+    source += QString("%1,\"A,\"\"%1\"\"\nB\",C\n").arg(row);
+  }
+  // Reference: sequential parsing
+  parser.setCsvSettings(csvSettings);
+  parser.setSource(source);
+  const auto expectedList = parser.readAll();
+  QVERIFY(expectedList.hasValue());
+  QCOMPARE(expectedList.value().rowCount(), 20000);
+  // Parallel parsing
+  csvSettings.setThreadCount(4);
+  parser.setCsvSettings(csvSettings);
+  parser.setSource(source);
+  const auto recList = parser.readAll();
+  QVERIFY(recList.hasValue());
+  QVERIFY(parser.atEnd());
+  const auto data = recList.value();
+  const auto expectedData = expectedList.value();
+  QCOMPARE(data.rowCount(), expectedData.rowCount());
+  for(int row = 0; row < data.rowCount(); ++row){
+    QCOMPARE(data.columnCount(row), 3);
+    for(int col = 0; col < 3; ++col){
+      QCOMPARE(data.data(row, col), expectedData.data(row, col));
+    }
+  }
+}
+
+void CsvParserTest::fieldConversionTest()
+{
+  QFETCH(QString, field);
+  QFETCH(int, type);
+  QFETCH(bool, expectedOk);
+  QFETCH(QVariant, expectedValue);
+  QVariant value;
+
+  const auto metaType = static_cast<QMetaType::Type>(type);
+  // From a UTF-16 source
+  QCOMPARE(Impl::convertField(field.constData(), field.constData() + field.size(), metaType, value), expectedOk);
+  if(expectedOk){
+    QCOMPARE(value.userType(), type);
+    QCOMPARE(value.isNull(), expectedValue.isNull());
+    QCOMPARE(value, expectedValue);
+  }
+  // From a byte source
+  const QByteArray bytes = field.toLatin1();
+  const auto *first = reinterpret_cast<const uchar*>(bytes.constData());
+  QCOMPARE(Impl::convertField(first, first + bytes.size(), metaType, value), expectedOk);
+  if(expectedOk){
+    QCOMPARE(value.userType(), type);
+    QCOMPARE(value, expectedValue);
+  }
+}
+
+void CsvParserTest::fieldConversionTest_data()
+{
+  QTest::addColumn<QString>("field");
+  QTest::addColumn<int>("type");
+  QTest::addColumn<bool>("expectedOk");
+  QTest::addColumn<QVariant>("expectedValue");
+
+  const int Int = QMetaType::Int;
+  const int LongLong = QMetaType::LongLong;
+  const int Double = QMetaType::Double;
+  const int Date = QMetaType::QDate;
+
+  QTest::newRow("int,empty") << "" << Int << true << QVariant(QVariant::Int);
+  QTest::newRow("int,0") << "0" << Int << true << QVariant(0);
+  QTest::newRow("int,-15") << "-15" << Int << true << QVariant(-15);
+  QTest::newRow("int,+15") << "+15" << Int << true << QVariant(15);
+  QTest::newRow("int,max") << "2147483647" << Int << true << QVariant(2147483647);
+  QTest::newRow("int,min") << "-2147483648" << Int << true << QVariant(-2147483647-1);
+  QTest::newRow("int,overflow") << "2147483648" << Int << false << QVariant();
+  QTest::newRow("int,1.5") << "1.5" << Int << false << QVariant();
+  QTest::newRow("int,A") << "A" << Int << false << QVariant();
+  QTest::newRow("int,-") << "-" << Int << false << QVariant();
+  QTest::newRow("int, 1") << " 1" << Int << false << QVariant();
+  QTest::newRow("longlong,max") << "9223372036854775807" << LongLong << true << QVariant(Q_INT64_C(9223372036854775807));
+  QTest::newRow("longlong,-5") << "-5" << LongLong << true << QVariant(Q_INT64_C(-5));
+  QTest::newRow("longlong,overflow") << "9223372036854775808" << LongLong << false << QVariant();
+  QTest::newRow("double,empty") << "" << Double << true << QVariant(QVariant::Double);
+  QTest::newRow("double,0") << "0" << Double << true << QVariant(0.0);
+  QTest::newRow("double,1.5") << "1.5" << Double << true << QVariant(1.5);
+  QTest::newRow("double,-0.25") << "-0.25" << Double << true << QVariant(-0.25);
+  QTest::newRow("double,.5") << ".5" << Double << true << QVariant(0.5);
+  QTest::newRow("double,0.1") << "0.1" << Double << true << QVariant(0.1);
+  QTest::newRow("double,1e3") << "1e3" << Double << true << QVariant(1000.0);
+  QTest::newRow("double,1.5E-3") << "1.5E-3" << Double << true << QVariant(1.5e-3);
+  QTest::newRow("double,pi") << "3.14159265358979323846" << Double << true << QVariant(3.14159265358979323846);
+  QTest::newRow("double,max") << "1.7976931348623157e308" << Double << true << QVariant(1.7976931348623157e308);
+  QTest::newRow("double,24 digits") << "123456789012345678901234" << Double << true << QVariant(123456789012345678901234.0);
+  QTest::newRow("double,.") << "." << Double << false << QVariant();
+  QTest::newRow("double,1e") << "1e" << Double << false << QVariant();
+  QTest::newRow("double,1,5") << "1,5" << Double << false << QVariant();
+  QTest::newRow("double,A") << "A" << Double << false << QVariant();
+  QTest::newRow("date,empty") << "" << Date << true << QVariant(QVariant::Date);
+  QTest::newRow("date,2017-03-25") << "2017-03-25" << Date << true << QVariant(QDate(2017, 3, 25));
+  QTest::newRow("date,2016-02-29") << "2016-02-29" << Date << true << QVariant(QDate(2016, 2, 29));
+  QTest::newRow("date,2017-02-29") << "2017-02-29" << Date << false << QVariant();
+  QTest::newRow("date,2017-3-25") << "2017-3-25" << Date << false << QVariant();
+  QTest::newRow("date,25.03.2017") << "25.03.2017" << Date << false << QVariant();
+  QTest::newRow("date,2017-+3-25") << "2017-+3-25" << Date << false << QVariant();
+}
+
+void CsvParserTest::stringParserReadAllTypedTest()
+{
+  QFETCH(int, parserEngine);
+  QFETCH(int, threadCount);
+  CsvStringParser parser;
+  CsvParserSettings csvSettings;
+
+  csvSettings.setParserEngine(static_cast<CsvParserSettings::ParserEngine>(parserEngine));
+  csvSettings.setThreadCount(threadCount);
+  csvSettings.setColumnDataTypes({QMetaType::Int, QMetaType::QString, QMetaType::Double, QMetaType::QDate, QMetaType::LongLong});
+  QVERIFY(csvSettings.isValid());
+  parser.setCsvSettings(csvSettings);
+  /*
+   * Valid source
+   */
+  const QString source = "1,A,1.5,2017-03-25,10000000000,X\n"
+                         "\"2\",\"B,\"\"C\"\"\",\"-2.5\",,,\n"
+                         "3,,,2017-12-31,-1\n";
+  parser.setSource(source);
+  const auto recordList = parser.readAllTyped();
+  QVERIFY(recordList.hasValue());
+  QVERIFY(parser.atEnd());
+  checkTypedTestData(recordList.value());
+  /*
+   * Conversion error
+   */
+  const QString badSource = "1,A,1.5\n"
+                            "B,A,1.5\n";
+  parser.setSource(badSource);
+  QVERIFY(parser.readAllTyped().hasError());
+}
+
+void CsvParserTest::stringParserReadAllTypedTest_data()
+{
+  QTest::addColumn<int>("parserEngine");
+  QTest::addColumn<int>("threadCount");
+
+  QTest::newRow("Spirit") << static_cast<int>(CsvParserSettings::SpiritEngine) << 1;
+  QTest::newRow("Scanner") << static_cast<int>(CsvParserSettings::ScannerEngine) << 1;
+  QTest::newRow("Scanner,2 threads") << static_cast<int>(CsvParserSettings::ScannerEngine) << 2;
+}
+
 void CsvParserTest::fileParserReadLineTest()
 {
   QFETCH(QString, sourceData);
@@ -241,6 +546,296 @@ void CsvParserTest::fileParserReadAllTest_data()
   buildParserTestData();
 }
 
+void CsvParserTest::fileParserMemoryMappedReadAllTest()
+{
+  QFETCH(QString, sourceData);
+  QFETCH(StringRecordList, expectedData);
+  QFETCH(bool, expectedOk);
+  QFETCH(CsvParserSettings, csvSettings);
+  CsvFileParser parser;
+  QTemporaryFile file;
+
+  /*
+   * Prepare file
+   */
+  QVERIFY(writeTemporaryTextFile(file, sourceData, "UTF-8"));
+  /*
+   * Initial state
+   */
+  QCOMPARE(parser.inputMode(), CsvFileParser::BufferedInput);
+  QVERIFY(!parser.isOpen());
+  QVERIFY(parser.atEnd());
+  // Setup CSV parser
+  parser.setCsvSettings(csvSettings);
+  parser.setInputMode(CsvFileParser::MemoryMappedInput);
+  QCOMPARE(parser.inputMode(), CsvFileParser::MemoryMappedInput);
+  QVERIFY(parser.openFile(file.fileName(), "UTF-8"));
+  QVERIFY(parser.isOpen());
+  // Parse the file
+  const auto recList = parser.readAll();
+  if(expectedOk){
+    QVERIFY(recList.hasValue());
+  }else{
+    QVERIFY(recList.hasError());
+    return;
+  }
+  QVERIFY(recList.hasValue());
+  const auto data = recList.value();
+  // Close
+  parser.closeFile();
+  QVERIFY(!parser.isOpen());
+  QVERIFY(parser.atEnd());
+  // Check
+  QCOMPARE(data.rowCount(), expectedData.rowCount());
+  for(int row = 0; row < data.rowCount(); ++row){
+    QCOMPARE(data.columnCount(row), expectedData.columnCount(row));
+    for(int col = 0; col < data.columnCount(row); ++col){
+      QCOMPARE(data.data(row, col), expectedData.data(row, col));
+    }
+  }
+}
+
+void CsvParserTest::fileParserMemoryMappedReadAllTest_data()
+{
+  buildParserTestData();
+}
+
+void CsvParserTest::fileParserMemoryMappedScannerReadAllTest()
+{
+  QFETCH(QString, sourceData);
+  QFETCH(StringRecordList, expectedData);
+  QFETCH(bool, expectedOk);
+  QFETCH(CsvParserSettings, csvSettings);
+  CsvFileParser parser;
+  QTemporaryFile file;
+
+  QVERIFY(writeTemporaryTextFile(file, sourceData, "UTF-8"));
+  csvSettings.setParserEngine(CsvParserSettings::ScannerEngine);
+  parser.setCsvSettings(csvSettings);
+  parser.setInputMode(CsvFileParser::MemoryMappedInput);
+  QVERIFY(parser.openFile(file.fileName(), "UTF-8"));
+  // Parse the file
+  const auto recList = parser.readAll();
+  if(expectedOk){
+    QVERIFY(recList.hasValue());
+  }else{
+    QVERIFY(recList.hasError());
+    return;
+  }
+  QVERIFY(recList.hasValue());
+  const auto data = recList.value();
+  parser.closeFile();
+  // Check
+  QCOMPARE(data.rowCount(), expectedData.rowCount());
+  for(int row = 0; row < data.rowCount(); ++row){
+    QCOMPARE(data.columnCount(row), expectedData.columnCount(row));
+    for(int col = 0; col < data.columnCount(row); ++col){
+      QCOMPARE(data.data(row, col), expectedData.data(row, col));
+    }
+  }
+}
+
+void CsvParserTest::fileParserMemoryMappedScannerReadAllTest_data()
+{
+  buildParserTestData();
+}
+
+void CsvParserTest::fileParserMemoryMappedLatin1Test()
+{
+  CsvFileParser parser;
+  CsvParserSettings csvSettings;
+  QTemporaryFile file;
+
+  QVERIFY(writeTemporaryTextFile(file, QString::fromUtf8(u8"A,é\n\"à,B\",ü\n"), "ISO-8859-1"));
+  parser.setCsvSettings(csvSettings);
+  parser.setInputMode(CsvFileParser::MemoryMappedInput);
+  QVERIFY(parser.openFile(file.fileName(), "ISO-8859-1"));
+  const auto recList = parser.readAll();
+  QVERIFY(recList.hasValue());
+  const auto data = recList.value();
+  QCOMPARE(data.rowCount(), 2);
+  QCOMPARE(data.columnCount(0), 2);
+  QCOMPARE(data.data(0, 0), QString("A"));
+  QCOMPARE(data.data(0, 1), QString::fromUtf8(u8"é"));
+  QCOMPARE(data.columnCount(1), 2);
+  QCOMPARE(data.data(1, 0), QString::fromUtf8(u8"à,B"));
+  QCOMPARE(data.data(1, 1), QString::fromUtf8(u8"ü"));
+}
+
+void CsvParserTest::fileParserMemoryMappedSeekTest()
+{
+  CsvFileParser parser;
+  CsvParserSettings csvSettings;
+  QTemporaryFile file;
+
+  QVERIFY(writeTemporaryTextFile(file, QString::fromUtf8(u8"A,é\n\"B\nC\",D\nE,F\n"), "UTF-8"));
+  parser.setCsvSettings(csvSettings);
+  parser.setInputMode(CsvFileParser::MemoryMappedInput);
+  QVERIFY(parser.openFile(file.fileName(), "UTF-8"));
+  QCOMPARE(parser.mappedPosition(), qint64(0));
+  QVERIFY(parser.readLine().hasValue());
+  const qint64 secondRecordPosition = parser.mappedPosition();
+  QCOMPARE(secondRecordPosition, qint64(5));
+  QVERIFY(parser.readLine().hasValue());
+  QVERIFY(parser.readLine().hasValue());
+  QVERIFY(parser.atEnd());
+  // Seek back to the second record
+  parser.seekToMappedPosition(secondRecordPosition);
+  QVERIFY(!parser.atEnd());
+  auto record = parser.readLine();
+  QVERIFY(record.hasValue());
+  QCOMPARE(record.value().columnCount(), 2);
+  QCOMPARE(record.value().data(0), QString("B\nC"));
+  QCOMPARE(record.value().data(1), QString("D"));
+  // Seek back to the first record
+  parser.seekToMappedPosition(0);
+  record = parser.readLine();
+  QVERIFY(record.hasValue());
+  QCOMPARE(record.value().data(0), QString("A"));
+  QCOMPARE(record.value().data(1), QString::fromUtf8(u8"é"));
+}
+
+void CsvParserTest::fileParserReadAllInBatchesTest()
+{
+  CsvFileParser parser;
+  CsvParserSettings csvSettings;
+  QTemporaryFile file;
+  QString source;
+  QVector<int> batchSizes;
+  StringRecordList data;
+
+  for(int row = 0; row < 10; ++row){
+    source += QString("%1,\"A\nB\"\n").arg(row);
+  }
+  QVERIFY(writeTemporaryTextFile(file, source, "UTF-8"));
+  parser.setCsvSettings(csvSettings);
+  const auto handler = [&batchSizes, &data](const StringRecordList & batch){
+    batchSizes.append(batch.rowCount());
+    for(const auto & record : batch){
+      data.appendRecord(record);
+    }
+    return true;
+  };
+  /*
+   * Read all
+   */
+  QVERIFY(parser.openFile(file.fileName(), "UTF-8"));
+  auto count = parser.readAllInBatches(3, handler);
+  QVERIFY(count.hasValue());
+  QCOMPARE(count.value(), Q_INT64_C(10));
+  QVERIFY(parser.atEnd());
+  QCOMPARE(batchSizes, QVector<int>({3,3,3,1}));
+  QCOMPARE(data.rowCount(), 10);
+  for(int row = 0; row < 10; ++row){
+    QCOMPARE(data.columnCount(row), 2);
+    QCOMPARE(data.data(row, 0), QString::number(row));
+    QCOMPARE(data.data(row, 1), QString("A\nB"));
+  }
+  parser.closeFile();
+  /*
+   * Stop after first batch
+   */
+  batchSizes.clear();
+  QVERIFY(parser.openFile(file.fileName(), "UTF-8"));
+  count = parser.readAllInBatches(4, [&batchSizes](const StringRecordList & batch){
+    batchSizes.append(batch.rowCount());
+    return false;
+  });
+  QVERIFY(count.hasValue());
+  QCOMPARE(count.value(), Q_INT64_C(4));
+  QVERIFY(!parser.atEnd());
+  QCOMPARE(batchSizes, QVector<int>({4}));
+  parser.closeFile();
+}
+
+void CsvParserTest::fileParserMemoryMappedUnsupportedEncodingTest()
+{
+  CsvFileParser parser;
+  CsvParserSettings csvSettings;
+  QTemporaryFile file;
+
+  QVERIFY(writeTemporaryTextFile(file, "A,B\n", "UTF-16"));
+  parser.setCsvSettings(csvSettings);
+  parser.setInputMode(CsvFileParser::MemoryMappedInput);
+  QVERIFY(!parser.openFile(file.fileName(), "UTF-16"));
+  QVERIFY(!parser.isOpen());
+}
+
+void CsvParserTest::fileParserReadAllTypedTest()
+{
+  QFETCH(int, inputMode);
+  QFETCH(int, parserEngine);
+  QFETCH(int, threadCount);
+  CsvFileParser parser;
+  CsvParserSettings csvSettings;
+  QTemporaryFile file;
+
+  const QString source = "1,A,1.5,2017-03-25,10000000000,X\n"
+                         "\"2\",\"B,\"\"C\"\"\",\"-2.5\",,,\n"
+                         "3,,,2017-12-31,-1\n";
+  QVERIFY(writeTemporaryTextFile(file, source, "UTF-8"));
+  csvSettings.setParserEngine(static_cast<CsvParserSettings::ParserEngine>(parserEngine));
+  csvSettings.setThreadCount(threadCount);
+  csvSettings.setColumnDataTypes({QMetaType::Int, QMetaType::QString, QMetaType::Double, QMetaType::QDate, QMetaType::LongLong});
+  parser.setCsvSettings(csvSettings);
+  parser.setInputMode(static_cast<CsvFileParser::InputMode>(inputMode));
+  QVERIFY(parser.openFile(file.fileName(), "UTF-8"));
+  const auto recordList = parser.readAllTyped();
+  QVERIFY(recordList.hasValue());
+  QVERIFY(parser.atEnd());
+  checkTypedTestData(recordList.value());
+}
+
+void CsvParserTest::fileParserReadAllTypedTest_data()
+{
+  QTest::addColumn<int>("inputMode");
+  QTest::addColumn<int>("parserEngine");
+  QTest::addColumn<int>("threadCount");
+
+  const int buffered = CsvFileParser::BufferedInput;
+  const int mapped = CsvFileParser::MemoryMappedInput;
+  const int spirit = CsvParserSettings::SpiritEngine;
+  const int scanner = CsvParserSettings::ScannerEngine;
+
+  QTest::newRow("Buffered") << buffered << spirit << 1;
+  QTest::newRow("Mapped,Spirit") << mapped << spirit << 1;
+  QTest::newRow("Mapped,Scanner") << mapped << scanner << 1;
+  QTest::newRow("Mapped,Scanner,2 threads") << mapped << scanner << 2;
+}
+
+/*
+ * Helpers
+ */
+
+void CsvParserTest::checkTypedTestData(const RecordList & data)
+{
+  QCOMPARE(data.rowCount(), 3);
+  QCOMPARE(data.columnCount(0), 6);
+  QCOMPARE(data.data(0, 0), QVariant(1));
+  QCOMPARE(data.data(0, 0).userType(), static_cast<int>(QMetaType::Int));
+  QCOMPARE(data.data(0, 1), QVariant("A"));
+  QCOMPARE(data.data(0, 2), QVariant(1.5));
+  QCOMPARE(data.data(0, 2).userType(), static_cast<int>(QMetaType::Double));
+  QCOMPARE(data.data(0, 3), QVariant(QDate(2017, 3, 25)));
+  QCOMPARE(data.data(0, 4), QVariant(Q_INT64_C(10000000000)));
+  QCOMPARE(data.data(0, 4).userType(), static_cast<int>(QMetaType::LongLong));
+  QCOMPARE(data.data(0, 5), QVariant("X"));
+  QCOMPARE(data.columnCount(1), 6);
+  QCOMPARE(data.data(1, 0), QVariant(2));
+  QCOMPARE(data.data(1, 1), QVariant("B,\"C\""));
+  QCOMPARE(data.data(1, 2), QVariant(-2.5));
+  QVERIFY(data.data(1, 3).isNull());
+  QCOMPARE(data.data(1, 3).userType(), static_cast<int>(QMetaType::QDate));
+  QVERIFY(data.data(1, 4).isNull());
+  QCOMPARE(data.data(1, 5), QVariant(""));
+  QCOMPARE(data.columnCount(2), 5);
+  QCOMPARE(data.data(2, 0), QVariant(3));
+  QCOMPARE(data.data(2, 1), QVariant(""));
+  QVERIFY(data.data(2, 2).isNull());
+  QCOMPARE(data.data(2, 3), QVariant(QDate(2017, 12, 31)));
+  QCOMPARE(data.data(2, 4), QVariant(Q_INT64_C(-1)));
+}
+
 void CsvParserTest::buildParserTestData()
 {
   QTest::addColumn<QString>("sourceData");
@@ -22,6 +22,7 @@
 #define MDT_PLAIN_TEXT_CSV_PARSER_TEST_H
 
 #include "TestBase.h"
+#include "Mdt/PlainText/RecordList.h"
 
 class CsvParserTest : public TestBase
 {
@@ -36,15 +37,38 @@ class CsvParserTest : public TestBase
   void stringParserReadLineTest_data();
   void stringParserReadAllTest();
   void stringParserReadAllTest_data();
+  void stringParserScannerReadAllTest();
+  void stringParserScannerReadAllTest_data();
+  void scannerErrorTest();
+  void findFirstOfTest();
+  void parallelChunkBoundariesTest();
+  void parallelParserReadAllTest();
+  void parallelParserReadAllTest_data();
+  void stringParserParallelReadAllTest();
+  void fieldConversionTest();
+  void fieldConversionTest_data();
+  void stringParserReadAllTypedTest();
+  void stringParserReadAllTypedTest_data();
 
   void fileParserReadLineTest();
   void fileParserReadLineTest_data();
   void fileParserReadAllTest();
   void fileParserReadAllTest_data();
+  void fileParserMemoryMappedReadAllTest();
+  void fileParserMemoryMappedReadAllTest_data();
+  void fileParserMemoryMappedScannerReadAllTest();
+  void fileParserMemoryMappedScannerReadAllTest_data();
+  void fileParserMemoryMappedLatin1Test();
+  void fileParserMemoryMappedSeekTest();
+  void fileParserReadAllInBatchesTest();
+  void fileParserMemoryMappedUnsupportedEncodingTest();
+  void fileParserReadAllTypedTest();
+  void fileParserReadAllTypedTest_data();
 
  private:
 
   void buildParserTestData();
+  static void checkTypedTestData(const Mdt::PlainText::RecordList & data);
 };
 
 #endif // #ifndef MDT_PLAIN_TEXT_CSV_PARSER_TEST_H
@@ -0,0 +1,265 @@
+/****************************************************************************
+ **
+ ** Copyright (C) 2011-2017 Philippe Steinmann.
+ **
+ ** This file is part of multiDiagTools library.
+ **
+ ** multiDiagTools is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Lesser General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** multiDiagTools is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public License
+ ** along with multiDiagTools.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+#include "CsvRowIndexTest.h"
+#include "Mdt/PlainText/CsvRowIndex.h"
+#include "Mdt/PlainText/CsvParserSettings.h"
+#include "Mdt/PlainText/CsvFileParser.h"
+#include "Mdt/PlainText/StringRecordList.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryFile>
+
+using namespace Mdt::PlainText;
+
+Q_DECLARE_METATYPE(Mdt::PlainText::CsvFileParser::InputMode)
+
+void CsvRowIndexTest::initTestCase()
+{
+}
+
+void CsvRowIndexTest::cleanupTestCase()
+{
+}
+
+/*
+ * Tests
+ */
+
+void CsvRowIndexTest::buildTest()
+{
+  QFETCH(QByteArray, fileData);
+  QFETCH(int, indexInterval);
+  QFETCH(qint64, expectedRowCount);
+  CsvRowIndex index;
+  QTemporaryFile file;
+
+  QVERIFY(file.open());
+  QVERIFY(file.write(fileData) == fileData.size());
+  file.close();
+  /*
+   * Initial state
+   */
+  QVERIFY(index.isEmpty());
+  QCOMPARE(index.rowCount(), 0LL);
+  QVERIFY(index.isFinished());
+  /*
+   * Build
+   */
+  index.setCsvSettings(CsvParserSettings());
+  index.setIndexInterval(indexInterval);
+  QCOMPARE(index.indexInterval(), indexInterval);
+  QVERIFY(index.build(file.fileName(), "UTF-8"));
+  QCOMPARE(index.rowCount(), expectedRowCount);
+  QCOMPARE(index.fileSize(), static_cast<qint64>(fileData.size()));
+  QCOMPARE(index.indexedByteCount(), static_cast<qint64>(fileData.size()));
+  for(qint64 row = 0; row < index.rowCount(); ++row){
+    const auto position = index.nearestPosition(row);
+    QVERIFY(position.row <= row);
+    QVERIFY(row - position.row < indexInterval);
+    QVERIFY(position.offset >= 0);
+    QVERIFY(position.offset < fileData.size());
+  }
+  /*
+   * Clear
+   */
+  index.clear();
+  QVERIFY(index.isEmpty());
+  QCOMPARE(index.fileSize(), 0LL);
+}
+
+void CsvRowIndexTest::buildTest_data()
+{
+  QTest::addColumn<QByteArray>("fileData");
+  QTest::addColumn<int>("indexInterval");
+  QTest::addColumn<qint64>("expectedRowCount");
+
+  QTest::newRow("Empty") << QByteArray() << 1 << 0LL;
+  QTest::newRow("A") << QByteArray("A") << 1 << 1LL;
+  QTest::newRow("A\\n") << QByteArray("A\n") << 1 << 1LL;
+  QTest::newRow("A\\r\\n") << QByteArray("A\r\n") << 1 << 1LL;
+  QTest::newRow("A\\nB") << QByteArray("A\nB") << 1 << 2LL;
+  QTest::newRow("A\\nB\\n") << QByteArray("A\nB\n") << 1 << 2LL;
+  QTest::newRow("A,B\\r\\nC,D\\r\\n") << QByteArray("A,B\r\nC,D\r\n") << 1 << 2LL;
+  QTest::newRow("\"A\\nB\"\\nC") << QByteArray("\"A\nB\"\nC") << 1 << 2LL;
+  QTest::newRow("\"A\"\"\\n\"\\nC") << QByteArray("\"A\"\"\n\"\nC") << 1 << 2LL;
+  QTest::newRow("BOM,A\\nB") << QByteArray("\xEF\xBB\xBF" "A\nB") << 1 << 2LL;
+  QTest::newRow("BOM") << QByteArray("\xEF\xBB\xBF") << 1 << 0LL;
+  QTest::newRow("5 rows,2") << QByteArray("1\n2\n3\n4\n5\n") << 2 << 5LL;
+  QTest::newRow("5 rows,10") << QByteArray("1\n2\n3\n4\n5\n") << 10 << 5LL;
+}
+
+void CsvRowIndexTest::backgroundBuildTest()
+{
+  CsvRowIndex index;
+  QTemporaryFile file;
+  QByteArray fileData;
+
+  for(int i = 0; i < 10000; ++i){
+    fileData += "\"Line\n" + QByteArray::number(i) + "\",A,B\n";
+  }
+  QVERIFY(file.open());
+  QVERIFY(file.write(fileData) == fileData.size());
+  file.close();
+  index.setIndexInterval(100);
+  index.startBuild(file.fileName(), "UTF-8");
+  QVERIFY(index.waitForFinished());
+  QVERIFY(index.isFinished());
+  QCOMPARE(index.rowCount(), 10000LL);
+  QCOMPARE(index.indexedByteCount(), static_cast<qint64>(fileData.size()));
+  /*
+   * Cancel a build
+   */
+  index.startBuild(file.fileName(), "UTF-8");
+  index.cancel();
+  index.waitForFinished();
+  QVERIFY(index.isFinished());
+  /*
+   * Unsupported encoding
+   */
+  QVERIFY(!index.build(file.fileName(), "UTF-16"));
+}
+
+void CsvRowIndexTest::sidecarFileTest()
+{
+  CsvRowIndex index;
+  CsvRowIndex loadedIndex;
+  QTemporaryFile file;
+
+  QVERIFY(file.open());
+  QVERIFY(file.write("A\nB\nC\n") == 6);
+  file.close();
+  const QFileInfo fileInfo(file.fileName());
+  const auto sidecarFilePath = CsvRowIndex::sidecarFilePath(fileInfo);
+  QCOMPARE(sidecarFilePath, fileInfo.absoluteFilePath() + ".idx");
+  /*
+   * Save and load
+   */
+  index.setIndexInterval(2);
+  QVERIFY(index.build(fileInfo, "UTF-8"));
+  QVERIFY(index.save(sidecarFilePath));
+  loadedIndex.setIndexInterval(2);
+  QVERIFY(loadedIndex.load(sidecarFilePath, fileInfo));
+  QCOMPARE(loadedIndex.rowCount(), index.rowCount());
+  QCOMPARE(loadedIndex.fileSize(), index.fileSize());
+  QCOMPARE(loadedIndex.nearestPosition(2).offset, index.nearestPosition(2).offset);
+  /*
+   * Load with other settings
+   */
+  loadedIndex.setIndexInterval(1);
+  QVERIFY(!loadedIndex.load(sidecarFilePath, fileInfo));
+  QVERIFY(loadedIndex.isEmpty());
+  loadedIndex.setIndexInterval(2);
+  /*
+   * Load outdated index
+   */
+  QVERIFY(file.open());
+  QVERIFY(file.seek(file.size()));
+  QVERIFY(file.write("D\n") == 2);
+  file.close();
+  QVERIFY(!loadedIndex.load(sidecarFilePath, fileInfo));
+  QVERIFY(loadedIndex.isEmpty());
+  /*
+   * Load a file that is not a index
+   */
+  QVERIFY(!loadedIndex.load(file.fileName(), fileInfo));
+
+  QVERIFY(QFile::remove(sidecarFilePath));
+}
+
+void CsvRowIndexTest::seekToRowTest()
+{
+  QFETCH(CsvFileParser::InputMode, inputMode);
+  QFETCH(int, indexInterval);
+  CsvParserSettings csvSettings;
+  CsvRowIndex index;
+  CsvFileParser parser;
+  QTemporaryFile file;
+  QByteArray fileData;
+
+  /*
+   * Prepare file
+   */
+  fileData = "\xEF\xBB\xBF";
+  for(int i = 0; i < 50; ++i){
+    fileData += "\"" + QByteArray::number(i) + "\r\n\"\"A\"\"\",\xC3\xA9,B\r\n";
+  }
+  QVERIFY(file.open());
+  QVERIFY(file.write(fileData) == fileData.size());
+  file.close();
+  index.setCsvSettings(csvSettings);
+  index.setIndexInterval(indexInterval);
+  QVERIFY(index.build(file.fileName(), "UTF-8"));
+  QCOMPARE(index.rowCount(), 50LL);
+  /*
+   * Read reference data
+   */
+  parser.setCsvSettings(csvSettings);
+  parser.setInputMode(inputMode);
+  QVERIFY(parser.openFile(file.fileName(), "UTF-8"));
+  const auto expectedData = parser.readAll();
+  QVERIFY(expectedData);
+  QCOMPARE(expectedData->rowCount(), 50);
+  /*
+   * Seek to each row, in reverse order
+   */
+  for(int row = 49; row >= 0; --row){
+    QVERIFY(parser.seekToRow(index, row));
+    const auto record = parser.readLine();
+    QVERIFY(record);
+    QCOMPARE(record->columnCount(), expectedData->columnCount(row));
+    for(int col = 0; col < record->columnCount(); ++col){
+      QCOMPARE(record->data(col), expectedData->data(row, col));
+    }
+  }
+  // Read to the end after a seek
+  QVERIFY(parser.seekToRow(index, 48));
+  QVERIFY(parser.readLine());
+  QVERIFY(parser.readLine());
+  QVERIFY(parser.atEnd());
+  /*
+   * Out of range
+   */
+  QVERIFY(!parser.seekToRow(index, 50));
+  parser.closeFile();
+}
+
+void CsvRowIndexTest::seekToRowTest_data()
+{
+  QTest::addColumn<CsvFileParser::InputMode>("inputMode");
+  QTest::addColumn<int>("indexInterval");
+
+  QTest::newRow("Buffered,1") << CsvFileParser::BufferedInput << 1;
+  QTest::newRow("Buffered,7") << CsvFileParser::BufferedInput << 7;
+  QTest::newRow("Mapped,1") << CsvFileParser::MemoryMappedInput << 1;
+  QTest::newRow("Mapped,7") << CsvFileParser::MemoryMappedInput << 7;
+}
+
+/*
+ * Main
+ */
+
+int main(int argc, char **argv)
+{
+  Mdt::CoreApplication app(argc, argv);
+  CsvRowIndexTest test;
+
+  return QTest::qExec(&test, argc, argv);
+}
@@ -23,6 +23,7 @@
 #include "Mdt/PlainText/RecordList.h"
 #include "Mdt/PlainText/StringRecord.h"
 #include "Mdt/PlainText/StringRecordList.h"
+#include "Mdt/PlainText/ColumnarStringRecordList.h"
 #include <QVector>
 #include <algorithm>
 #include <iterator>
@@ -313,6 +314,71 @@ void DataTest::stringRecordListTest()
   QCOMPARE(list1, list2);
 }
 
+void DataTest::columnarStringRecordListTest()
+{
+  ColumnarStringRecordList list;
+  /*
+   * Initial state
+   */
+  QCOMPARE(list.rowCount(), 0);
+  QCOMPARE(list.maximumColumnCount(), 0);
+  QVERIFY(list.isEmpty());
+  /*
+   * Add/get
+   */
+  list.appendRecord({"A","BC"});
+  QCOMPARE(list.rowCount(), 1);
+  QVERIFY(!list.isEmpty());
+  QCOMPARE(list.columnCount(0), 2);
+  QCOMPARE(list.maximumColumnCount(), 2);
+  QCOMPARE(list.data(0, 0).toString(), QString("A"));
+  QCOMPARE(list.data(0, 1).toString(), QString("BC"));
+  QCOMPARE(list.value(0, 1).toString(), QString("BC"));
+  QVERIFY(list.value(0, 2).isNull());
+  QVERIFY(list.value(1, 0).isNull());
+  // Fewer columns
+  list.appendRecord({"D"});
+  QCOMPARE(list.rowCount(), 2);
+  QCOMPARE(list.columnCount(1), 1);
+  QCOMPARE(list.maximumColumnCount(), 2);
+  QCOMPARE(list.data(1, 0).toString(), QString("D"));
+  QVERIFY(list.value(1, 1).isNull());
+  // More columns
+  list.appendRecord({"E","","FGH"});
+  QCOMPARE(list.rowCount(), 3);
+  QCOMPARE(list.columnCount(2), 3);
+  QCOMPARE(list.maximumColumnCount(), 3);
+  QCOMPARE(list.data(2, 0).toString(), QString("E"));
+  QVERIFY(list.data(2, 1).isEmpty());
+  QCOMPARE(list.data(2, 2).toString(), QString("FGH"));
+  // Previous rows are unchanged
+  QCOMPARE(list.data(0, 0).toString(), QString("A"));
+  QCOMPARE(list.data(0, 1).toString(), QString("BC"));
+  QCOMPARE(list.data(1, 0).toString(), QString("D"));
+  QCOMPARE(list.columnCount(0), 2);
+  QCOMPARE(list.record(0), StringRecord({"A","BC"}));
+  QCOMPARE(list.record(2), StringRecord({"E","","FGH"}));
+  /*
+   * Clear
+   */
+  list.clear();
+  QCOMPARE(list.rowCount(), 0);
+  QCOMPARE(list.maximumColumnCount(), 0);
+  /*
+   * From a StringRecordList
+   */
+  const StringRecordList source = {{"1","A"},{"2","B","X"}};
+  list = ColumnarStringRecordList(source);
+  QCOMPARE(list.rowCount(), 2);
+  QCOMPARE(list.columnCount(0), 2);
+  QCOMPARE(list.columnCount(1), 3);
+  QCOMPARE(list.data(0, 0).toString(), QString("1"));
+  QCOMPARE(list.data(0, 1).toString(), QString("A"));
+  QCOMPARE(list.data(1, 0).toString(), QString("2"));
+  QCOMPARE(list.data(1, 1).toString(), QString("B"));
+  QCOMPARE(list.data(1, 2).toString(), QString("X"));
+}
+
 /*
  * Main
  */
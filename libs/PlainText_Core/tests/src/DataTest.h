@@ -41,6 +41,7 @@ class DataTest : public TestBase
 
   void stringRecordTest();
   void stringRecordListTest();
+  void columnarStringRecordListTest();
 
 };
 
@@ -21,9 +21,11 @@
 #include "FileInputIteratorTest.h"
 #include "Mdt/PlainText/FileInputIteratorSharedData.h"
 #include "Mdt/PlainText/FileInputIterator.h"
+#include "Mdt/PlainText/TextDecoding.h"
 #include <QTemporaryFile>
 #include <QTextCodec>
 #include <QString>
+#include <QVector>
 
 #include <QDebug>
 
@@ -221,6 +223,157 @@ void FileInputIteratorTest::sharedDataReadTest_data()
   QTest::newRow("Medium string,UTF-16,1024") << "ABCDEFGHIJKLMNOPQRSTUVWXYZ@01€23456789aäbcdeéfghijklmnoöpqrstuvwxyz" << "UTF-16" << 1024;
   QTest::newRow("Medium string,UTF-32,3") << "ABCDEFGHIJKLMNOPQRSTUVWXYZ@01€23456789aäbcdeéfghijklmnoöpqrstuvwxyz" << "UTF-32" << 3;
   QTest::newRow("Medium string,UTF-32,1024") << "ABCDEFGHIJKLMNOPQRSTUVWXYZ@01€23456789aäbcdeéfghijklmnoöpqrstuvwxyz" << "UTF-32" << 1024;
+  QTest::newRow("Medium string,ISO-8859-1,3") << "ABCDEFGHIJKLMNOPQRSTUVWXYZ@0123456789aäbcdeéfghijklmnoöpqrstuvwxyz" << "ISO-8859-1" << 3;
+  QTest::newRow("Medium string,ISO-8859-1,1024") << "ABCDEFGHIJKLMNOPQRSTUVWXYZ@0123456789aäbcdeéfghijklmnoöpqrstuvwxyz" << "ISO-8859-1" << 1024;
+  QTest::newRow("A😀B,UTF-8,1") << "A😀B" << "UTF-8" << 1;
+  QTest::newRow("A😀B,UTF-8,2") << "A😀B" << "UTF-8" << 2;
+  QTest::newRow("A😀B,UTF-8,3") << "A😀B" << "UTF-8" << 3;
+  QTest::newRow("A😀B,UTF-8,4") << "A😀B" << "UTF-8" << 4;
+  QTest::newRow("A😀B,UTF-8,5") << "A😀B" << "UTF-8" << 5;
+  QTest::newRow("A😀B,UTF-8,1024") << "A😀B" << "UTF-8" << 1024;
+  QTest::newRow("Long string,UTF-8,7") << "ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789abcdefghijklmnopqrstuvwxyz€ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789abcdefghijklmnopqrstuvwxyzé" << "UTF-8" << 7;
+  QTest::newRow("Long string,UTF-8,17") << "ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789abcdefghijklmnopqrstuvwxyz€ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789abcdefghijklmnopqrstuvwxyzé" << "UTF-8" << 17;
+}
+
+void FileInputIteratorTest::sharedDataUtf8BomTest()
+{
+  QTemporaryFile file;
+  QString unicodeBuffer;
+
+  QVERIFY(file.open());
+  QVERIFY(file.write("\xEF\xBB\xBF" "AB\xC3\xB6") == 7);
+  file.close();
+  for(int rawDataBufferSize = 1; rawDataBufferSize < 9; ++rawDataBufferSize){
+    FileInputIteratorSharedData sd(rawDataBufferSize);
+    QVERIFY(file.open());
+    QVERIFY(sd.setSource(&file, "UTF-8"));
+    unicodeBuffer.clear();
+    while(!sd.atEnd()){
+      unicodeBuffer.append(sd.get());
+      QVERIFY(sd.advance());
+    }
+    QCOMPARE(unicodeBuffer, QString::fromUtf8("ABö"));
+    file.close();
+  }
+  // File that only contains a BOM
+  QVERIFY(file.open());
+  QVERIFY(file.resize(0));
+  QVERIFY(file.write("\xEF\xBB\xBF") == 3);
+  file.close();
+  QVERIFY(file.open());
+  FileInputIteratorSharedData sd;
+  QVERIFY(sd.setSource(&file, "UTF-8"));
+  QVERIFY(sd.atEnd());
+}
+
+void FileInputIteratorTest::sharedDataAdaptiveBufferTest()
+{
+  QTemporaryFile file;
+  QByteArray fileData;
+
+  for(int i = 0; i < 200000; ++i){
+    fileData += "0123456789";
+  }
+  QVERIFY(file.open());
+  QVERIFY(file.write(fileData) == fileData.size());
+  file.close();
+  /*
+   * Default: adaptive buffer
+   */
+  FileInputIteratorSharedData sd;
+  QCOMPARE(sd.maximumRawDataBufferCapacity(), 4*1024*1024);
+  QCOMPARE(sd.counters().rawDataBufferCapacity, 16*1024);
+  QVERIFY(file.open());
+  QVERIFY(sd.setSource(&file, "UTF-8"));
+  int charCount = 0;
+  while(!sd.atEnd()){
+    ++charCount;
+    QVERIFY(sd.advance());
+  }
+  QCOMPARE(charCount, fileData.size());
+  auto counters = sd.counters();
+  QCOMPARE(counters.bytesRead, static_cast<qint64>(fileData.size()));
+  QVERIFY(counters.refillCount > 0);
+  QVERIFY(counters.decodeTime >= 0);
+  QVERIFY(counters.rawDataBufferCapacity >= 16*1024);
+  QVERIFY(counters.rawDataBufferCapacity <= 4*1024*1024);
+  file.close();
+  /*
+   * Fixed buffer
+   */
+  FileInputIteratorSharedData fixedSd(1024);
+  QCOMPARE(fixedSd.maximumRawDataBufferCapacity(), 1024);
+  QVERIFY(file.open());
+  QVERIFY(fixedSd.setSource(&file, "UTF-8"));
+  while(!fixedSd.atEnd()){
+    QVERIFY(fixedSd.advance());
+  }
+  counters = fixedSd.counters();
+  QCOMPARE(counters.bytesRead, static_cast<qint64>(fileData.size()));
+  QVERIFY(counters.refillCount >= fileData.size() / 1024);
+  QCOMPARE(counters.rawDataBufferCapacity, 1024);
+  file.close();
+  /*
+   * Counters are reset by setSource()
+   */
+  QVERIFY(file.open());
+  QVERIFY(fixedSd.setSource(&file, "UTF-8"));
+  QCOMPARE(fixedSd.counters().bytesRead, Q_INT64_C(1024));
+  QCOMPARE(fixedSd.counters().refillCount, 1);
+  file.close();
+}
+
+void FileInputIteratorTest::decodeUtf8Test()
+{
+  using Mdt::PlainText::Impl::decodeUtf8;
+
+  const QString expected = QString::fromUtf8("ABCDEFGHIJKLMNOPQRSTUVWXYZ aäöü € 😀 0123456789 abcdefghijklmnopqrstuvwxyz");
+  const QByteArray source = expected.toUtf8();
+  /*
+   * Decode by chunks of all possible sizes
+   */
+  for(int chunkSize = 1; chunkSize <= source.size(); ++chunkSize){
+    QString result;
+    QByteArray pending;
+    int pos = 0;
+    while(pos < source.size()){
+      const int n = qMin(chunkSize, source.size() - pos);
+      QByteArray chunk = pending + QByteArray::fromRawData(source.constData() + pos, n);
+      pos += n;
+      const bool flush = (pos == source.size());
+      const auto *first = reinterpret_cast<const uchar*>(chunk.constData());
+      QVector<ushort> out(chunk.size());
+      int bytesConsumed;
+      const int charCount = decodeUtf8(first, first + chunk.size(), out.data(), bytesConsumed, flush);
+      result.append(reinterpret_cast<const QChar*>(out.constData()), charCount);
+      pending = chunk.mid(bytesConsumed);
+      QVERIFY(pending.size() <= 3);
+    }
+    QVERIFY(pending.isEmpty());
+    QCOMPARE(result, expected);
+  }
+  /*
+   * Invalid sequences
+   */
+  const QByteArray invalid("A\xC3(\xC0\x80\xED\xA0\x80\xE2\x82");
+  const auto *first = reinterpret_cast<const uchar*>(invalid.constData());
+  QVector<ushort> out(invalid.size());
+  int bytesConsumed;
+  // Without flush, the incomplete sequence at end is not consumed
+  int charCount = decodeUtf8(first, first + invalid.size(), out.data(), bytesConsumed, false);
+  QCOMPARE(bytesConsumed, invalid.size() - 2);
+  QCOMPARE(charCount, 8);
+  QCOMPARE(out.at(0), static_cast<ushort>('A'));
+  QCOMPARE(out.at(1), static_cast<ushort>(QChar::ReplacementCharacter));
+  QCOMPARE(out.at(2), static_cast<ushort>('('));
+  for(int i = 3; i < 8; ++i){
+    QCOMPARE(out.at(i), static_cast<ushort>(QChar::ReplacementCharacter));
+  }
+  // With flush, it is replaced
+  charCount = decodeUtf8(first, first + invalid.size(), out.data(), bytesConsumed, true);
+  QCOMPARE(bytesConsumed, invalid.size());
+  QCOMPARE(charCount, 10);
+  QCOMPARE(out.at(9), static_cast<ushort>(QChar::ReplacementCharacter));
 }
 
 void FileInputIteratorTest::sharedDataBenchmark()
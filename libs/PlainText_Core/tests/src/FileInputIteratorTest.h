@@ -35,6 +35,9 @@ class FileInputIteratorTest : public TestBase
   void sharedDataTest();
   void sharedDataReadTest();
   void sharedDataReadTest_data();
+  void sharedDataUtf8BomTest();
+  void sharedDataAdaptiveBufferTest();
+  void decodeUtf8Test();
   void sharedDataBenchmark();
   void sharedDataBenchmark_data();
   void iteratorTest();
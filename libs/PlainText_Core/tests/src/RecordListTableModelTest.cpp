@@ -21,6 +21,8 @@
 #include "RecordListTableModelTest.h"
 #include "Mdt/PlainText/RecordListTableModel.h"
 #include "Mdt/PlainText/RecordList.h"
+#include "Mdt/PlainText/StringRecordList.h"
+#include "Mdt/PlainText/ColumnarStringRecordList.h"
 #include "qtmodeltest.h"
 
 using namespace Mdt::PlainText;
@@ -125,6 +127,44 @@ void RecordListTableModelTest::dataTest_data()
   QTest::newRow("") << sourceData;
 }
 
+void RecordListTableModelTest::columnarDataTest()
+{
+  QFETCH(StringRecordList, sourceData);
+  QFETCH(int, expectedColumnCount);
+
+  RecordListTableModel model;
+  model.setRecordList(ColumnarStringRecordList(sourceData));
+  QCOMPARE(model.rowCount(), sourceData.rowCount());
+  QCOMPARE(model.columnCount(), expectedColumnCount);
+  for(int row = 0; row < model.rowCount(); ++row){
+    for(int col = 0; col < model.columnCount(); ++col){
+      if(col >= sourceData.columnCount(row)){
+        QVERIFY(getModelData(model, row, col).isNull());
+      }else{
+        QCOMPARE(getModelData(model, row, col), QVariant(sourceData.data(row, col)));
+      }
+    }
+  }
+  // Setting a RecordList again
+  model.setRecordList(RecordList{{"A"}});
+  QCOMPARE(model.rowCount(), 1);
+  QCOMPARE(model.columnCount(), 1);
+  QCOMPARE(getModelData(model, 0, 0), QVariant("A"));
+}
+
+void RecordListTableModelTest::columnarDataTest_data()
+{
+  QTest::addColumn<StringRecordList>("sourceData");
+  QTest::addColumn<int>("expectedColumnCount");
+
+  QTest::newRow("Empty") << StringRecordList{} << 0;
+  QTest::newRow("1 record") << StringRecordList{{"A"}} << 1;
+  QTest::newRow("Same column count") << StringRecordList{{"0A","0B"},{"1A","1B"}} << 2;
+  QTest::newRow("Step up") << StringRecordList{{"0A"},{"1A","1B"},{"2A","2B","2C"}} << 3;
+  QTest::newRow("Step down") << StringRecordList{{"0A","0B","0C"},{"1A","1B"},{"2A"}} << 3;
+  QTest::newRow("Multiple") << StringRecordList{{"0A"},{"1A","1B","1C"},{"2A","2B"}} << 3;
+}
+
 void RecordListTableModelTest::qtModelTest()
 {
   /*
@@ -36,6 +36,8 @@ class RecordListTableModelTest : public TestBase
   void columnCountTest_data();
   void dataTest();
   void dataTest_data();
+  void columnarDataTest();
+  void columnarDataTest_data();
   void qtModelTest();
 };
 
@@ -21,6 +21,7 @@
 #include "SettingsTest.h"
 #include "Mdt/PlainText/CsvCommonSettings.h"
 #include "Mdt/PlainText/CsvParserSettings.h"
+#include "Mdt/PlainText/CsvGeneratorSettings.h"
 
 using namespace Mdt::PlainText;
 
@@ -81,6 +82,11 @@ void SettingsTest::csvParserSettingsTest()
   QCOMPARE(s.fieldSeparator(), ',');
   QCOMPARE(s.fieldProtection(), '\"');
   QCOMPARE(s.parseExp(), true);
+  QCOMPARE(s.parserEngine(), CsvParserSettings::SpiritEngine);
+  QCOMPARE(s.threadCount(), 1);
+  QCOMPARE(s.effectiveThreadCount(), 1);
+  QVERIFY(s.columnDataTypes().isEmpty());
+  QCOMPARE(s.columnDataType(0), QMetaType::QString);
   QVERIFY(s.isValid());
   /*
    * Set/get
@@ -89,6 +95,19 @@ void SettingsTest::csvParserSettingsTest()
   QVERIFY(!s.parseExp());
   s.setParseExp(true);
   QVERIFY(s.parseExp());
+  s.setParserEngine(CsvParserSettings::ScannerEngine);
+  QCOMPARE(s.parserEngine(), CsvParserSettings::ScannerEngine);
+  s.setThreadCount(4);
+  QCOMPARE(s.threadCount(), 4);
+  QCOMPARE(s.effectiveThreadCount(), 4);
+  s.setThreadCount(0);
+  QCOMPARE(s.threadCount(), 0);
+  QVERIFY(s.effectiveThreadCount() >= 1);
+  s.setColumnDataTypes({QMetaType::Int, QMetaType::QDate});
+  QCOMPARE(s.columnDataTypes().size(), 2);
+  QCOMPARE(s.columnDataType(0), QMetaType::Int);
+  QCOMPARE(s.columnDataType(1), QMetaType::QDate);
+  QCOMPARE(s.columnDataType(2), QMetaType::QString);
   /*
    * Validity
    */
@@ -107,6 +126,11 @@ void SettingsTest::csvParserSettingsTest()
   s.setFieldProtection('\'');
   s.setParseExp(true);
   QVERIFY(s.isValid());
+  // Unsupported column data type
+  s.setColumnDataTypes({QMetaType::Int, QMetaType::QPoint});
+  QVERIFY(!s.isValid());
+  s.setColumnDataTypes({QMetaType::Int, QMetaType::Double, QMetaType::LongLong, QMetaType::QString, QMetaType::QDate});
+  QVERIFY(s.isValid());
   /*
    * Clear
    */
@@ -114,6 +138,57 @@ void SettingsTest::csvParserSettingsTest()
   QCOMPARE(s.fieldSeparator(), ',');
   QCOMPARE(s.fieldProtection(), '\"');
   QCOMPARE(s.parseExp(), true);
+  QCOMPARE(s.parserEngine(), CsvParserSettings::SpiritEngine);
+  QCOMPARE(s.threadCount(), 1);
+  QVERIFY(s.columnDataTypes().isEmpty());
+  QVERIFY(s.isValid());
+}
+
+void SettingsTest::csvGeneratorSettingsTest()
+{
+  CsvGeneratorSettings s;
+  /*
+   * Initial state
+   */
+  QCOMPARE(s.fieldSeparator(), ',');
+  QCOMPARE(s.fieldProtection(), '\"');
+  QCOMPARE(s.fieldProtectionMode(), CsvGeneratorSettings::ProtectWhenRequired);
+  QCOMPARE(s.endOfLine(), CsvGeneratorSettings::CrLfEndOfLine);
+  QVERIFY(s.isValid());
+  /*
+   * Set/get
+   */
+  s.setFieldProtectionMode(CsvGeneratorSettings::ProtectAllFields);
+  QCOMPARE(s.fieldProtectionMode(), CsvGeneratorSettings::ProtectAllFields);
+  s.setEndOfLine(CsvGeneratorSettings::LfEndOfLine);
+  QCOMPARE(s.endOfLine(), CsvGeneratorSettings::LfEndOfLine);
+  /*
+   * Validity
+   */
+  // Wrong setup
+  s.setFieldSeparator(',');
+  s.setFieldProtection(',');
+  QVERIFY(!s.isValid());
+  // Wrong setup
+  s.setFieldSeparator('\n');
+  s.setFieldProtection('\"');
+  QVERIFY(!s.isValid());
+  // Wrong setup
+  s.setFieldSeparator(',');
+  s.setFieldProtection('\r');
+  QVERIFY(!s.isValid());
+  // Good setup
+  s.setFieldSeparator(';');
+  s.setFieldProtection('\'');
+  QVERIFY(s.isValid());
+  /*
+   * Clear
+   */
+  s.clear();
+  QCOMPARE(s.fieldSeparator(), ',');
+  QCOMPARE(s.fieldProtection(), '\"');
+  QCOMPARE(s.fieldProtectionMode(), CsvGeneratorSettings::ProtectWhenRequired);
+  QCOMPARE(s.endOfLine(), CsvGeneratorSettings::CrLfEndOfLine);
   QVERIFY(s.isValid());
 }
 
@@ -34,6 +34,7 @@ class SettingsTest : public TestBase
 
   void csvCommonSettingsTest();
   void csvParserSettingsTest();
+  void csvGeneratorSettingsTest();
 };
 
 #endif // #ifndef MDT_PLAIN_TEXT_CORE_SETTINGS_TEST_H